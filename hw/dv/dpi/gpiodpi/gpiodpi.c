@@ -29,12 +29,63 @@
 // This module currently is capable of implementing 32 GPIOs.
 #define NUM_GPIO 32
 
+// Number of device-to-host records buffered in binary mode before they are
+// flushed to the FIFO with a single `write`.
+#define BIN_TX_RECORDS 256
+
+// Number of host-to-device records that can be pending in binary mode.
+#define BIN_RX_RECORDS 1024
+
+// Preamble sent to the host when switching into binary mode.
+#define BIN_MAGIC "GPB1"
+
 // This file does a lot of bit setting and getting; these macros are intended to
 // make that a little more readable.
 #define GET_BIT(word, bit_idx) (((word) >> (bit_idx)) & 1)
 #define SET_BIT(word, bit_idx) ((word) |= (1 << (bit_idx)))
 #define CLR_BIT(word, bit_idx) ((word) &= ~(1 << (bit_idx)))
 
+/**
+ * Device-to-host record in binary mode. All fields are little-endian.
+ */
+typedef struct gpiodpi_bin_event {
+  // Number of ticks since the previous record.
+  uint32_t delta_ticks;
+  // Pins whose observed state (0, 1 or X) changed.
+  uint32_t changed;
+  // Output enables of the changed pins; zero for all other pins.
+  uint32_t oe;
+  // Output values of the changed, enabled pins; zero for all other pins.
+  uint32_t data;
+} gpiodpi_bin_event_t;
+
+/**
+ * Host-to-device record in binary mode. All fields are little-endian.
+ */
+typedef struct gpiodpi_bin_cmd {
+  // One of `gpiodpi_bin_op_t`.
+  uint8_t op;
+  uint8_t reserved[3];
+  // Number of ticks to wait after the previous record has been applied.
+  uint32_t delay_ticks;
+  // Pins affected by a drive command.
+  uint32_t mask;
+  // Values to drive the pins in `mask` to.
+  uint32_t value;
+} gpiodpi_bin_cmd_t;
+
+typedef enum gpiodpi_bin_op {
+  // Drive the pins in `mask` strongly.
+  kGpiodpiBinOpDriveStrong = 0x01,
+  // Drive the pins in `mask` through a weak pull.
+  kGpiodpiBinOpDriveWeak = 0x02,
+  // Emit a record with the full pin state, even if nothing changed.
+  kGpiodpiBinOpSync = 0x03,
+  // Flush all pending device-to-host records and return to text mode. This
+  // takes effect as soon as it is received; `delay_ticks` is ignored.
+  kGpiodpiBinOpText = 0x04,
+} gpiodpi_bin_op_t;
+
 struct gpiodpi_ctx {
   // The number of pins we're driving.
   int n_bits;
@@ -47,6 +98,30 @@ struct gpiodpi_ctx {
   // avoid excessive `read` syscalls to the pipe fd.
   uint32_t counter;
 
+  // Whether the FIFOs carry the binary protocol instead of text.
+  bool binary;
+  // The last pin state reported to the host in binary mode, and the tick at
+  // which it was reported.
+  uint32_t last_data;
+  uint32_t last_oe;
+  uint64_t last_event_tick;
+  // Monotonic tick counter used for binary mode timestamps.
+  uint64_t ticks;
+
+  // Device-to-host records waiting to be written.
+  gpiodpi_bin_event_t tx_buf[BIN_TX_RECORDS];
+  size_t tx_len;
+
+  // Host-to-device records waiting to be applied, as a ring buffer, and the
+  // tick at which the previous record was applied.
+  gpiodpi_bin_cmd_t rx_buf[BIN_RX_RECORDS];
+  size_t rx_head;
+  size_t rx_len;
+  uint64_t rx_last_tick;
+  // A partially received host-to-device record.
+  uint8_t rx_partial[sizeof(gpiodpi_bin_cmd_t)];
+  size_t rx_partial_len;
+
   // File descriptors and paths for the device-to-host and host-to-device
   // FIFOs.
   int dev_to_host_fifo;
@@ -105,6 +180,7 @@ static void print_usage(char *rfifo, char *wfifo, int n_bits) {
          wfifo);
   printf("$ echo 'wh10' > %s  # Pull pin 10 high through a weak pull-up.\n",
          wfifo);
+  printf("GPIO: Send 'B' to switch both FIFOs to the binary protocol.\n");
 }
 
 void *gpiodpi_create(const char *name, int n_bits) {
@@ -120,6 +196,16 @@ void *gpiodpi_create(const char *name, int n_bits) {
   ctx->driven_pin_values = 0;
   ctx->weak_pins = 0;
   ctx->counter = 0;
+  ctx->binary = false;
+  ctx->last_data = 0;
+  ctx->last_oe = 0;
+  ctx->last_event_tick = 0;
+  ctx->ticks = 0;
+  ctx->tx_len = 0;
+  ctx->rx_head = 0;
+  ctx->rx_len = 0;
+  ctx->rx_last_tick = 0;
+  ctx->rx_partial_len = 0;
 
   char cwd_buf[PATH_MAX];
   char *cwd = getcwd(cwd_buf, sizeof(cwd_buf));
@@ -150,11 +236,133 @@ void *gpiodpi_create(const char *name, int n_bits) {
   return (void *)ctx;
 }
 
+/**
+ * Writes all of |buf| to |fd|, retrying on short writes.
+ */
+static void write_all(int fd, const void *buf, size_t len) {
+  const uint8_t *bytes = (const uint8_t *)buf;
+  while (len > 0) {
+    ssize_t written = write(fd, bytes, len);
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    assert(written > 0);
+    bytes += written;
+    len -= (size_t)written;
+  }
+}
+
+static void store_le32(uint8_t *dst, uint32_t val) {
+  dst[0] = val & 0xff;
+  dst[1] = (val >> 8) & 0xff;
+  dst[2] = (val >> 16) & 0xff;
+  dst[3] = (val >> 24) & 0xff;
+}
+
+static uint32_t load_le32(const uint8_t *src) {
+  return (uint32_t)src[0] | ((uint32_t)src[1] << 8) |
+         ((uint32_t)src[2] << 16) | ((uint32_t)src[3] << 24);
+}
+
+/**
+ * Writes all buffered binary device-to-host records with a single syscall.
+ */
+static void bin_flush(struct gpiodpi_ctx *ctx) {
+  if (ctx->tx_len == 0) {
+    return;
+  }
+
+  uint8_t bytes[BIN_TX_RECORDS * sizeof(gpiodpi_bin_event_t)];
+  uint8_t *out = bytes;
+  for (size_t i = 0; i < ctx->tx_len; ++i) {
+    const gpiodpi_bin_event_t *ev = &ctx->tx_buf[i];
+    store_le32(out, ev->delta_ticks);
+    store_le32(out + 4, ev->changed);
+    store_le32(out + 8, ev->oe);
+    store_le32(out + 12, ev->data);
+    out += sizeof(gpiodpi_bin_event_t);
+  }
+  write_all(ctx->dev_to_host_fifo, bytes, (size_t)(out - bytes));
+  ctx->tx_len = 0;
+}
+
+static void bin_push_event(struct gpiodpi_ctx *ctx, uint32_t delta_ticks,
+                           uint32_t changed, uint32_t oe, uint32_t data) {
+  if (ctx->tx_len == BIN_TX_RECORDS) {
+    bin_flush(ctx);
+  }
+  ctx->tx_buf[ctx->tx_len++] = (gpiodpi_bin_event_t){
+      .delta_ticks = delta_ticks,
+      .changed = changed,
+      .oe = oe & changed,
+      .data = data & oe & changed,
+  };
+}
+
+/**
+ * Queues a binary record for the pins in |changed|, splitting the timestamp
+ * into several records if it does not fit into 32 bits.
+ */
+static void bin_report(struct gpiodpi_ctx *ctx, uint32_t changed) {
+  uint64_t delta = ctx->ticks - ctx->last_event_tick;
+  while (delta > UINT32_MAX) {
+    bin_push_event(ctx, UINT32_MAX, 0, 0, 0);
+    delta -= UINT32_MAX;
+  }
+  bin_push_event(ctx, (uint32_t)delta, changed, ctx->last_oe, ctx->last_data);
+  ctx->last_event_tick = ctx->ticks;
+}
+
+/**
+ * Switches the FIFOs to the binary protocol.
+ *
+ * The host receives the preamble followed by a record carrying the full pin
+ * state, so it never has to track state from before the switch.
+ */
+static void bin_enter(struct gpiodpi_ctx *ctx) {
+  if (ctx->binary) {
+    return;
+  }
+  ctx->binary = true;
+  ctx->tx_len = 0;
+  ctx->rx_partial_len = 0;
+  ctx->last_event_tick = ctx->ticks;
+
+  uint8_t preamble[8] = {0};
+  memcpy(preamble, BIN_MAGIC, 4);
+  preamble[4] = (uint8_t)ctx->n_bits;
+  preamble[5] = sizeof(gpiodpi_bin_event_t);
+  preamble[6] = sizeof(gpiodpi_bin_cmd_t);
+  write_all(ctx->dev_to_host_fifo, preamble, sizeof(preamble));
+
+  bin_report(ctx, (uint32_t)((1ull << ctx->n_bits) - 1));
+  bin_flush(ctx);
+}
+
 void gpiodpi_device_to_host(void *ctx_void, svBitVecVal *gpio_data,
                             svBitVecVal *gpio_oe) {
   struct gpiodpi_ctx *ctx = (struct gpiodpi_ctx *)ctx_void;
   assert(ctx);
 
+  uint32_t prev_data = ctx->last_data;
+  uint32_t prev_oe = ctx->last_oe;
+  ctx->last_data = gpio_data[0];
+  ctx->last_oe = gpio_oe[0];
+
+  if (ctx->binary) {
+    // Only the pins whose observed 0/1/X state changed are reported; data
+    // toggles on disabled pins are invisible to the host.
+    uint32_t changed = (prev_oe ^ ctx->last_oe) |
+                       ((prev_data ^ ctx->last_data) & ctx->last_oe);
+    if (ctx->n_bits < 32) {
+      changed &= (1u << ctx->n_bits) - 1;
+    }
+    if (changed != 0) {
+      bin_report(ctx, changed);
+    }
+    return;
+  }
+
   // Write 0, 1, or X (when oe is not set) for each GPIO pin, in big endian
   // order (i.e., pin 0 is the last character written). Finish it with a
   // newline.
@@ -211,6 +419,164 @@ static void set_bit_val(uint32_t *word, uint32_t idx, bool val) {
   }
 }
 
+/**
+ * Parses text commands from the NUL-terminated |gpio_str|.
+ *
+ * @return a pointer just past a binary mode switch command, or NULL if the
+ *         whole string was consumed as text.
+ */
+static char *parse_text_cmds(struct gpiodpi_ctx *ctx, char *gpio_str,
+                             svBitVecVal *gpio_oe) {
+  bool weak = false;
+  char *gpio_text = gpio_str;
+  for (; *gpio_text != '\0'; ++gpio_text) {
+    switch (*gpio_text) {
+      case 'b':
+      case 'B': {
+        return gpio_text + 1;
+      }
+      case 'w':
+      case 'W': {
+        weak = true;
+        break;
+      }
+      case 'l':
+      case 'L': {
+        ++gpio_text;
+        int idx = parse_dec(&gpio_text);
+        if (idx < NUM_GPIO) {
+          if (!GET_BIT(gpio_oe[0], idx)) {
+            fprintf(stderr,
+                    "GPIO: Host tried to pull disabled pin low: pin %2d\n",
+                    idx);
+          }
+          CLR_BIT(ctx->driven_pin_values, idx);
+          set_bit_val(&ctx->weak_pins, idx, weak);
+        } else {
+          fprintf(stderr, "GPIO: Host tried to pull invalid pin low: pin %2d\n",
+                  idx);
+        }
+        weak = false;
+        break;
+      }
+      case 'h':
+      case 'H': {
+        ++gpio_text;
+        int idx = parse_dec(&gpio_text);
+        if (idx < NUM_GPIO) {
+          if (!GET_BIT(gpio_oe[0], idx)) {
+            fprintf(stderr,
+                    "GPIO: Host tried to pull disabled pin high: pin %2d\n",
+                    idx);
+          }
+          SET_BIT(ctx->driven_pin_values, idx);
+          set_bit_val(&ctx->weak_pins, idx, weak);
+        } else {
+          fprintf(stderr,
+                  "GPIO: Host tried to pull invalid pin high: pin %2d\n", idx);
+        }
+        weak = false;
+        break;
+      }
+      default:
+        break;
+    }
+    // `parse_dec` leaves the pointer on the first non-digit, which must not be
+    // skipped by the loop increment.
+    if (*gpio_text == '\0') {
+      break;
+    }
+  }
+  return NULL;
+}
+
+/**
+ * Queues binary host-to-device records from |buf|, keeping any trailing
+ * partial record for the next read.
+ *
+ * @return the number of bytes consumed; bytes following a text mode switch
+ *         record are left for the text parser.
+ */
+static size_t bin_receive(struct gpiodpi_ctx *ctx, const uint8_t *buf,
+                          size_t len) {
+  size_t consumed = 0;
+  while (consumed < len) {
+    size_t take = sizeof(ctx->rx_partial) - ctx->rx_partial_len;
+    if (take > len - consumed) {
+      take = len - consumed;
+    }
+    memcpy(&ctx->rx_partial[ctx->rx_partial_len], &buf[consumed], take);
+    ctx->rx_partial_len += take;
+    consumed += take;
+    if (ctx->rx_partial_len < sizeof(ctx->rx_partial)) {
+      break;
+    }
+    ctx->rx_partial_len = 0;
+
+    gpiodpi_bin_cmd_t cmd = {
+        .op = ctx->rx_partial[0],
+        .delay_ticks = load_le32(&ctx->rx_partial[4]),
+        .mask = load_le32(&ctx->rx_partial[8]),
+        .value = load_le32(&ctx->rx_partial[12]),
+    };
+    if (cmd.op == kGpiodpiBinOpText) {
+      // Takes effect immediately; records queued before the switch are still
+      // applied on schedule.
+      bin_flush(ctx);
+      ctx->binary = false;
+      break;
+    }
+    if (ctx->rx_len == BIN_RX_RECORDS) {
+      fprintf(stderr, "GPIO: Binary command queue full, dropping command\n");
+      continue;
+    }
+    if (ctx->rx_len == 0 && ctx->rx_last_tick < ctx->ticks) {
+      ctx->rx_last_tick = ctx->ticks;
+    }
+    ctx->rx_buf[(ctx->rx_head + ctx->rx_len) % BIN_RX_RECORDS] = cmd;
+    ctx->rx_len++;
+  }
+  return consumed;
+}
+
+/**
+ * Applies all queued binary records whose delay has elapsed.
+ */
+static void bin_apply_due(struct gpiodpi_ctx *ctx) {
+  while (ctx->rx_len > 0) {
+    const gpiodpi_bin_cmd_t *cmd = &ctx->rx_buf[ctx->rx_head];
+    uint64_t due = ctx->rx_last_tick + cmd->delay_ticks;
+    if (due > ctx->ticks) {
+      return;
+    }
+    ctx->rx_last_tick = due;
+    ctx->rx_head = (ctx->rx_head + 1) % BIN_RX_RECORDS;
+    ctx->rx_len--;
+
+    switch (cmd->op) {
+      case kGpiodpiBinOpDriveStrong:
+        ctx->driven_pin_values =
+            (ctx->driven_pin_values & ~cmd->mask) | (cmd->value & cmd->mask);
+        ctx->weak_pins &= ~cmd->mask;
+        break;
+      case kGpiodpiBinOpDriveWeak:
+        ctx->driven_pin_values =
+            (ctx->driven_pin_values & ~cmd->mask) | (cmd->value & cmd->mask);
+        ctx->weak_pins |= cmd->mask;
+        break;
+      case kGpiodpiBinOpSync:
+        if (ctx->binary) {
+          bin_report(ctx, (uint32_t)((1ull << ctx->n_bits) - 1));
+        }
+        break;
+      default:
+        fprintf(stderr, "GPIO: Ignoring unknown binary command 0x%02x\n",
+                cmd->op);
+        break;
+    }
+  }
+}
+
 uint32_t gpiodpi_host_to_device_tick(void *ctx_void, svBitVecVal *gpio_oe,
                                      svBitVecVal *gpio_pull_en,
                                      svBitVecVal *gpio_pull_sel) {
@@ -218,72 +584,39 @@ uint32_t gpiodpi_host_to_device_tick(void *ctx_void, svBitVecVal *gpio_oe,
   assert(ctx);
 
   if (ctx->counter % TICKS_PER_SYSCALL == 0) {
+    if (ctx->binary) {
+      bin_flush(ctx);
+    }
+
     char gpio_str[256];
     ssize_t read_len =
         read(ctx->host_to_dev_fifo, gpio_str, sizeof(gpio_str) - 1);
     if (read_len > 0) {
       gpio_str[read_len] = '\0';
 
-      bool weak = false;
-      char *gpio_text = gpio_str;
-      for (; *gpio_text != '\0'; ++gpio_text) {
-        switch (*gpio_text) {
-          case '\0':
-            goto parse_loop_end;
-          case 'w':
-          case 'W': {
-            weak = true;
-            break;
-          }
-          case 'l':
-          case 'L': {
-            ++gpio_text;
-            int idx = parse_dec(&gpio_text);
-            if (idx < NUM_GPIO) {
-              if (!GET_BIT(gpio_oe[0], idx)) {
-                fprintf(stderr,
-                        "GPIO: Host tried to pull disabled pin low: pin %2d\n",
-                        idx);
-              }
-              CLR_BIT(ctx->driven_pin_values, idx);
-              set_bit_val(&ctx->weak_pins, idx, weak);
-            } else {
-              fprintf(stderr,
-                      "GPIO: Host tried to pull invalid pin low: pin %2d\n",
-                      idx);
-            }
-            weak = false;
+      // A single read may switch between the text and binary protocols any
+      // number of times.
+      size_t pos = 0;
+      while (pos < (size_t)read_len) {
+        if (ctx->binary) {
+          pos += bin_receive(ctx, (const uint8_t *)&gpio_str[pos],
+                             (size_t)read_len - pos);
+        } else {
+          char *rest = parse_text_cmds(ctx, &gpio_str[pos], gpio_oe);
+          if (rest == NULL) {
             break;
           }
-          case 'h':
-          case 'H': {
-            ++gpio_text;
-            int idx = parse_dec(&gpio_text);
-            if (idx < NUM_GPIO) {
-              if (!GET_BIT(gpio_oe[0], idx)) {
-                fprintf(stderr,
-                        "GPIO: Host tried to pull disabled pin high: pin %2d\n",
-                        idx);
-              }
-              SET_BIT(ctx->driven_pin_values, idx);
-              set_bit_val(&ctx->weak_pins, idx, weak);
-            } else {
-              fprintf(stderr,
-                      "GPIO: Host tried to pull invalid pin high: pin %2d\n",
-                      idx);
-            }
-            weak = false;
-            break;
-          }
-          default:
-            break;
+          pos = (size_t)(rest - gpio_str);
+          bin_enter(ctx);
         }
       }
     }
   }
 
-parse_loop_end:
   ctx->counter += 1;
+  ctx->ticks += 1;
+  bin_apply_due(ctx);
+
   // The verilated module simulates logic, but the weak/strong inputs result
   // from the properties of the IO pads and the selection of external pull
   // resistors. Since the verilated model doesn't model the analog properties
@@ -305,6 +638,10 @@ void gpiodpi_close(void *ctx_void) {
     return;
   }
 
+  if (ctx->binary) {
+    bin_flush(ctx);
+  }
+
   if (close(ctx->dev_to_host_fifo) != 0) {
     printf("GPIO: Failed to close FIFO file at %s: %s\n", ctx->dev_to_host_path,
            strerror(errno));
@@ -37,6 +37,24 @@ void gpiodpi_device_to_host(void *ctx_void, svBitVecVal *gpio_data,
  * does the opposite. All other pins at left in an unspecified state. Invalid
  * commands are ignored.
  *
+ * A |B| command switches both FIFOs to a binary protocol intended for
+ * automated stress tests. The device answers with an 8-byte preamble
+ * ("GPB1", the pin count, the device record size and the host record size)
+ * followed by one record with the full pin state. From then on, the device
+ * only sends 16-byte records for pins whose state changed, batched into as
+ * few writes as possible:
+ *
+ *   u32 delta_ticks; u32 changed; u32 oe; u32 data;
+ *
+ * and the host sends 16-byte records, which may be batched freely:
+ *
+ *   u8 op; u8 reserved[3]; u32 delay_ticks; u32 mask; u32 value;
+ *
+ * where |op| is 1 (drive |mask| strongly to |value|), 2 (drive weakly), 3
+ * (request a full-state record) or 4 (return to text mode). Each host record
+ * is applied |delay_ticks| ticks after the previous one. All fields are
+ * little-endian.
+ *
  * Intended to be called from SystemVerilog.
  * @return the values to pull the GPIO pins to.
  */
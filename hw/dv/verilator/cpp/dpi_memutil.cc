@@ -522,6 +522,16 @@ void DpiMemUtil::StageElf(bool verbose, const std::string &path) {
 
     staged_mem.AddSegment(local_base, std::move(vec));
   }
+
+  // A file whose symbols cannot be read fails to stage like one with bad
+  // segments, leaving nothing in the staging area.
+  try {
+    ReadSymbols(path, elf.ptr_);
+  } catch (const ElfError &err) {
+    staging_area_.clear();
+    throw std::runtime_error(std::string("Failed to stage ELF file: ") +
+                             err.what());
+  }
 }
 
 const StagedMem &DpiMemUtil::GetMemoryData(const std::string &mem_name) const {
@@ -529,6 +539,117 @@ const StagedMem &DpiMemUtil::GetMemoryData(const std::string &mem_name) const {
   return (it == staging_area_.end()) ? empty_ : it->second;
 }
 
+void DpiMemUtil::LoadElfSymbols(const std::string &path) {
+  ElfFile elf(path);
+  ReadSymbols(path, elf.ptr_);
+}
+
+void DpiMemUtil::ReadSymbols(const std::string &path, Elf *elf_file) {
+  // Collect the symbols of this file first, so that a malformed symbol table
+  // leaves symbols_ unchanged.
+  std::map<uint32_t, ElfSymbol> symbols = symbols_;
+  Elf_Scn *scn = nullptr;
+  while ((scn = elf_nextscn(elf_file, scn)) != nullptr) {
+    const Elf32_Shdr *shdr = elf32_getshdr(scn);
+    if (!shdr) {
+      throw ElfError(path, elf_errmsg(-1));
+    }
+    if (shdr->sh_type != SHT_SYMTAB) {
+      continue;
+    }
+
+    Elf_Data *data = elf_getdata(scn, nullptr);
+    if (!data || shdr->sh_entsize != sizeof(Elf32_Sym)) {
+      throw ElfError(path, "malformed symbol table.");
+    }
+
+    size_t num_syms = data->d_size / sizeof(Elf32_Sym);
+    const Elf32_Sym *syms = static_cast<const Elf32_Sym *>(data->d_buf);
+    for (size_t i = 0; i < num_syms; ++i) {
+      const Elf32_Sym &sym = syms[i];
+      if (ELF32_ST_TYPE(sym.st_info) != STT_FUNC ||
+          sym.st_shndx == SHN_UNDEF) {
+        continue;
+      }
+
+      const char *name = elf_strptr(elf_file, shdr->sh_link, sym.st_name);
+      if (!name || !name[0]) {
+        continue;
+      }
+
+      // Keep the first definition of an address, unless it is a zero sized
+      // label and this one has a size.
+      auto it = symbols.find(sym.st_value);
+      if (it == symbols.end()) {
+        symbols.emplace(sym.st_value, ElfSymbol{name, sym.st_size});
+      } else if (it->second.size == 0 && sym.st_size != 0) {
+        it->second = ElfSymbol{name, sym.st_size};
+      }
+    }
+  }
+  symbols_ = std::move(symbols);
+}
+
+bool DpiMemUtil::LookupSymbol(uint32_t addr, std::string *name,
+                              uint32_t *offset) const {
+  assert(name);
+  assert(offset);
+
+  auto it = symbols_.upper_bound(addr);
+  if (it == symbols_.begin()) {
+    return false;
+  }
+  --it;
+
+  // Zero sized symbols (e.g. from assembly files without .size directives)
+  // are taken to extend up to the next symbol.
+  uint32_t off = addr - it->first;
+  if (it->second.size != 0 && off >= it->second.size) {
+    return false;
+  }
+
+  *name = it->second.name;
+  *offset = off;
+  return true;
+}
+
+std::vector<uint8_t> DpiMemUtil::ReadMemory(uint32_t addr,
+                                            uint32_t num_bytes) const {
+  if (num_bytes == 0) {
+    return {};
+  }
+
+  auto mem_area_it = addr_to_mem_.find(addr);
+  if (mem_area_it == addr_to_mem_.end()) {
+    std::ostringstream oss;
+    oss << "No memory region is registered that contains the address 0x"
+        << std::hex << addr << ".";
+    throw std::runtime_error(oss.str());
+  }
+  size_t mem_area_idx = mem_area_it->second;
+  const MemArea &mem_area = *mem_areas_[mem_area_idx];
+
+  uint32_t local_base = addr - base_addrs_[mem_area_idx];
+  if (mem_area.GetSizeBytes() < local_base ||
+      mem_area.GetSizeBytes() - local_base < num_bytes) {
+    std::ostringstream oss;
+    oss << "Cannot read 0x" << std::hex << num_bytes << " bytes at 0x" << addr
+        << ": the range runs past the end of the memory region `"
+        << names_[mem_area_idx] << "'.";
+    throw std::runtime_error(oss.str());
+  }
+
+  // Read whole words covering the range and trim them to the requested bytes.
+  uint32_t width = mem_area.GetWidthByte();
+  uint32_t first_word = local_base / width;
+  uint32_t last_word = (local_base + num_bytes - 1) / width;
+  std::vector<uint8_t> words =
+      mem_area.Read(first_word, last_word - first_word + 1);
+  uint32_t skip = local_base - first_word * width;
+  return std::vector<uint8_t>(words.begin() + skip,
+                              words.begin() + skip + num_bytes);
+}
+
 size_t DpiMemUtil::GetRegionForSegment(const std::string &path, int seg_idx,
                                        uint32_t lma, uint32_t mem_sz) const {
   assert(mem_sz > 0);
@@ -52,6 +52,12 @@ class StagedMem {
   SegMap segs_;
 };
 
+// A function symbol read from an ELF file
+struct ElfSymbol {
+  std::string name;
+  uint32_t size;
+};
+
 /**
  * Provide various memory loading utilities for verilog simulations
  *
@@ -121,10 +127,12 @@ class DpiMemUtil {
 
   /**
    * Load an ELF file into a staging area in this object, which can then be
-   * accessed with GetMemoryData().
+   * accessed with GetMemoryData(). The function symbols of the file are
+   * read as well, see LoadElfSymbols().
    *
-   * If the load fails, raises a std::exception with information about what
-   * happened.
+   * If the load fails, including because of a malformed symbol table, raises
+   * a std::exception with information about what happened and leaves the
+   * staging area empty.
    */
   void StageElf(bool verbose, const std::string &path);
 
@@ -133,6 +141,35 @@ class DpiMemUtil {
    */
   const StagedMem &GetMemoryData(const std::string &mem_name) const;
 
+  /**
+   * Read the function symbols of the ELF file at |path| without loading any
+   * data. StageElf does this for every file it loads.
+   *
+   * Symbols accumulate over all files read, so that images for different
+   * memories (e.g. ROM and flash) can be symbolized at the same time. If the
+   * load fails, raises a std::exception with information about what happened.
+   */
+  void LoadElfSymbols(const std::string &path);
+
+  /**
+   * Find the function symbol containing |addr|
+   *
+   * On success, writes the symbol name to |name| and the offset of |addr|
+   * within the symbol to |offset| and returns true. Returns false if no
+   * symbol read so far contains |addr|.
+   */
+  bool LookupSymbol(uint32_t addr, std::string *name, uint32_t *offset) const;
+
+  /**
+   * Read |num_bytes| bytes at the logical address |addr| by backdoor
+   *
+   * The range must lie within a single registered memory area, otherwise this
+   * throws a std::runtime_error. Reading goes through MemArea::Read, so it
+   * needs the same DPI functions as that, and does not advance the
+   * simulation.
+   */
+  std::vector<uint8_t> ReadMemory(uint32_t addr, uint32_t num_bytes) const;
+
  protected:
   /**
    * A hook for subclasses to do extra computations with loaded ELF data. This
@@ -159,6 +196,14 @@ class DpiMemUtil {
   std::map<std::string, StagedMem> staging_area_;
   const StagedMem empty_;
 
+  // Function symbols from every ELF file read so far, keyed by address.
+  std::map<uint32_t, ElfSymbol> symbols_;
+
+  /**
+   * Add the function symbols of an opened ELF file to symbols_
+   */
+  void ReadSymbols(const std::string &path, Elf *elf_file);
+
   /**
    * Find the index of a memory area containing the given segment's addresses.
    * Raises a std::exception if none is found.
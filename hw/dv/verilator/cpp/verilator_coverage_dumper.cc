@@ -0,0 +1,327 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "verilator_coverage_dumper.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <getopt.h>
+#include <iostream>
+#include <libelf.h>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace {
+// File magic of compressed counters: \x81OTCove\xff
+constexpr uint64_t kFileMagic = 0xff65766f43544f81ULL;
+
+// Size of the SHA-1 build ID at the end of the build ID note
+constexpr size_t kBuildIdSize = 20;
+
+// Counter values used by the coverage runtime
+constexpr uint8_t kCovered = 0x00;
+constexpr uint8_t kUncovered = 0xff;
+
+// Print a usage message to stdout
+void PrintHelp() {
+  std::cout << "Coverage dumper:\n\n"
+               "--coverage-dump=PREFIX\n"
+               "  At the end of the run, read the coverage counters of each\n"
+               "  --coverage-elf image from memory and write them to\n"
+               "  PREFIX.BUILD_ID.xprofraw\n\n"
+               "--coverage-elf=FILE\n"
+               "  Coverage build whose counters to dump (can be given\n"
+               "  multiple times)\n\n";
+}
+
+// Class wrapping an ELF file opened for reading
+class ElfReader {
+ public:
+  explicit ElfReader(const std::string &path) : path_(path) {
+    if (elf_version(EV_CURRENT) == EV_NONE) {
+      throw std::runtime_error(elf_errmsg(-1));
+    }
+    fd_ = open(path.c_str(), O_RDONLY, 0);
+    if (fd_ < 0) {
+      Fail("could not open file.");
+    }
+    elf_ = elf_begin(fd_, ELF_C_READ, nullptr);
+    if (!elf_ || elf_kind(elf_) != ELF_K_ELF) {
+      if (elf_) {
+        elf_end(elf_);
+      }
+      close(fd_);
+      Fail("not an ELF file.");
+    }
+  }
+
+  ~ElfReader() {
+    elf_end(elf_);
+    close(fd_);
+  }
+
+  // Find the section called |name|. Throws if there is none.
+  Elf_Scn *GetSection(const char *name) const {
+    size_t shstrndx;
+    if (elf_getshdrstrndx(elf_, &shstrndx) != 0) {
+      Fail(elf_errmsg(-1));
+    }
+    Elf_Scn *scn = nullptr;
+    while ((scn = elf_nextscn(elf_, scn)) != nullptr) {
+      const Elf32_Shdr *shdr = elf32_getshdr(scn);
+      const char *scn_name =
+          shdr ? elf_strptr(elf_, shstrndx, shdr->sh_name) : nullptr;
+      if (scn_name && strcmp(scn_name, name) == 0) {
+        return scn;
+      }
+    }
+    Fail(std::string("no section `") + name + "'.");
+    return nullptr;
+  }
+
+  // Find the value of the symbol called |name|. Throws if there is none.
+  uint32_t GetSymbol(const char *name) const {
+    Elf_Scn *scn = nullptr;
+    while ((scn = elf_nextscn(elf_, scn)) != nullptr) {
+      const Elf32_Shdr *shdr = elf32_getshdr(scn);
+      if (!shdr || shdr->sh_type != SHT_SYMTAB) {
+        continue;
+      }
+      Elf_Data *data = elf_getdata(scn, nullptr);
+      if (!data || shdr->sh_entsize != sizeof(Elf32_Sym)) {
+        Fail("malformed symbol table.");
+      }
+      size_t num_syms = data->d_size / sizeof(Elf32_Sym);
+      const Elf32_Sym *syms = static_cast<const Elf32_Sym *>(data->d_buf);
+      for (size_t i = 0; i < num_syms; ++i) {
+        const char *sym_name =
+            elf_strptr(elf_, shdr->sh_link, syms[i].st_name);
+        if (sym_name && strcmp(sym_name, name) == 0 &&
+            syms[i].st_shndx != SHN_UNDEF) {
+          return syms[i].st_value;
+        }
+      }
+    }
+    Fail(std::string("no symbol `") + name + "'.");
+    return 0;
+  }
+
+  [[noreturn]] void Fail(const std::string &msg) const {
+    std::ostringstream oss;
+    oss << "Failed to read coverage build `" << path_ << "': " << msg;
+    throw std::runtime_error(oss.str());
+  }
+
+ private:
+  std::string path_;
+  int fd_;
+  Elf *elf_;
+};
+
+// Append a run of |size| counters with value |tag| to |out|
+void CompressRun(uint8_t tag, uint32_t size, std::vector<uint8_t> *out) {
+  out->push_back(tag);
+  if (size <= 0xfd) {
+    out->push_back(size);
+  } else if (size <= 0xffff) {
+    out->push_back(0xfe);
+    out->push_back(size & 0xff);
+    out->push_back(size >> 8);
+  } else {
+    out->push_back(0xff);
+    out->push_back(size & 0xff);
+    out->push_back((size >> 8) & 0xff);
+    out->push_back(size >> 16);
+  }
+}
+
+// Compress counters as coverage_compress() in sw/device/lib/coverage/printer.c
+// does, so that dumps and console reports can be processed the same way.
+std::vector<uint8_t> CompressCounters(const std::vector<uint8_t> &cnts) {
+  std::vector<uint8_t> out;
+  size_t i = 0;
+  while (i < cnts.size()) {
+    size_t start = i;
+    uint8_t tag = cnts[i++];
+    while (i < cnts.size() && cnts[i] == tag) {
+      ++i;
+    }
+    size_t span_size = i - start;
+
+    if (span_size < 8 && start + 8 <= cnts.size()) {
+      // Pack the next 8 counters into a byte, covered counters as set bits.
+      uint8_t packed_byte = 0;
+      for (size_t k = 0; k < 8; ++k) {
+        if (cnts[start + k] == kCovered) {
+          packed_byte |= 1 << k;
+        }
+      }
+      out.push_back(packed_byte);
+      i = start + 8;
+    } else {
+      CompressRun(tag, span_size, &out);
+    }
+  }
+  return out;
+}
+}  // namespace
+
+VerilatorCoverageDumper::VerilatorCoverageDumper(DpiMemUtil *mem_util)
+    : mem_util_(mem_util), enabled_(false) {
+  assert(mem_util);
+}
+
+bool VerilatorCoverageDumper::ParseCLIArguments(int argc, char **argv,
+                                                bool &exit_app) {
+  const struct option long_options[] = {
+      {"coverage-dump", required_argument, nullptr, 'D'},
+      {"coverage-elf", required_argument, nullptr, 'E'},
+      {"help", no_argument, nullptr, 'h'},
+      {nullptr, no_argument, nullptr, 0}};
+
+  std::vector<std::string> elf_paths;
+
+  // Reset the command parsing index in-case other utils have already parsed
+  // some arguments
+  optind = 1;
+  while (1) {
+    int c = getopt_long(argc, argv, "-:h", long_options, nullptr);
+    if (c == -1) {
+      break;
+    }
+
+    // Disable error reporting by getopt
+    opterr = 0;
+
+    switch (c) {
+      case 0:
+      case 1:
+        break;
+      case 'D':
+        enabled_ = true;
+        out_prefix_ = optarg;
+        break;
+      case 'E':
+        elf_paths.push_back(optarg);
+        break;
+      case 'h':
+        PrintHelp();
+        return true;
+      case ':':  // missing argument
+        std::cerr << "ERROR: Missing argument." << std::endl << std::endl;
+        return false;
+      case '?':
+      default:;
+        // Ignore unrecognized options since they might be consumed by
+        // other utils
+    }
+  }
+
+  for (const std::string &path : elf_paths) {
+    try {
+      images_.push_back(ReadCoverageImage(path));
+    } catch (const std::exception &err) {
+      std::cerr << "ERROR: " << err.what() << std::endl;
+      return false;
+    }
+  }
+
+  if (enabled_ && images_.empty()) {
+    std::cerr << "ERROR: --coverage-dump needs at least one --coverage-elf."
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+VerilatorCoverageDumper::CoverageImage
+VerilatorCoverageDumper::ReadCoverageImage(const std::string &path) {
+  ElfReader elf(path);
+
+  CoverageImage image;
+  image.path = path;
+
+  const Elf32_Shdr *cnts = elf32_getshdr(elf.GetSection("__llvm_prf_cnts"));
+  if (!cnts) {
+    elf.Fail(elf_errmsg(-1));
+  }
+  image.cnts_addr = cnts->sh_addr;
+  image.cnts_size = cnts->sh_size;
+
+  // The build ID is the last part of the note, as the runtime reads it.
+  Elf_Data *note = elf_getdata(elf.GetSection(".note.gnu.build-id"), nullptr);
+  if (!note || note->d_size < kBuildIdSize) {
+    elf.Fail("build ID note is too short.");
+  }
+  const uint8_t *note_data = static_cast<const uint8_t *>(note->d_buf);
+  image.build_id.assign(note_data + note->d_size - kBuildIdSize,
+                        note_data + note->d_size);
+
+  image.status_addr = elf.GetSymbol("coverage_status");
+  return image;
+}
+
+bool VerilatorCoverageDumper::Dump(const CoverageImage &image) {
+  // The runtime stores the first word of the build ID in `coverage_status`
+  // while the counters are valid for this build.
+  std::vector<uint8_t> status = mem_util_->ReadMemory(image.status_addr, 4);
+  if (memcmp(status.data(), image.build_id.data(), status.size()) != 0) {
+    return false;
+  }
+  std::vector<uint8_t> cnts =
+      mem_util_->ReadMemory(image.cnts_addr, image.cnts_size);
+  for (uint8_t cnt : cnts) {
+    if (cnt != kCovered && cnt != kUncovered) {
+      return false;
+    }
+  }
+
+  std::ostringstream path;
+  path << out_prefix_ << ".";
+  for (uint8_t b : image.build_id) {
+    char hex[3];
+    snprintf(hex, sizeof(hex), "%02x", b);
+    path << hex;
+  }
+  path << ".xprofraw";
+
+  FILE *f = fopen(path.str().c_str(), "wb");
+  if (!f) {
+    std::cerr << "ERROR: Unable to open `" << path.str() << "'." << std::endl;
+    return false;
+  }
+  // The device is little-endian like the simulation host.
+  std::vector<uint8_t> compressed = CompressCounters(cnts);
+  fwrite(&kFileMagic, sizeof(kFileMagic), 1, f);
+  fwrite(image.build_id.data(), 1, image.build_id.size(), f);
+  fwrite(compressed.data(), 1, compressed.size(), f);
+  fclose(f);
+
+  std::cout << "Coverage of `" << image.path << "' written to `" << path.str()
+            << "'." << std::endl;
+  return true;
+}
+
+void VerilatorCoverageDumper::PostExec() {
+  if (!enabled_) {
+    return;
+  }
+
+  bool dumped = false;
+  for (const CoverageImage &image : images_) {
+    try {
+      dumped |= Dump(image);
+    } catch (const std::exception &err) {
+      std::cerr << "ERROR: Coverage dump of `" << image.path
+                << "' failed: " << err.what() << std::endl;
+    }
+  }
+  if (!dumped) {
+    std::cerr << "WARNING: No valid coverage counters found in memory."
+              << std::endl;
+  }
+}
@@ -0,0 +1,73 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+#ifndef OPENTITAN_HW_DV_VERILATOR_CPP_VERILATOR_COVERAGE_DUMPER_H_
+#define OPENTITAN_HW_DV_VERILATOR_CPP_VERILATOR_COVERAGE_DUMPER_H_
+
+//
+// A SimCtrlExtension extracting software coverage counters from SRAM
+//
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "dpi_memutil.h"
+#include "sim_ctrl_extension.h"
+
+/**
+ * Backdoor extraction of software coverage counters
+ *
+ * Coverage builds of device software (see sw/device/lib/coverage) keep their
+ * counters in main SRAM and normally send them over the console, which is
+ * slow in simulation and lost entirely if the software never gets to report.
+ * Instead, at the end of the simulation this extension reads the counter
+ * region of each ELF file given with --coverage-elf straight from the
+ * simulated memory through DpiMemUtil::ReadMemory, and writes it out as
+ * PREFIX.BUILD_ID.xprofraw in the same compressed format that the device
+ * sends, ready for util/coverage/collect_cc_coverage.
+ *
+ * Since all boot stages share main SRAM, only the images whose coverage
+ * runtime marked the counters as valid for their build ID are dumped.
+ *
+ * Software built with --define ot_coverage_stream=true resets its counters
+ * whenever it streams them over the console, so the dump then only holds the
+ * coverage since the last streamed report and must be merged with the console
+ * log by collect_cc_coverage.
+ *
+ * Dumping is off unless --coverage-dump=PREFIX is given.
+ */
+class VerilatorCoverageDumper : public SimCtrlExtension {
+ public:
+  // |mem_util| is used for backdoor reads and must outlive this object.
+  explicit VerilatorCoverageDumper(DpiMemUtil *mem_util);
+
+  // Declared in SimCtrlExtension
+  bool ParseCLIArguments(int argc, char **argv, bool &exit_app) override;
+  void PostExec() override;
+
+ private:
+  // Location of the coverage counters of an ELF file
+  struct CoverageImage {
+    std::string path;
+    std::vector<uint8_t> build_id;
+    uint32_t cnts_addr;
+    uint32_t cnts_size;
+    uint32_t status_addr;
+  };
+
+  // Read the location of the coverage counters from the ELF file at |path|.
+  // Throws a std::exception if the file is not a coverage build.
+  static CoverageImage ReadCoverageImage(const std::string &path);
+
+  // Write the counters of |image| if they are valid. Returns true if a
+  // profile was written.
+  bool Dump(const CoverageImage &image);
+
+  DpiMemUtil *mem_util_;
+  bool enabled_;
+  std::string out_prefix_;
+  std::vector<CoverageImage> images_;
+};
+
+#endif  // OPENTITAN_HW_DV_VERILATOR_CPP_VERILATOR_COVERAGE_DUMPER_H_
@@ -0,0 +1,345 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "verilator_pc_profiler.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <getopt.h>
+#include <iostream>
+#include <sstream>
+#include <svdpi.h>
+#include <unordered_map>
+
+namespace {
+// The profiler receiving pc_profiler_retire() calls, if any.
+VerilatorPcProfiler *active_profiler = nullptr;
+
+// Link registers of the RISC-V calling convention (ra and t0)
+bool IsLinkReg(uint32_t reg) { return reg == 1 || reg == 5; }
+
+enum ControlFlow {
+  kControlFlowOther,
+  kControlFlowCall,
+  kControlFlowReturn,
+};
+
+// Classify a retired instruction as reported on RVFI
+ControlFlow ClassifyInsn(uint32_t insn) {
+  if ((insn & 0x3) == 0x3) {
+    uint32_t opcode = insn & 0x7f;
+    uint32_t rd = (insn >> 7) & 0x1f;
+    uint32_t rs1 = (insn >> 15) & 0x1f;
+    if (opcode == 0x6f) {
+      // jal
+      return IsLinkReg(rd) ? kControlFlowCall : kControlFlowOther;
+    }
+    if (opcode == 0x67) {
+      // jalr
+      if (IsLinkReg(rd)) {
+        return kControlFlowCall;
+      }
+      return (rd == 0 && IsLinkReg(rs1)) ? kControlFlowReturn
+                                         : kControlFlowOther;
+    }
+    return kControlFlowOther;
+  }
+
+  uint32_t quadrant = insn & 0x3;
+  uint32_t funct3 = (insn >> 13) & 0x7;
+  if (quadrant == 1 && funct3 == 1) {
+    // c.jal (RV32 only)
+    return kControlFlowCall;
+  }
+  if (quadrant == 2 && funct3 == 4) {
+    uint32_t rs1 = (insn >> 7) & 0x1f;
+    uint32_t rs2 = (insn >> 2) & 0x1f;
+    if (rs1 == 0 || rs2 != 0) {
+      return kControlFlowOther;
+    }
+    if (insn & (1 << 12)) {
+      // c.jalr
+      return kControlFlowCall;
+    }
+    // c.jr
+    return IsLinkReg(rs1) ? kControlFlowReturn : kControlFlowOther;
+  }
+  return kControlFlowOther;
+}
+
+// Print a usage message to stdout
+void PrintHelp() {
+  std::cout << "PC profiler:\n\n"
+               "--pc-profile=PREFIX\n"
+               "  Sample the PC of the core and write PREFIX.flat and\n"
+               "  PREFIX.folded (flamegraph input) at the end of the run\n\n"
+               "--pc-profile-interval=N\n"
+               "  Take a sample every N clock cycles (default: 100)\n\n"
+               "--pc-profile-elf=FILE\n"
+               "  Read function symbols from FILE in addition to any ELF file\n"
+               "  loaded into a memory (can be given multiple times)\n\n";
+}
+}  // namespace
+
+VerilatorPcProfiler::VerilatorPcProfiler(DpiMemUtil *mem_util)
+    : mem_util_(mem_util),
+      enabled_(false),
+      interval_(100),
+      cycles_to_sample_(100),
+      have_pc_(false),
+      pc_(0),
+      pending_flow_(kPendingNone),
+      num_samples_(0) {
+  assert(mem_util);
+  assert(!active_profiler);
+  active_profiler = this;
+}
+
+VerilatorPcProfiler::~VerilatorPcProfiler() {
+  assert(active_profiler == this);
+  active_profiler = nullptr;
+}
+
+bool VerilatorPcProfiler::ParseCLIArguments(int argc, char **argv,
+                                            bool &exit_app) {
+  const struct option long_options[] = {
+      {"pc-profile", required_argument, nullptr, 'P'},
+      {"pc-profile-interval", required_argument, nullptr, 'I'},
+      {"pc-profile-elf", required_argument, nullptr, 'S'},
+      {"help", no_argument, nullptr, 'h'},
+      {nullptr, no_argument, nullptr, 0}};
+
+  std::vector<std::string> elf_paths;
+
+  // Reset the command parsing index in-case other utils have already parsed
+  // some arguments
+  optind = 1;
+  while (1) {
+    int c = getopt_long(argc, argv, "-:h", long_options, nullptr);
+    if (c == -1) {
+      break;
+    }
+
+    // Disable error reporting by getopt
+    opterr = 0;
+
+    switch (c) {
+      case 0:
+      case 1:
+        break;
+      case 'P':
+        enabled_ = true;
+        out_prefix_ = optarg;
+        break;
+      case 'I': {
+        char *end;
+        unsigned long interval = strtoul(optarg, &end, 0);
+        if (*end != '\0' || interval == 0) {
+          std::cerr << "ERROR: Invalid --pc-profile-interval: `" << optarg
+                    << "'." << std::endl;
+          return false;
+        }
+        interval_ = interval;
+        break;
+      }
+      case 'S':
+        elf_paths.push_back(optarg);
+        break;
+      case 'h':
+        PrintHelp();
+        return true;
+      case ':':  // missing argument
+        std::cerr << "ERROR: Missing argument." << std::endl << std::endl;
+        return false;
+      case '?':
+      default:;
+        // Ignore unrecognized options since they might be consumed by
+        // other utils
+    }
+  }
+
+  for (const std::string &path : elf_paths) {
+    try {
+      mem_util_->LoadElfSymbols(path);
+    } catch (const std::exception &err) {
+      std::cerr << "ERROR: " << err.what() << std::endl;
+      return false;
+    }
+  }
+
+  cycles_to_sample_ = interval_;
+  return true;
+}
+
+void VerilatorPcProfiler::OnRetire(uint32_t pc, uint32_t insn, bool trap) {
+  if (!enabled_) {
+    return;
+  }
+
+  // Calls and returns take effect on the stack once the next instruction
+  // retires, so that cycles spent on the call or return instruction itself
+  // are attributed to the function containing it.
+  switch (pending_flow_) {
+    case kPendingCall:
+      if (call_sites_.size() == kMaxStackDepth) {
+        call_sites_.erase(call_sites_.begin());
+      }
+      call_sites_.push_back(pc_);
+      break;
+    case kPendingReturn:
+      if (!call_sites_.empty()) {
+        call_sites_.pop_back();
+      }
+      break;
+    default:
+      break;
+  }
+
+  have_pc_ = true;
+  pc_ = pc;
+
+  // A trapping instruction did not transfer control itself.
+  switch (trap ? kControlFlowOther : ClassifyInsn(insn)) {
+    case kControlFlowCall:
+      pending_flow_ = kPendingCall;
+      break;
+    case kControlFlowReturn:
+      pending_flow_ = kPendingReturn;
+      break;
+    default:
+      pending_flow_ = kPendingNone;
+      break;
+  }
+}
+
+void VerilatorPcProfiler::OnClock(unsigned long) {
+  if (!enabled_ || !have_pc_) {
+    return;
+  }
+  if (--cycles_to_sample_) {
+    return;
+  }
+  cycles_to_sample_ = interval_;
+
+  std::vector<uint32_t> stack;
+  stack.reserve(call_sites_.size() + 1);
+  stack.insert(stack.end(), call_sites_.begin(), call_sites_.end());
+  stack.push_back(pc_);
+  ++samples_[stack];
+  ++num_samples_;
+}
+
+void VerilatorPcProfiler::PostExec() {
+  if (!enabled_) {
+    return;
+  }
+
+  WriteFlat(out_prefix_ + ".flat");
+  WriteFolded(out_prefix_ + ".folded");
+  std::cout << std::endl
+            << "PC profile (" << num_samples_ << " samples, every "
+            << interval_ << " cycles) written to " << out_prefix_
+            << ".flat and " << out_prefix_ << ".folded" << std::endl;
+}
+
+std::string VerilatorPcProfiler::Symbolize(uint32_t pc) {
+  auto it = symbol_cache_.find(pc);
+  if (it != symbol_cache_.end()) {
+    return it->second;
+  }
+
+  std::string name;
+  uint32_t offset;
+  if (!mem_util_->LookupSymbol(pc, &name, &offset)) {
+    std::ostringstream oss;
+    oss << "0x" << std::hex << pc;
+    name = oss.str();
+  }
+  symbol_cache_.emplace(pc, name);
+  return name;
+}
+
+void VerilatorPcProfiler::WriteFlat(const std::string &path) {
+  struct Counts {
+    uint64_t self = 0;
+    uint64_t total = 0;
+  };
+  std::unordered_map<std::string, Counts> counts;
+
+  for (const auto &pr : samples_) {
+    const std::vector<uint32_t> &stack = pr.first;
+    std::vector<std::string> seen;
+    for (uint32_t pc : stack) {
+      std::string name = Symbolize(pc);
+      // Count recursive functions once per sample
+      if (std::find(seen.begin(), seen.end(), name) == seen.end()) {
+        counts[name].total += pr.second;
+        seen.push_back(name);
+      }
+    }
+    counts[Symbolize(stack.back())].self += pr.second;
+  }
+
+  std::vector<std::pair<std::string, Counts>> sorted(counts.begin(),
+                                                     counts.end());
+  std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) {
+    if (a.second.self != b.second.self) {
+      return a.second.self > b.second.self;
+    }
+    return a.second.total > b.second.total;
+  });
+
+  FILE *f = fopen(path.c_str(), "w");
+  if (!f) {
+    std::cerr << "ERROR: Unable to open `" << path << "'." << std::endl;
+    return;
+  }
+
+  double scale = num_samples_ ? 100.0 / num_samples_ : 0.0;
+  fprintf(f, "# %llu samples, one every %lu cycles\n",
+          (unsigned long long)num_samples_, interval_);
+  fprintf(f, "#   self%%        self  total%%       total  function\n");
+  for (const auto &pr : sorted) {
+    fprintf(f, "%8.2f %11llu %7.2f %11llu  %s\n", pr.second.self * scale,
+            (unsigned long long)pr.second.self, pr.second.total * scale,
+            (unsigned long long)pr.second.total, pr.first.c_str());
+  }
+  fclose(f);
+}
+
+void VerilatorPcProfiler::WriteFolded(const std::string &path) {
+  // Different call sites within the same functions fold into one stack
+  std::map<std::string, uint64_t> folded;
+  for (const auto &pr : samples_) {
+    std::string line;
+    for (uint32_t pc : pr.first) {
+      if (!line.empty()) {
+        line += ';';
+      }
+      line += Symbolize(pc);
+    }
+    folded[line] += pr.second;
+  }
+
+  FILE *f = fopen(path.c_str(), "w");
+  if (!f) {
+    std::cerr << "ERROR: Unable to open `" << path << "'." << std::endl;
+    return;
+  }
+  for (const auto &pr : folded) {
+    fprintf(f, "%s %llu\n", pr.first.c_str(), (unsigned long long)pr.second);
+  }
+  fclose(f);
+}
+
+extern "C" {
+void pc_profiler_retire(const svBitVecVal *pc, const svBitVecVal *insn,
+                        svBit trap) {
+  if (active_profiler) {
+    active_profiler->OnRetire(pc[0], insn[0], trap);
+  }
+}
+}
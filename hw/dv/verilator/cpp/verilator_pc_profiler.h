@@ -0,0 +1,94 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+#ifndef OPENTITAN_HW_DV_VERILATOR_CPP_VERILATOR_PC_PROFILER_H_
+#define OPENTITAN_HW_DV_VERILATOR_CPP_VERILATOR_PC_PROFILER_H_
+
+//
+// A SimCtrlExtension sampling the program counter of the simulated core
+//
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "dpi_memutil.h"
+#include "sim_ctrl_extension.h"
+
+/**
+ * Statistical PC profiler for Verilator simulations
+ *
+ * The testbench reports every retired instruction via the
+ * `pc_profiler_retire()` DPI function (see the RVFI hookup in
+ * hw/top_earlgrey/dv/verilator/chip_sim_tb.sv). From these the
+ * profiler tracks the PC of the last retired instruction and a shadow call
+ * stack, built from calls and returns following the RISC-V calling
+ * convention. Every N clock cycles the current stack is sampled, so samples
+ * are proportional to the time spent at each PC, including stalls.
+ *
+ * At the end of the simulation the samples are symbolized against the
+ * function symbols of the ELF files read by the DpiMemUtil (see
+ * DpiMemUtil::StageElf and --pc-profile-elf) and written out as:
+ *
+ * - PREFIX.flat: self and total samples per function, hottest first.
+ * - PREFIX.folded: one line per unique stack in the "folded" format read by
+ *   flamegraph.pl and compatible tools.
+ *
+ * Profiling is off unless --pc-profile=PREFIX is given.
+ */
+class VerilatorPcProfiler : public SimCtrlExtension {
+ public:
+  // |mem_util| is used for symbolization and must outlive this object. Only
+  // one profiler may exist at a time.
+  explicit VerilatorPcProfiler(DpiMemUtil *mem_util);
+  ~VerilatorPcProfiler() override;
+
+  // Declared in SimCtrlExtension
+  bool ParseCLIArguments(int argc, char **argv, bool &exit_app) override;
+  void OnClock(unsigned long) override;
+  void PostExec() override;
+
+  /**
+   * Record a retired instruction
+   *
+   * |insn| is the instruction as reported on RVFI, i.e. with compressed
+   * instructions in the lower 16 bits. |trap| is set if the instruction
+   * caused a synchronous trap.
+   */
+  void OnRetire(uint32_t pc, uint32_t insn, bool trap);
+
+ private:
+  // Shadow call stacks deeper than this are truncated at the top.
+  static constexpr size_t kMaxStackDepth = 256;
+
+  std::string Symbolize(uint32_t pc);
+  void WriteFlat(const std::string &path);
+  void WriteFolded(const std::string &path);
+
+  DpiMemUtil *mem_util_;
+  bool enabled_;
+  std::string out_prefix_;
+  unsigned long interval_;
+  unsigned long cycles_to_sample_;
+
+  enum PendingFlow {
+    kPendingNone,
+    kPendingCall,
+    kPendingReturn,
+  };
+
+  // State tracked from retired instructions
+  bool have_pc_;
+  uint32_t pc_;
+  PendingFlow pending_flow_;
+  std::vector<uint32_t> call_sites_;
+
+  // Samples by stack, stored as call sites followed by the sampled PC
+  std::map<std::vector<uint32_t>, uint64_t> samples_;
+  uint64_t num_samples_;
+
+  std::map<uint32_t, std::string> symbol_cache_;
+};
+
+#endif  // OPENTITAN_HW_DV_VERILATOR_CPP_VERILATOR_PC_PROFILER_H_
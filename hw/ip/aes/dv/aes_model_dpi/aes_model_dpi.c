@@ -13,11 +13,130 @@
 #include "crypto.h"
 #include "svdpi.h"
 
-void c_dpi_aes_crypt_block(const unsigned char impl_i, const unsigned char op_i,
-                           const svBitVecVal *mode_i, const svBitVecVal *iv_i,
-                           const svBitVecVal *key_len_i,
-                           const svBitVecVal *key_i, const svBitVecVal *data_i,
-                           svBitVecVal *data_o) {
+// Number of key schedules cached per context.
+#define AES_DPI_KS_CACHE_SIZE 4
+
+typedef struct aes_dpi_ks_entry {
+  int valid;
+  int key_len;
+  unsigned char key[32];
+  // Whether the fast path matched the reference model for this key.
+  int fast_ok;
+  aes_key_schedule_t ks;
+} aes_dpi_ks_entry_t;
+
+struct aes_dpi_ctx {
+  int use_fast;
+  int next_victim;
+  aes_dpi_ks_entry_t entries[AES_DPI_KS_CACHE_SIZE];
+};
+
+// Context used by c_dpi_aes_crypt_block().
+static struct aes_dpi_ctx default_ctx = {.use_fast = 1};
+
+/**
+ * Look up the key schedule for (key, key_len), expanding the key on a miss.
+ */
+static const aes_dpi_ks_entry_t *aes_dpi_ks_get(struct aes_dpi_ctx *ctx,
+                                                const unsigned char *key,
+                                                int key_len) {
+  for (int i = 0; i < AES_DPI_KS_CACHE_SIZE; ++i) {
+    aes_dpi_ks_entry_t *entry = &ctx->entries[i];
+    if (entry->valid && entry->key_len == key_len &&
+        memcmp(entry->key, key, key_len) == 0) {
+      return entry;
+    }
+  }
+
+  aes_dpi_ks_entry_t *entry = &ctx->entries[ctx->next_victim];
+  ctx->next_victim = (ctx->next_victim + 1) % AES_DPI_KS_CACHE_SIZE;
+  entry->valid = 0;
+  if (aes_key_schedule_init(&entry->ks, key, key_len)) {
+    return NULL;
+  }
+  entry->fast_ok = 0;
+  if (ctx->use_fast) {
+    if (aes_key_schedule_self_check(&entry->ks) == 0) {
+      entry->fast_ok = 1;
+    } else {
+      printf(
+          "ERROR: AES fast path does not match the C model, falling back to "
+          "the C model\n");
+    }
+  }
+  entry->key_len = key_len;
+  memcpy(entry->key, key, key_len);
+  entry->valid = 1;
+  return entry;
+}
+
+static void aes_dpi_encrypt(const aes_dpi_ks_entry_t *entry,
+                            const unsigned char *in, unsigned char *out) {
+  if (entry->fast_ok) {
+    aes_encrypt_block_fast(&entry->ks, in, out);
+  } else {
+    aes_encrypt_block_ks(&entry->ks, in, out);
+  }
+}
+
+static void aes_dpi_decrypt(const aes_dpi_ks_entry_t *entry,
+                            const unsigned char *in, unsigned char *out) {
+  if (entry->fast_ok) {
+    aes_decrypt_block_fast(&entry->ks, in, out);
+  } else {
+    aes_decrypt_block_ks(&entry->ks, in, out);
+  }
+}
+
+/**
+ * Convert a packed data block from the simulator into a 16-byte buffer.
+ */
+static void aes_data_get_buf(const svBitVecVal *data_i, unsigned char *data) {
+  // convert from 2D to 1D
+  for (int i = 0; i < 4; i++) {
+    svBitVecVal value = data_i[i];
+    for (int j = 0; j < 4; j++) {
+      data[i + j * 4] = (unsigned char)(value >> (8 * j));
+    }
+  }
+}
+
+/**
+ * Write a 16-byte buffer to the simulator as packed data block.
+ */
+static void aes_data_put_buf(svBitVecVal *data_o, const unsigned char *data) {
+  // convert from 1D to 2D
+  for (int i = 0; i < 4; i++) {
+    svBitVecVal value = 0;
+    for (int j = 0; j < 4; j++) {
+      value |= (svBitVecVal)((data[i + 4 * j]) << (8 * j));
+    }
+    data_o[i] = value;
+  }
+}
+
+/**
+ * Convert a packed key from the simulator into a 32-byte buffer.
+ */
+static void aes_key_get_buf(const svBitVecVal *key_i, unsigned char *key) {
+  for (int i = 0; i < 8; i++) {
+    svBitVecVal value = key_i[i];
+    key[4 * i + 0] = (unsigned char)(value >> 0);
+    key[4 * i + 1] = (unsigned char)(value >> 8);
+    key[4 * i + 2] = (unsigned char)(value >> 16);
+    key[4 * i + 3] = (unsigned char)(value >> 24);
+  }
+}
+
+static void aes_dpi_crypt_block(struct aes_dpi_ctx *ctx,
+                                const unsigned char impl_i,
+                                const unsigned char op_i,
+                                const svBitVecVal *mode_i,
+                                const svBitVecVal *iv_i,
+                                const svBitVecVal *key_len_i,
+                                const svBitVecVal *key_i,
+                                const svBitVecVal *data_i,
+                                svBitVecVal *data_o) {
   // Mask out unused bits as their value is undetermined.
   const unsigned char impl = impl_i & impl_mask;
   const unsigned char op = op_i & op_mask;
@@ -38,23 +157,26 @@ void c_dpi_aes_crypt_block(const unsigned char impl_i, const unsigned char op_i,
   }
 
   // get input data from simulator
-  unsigned char *key = aes_key_get(key_i);
-  unsigned char *ref_in = aes_data_get(data_i);
+  unsigned char key[32];
+  unsigned char ref_in[16];
+  aes_key_get_buf(key_i, key);
+  aes_data_get_buf(data_i, ref_in);
 
   // Modes other than ECB require an IV from the simulator.
-  unsigned char *iv;
+  unsigned char iv[16] = {0};
   if (mode != kCryptoAesEcb) {
-    iv = aes_data_get(iv_i);
-  } else {
-    iv = (unsigned char *)calloc(16, sizeof(unsigned char));
-    assert(iv);
+    aes_data_get_buf(iv_i, iv);
   }
 
-  // allocate memory
-  unsigned char *ref_out = (unsigned char *)malloc(16 * sizeof(unsigned char));
-  assert(ref_out);
+  unsigned char ref_out[16];
 
   if (impl == 0) {
+    const aes_dpi_ks_entry_t *entry = aes_dpi_ks_get(ctx, key, key_len);
+    if (entry == NULL) {
+      printf("ERROR: aes_key_schedule_init() failed\n");
+      return;
+    }
+
     // The C model does ECB only. We "emulate" other modes here.
     unsigned char data_in[16];
     unsigned char data_out[16];
@@ -65,38 +187,27 @@ void c_dpi_aes_crypt_block(const unsigned char impl_i, const unsigned char op_i,
         for (int i = 0; i < 16; ++i) {
           data_in[i] = ref_in[i] ^ iv[i];
         }
-        aes_encrypt_block(data_in, key, key_len, ref_out);
+        aes_dpi_encrypt(entry, data_in, ref_out);
       } else {
-        aes_decrypt_block(ref_in, key, key_len, data_out);
+        aes_dpi_decrypt(entry, ref_in, data_out);
         // ref_out = data_out XOR iv (or previous data_out)
         for (int i = 0; i < 16; ++i) {
           ref_out[i] = data_out[i] ^ iv[i];
         }
       }
-    } else if (mode == kCryptoAesCfb || mode == kCryptoAesOfb) {
-      // data_in = iv
-      for (int i = 0; i < 16; ++i) {
-        data_in[i] = iv[i];
-      }
-      aes_encrypt_block(data_in, key, key_len, data_out);
+    } else if (mode == kCryptoAesCfb || mode == kCryptoAesOfb ||
+               mode == kCryptoAesCtr) {
+      // data_in = iv (or counter value)
+      aes_dpi_encrypt(entry, iv, data_out);
       // ref_out = data_out XOR ref_in
       for (int i = 0; i < 16; ++i) {
         ref_out[i] = data_out[i] ^ ref_in[i];
       }
-    } else if (mode == kCryptoAesCtr) {
-      // data_in = counter value
-      for (int i = 0; i < 16; ++i) {
-        data_in[i] = iv[i];
-      }
-      aes_encrypt_block(data_in, key, key_len, data_out);
-      for (int i = 0; i < 16; ++i) {
-        ref_out[i] = data_out[i] ^ ref_in[i];
-      }
     } else {  // ECB
       if (!op) {
-        aes_encrypt_block(ref_in, key, key_len, ref_out);
+        aes_dpi_encrypt(entry, ref_in, ref_out);
       } else {
-        aes_decrypt_block(ref_in, key, key_len, ref_out);
+        aes_dpi_decrypt(entry, ref_in, ref_out);
       }
     }
   } else {  // OpenSSL/BoringSSL
@@ -109,15 +220,40 @@ void c_dpi_aes_crypt_block(const unsigned char impl_i, const unsigned char op_i,
     }
   }
 
-  // write output data back to simulator, free ref_out
-  aes_data_put(data_o, ref_out);
+  // write output data back to simulator
+  aes_data_put_buf(data_o, ref_out);
+}
+
+void c_dpi_aes_crypt_block(const unsigned char impl_i, const unsigned char op_i,
+                           const svBitVecVal *mode_i, const svBitVecVal *iv_i,
+                           const svBitVecVal *key_len_i,
+                           const svBitVecVal *key_i, const svBitVecVal *data_i,
+                           svBitVecVal *data_o) {
+  aes_dpi_crypt_block(&default_ctx, impl_i, op_i, mode_i, iv_i, key_len_i,
+                      key_i, data_i, data_o);
+}
 
-  // free memory
-  free(iv);
-  free(key);
-  free(ref_in);
+void *c_dpi_aes_ctx_create(const unsigned char fast_i) {
+  struct aes_dpi_ctx *ctx =
+      (struct aes_dpi_ctx *)calloc(1, sizeof(struct aes_dpi_ctx));
+  assert(ctx);
+  ctx->use_fast = fast_i & 0x1;
+  return (void *)ctx;
+}
 
-  return;
+void c_dpi_aes_ctx_free(void *ctx_void) { free(ctx_void); }
+
+void c_dpi_aes_ctx_crypt_block(void *ctx_void, const unsigned char impl_i,
+                               const unsigned char op_i,
+                               const svBitVecVal *mode_i,
+                               const svBitVecVal *iv_i,
+                               const svBitVecVal *key_len_i,
+                               const svBitVecVal *key_i,
+                               const svBitVecVal *data_i, svBitVecVal *data_o) {
+  struct aes_dpi_ctx *ctx = (struct aes_dpi_ctx *)ctx_void;
+  assert(ctx);
+  aes_dpi_crypt_block(ctx, impl_i, op_i, mode_i, iv_i, key_len_i, key_i,
+                      data_i, data_o);
 }
 
 void c_dpi_aes_crypt_message(unsigned char impl_i, unsigned char op_i,
@@ -350,34 +486,20 @@ void c_dpi_aes_key_expand(const unsigned char op_i, const svBitVecVal *rcon_i,
 
 unsigned char *aes_data_get(const svBitVecVal *data_i) {
   unsigned char *data;
-  svBitVecVal value;
 
   // alloc data buffer
   data = (unsigned char *)malloc(16 * sizeof(unsigned char));
   assert(data);
 
-  // get data from simulator, convert from 2D to 1D
-  for (int i = 0; i < 4; i++) {
-    value = data_i[i];
-    for (int j = 0; j < 4; j++) {
-      data[i + j * 4] = (unsigned char)(value >> (8 * j));
-    }
-  }
+  // get data from simulator
+  aes_data_get_buf(data_i, data);
 
   return data;
 }
 
 void aes_data_put(svBitVecVal *data_o, unsigned char *data) {
-  svBitVecVal value;
-
-  // convert from 1D to 2D, write output data to simulation
-  for (int i = 0; i < 4; i++) {
-    value = 0;
-    for (int j = 0; j < 4; j++) {
-      value |= (svBitVecVal)((data[i + 4 * j]) << (8 * j));
-    }
-    data_o[i] = value;
-  }
+  // write output data to simulation
+  aes_data_put_buf(data_o, data);
 
   // free data
   free(data);
@@ -426,20 +548,13 @@ void aes_data_unpacked_put(const svOpenArrayHandle data_o,
 
 unsigned char *aes_key_get(const svBitVecVal *key_i) {
   unsigned char *key;
-  svBitVecVal value;
 
   // alloc data buffer
   key = (unsigned char *)malloc(32 * sizeof(unsigned char));
   assert(key);
 
   // get data from simulator
-  for (int i = 0; i < 8; i++) {
-    value = key_i[i];
-    key[4 * i + 0] = (unsigned char)(value >> 0);
-    key[4 * i + 1] = (unsigned char)(value >> 8);
-    key[4 * i + 2] = (unsigned char)(value >> 16);
-    key[4 * i + 3] = (unsigned char)(value >> 24);
-  }
+  aes_key_get_buf(key_i, key);
 
   return key;
 }
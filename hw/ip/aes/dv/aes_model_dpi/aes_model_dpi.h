@@ -41,6 +41,50 @@ void c_dpi_aes_crypt_block(const unsigned char impl_i, const unsigned char op_i,
                            const svBitVecVal *key_i, const svBitVecVal *data_i,
                            svBitVecVal *data_o);
 
+/**
+ * Create a context that caches expanded keys across calls of
+ * c_dpi_aes_ctx_crypt_block().
+ *
+ * @param  fast_i Use the T-table fast path for the C model. Every newly
+ *                expanded key is first checked against the C model; on a
+ *                mismatch, the context falls back to the C model for that key.
+ * @return Opaque context handle
+ */
+void *c_dpi_aes_ctx_create(const unsigned char fast_i);
+
+/**
+ * Free a context created with c_dpi_aes_ctx_create().
+ *
+ * @param  ctx_void Context handle
+ */
+void c_dpi_aes_ctx_free(void *ctx_void);
+
+/**
+ * Perform encryption/decryption of one block using a context.
+ *
+ * Same as c_dpi_aes_crypt_block(), but the key schedule is cached in the
+ * context and reused for as long as the key and key length do not change.
+ * c_dpi_aes_crypt_block() itself uses a built-in context with the fast path
+ * enabled.
+ *
+ * @param  ctx_void  Context handle
+ * @param  impl_i    Select reference impl.: 0 = C model, 1 = OpenSSL/BoringSSL
+ * @param  op_i      Operation: 0 = encrypt, 1 = decrypt
+ * @param  mode_i    Cipher mode, see c_dpi_aes_crypt_block()
+ * @param  iv_i      Initialization vector: 2D matrix (3D packed array in SV)
+ * @param  key_len_i Key length: 3'b001 = 128b, 3'b010 = 192b, 3'b100 = 256b
+ * @param  key_i     Full input key, 1D array of words (2D packed array in SV)
+ * @param  data_i    Input data, 2D state matrix (3D packed array in SV)
+ * @param  data_o    Output data, 2D state matrix (3D packed array in SV)
+ */
+void c_dpi_aes_ctx_crypt_block(void *ctx_void, const unsigned char impl_i,
+                               const unsigned char op_i,
+                               const svBitVecVal *mode_i,
+                               const svBitVecVal *iv_i,
+                               const svBitVecVal *key_len_i,
+                               const svBitVecVal *key_i,
+                               const svBitVecVal *data_i, svBitVecVal *data_o);
+
 /**
  * Perform encryption/decryption of an entire message using OpenSSL/BoringSSL.
  *
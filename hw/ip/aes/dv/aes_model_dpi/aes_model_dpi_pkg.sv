@@ -19,6 +19,28 @@ package aes_model_dpi_pkg;
     output bit[3:0][3:0][7:0] data_o
   );
 
+  import "DPI-C" context function chandle c_dpi_aes_ctx_create(
+    input  bit                fast_i     // 1 = T-table fast path for the C model
+  );
+
+  import "DPI-C" context function void c_dpi_aes_ctx_free(
+    input  chandle            ctx_i
+  );
+
+  import "DPI-C" context function void c_dpi_aes_ctx_crypt_block(
+    input  chandle            ctx_i,
+    input  bit                impl_i,    // 0 = C model, 1 = OpenSSL/BoringSSL
+    input  bit                op_i,      // 0 = encrypt, 1 = decrypt
+    input  bit          [5:0] mode_i,    // 6'b00_0001 = ECB, 6'00_b0010 = CBC, 6'b00_0100 = CFB,
+                                         // 6'b00_1000 = OFB, 6'b01_0000 = CTR, 6'b10_0000 = GCM,
+                                         // 6'b11_1111 = NONE
+    input  bit[3:0][3:0][7:0] iv_i,
+    input  bit          [2:0] key_len_i, // 3'b001 = 128b, 3'b010 = 192b, 3'b100 = 256b
+    input  bit    [7:0][31:0] key_i,
+    input  bit[3:0][3:0][7:0] data_i,
+    output bit[3:0][3:0][7:0] data_o
+  );
+
   import "DPI-C" context function void c_dpi_aes_crypt_message(
     input  bit              impl_i,    // 0 = C model, 1 = OpenSSL/BoringSSL
     input  bit              op_i,      // 0 = encrypt, 1 = decrypt
@@ -86,4 +108,29 @@ package aes_model_dpi_pkg;
     data_o  = {<<8{data_o}};
     return;
   endfunction // sv_dpi_aes_crypt_block
+
+  // Same as sv_dpi_aes_crypt_block but reuses the key schedule cached in ctx_i.
+  function automatic void sv_dpi_aes_ctx_crypt_block(
+    input  chandle         ctx_i,
+    input  bit             impl_i,    // 0 = C model, 1 = OpenSSL/BoringSSL
+    input  bit             op_i,      // 0 = encrypt, 1 = decrypt
+    input  bit       [5:0] mode_i,    // 6'b00_0001 = ECB, 6'00_b0010 = CBC, 6'b00_0100 = CFB,
+                                      // 6'b00_1000 = OFB, 6'b01_0000 = CTR, 6'b10_0000 = GCM,
+                                      // 6'b11_1111 = NONE
+    input  bit [3:0][31:0] iv_i,
+    input  bit       [2:0] key_len_i, // 3'b001 = 128b, 3'b010 = 192b, 3'b100 = 256b
+    input  bit [7:0][31:0] key_i,
+    input  bit [3:0][31:0] data_i,
+    output bit [3:0][31:0] data_o);
+
+    bit [3:0][3:0][7:0] iv_in, data_in, data_out;
+    data_in = aes_transpose({<<8{data_i}});
+    iv_in   = aes_transpose(iv_i);
+    key_i   = {<<8{key_i}};
+    c_dpi_aes_ctx_crypt_block(ctx_i, impl_i, op_i, mode_i, iv_in, key_len_i, key_i, data_in,
+                              data_out);
+    data_o  = aes_transpose(data_out);
+    data_o  = {<<8{data_o}};
+    return;
+  endfunction // sv_dpi_aes_ctx_crypt_block
 endpackage
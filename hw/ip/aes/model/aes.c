@@ -19,12 +19,7 @@ int aes_encrypt_block(const unsigned char *plain_text, const unsigned char *key,
   unsigned char rcon;
   unsigned char state[16];
   unsigned char round_key[16];
-  unsigned char *full_key =
-      (unsigned char *)malloc(key_len * sizeof(unsigned char));
-  if (full_key == NULL) {
-    printf("ERROR: malloc() failed\n");
-    return -ENOMEM;
-  }
+  unsigned char full_key[32];
 
   // init
   for (int i = 0; i < 16; i++) {
@@ -55,8 +50,6 @@ int aes_encrypt_block(const unsigned char *plain_text, const unsigned char *key,
     cipher_text[i] = state[i];
   }
 
-  free(full_key);
-
   return 0;
 }
 
@@ -72,12 +65,7 @@ int aes_decrypt_block(const unsigned char *cipher_text,
   unsigned char rcon;
   unsigned char state[16];
   unsigned char round_key[16];
-  unsigned char *full_key =
-      (unsigned char *)malloc(key_len * sizeof(unsigned char));
-  if (full_key == NULL) {
-    printf("ERROR: malloc() failed\n");
-    return -ENOMEM;
-  }
+  unsigned char full_key[32];
 
   // init
   for (int i = 0; i < 16; i++) {
@@ -117,7 +105,6 @@ int aes_decrypt_block(const unsigned char *cipher_text,
     plain_text[i] = state[i];
   }
 
-  free(full_key);
   return 0;
 }
 
@@ -352,11 +339,7 @@ void aes_key_expand(unsigned char *round_key, unsigned char *key, int key_len,
   //       for key_len == 16, key == round_key
 
   unsigned char temp[4];
-  unsigned char *old_key;
-  old_key = (unsigned char *)malloc(key_len * sizeof(unsigned char));
-  if (!old_key) {
-    printf("ERROR: malloc() failed.");
-  }
+  unsigned char old_key[32];
 
   // copy key to temp
   for (int i = 0; i < key_len; i++) {
@@ -648,8 +631,6 @@ void aes_key_expand(unsigned char *round_key, unsigned char *key, int key_len,
     round_key[i] = key[key_len - 16 + i];
   }
 
-  free(old_key);
-
   return;
 }
 
@@ -663,11 +644,7 @@ void aes_inv_key_expand(unsigned char *round_key, unsigned char *key,
   //       for key_len == 16, key == round_key
 
   unsigned char temp[4];
-  unsigned char *old_key;
-  old_key = (unsigned char *)malloc(key_len * sizeof(unsigned char));
-  if (!old_key) {
-    printf("ERROR: malloc() failed.");
-  }
+  unsigned char old_key[32];
 
   // copy key to temp
   for (int i = 0; i < key_len; i++) {
@@ -951,8 +928,6 @@ void aes_inv_key_expand(unsigned char *round_key, unsigned char *key,
     round_key[i] = key[i];
   }
 
-  free(old_key);
-
   return;
 }
 
@@ -1002,3 +977,258 @@ void aes_rcon_prev(unsigned char *rcon, int key_len) {
 
   return;
 }
+
+int aes_key_schedule_init(aes_key_schedule_t *ks, const unsigned char *key,
+                          const int key_len) {
+  int num_rounds = aes_get_num_rounds(key_len);
+  if (num_rounds < 0) {
+    printf("ERROR: aes_get_num_rounds() failed\n");
+    return -EINVAL;
+  }
+  ks->key_len = key_len;
+  ks->num_rounds = num_rounds;
+
+  unsigned char rcon;
+  unsigned char round_key[16];
+  unsigned char full_key[32];
+
+  // forward round keys
+  for (int i = 0; i < key_len; i++) {
+    full_key[i] = key[i];
+  }
+  for (int i = 0; i < 16; i++) {
+    round_key[i] = full_key[i];
+    ks->enc_round_key[0][i] = round_key[i];
+  }
+  rcon = 0;
+  for (int j = 0; j < num_rounds; j++) {
+    aes_key_expand(round_key, full_key, key_len, &rcon, j);
+    for (int i = 0; i < 16; i++) {
+      ks->enc_round_key[j + 1][i] = round_key[i];
+    }
+  }
+
+  // inverse round keys - full_key now holds the decryption start key
+  for (int i = 0; i < 16; i++) {
+    ks->dec_round_key[0][i] = round_key[i];
+  }
+  rcon = 0;
+  for (int j = 0; j < num_rounds; j++) {
+    aes_inv_key_expand(round_key, full_key, key_len, &rcon, j);
+    for (int i = 0; i < 16; i++) {
+      ks->dec_round_key[j + 1][i] = round_key[i];
+    }
+    if (j < (num_rounds - 1)) {
+      aes_inv_mix_columns(ks->dec_round_key[j + 1]);
+    }
+  }
+
+  // pack round keys for the fast path
+  for (int j = 0; j <= num_rounds; j++) {
+    for (int c = 0; c < 4; c++) {
+      const unsigned char *ek = &ks->enc_round_key[j][4 * c];
+      const unsigned char *dk = &ks->dec_round_key[j][4 * c];
+      ks->enc_round_word[j][c] = (uint32_t)ek[0] | ((uint32_t)ek[1] << 8) |
+                                 ((uint32_t)ek[2] << 16) |
+                                 ((uint32_t)ek[3] << 24);
+      ks->dec_round_word[j][c] = (uint32_t)dk[0] | ((uint32_t)dk[1] << 8) |
+                                 ((uint32_t)dk[2] << 16) |
+                                 ((uint32_t)dk[3] << 24);
+    }
+  }
+
+  return 0;
+}
+
+void aes_encrypt_block_ks(const aes_key_schedule_t *ks,
+                          const unsigned char *plain_text,
+                          unsigned char *cipher_text) {
+  unsigned char state[16];
+  for (int i = 0; i < 16; i++) {
+    state[i] = plain_text[i];
+  }
+
+  aes_add_round_key(state, ks->enc_round_key[0]);
+  for (int j = 0; j < ks->num_rounds; j++) {
+    aes_sub_bytes(state);
+    aes_shift_rows(state);
+    if (j < (ks->num_rounds - 1)) {
+      aes_mix_columns(state);
+    }
+    aes_add_round_key(state, ks->enc_round_key[j + 1]);
+  }
+
+  for (int i = 0; i < 16; i++) {
+    cipher_text[i] = state[i];
+  }
+}
+
+void aes_decrypt_block_ks(const aes_key_schedule_t *ks,
+                          const unsigned char *cipher_text,
+                          unsigned char *plain_text) {
+  unsigned char state[16];
+  for (int i = 0; i < 16; i++) {
+    state[i] = cipher_text[i];
+  }
+
+  // decrypt - using Equivalent Inverse Cipher
+  aes_add_round_key(state, ks->dec_round_key[0]);
+  for (int j = 0; j < ks->num_rounds; j++) {
+    aes_inv_sub_bytes(state);
+    aes_inv_shift_rows(state);
+    if (j < (ks->num_rounds - 1)) {
+      aes_inv_mix_columns(state);
+    }
+    aes_add_round_key(state, ks->dec_round_key[j + 1]);
+  }
+
+  for (int i = 0; i < 16; i++) {
+    plain_text[i] = state[i];
+  }
+}
+
+// T-tables for the fast path. Column words are packed little-endian, i.e.,
+// row 0 is in the least significant byte. te[x] holds the MixColumns column
+// produced by sbox[x] in row 0: {2, 1, 1, 3} * sbox[x]. The tables for rows
+// 1-3 are byte rotations of te and td and are applied via rotl8().
+static uint32_t te[256];
+static uint32_t td[256];
+static int t_tables_ready = 0;
+
+static unsigned char aes_gf_mul(unsigned char a, unsigned char b) {
+  unsigned char p = 0;
+  for (int i = 0; i < 8; i++) {
+    if (b & 1) {
+      p ^= a;
+    }
+    a = aes_mul2(a);
+    b >>= 1;
+  }
+  return p;
+}
+
+static void aes_t_tables_init(void) {
+  if (t_tables_ready) {
+    return;
+  }
+  for (int x = 0; x < 256; x++) {
+    unsigned char s = sbox[x];
+    te[x] = (uint32_t)aes_gf_mul(s, 2) | ((uint32_t)s << 8) |
+            ((uint32_t)s << 16) | ((uint32_t)aes_gf_mul(s, 3) << 24);
+    unsigned char is = inv_sbox[x];
+    td[x] = (uint32_t)aes_gf_mul(is, 0xe) |
+            ((uint32_t)aes_gf_mul(is, 0x9) << 8) |
+            ((uint32_t)aes_gf_mul(is, 0xd) << 16) |
+            ((uint32_t)aes_gf_mul(is, 0xb) << 24);
+  }
+  t_tables_ready = 1;
+}
+
+static inline uint32_t rotl8(uint32_t x, int n) {
+  return n ? (x << (8 * n)) | (x >> (32 - 8 * n)) : x;
+}
+
+static inline uint32_t load_col(const unsigned char *b) {
+  return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) |
+         ((uint32_t)b[3] << 24);
+}
+
+static inline void store_col(unsigned char *b, uint32_t w) {
+  b[0] = (unsigned char)w;
+  b[1] = (unsigned char)(w >> 8);
+  b[2] = (unsigned char)(w >> 16);
+  b[3] = (unsigned char)(w >> 24);
+}
+
+void aes_encrypt_block_fast(const aes_key_schedule_t *ks,
+                            const unsigned char *plain_text,
+                            unsigned char *cipher_text) {
+  aes_t_tables_init();
+
+  uint32_t s[4], t[4];
+  for (int c = 0; c < 4; c++) {
+    s[c] = load_col(&plain_text[4 * c]) ^ ks->enc_round_word[0][c];
+  }
+
+  // ShiftRows moves row r of column c + r into column c.
+  for (int j = 1; j < ks->num_rounds; j++) {
+    for (int c = 0; c < 4; c++) {
+      t[c] = te[s[c] & 0xff] ^ rotl8(te[(s[(c + 1) & 3] >> 8) & 0xff], 1) ^
+             rotl8(te[(s[(c + 2) & 3] >> 16) & 0xff], 2) ^
+             rotl8(te[s[(c + 3) & 3] >> 24], 3) ^ ks->enc_round_word[j][c];
+    }
+    for (int c = 0; c < 4; c++) {
+      s[c] = t[c];
+    }
+  }
+
+  // final round without MixColumns
+  const uint32_t *rk = ks->enc_round_word[ks->num_rounds];
+  for (int c = 0; c < 4; c++) {
+    t[c] = (uint32_t)sbox[s[c] & 0xff] |
+           ((uint32_t)sbox[(s[(c + 1) & 3] >> 8) & 0xff] << 8) |
+           ((uint32_t)sbox[(s[(c + 2) & 3] >> 16) & 0xff] << 16) |
+           ((uint32_t)sbox[s[(c + 3) & 3] >> 24] << 24);
+    store_col(&cipher_text[4 * c], t[c] ^ rk[c]);
+  }
+}
+
+void aes_decrypt_block_fast(const aes_key_schedule_t *ks,
+                            const unsigned char *cipher_text,
+                            unsigned char *plain_text) {
+  aes_t_tables_init();
+
+  uint32_t s[4], t[4];
+  for (int c = 0; c < 4; c++) {
+    s[c] = load_col(&cipher_text[4 * c]) ^ ks->dec_round_word[0][c];
+  }
+
+  // InvShiftRows moves row r of column c - r into column c.
+  for (int j = 1; j < ks->num_rounds; j++) {
+    for (int c = 0; c < 4; c++) {
+      t[c] = td[s[c] & 0xff] ^ rotl8(td[(s[(c + 3) & 3] >> 8) & 0xff], 1) ^
+             rotl8(td[(s[(c + 2) & 3] >> 16) & 0xff], 2) ^
+             rotl8(td[s[(c + 1) & 3] >> 24], 3) ^ ks->dec_round_word[j][c];
+    }
+    for (int c = 0; c < 4; c++) {
+      s[c] = t[c];
+    }
+  }
+
+  // final round without InvMixColumns
+  const uint32_t *rk = ks->dec_round_word[ks->num_rounds];
+  for (int c = 0; c < 4; c++) {
+    t[c] = (uint32_t)inv_sbox[s[c] & 0xff] |
+           ((uint32_t)inv_sbox[(s[(c + 3) & 3] >> 8) & 0xff] << 8) |
+           ((uint32_t)inv_sbox[(s[(c + 2) & 3] >> 16) & 0xff] << 16) |
+           ((uint32_t)inv_sbox[s[(c + 1) & 3] >> 24] << 24);
+    store_col(&plain_text[4 * c], t[c] ^ rk[c]);
+  }
+}
+
+int aes_key_schedule_self_check(const aes_key_schedule_t *ks) {
+  unsigned char in[16];
+  unsigned char ref[16];
+  unsigned char fast[16];
+  for (int i = 0; i < 16; i++) {
+    in[i] = (unsigned char)(0x11 * i) ^ ks->enc_round_key[0][i];
+  }
+
+  aes_encrypt_block_ks(ks, in, ref);
+  aes_encrypt_block_fast(ks, in, fast);
+  for (int i = 0; i < 16; i++) {
+    if (ref[i] != fast[i]) {
+      return -EIO;
+    }
+  }
+
+  aes_decrypt_block_ks(ks, in, ref);
+  aes_decrypt_block_fast(ks, in, fast);
+  for (int i = 0; i < 16; i++) {
+    if (ref[i] != fast[i]) {
+      return -EIO;
+    }
+  }
+
+  return 0;
+}
@@ -5,6 +5,8 @@
 #ifndef OPENTITAN_HW_IP_AES_MODEL_AES_H_
 #define OPENTITAN_HW_IP_AES_MODEL_AES_H_
 
+#include <stdint.h>
+
 /**
  * Encrypt one data block (16 Bytes) in ECB mode.
  *
@@ -137,6 +139,99 @@ void aes_rcon_next(unsigned char *rcon);
  */
 void aes_rcon_prev(unsigned char *rcon, int key_len);
 
+/**
+ * Expanded key schedule of one key.
+ *
+ * Computing the schedule once and reusing it for every block encrypted or
+ * decrypted with the same key avoids re-running the key expansion per block.
+ */
+typedef struct aes_key_schedule {
+  int key_len;
+  int num_rounds;
+  // Round keys of the forward cipher, round 0 first.
+  unsigned char enc_round_key[15][16];
+  // Round keys of the Equivalent Inverse Cipher, in the order they are added.
+  unsigned char dec_round_key[15][16];
+  // Round keys packed into little-endian column words for the fast path.
+  uint32_t enc_round_word[15][4];
+  uint32_t dec_round_word[15][4];
+} aes_key_schedule_t;
+
+/**
+ * Expand a key into a key schedule.
+ *
+ * The round keys are derived with aes_key_expand() and aes_inv_key_expand(),
+ * i.e., exactly as aes_encrypt_block() and aes_decrypt_block() do.
+ *
+ * @param  ks      Key schedule to initialize
+ * @param  key     Initial encryption key
+ * @param  key_len Key length in bytes (16, 24, 32)
+ * @return 0 on success, -ERRNO otherwise
+ */
+int aes_key_schedule_init(aes_key_schedule_t *ks, const unsigned char *key,
+                          const int key_len);
+
+/**
+ * Encrypt one data block (16 Bytes) in ECB mode using the reference round
+ * functions and a precomputed key schedule.
+ *
+ * @param  ks          Key schedule
+ * @param  plain_text  Input block to encrypt
+ * @param  cipher_text Encrypted output block
+ */
+void aes_encrypt_block_ks(const aes_key_schedule_t *ks,
+                          const unsigned char *plain_text,
+                          unsigned char *cipher_text);
+
+/**
+ * Decrypt one data block (16 Bytes) in ECB mode using the reference round
+ * functions and a precomputed key schedule.
+ *
+ * @param  ks          Key schedule
+ * @param  cipher_text Encrypted input block
+ * @param  plain_text  Decrypted output block
+ */
+void aes_decrypt_block_ks(const aes_key_schedule_t *ks,
+                          const unsigned char *cipher_text,
+                          unsigned char *plain_text);
+
+/**
+ * Encrypt one data block (16 Bytes) in ECB mode using T-tables.
+ *
+ * Produces the same output as aes_encrypt_block_ks() at a fraction of the
+ * cost. Not constant time; for verification use only.
+ *
+ * @param  ks          Key schedule
+ * @param  plain_text  Input block to encrypt
+ * @param  cipher_text Encrypted output block
+ */
+void aes_encrypt_block_fast(const aes_key_schedule_t *ks,
+                            const unsigned char *plain_text,
+                            unsigned char *cipher_text);
+
+/**
+ * Decrypt one data block (16 Bytes) in ECB mode using T-tables.
+ *
+ * Produces the same output as aes_decrypt_block_ks() at a fraction of the
+ * cost. Not constant time; for verification use only.
+ *
+ * @param  ks          Key schedule
+ * @param  cipher_text Encrypted input block
+ * @param  plain_text  Decrypted output block
+ */
+void aes_decrypt_block_fast(const aes_key_schedule_t *ks,
+                            const unsigned char *cipher_text,
+                            unsigned char *plain_text);
+
+/**
+ * Check the fast path against the reference round functions for one block in
+ * each direction.
+ *
+ * @param  ks Key schedule
+ * @return 0 if both paths agree, -EIO otherwise
+ */
+int aes_key_schedule_self_check(const aes_key_schedule_t *ks);
+
 static const unsigned char sbox[256] = {
     0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5,
     0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
@@ -342,5 +342,26 @@ int main(int argc, char *argv[]) {
     return 0;
   }
 
+  //
+  // KEY SCHEDULE & FAST PATH
+  //
+
+  aes_key_schedule_t ks;
+  if (aes_key_schedule_init(&ks, key, key_len)) {
+    return -EINVAL;
+  }
+  aes_encrypt_block_fast(&ks, plain_text, state);
+  if (!check_block(state, cipher_text_gold, 1)) {
+    printf("SUCCESS: fast path matches expected cipher text\n");
+  } else {
+    printf("ERROR: fast path does not match expected cipher text\n");
+  }
+  aes_decrypt_block_fast(&ks, cipher_text_gold, state);
+  if (!check_block(state, plain_text, 1)) {
+    printf("SUCCESS: fast path matches expected plain text\n");
+  } else {
+    printf("ERROR: fast path does not match expected plain text\n");
+  }
+
   return 0;
 }
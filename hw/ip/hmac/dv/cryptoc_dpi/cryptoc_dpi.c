@@ -3,9 +3,11 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "hmac.h"
 #include "hmac_wrap.h"
@@ -198,3 +200,151 @@ extern void c_dpi_HMAC_SHA512(const svOpenArrayHandle key, uint64_t key_len,
 
   free(key_arr);
 }
+
+// Streaming hash/HMAC contexts.
+//
+// These mirror the context switching of the HMAC IP: a testbench can create
+// one context per message, feed it as the message is pushed into the IP, save
+// and restore it, and peek at the digest at any point without re-hashing the
+// whole message.
+
+typedef struct cryptoc_dpi_ctx {
+  // Digest size in bits: 256, 384 or 512.
+  uint32_t digest_size;
+  // Whether this is an HMAC context or a plain hash context.
+  bool hmac_en;
+  union {
+    HASH_CTX hash;
+    LITE_HMAC_CTX hmac_lite;  // HMAC-SHA2-256
+    HMAC_CTX hmac;            // HMAC-SHA2-384/512
+  } u;
+} cryptoc_dpi_ctx_t;
+
+// Number of bytes converted from an open array per HASH_update() call.
+#define CRYPTOC_DPI_CHUNK_BYTES 256
+
+// Feed the first `len` elements of the open array into the context without
+// copying the whole array.
+static void ctx_update_bytes(cryptoc_dpi_ctx_t *ctx,
+                             const svOpenArrayHandle arg, uint64_t len) {
+  assert(1 == svDimensions(arg));
+  assert(len <= svSize(arg, 1));
+
+  HASH_CTX *hash = &ctx->u.hash;
+  if (ctx->hmac_en) {
+    hash = ctx->digest_size == 256 ? &ctx->u.hmac_lite.hash : &ctx->u.hmac.hash;
+  }
+
+  uint8_t chunk[CRYPTOC_DPI_CHUNK_BYTES];
+  const svBitVecVal *ptr = (svBitVecVal *)svGetArrayPtr(arg);
+  const int low = svLow(arg, 1);
+  uint64_t idx = 0u;
+  while (idx < len) {
+    size_t n = 0u;
+    for (; n < sizeof(chunk) && idx < len; ++n, ++idx) {
+      if (ptr) {
+        // C-style layout
+        chunk[n] = (uint8_t)ptr[idx];
+      } else {
+        uint8_t *elem = (uint8_t *)svGetArrElemPtr1(arg, low + (int)idx);
+        assert(elem);
+        chunk[n] = *elem;
+      }
+    }
+    HASH_update(hash, chunk, n);
+  }
+}
+
+extern void *c_dpi_hash_ctx_init(uint32_t digest_size, svBit hmac_en,
+                                 const svOpenArrayHandle key,
+                                 uint64_t key_len) {
+  assert(digest_size == 256 || digest_size == 384 || digest_size == 512);
+
+  cryptoc_dpi_ctx_t *ctx = (cryptoc_dpi_ctx_t *)malloc(sizeof(*ctx));
+  assert(ctx);
+  ctx->digest_size = digest_size;
+  ctx->hmac_en = hmac_en;
+
+  if (!hmac_en) {
+    switch (digest_size) {
+      case 256:
+        SHA256_init(&ctx->u.hash);
+        break;
+      case 384:
+        SHA384_init(&ctx->u.hash);
+        break;
+      default:
+        SHA512_init(&ctx->u.hash);
+        break;
+    }
+    return ctx;
+  }
+
+  // The key is short; collecting it is cheap compared to the message.
+  uint8_t *key_arr = NULL;
+  if (key_len > 0u) {
+    key_arr = collect_bytes(key, key_len);
+    assert(key_arr);
+  }
+  switch (digest_size) {
+    case 256:
+      HMAC_SHA256_init(&ctx->u.hmac_lite, key_arr, key_len);
+      break;
+    case 384:
+      HMAC_SHA384_init(&ctx->u.hmac, key_arr, key_len);
+      break;
+    default:
+      HMAC_SHA512_init(&ctx->u.hmac, key_arr, key_len);
+      break;
+  }
+  free(key_arr);
+
+  return ctx;
+}
+
+extern void c_dpi_hash_ctx_update(void *ctx_void, const svOpenArrayHandle msg,
+                                  uint64_t len) {
+  cryptoc_dpi_ctx_t *ctx = (cryptoc_dpi_ctx_t *)ctx_void;
+  assert(ctx);
+  if (len > 0u) {
+    ctx_update_bytes(ctx, msg, len);
+  }
+}
+
+extern void c_dpi_hash_ctx_final(void *ctx_void, uint32_t digest[16]) {
+  cryptoc_dpi_ctx_t *ctx = (cryptoc_dpi_ctx_t *)ctx_void;
+  assert(ctx);
+
+  // Finalize a copy so that the context can keep absorbing data.
+  cryptoc_dpi_ctx_t tmp = *ctx;
+  const uint8_t *result;
+  if (!tmp.hmac_en) {
+    result = HASH_final(&tmp.u.hash);
+  } else if (tmp.digest_size == 256) {
+    result = HMAC_final_LITE(&tmp.u.hmac_lite);
+  } else {
+    result = HMAC_final(&tmp.u.hmac);
+  }
+
+  memset(digest, 0, 16 * sizeof(uint32_t));
+  memcpy(digest, result, tmp.digest_size / 8);
+}
+
+extern void *c_dpi_hash_ctx_save(void *ctx_void) {
+  cryptoc_dpi_ctx_t *ctx = (cryptoc_dpi_ctx_t *)ctx_void;
+  assert(ctx);
+
+  cryptoc_dpi_ctx_t *saved = (cryptoc_dpi_ctx_t *)malloc(sizeof(*saved));
+  assert(saved);
+  *saved = *ctx;
+  return saved;
+}
+
+extern void c_dpi_hash_ctx_restore(void *ctx_void, void *saved_void) {
+  cryptoc_dpi_ctx_t *ctx = (cryptoc_dpi_ctx_t *)ctx_void;
+  const cryptoc_dpi_ctx_t *saved = (const cryptoc_dpi_ctx_t *)saved_void;
+  assert(ctx && saved);
+  *ctx = *saved;
+}
+
+extern void c_dpi_hash_ctx_free(void *ctx_void) { free(ctx_void); }
@@ -54,6 +54,28 @@ package cryptoc_dpi_pkg;
                                                          input longint unsigned msg_len,
                                                          output int unsigned hmac[16]);
 
+  // Streaming hash/HMAC contexts. digest_size is 256, 384 or 512; the key is ignored unless
+  // hmac_en is set. c_dpi_hash_ctx_final() does not consume the context, so it can be called at
+  // every checkpoint while the message is still being fed.
+  import "DPI-C" context function chandle c_dpi_hash_ctx_init(input int unsigned digest_size,
+                                                              input bit hmac_en,
+                                                              input bit[7:0] key[],
+                                                              input longint unsigned key_len);
+
+  import "DPI-C" context function void c_dpi_hash_ctx_update(input chandle ctx,
+                                                             input bit[7:0] msg[],
+                                                             input longint unsigned len);
+
+  import "DPI-C" context function void c_dpi_hash_ctx_final(input chandle ctx,
+                                                            output int unsigned digest[16]);
+
+  import "DPI-C" context function chandle c_dpi_hash_ctx_save(input chandle ctx);
+
+  import "DPI-C" context function void c_dpi_hash_ctx_restore(input chandle ctx,
+                                                              input chandle saved);
+
+  import "DPI-C" context function void c_dpi_hash_ctx_free(input chandle ctx);
+
   // sv wrapper functions
   function automatic void sv_dpi_get_sha_digest(input bit[7:0] msg[],
                                                 output int unsigned hash[8]);
@@ -115,4 +137,19 @@ package cryptoc_dpi_pkg;
     c_dpi_HMAC_SHA512(ckey, ckey.size(), msg, msg.size(), hmac);
   endfunction
 
+  function automatic chandle sv_dpi_hash_ctx_init(input int unsigned digest_size,
+                                                  input bit hmac_en,
+                                                  input bit[31:0] key[]);
+    bit [7:0] ckey[];
+    int ckey_size_bytes = $bits(key) / 8;
+    ckey = new[ckey_size_bytes];
+    {>>{ckey}} = key;
+    return c_dpi_hash_ctx_init(digest_size, hmac_en, ckey, ckey.size());
+  endfunction
+
+  function automatic void sv_dpi_hash_ctx_update(input chandle ctx,
+                                                 input bit[7:0] msg[]);
+    c_dpi_hash_ctx_update(ctx, msg, msg.size());
+  endfunction
+
 endpackage
@@ -10,7 +10,10 @@
 
 #include <cassert>
 #include <cstdint>
+#include <map>
+#include <memory>
 #include <svdpi.h>
+#include <tuple>
 #include <vector>
 
 static const uint8_t sbox4[16] = {0xc, 0x5, 0x6, 0xb, 0x9, 0x0, 0xa, 0xd,
@@ -38,6 +41,22 @@ struct key128_t {
   uint64_t hi, lo;
 };
 
+// Byte-indexed tables for a fast round function. enc_sp[j][b] is the result
+// of the sBoxLayer followed by the pLayer when byte j of the state is b and
+// every other byte is zero. Since pLayer is linear, XORing the entries for all
+// eight bytes gives the full sBoxLayer + pLayer. The inverse round applies the
+// (linear) inverse pLayer through dec_p and then the inverse sBoxLayer a byte
+// at a time through dec_s.
+struct PresentTables {
+  PresentTables();
+
+  uint64_t enc_sp[8][256];
+  uint64_t dec_p[8][256];
+  uint8_t dec_s[256];
+};
+
+const PresentTables &present_tables();
+
 class PresentState {
  public:
   PresentState(unsigned key_size, key128_t key);
@@ -50,20 +69,56 @@ class PresentState {
   // round and with is_last_round set, then count down.
   uint64_t dec_round(uint64_t input, unsigned round, bool is_last_round) const;
 
+  // Run all rounds from 1 to num_rounds, i.e. a full encryption.
+  uint64_t encrypt(uint64_t input, unsigned num_rounds) const;
+
+  // Run all rounds from num_rounds down to 1, i.e. a full decryption.
+  uint64_t decrypt(uint64_t input, unsigned num_rounds) const;
+
+  // The reference (nibble and bit serial) layers, used to build the tables.
+  static uint64_t sbox_layer(bool inverse, uint64_t data);
+  static uint64_t perm_layer(bool inverse, uint64_t data);
+
  private:
   static key128_t next_round_key(const key128_t &k, unsigned key_size,
                                  unsigned round_count);
 
   static uint64_t add_round_key(uint64_t data, const key128_t &k,
                                 unsigned key_size);
-  static uint64_t sbox_layer(bool inverse, uint64_t data);
-  static uint64_t perm_layer(bool inverse, uint64_t data);
+
+  static uint64_t enc_sp_layer(uint64_t data);
+  static uint64_t dec_sp_layer(uint64_t data);
 
   unsigned key_size;
   std::vector<key128_t> key_schedule;
+  // The 64-bit round keys extracted from key_schedule, as XORed by
+  // addRoundKey.
+  std::vector<uint64_t> round_keys;
 };
 }  // namespace
 
+PresentTables::PresentTables() {
+  uint8_t enc_s[256];
+  for (int b = 0; b < 256; ++b) {
+    enc_s[b] = (uint8_t)PresentState::sbox_layer(false, b);
+    dec_s[b] = (uint8_t)PresentState::sbox_layer(true, b);
+  }
+  for (int j = 0; j < 8; ++j) {
+    for (int b = 0; b < 256; ++b) {
+      enc_sp[j][b] = PresentState::perm_layer(false, (uint64_t)enc_s[b]
+                                                         << (8 * j));
+      dec_p[j][b] = PresentState::perm_layer(true, (uint64_t)b << (8 * j));
+    }
+  }
+}
+
+namespace {
+const PresentTables &present_tables() {
+  static const PresentTables tables;
+  return tables;
+}
+}  // namespace
+
 PresentState::PresentState(unsigned key_size, key128_t key)
     : key_size(key_size) {
   assert(key_size == 80 || key_size == 128);
@@ -73,50 +128,76 @@ PresentState::PresentState(unsigned key_size, key128_t key)
     key = next_round_key(key, key_size, i);
     key_schedule.push_back(key);
   }
+
+  round_keys.reserve(key_schedule.size());
+  for (const key128_t &k : key_schedule) {
+    round_keys.push_back(add_round_key(0, k, key_size));
+  }
 }
 
 uint64_t PresentState::enc_round(uint64_t input, unsigned round,
                                  bool is_last_round) const {
   assert(1 <= round && round < key_schedule.size());
-  const key128_t &key = key_schedule[round - 1];
-
-  // addRoundKey
-  uint64_t w1 = add_round_key(input, key, key_size);
 
-  // sBoxLayer
-  uint64_t w2 = sbox_layer(false, w1);
-
-  // pLayer
-  uint64_t w3 = perm_layer(false, w2);
+  // addRoundKey, sBoxLayer and pLayer
+  uint64_t w3 = enc_sp_layer(input ^ round_keys[round - 1]);
 
   // On the final round, call addRoundKey with the following key.
-  uint64_t w4 =
-      is_last_round ? add_round_key(w3, key_schedule[round], key_size) : w3;
-
-  return w4;
+  return is_last_round ? w3 ^ round_keys[round] : w3;
 }
 
 uint64_t PresentState::dec_round(uint64_t input, unsigned round,
                                  bool is_last_round) const {
   assert(1 <= round && round < key_schedule.size());
-  const key128_t &key = key_schedule[round - 1];
 
   // If we're undoing the last round, start by calling addRoundKey with the
   // following key.
-  uint64_t w1 = is_last_round
-                    ? add_round_key(input, key_schedule[round], key_size)
-                    : input;
+  uint64_t w1 = is_last_round ? input ^ round_keys[round] : input;
 
-  // pLayer^{-1}
-  uint64_t w2 = perm_layer(true, w1);
+  // pLayer^{-1}, sBoxLayer^{-1} and addRoundKey
+  return dec_sp_layer(w1) ^ round_keys[round - 1];
+}
 
-  // sBoxLayer^{-1}
-  uint64_t w3 = sbox_layer(true, w2);
+uint64_t PresentState::encrypt(uint64_t input, unsigned num_rounds) const {
+  assert(1 <= num_rounds && num_rounds < key_schedule.size());
 
-  // addRoundKey
-  uint64_t w4 = add_round_key(w3, key, key_size);
+  uint64_t data = input;
+  for (unsigned round = 1; round <= num_rounds; ++round) {
+    data = enc_sp_layer(data ^ round_keys[round - 1]);
+  }
+  return data ^ round_keys[num_rounds];
+}
 
-  return w4;
+uint64_t PresentState::decrypt(uint64_t input, unsigned num_rounds) const {
+  assert(1 <= num_rounds && num_rounds < key_schedule.size());
+
+  uint64_t data = input ^ round_keys[num_rounds];
+  for (unsigned round = num_rounds; round >= 1; --round) {
+    data = dec_sp_layer(data) ^ round_keys[round - 1];
+  }
+  return data;
+}
+
+uint64_t PresentState::enc_sp_layer(uint64_t data) {
+  const PresentTables &t = present_tables();
+  uint64_t ret = 0;
+  for (int j = 0; j < 8; ++j) {
+    ret ^= t.enc_sp[j][(data >> (8 * j)) & 0xff];
+  }
+  return ret;
+}
+
+uint64_t PresentState::dec_sp_layer(uint64_t data) {
+  const PresentTables &t = present_tables();
+  uint64_t permuted = 0;
+  for (int j = 0; j < 8; ++j) {
+    permuted ^= t.dec_p[j][(data >> (8 * j)) & 0xff];
+  }
+  uint64_t ret = 0;
+  for (int j = 0; j < 8; ++j) {
+    ret |= (uint64_t)t.dec_s[(permuted >> (8 * j)) & 0xff] << (8 * j);
+  }
+  return ret;
 }
 
 key128_t PresentState::next_round_key(const key128_t &k, unsigned key_size,
@@ -206,13 +287,9 @@ uint64_t PresentState::perm_layer(bool inverse, uint64_t data) {
   return ret;
 }
 
-extern "C" {
-
-PresentState *c_dpi_present_mk(unsigned key_size, const svBitVecVal *key) {
-  assert(key_size == 80 || key_size == 128);
-
-  // Each element of key represents 32 bits. Unpack into a key128_t, zeroing
-  // the top bits if key size was 80.
+// Each element of key represents 32 bits. Unpack into a key128_t, zeroing
+// the top bits if key size was 80.
+static key128_t unpack_key(unsigned key_size, const svBitVecVal *key) {
   uint32_t w32s[4];
   for (int i = 0; i < 4; ++i) {
     unsigned lsb = 32 * i;
@@ -223,8 +300,43 @@ PresentState *c_dpi_present_mk(unsigned key_size, const svBitVecVal *key) {
   }
   key128_t k128 = {.hi = ((uint64_t)w32s[3] << 32) | w32s[2],
                    .lo = ((uint64_t)w32s[1] << 32) | w32s[0]};
+  return k128;
+}
+
+// The maximum number of key schedules kept by cached_state. Scrambling
+// environments only ever use a handful of keys, so the cache is simply
+// dropped when it grows beyond this.
+static const size_t kMaxCachedKeys = 64;
+
+// Return a PresentState for the given key, reusing a previously expanded key
+// schedule where possible.
+static const PresentState &cached_state(unsigned key_size,
+                                        const svBitVecVal *key) {
+  typedef std::tuple<unsigned, uint64_t, uint64_t> cache_key_t;
+  static std::map<cache_key_t, std::unique_ptr<PresentState>> cache;
+
+  assert(key_size == 80 || key_size == 128);
+  key128_t k128 = unpack_key(key_size, key);
+  cache_key_t ck(key_size, k128.hi, k128.lo);
+
+  auto it = cache.find(ck);
+  if (it != cache.end()) {
+    return *it->second;
+  }
+  if (cache.size() >= kMaxCachedKeys) {
+    cache.clear();
+  }
+  std::unique_ptr<PresentState> ps(new PresentState(key_size, k128));
+  const PresentState &ret = *ps;
+  cache.emplace(ck, std::move(ps));
+  return ret;
+}
+
+extern "C" {
 
-  return new PresentState(key_size, k128);
+PresentState *c_dpi_present_mk(unsigned key_size, const svBitVecVal *key) {
+  assert(key_size == 80 || key_size == 128);
+  return new PresentState(key_size, unpack_key(key_size, key));
 }
 
 void c_dpi_present_free(PresentState *ps) { delete ps; }
@@ -254,4 +366,52 @@ void c_dpi_present_dec_round(const PresentState *ps, unsigned round,
   dst[1] = out64 >> 32;
   dst[0] = (uint32_t)out64;
 }
+
+void c_dpi_present_encrypt(unsigned key_size, const svBitVecVal *key,
+                           unsigned num_rounds, const svBitVecVal *src,
+                           svBitVecVal *dst) {
+  const PresentState &ps = cached_state(key_size, key);
+
+  uint64_t in64 = ((uint64_t)src[1] << 32) | src[0];
+  uint64_t out64 = ps.encrypt(in64, num_rounds);
+
+  dst[1] = out64 >> 32;
+  dst[0] = (uint32_t)out64;
+}
+
+void c_dpi_present_decrypt(unsigned key_size, const svBitVecVal *key,
+                           unsigned num_rounds, const svBitVecVal *src,
+                           svBitVecVal *dst) {
+  const PresentState &ps = cached_state(key_size, key);
+
+  uint64_t in64 = ((uint64_t)src[1] << 32) | src[0];
+  uint64_t out64 = ps.decrypt(in64, num_rounds);
+
+  dst[1] = out64 >> 32;
+  dst[0] = (uint32_t)out64;
+}
+
+void c_dpi_present_crypt_batch(unsigned key_size, const svBitVecVal *key,
+                               unsigned num_rounds, unsigned char decrypt,
+                               const svOpenArrayHandle src,
+                               const svOpenArrayHandle dst) {
+  assert(decrypt == 0 || decrypt == 1);
+  assert(svSize(src, 1) == svSize(dst, 1));
+
+  const PresentState &ps = cached_state(key_size, key);
+
+  int src_low = svLow(src, 1);
+  int dst_low = svLow(dst, 1);
+  int len = svSize(src, 1);
+  for (int i = 0; i < len; ++i) {
+    svBitVecVal word[2];
+    svGetBitArrElem1VecVal(word, src, src_low + i);
+    uint64_t in64 = ((uint64_t)word[1] << 32) | word[0];
+    uint64_t out64 =
+        decrypt ? ps.decrypt(in64, num_rounds) : ps.encrypt(in64, num_rounds);
+    word[1] = out64 >> 32;
+    word[0] = (uint32_t)out64;
+    svPutBitArrElem1VecVal(dst, word, dst_low + i);
+  }
+}
 }
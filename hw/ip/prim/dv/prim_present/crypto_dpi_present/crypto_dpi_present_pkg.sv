@@ -24,6 +24,25 @@ package crypto_dpi_present_pkg;
                                                        bit [DataWidth-1:0]        in,
                                                        output bit [DataWidth-1:0] out);
 
+  // Full-block and batch variants. These keep an internal cache of expanded key schedules, so
+  // repeated calls with the same key do not redo the key expansion.
+  import "DPI-C" function void c_dpi_present_encrypt(int unsigned               key_size,
+                                                     bit [MaxKeyWidth-1:0]      key,
+                                                     int unsigned               num_rounds,
+                                                     bit [DataWidth-1:0]        in,
+                                                     output bit [DataWidth-1:0] out);
+  import "DPI-C" function void c_dpi_present_decrypt(int unsigned               key_size,
+                                                     bit [MaxKeyWidth-1:0]      key,
+                                                     int unsigned               num_rounds,
+                                                     bit [DataWidth-1:0]        in,
+                                                     output bit [DataWidth-1:0] out);
+  import "DPI-C" function void c_dpi_present_crypt_batch(int unsigned               key_size,
+                                                         bit [MaxKeyWidth-1:0]      key,
+                                                         int unsigned               num_rounds,
+                                                         bit                        decrypt,
+                                                         bit [DataWidth-1:0]        in[],
+                                                         output bit [DataWidth-1:0] out[]);
+
   // This function encrypts the input plaintext with the PRESENT encryption algorithm.
   //
   // This produces a list of all intermediate values produced after each round of the algorithm,
@@ -36,17 +55,7 @@ package crypto_dpi_present_pkg;
     output bit [DataWidth-1:0]  ciphertext
   );
 
-    bit [DataWidth-1:0] round_in, round_out;
-    chandle h = c_dpi_present_mk(key_size, key);
-
-    round_out = plaintext;
-    for (int i = 1; i <= num_rounds; i++) begin
-      round_in = round_out;
-      c_dpi_present_enc_round(h, i, i == num_rounds, round_in, round_out);
-    end
-    ciphertext = round_out;
-
-    c_dpi_present_free(h);
+    c_dpi_present_encrypt(key_size, key, num_rounds, plaintext, ciphertext);
 
   endfunction
 
@@ -62,17 +71,23 @@ package crypto_dpi_present_pkg;
     output bit [DataWidth-1:0]  plaintext
   );
 
-    bit [DataWidth-1:0] round_in, round_out;
-    chandle h = c_dpi_present_mk(key_size, key);
+    c_dpi_present_decrypt(key_size, key, num_rounds, ciphertext, plaintext);
+
+  endfunction
 
-    round_in = ciphertext;
-    for (int i = num_rounds; i > 0; i--) begin
-      c_dpi_present_dec_round(h, i, i == num_rounds, round_in, round_out);
-      round_in = round_out;
-    end
-    plaintext = round_out;
+  // This function encrypts or decrypts a batch of blocks with the same key in a single DPI call.
+  function automatic void sv_dpi_present_crypt_batch(
+    input bit [DataWidth-1:0]   data_in[],
+    input bit [MaxKeyWidth-1:0] key,
+    input int unsigned          key_size,
+    input int unsigned          num_rounds,
+    input bit                   decrypt,
+    output bit [DataWidth-1:0]  data_out[]
+  );
 
-    c_dpi_present_free(h);
+    data_out = new[data_in.size()];
+    if (data_in.size() == 0) return;
+    c_dpi_present_crypt_batch(key_size, key, num_rounds, decrypt, data_in, data_out);
 
   endfunction
 
@@ -10,22 +10,114 @@ extern "C" {
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "prince_fast.h"
 #include "prince_ref.h"
 #include "svdpi.h"
 
+// Whether the table-driven implementation has been checked against the
+// reference model: 0 = not yet, 1 = passed, -1 = failed.
+static int fast_path_state;
+
+static int use_fast_path(void) {
+  if (fast_path_state == 0) {
+    if (prince_fast_self_check() == 0) {
+      fast_path_state = 1;
+    } else {
+      fprintf(stderr,
+              "WARNING: PRINCE fast path does not match the reference model, "
+              "falling back to the reference model.\n");
+      fast_path_state = -1;
+    }
+  }
+  return fast_path_state > 0;
+}
+
+static uint64_t prince_crypt(uint64_t data, uint64_t key0, uint64_t key1,
+                             int decrypt, int num_half_rounds,
+                             int old_key_schedule) {
+  if (use_fast_path()) {
+    return prince_enc_dec_uint64_fast(data, key0, key1, decrypt,
+                                      num_half_rounds, old_key_schedule);
+  }
+  return prince_enc_dec_uint64(data, key0, key1, decrypt, num_half_rounds,
+                               old_key_schedule);
+}
+
 extern uint64_t c_dpi_prince_encrypt(uint64_t plaintext, uint64_t key0,
                                      uint64_t key1, int num_half_rounds,
                                      int old_key_schedule) {
-  return prince_enc_dec_uint64(plaintext, key0, key1, 0, num_half_rounds,
-                               old_key_schedule);
+  return prince_crypt(plaintext, key0, key1, 0, num_half_rounds,
+                      old_key_schedule);
 }
 
 extern uint64_t c_dpi_prince_decrypt(const uint64_t ciphertext,
                                      const uint64_t key0, const uint64_t key1,
                                      int num_half_rounds,
                                      int old_key_schedule) {
-  return prince_enc_dec_uint64(ciphertext, key0, key1, 1, num_half_rounds,
-                               old_key_schedule);
+  return prince_crypt(ciphertext, key0, key1, 1, num_half_rounds,
+                      old_key_schedule);
+}
+
+/**
+ * Encrypt or decrypt a batch of blocks under the same key.
+ *
+ * @param data_i           Open array of input blocks.
+ * @param key0             K0, the MSB half of the key.
+ * @param key1             K1, the LSB half of the key.
+ * @param decrypt          Decrypt if set, encrypt otherwise.
+ * @param num_half_rounds  Number of cipher half rounds.
+ * @param old_key_schedule Use the key schedule from the original paper.
+ * @param data_o           Open array of output blocks, same size as data_i.
+ */
+extern void c_dpi_prince_crypt_batch(const svOpenArrayHandle data_i,
+                                     uint64_t key0, uint64_t key1,
+                                     int decrypt, int num_half_rounds,
+                                     int old_key_schedule,
+                                     const svOpenArrayHandle data_o) {
+  int num_blocks = svSize(data_i, 1);
+  if (num_blocks <= 0) {
+    return;
+  }
+  if (svSize(data_o, 1) != num_blocks) {
+    fprintf(stderr, "ERROR: c_dpi_prince_crypt_batch: size mismatch\n");
+    return;
+  }
+
+  // The open arrays may not be contiguous in the simulator, use a local copy
+  // in that case.
+  const uint64_t *in = (const uint64_t *)svGetArrayPtr(data_i);
+  uint64_t *out = (uint64_t *)svGetArrayPtr(data_o);
+  uint64_t *buf = NULL;
+  if (in == NULL || out == NULL) {
+    buf = (uint64_t *)malloc(num_blocks * sizeof(uint64_t));
+    if (buf == NULL) {
+      fprintf(stderr, "ERROR: c_dpi_prince_crypt_batch: out of memory\n");
+      return;
+    }
+    for (int i = 0; i < num_blocks; i++) {
+      buf[i] = *(const uint64_t *)svGetArrElemPtr1(
+          data_i, svLow(data_i, 1) + i);
+    }
+  }
+
+  const uint64_t *src = buf ? buf : in;
+  uint64_t *dst = buf ? buf : out;
+  if (use_fast_path()) {
+    prince_enc_dec_uint64_batch(src, dst, num_blocks, key0, key1, decrypt,
+                                num_half_rounds, old_key_schedule);
+  } else {
+    for (int i = 0; i < num_blocks; i++) {
+      dst[i] = prince_enc_dec_uint64(src[i], key0, key1, decrypt,
+                                     num_half_rounds, old_key_schedule);
+    }
+  }
+
+  if (buf) {
+    for (int i = 0; i < num_blocks; i++) {
+      *(uint64_t *)svGetArrElemPtr1(data_o, svLow(data_o, 1) + i) = buf[i];
+    }
+    free(buf);
+  }
 }
 
 #ifdef _cplusplus
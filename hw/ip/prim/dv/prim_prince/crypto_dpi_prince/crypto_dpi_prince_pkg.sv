@@ -27,6 +27,16 @@ package crypto_dpi_prince_pkg;
     input int unsigned      new_key_schedule
   );
 
+  import "DPI-C" context function void c_dpi_prince_crypt_batch(
+    input  longint unsigned data_i[],
+    input  longint unsigned key0,
+    input  longint unsigned key1,
+    input  int unsigned     decrypt,
+    input  int unsigned     num_half_rounds,
+    input  int unsigned     old_key_schedule,
+    output longint unsigned data_o[]
+  );
+
   //////////////////////////////////////////////////////
   // SV wrapper functions to be used by the testbench //
   //////////////////////////////////////////////////////
@@ -61,4 +71,29 @@ package crypto_dpi_prince_pkg;
     end
   endfunction
 
+  // Encrypt or decrypt a batch of blocks under the same key and number of half rounds with a
+  // single DPI call.
+  function automatic void sv_dpi_prince_crypt_batch(
+    input  bit [63:0]   data_i[],
+    input  bit [127:0]  key,
+    input  bit          decrypt,
+    input  int unsigned num_half_rounds,
+    input  bit          old_key_schedule,
+    output bit [63:0]   data_o[]
+  );
+    longint unsigned data_in[] = new[data_i.size()];
+    longint unsigned data_out[] = new[data_i.size()];
+    data_o = new[data_i.size()];
+    if (data_i.size() == 0) return;
+    foreach (data_i[i]) data_in[i] = data_i[i];
+    c_dpi_prince_crypt_batch(data_in,
+                             key[127:64], // k0 gets assigned the MSB halve
+                             key[63:0],   // k1 gets assigned the LSB halve
+                             decrypt,
+                             num_half_rounds,
+                             old_key_schedule,
+                             data_out);
+    foreach (data_out[i]) data_o[i] = data_out[i];
+  endfunction
+
 endpackage
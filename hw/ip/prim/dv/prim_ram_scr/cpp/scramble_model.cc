@@ -11,7 +11,7 @@
 #include <stdint.h>
 #include <vector>
 
-#include "prince_ref.h"
+#include "prince_fast.h"
 
 uint8_t PRESENT_SBOX4[] = {0xc, 0x5, 0x6, 0xb, 0x9, 0x0, 0xa, 0xd,
                            0x3, 0xe, 0xf, 0x8, 0x4, 0x7, 0x1, 0x2};
@@ -23,15 +23,6 @@ static const uint32_t kNumAddrSubstPermRounds = 2;
 static const uint32_t kNumDataSubstPermRounds = 2;
 static const uint32_t kNumPrinceHalfRounds = 3;
 
-static std::vector<uint8_t> byte_reverse_vector(
-    const std::vector<uint8_t> &vec_in) {
-  std::vector<uint8_t> vec_out(vec_in.size());
-
-  std::reverse_copy(std::begin(vec_in), std::end(vec_in), std::begin(vec_out));
-
-  return vec_out;
-}
-
 static uint8_t read_vector_bit(const std::vector<uint8_t> &vec,
                                uint32_t bit_pos) {
   assert(bit_pos / 8 < vec.size());
@@ -177,6 +168,21 @@ static std::vector<uint8_t> scramble_subst_perm_dec(
   return state;
 }
 
+// Check the table-driven PRINCE against the reference model once, and tell
+// whether it can be used.
+static bool prince_fast_checked() {
+  static const bool passed = [] {
+    if (prince_fast_self_check() == 0) {
+      return true;
+    }
+    std::cerr << "WARNING: PRINCE fast path does not match the reference "
+                 "model, falling back to the reference model."
+              << std::endl;
+    return false;
+  }();
+  return passed;
+}
+
 // Generate a keystream for XORing with data using PRINCE.
 // If repeat_keystream is set to true, the output from one PRINCE instance is
 // repeated when the keystream is greater than a single PRINCE width (64bit).
@@ -197,40 +203,53 @@ static std::vector<uint8_t> scramble_gen_keystream(
     num_repetitions = 1;
   }
 
-  std::vector<uint8_t> keystream;
-
+  // Initial vectors are data for PRINCE to encrypt. Formed from nonce and data
+  // address
+  std::vector<uint64_t> ivs(num_princes, 0);
   for (uint32_t i = 0; i < num_princes; ++i) {
-    // Initial vector is data for PRINCE to encrypt. Formed from nonce and data
-    // address
-    std::vector<uint8_t> iv(8, 0);
-
     for (uint32_t j = 0; j < kPrinceWidth; ++j) {
+      uint64_t bit;
       if (j < addr_width) {
         // Bottom addr_width bits of IV are address
-        or_vector_bit(iv, j, read_vector_bit(addr, j));
+        bit = read_vector_bit(addr, j);
       } else {
         // Other bits are taken from nonce. Each PRINCE instantiation will use
         // different nonce bits.
         int nonce_bit = (j - addr_width) + i * (kPrinceWidth - addr_width);
-        or_vector_bit(iv, j, read_vector_bit(nonce, nonce_bit));
+        bit = read_vector_bit(nonce, nonce_bit);
       }
+      ivs[i] |= bit << j;
     }
+  }
 
-    // PRINCE C reference model works on big-endian byte order
-    iv = byte_reverse_vector(iv);
-    auto key_be = byte_reverse_vector(key);
+  // The key is stored little endian, k0 being the upper half
+  uint64_t k0 = 0, k1 = 0;
+  for (uint32_t j = 0; j < kPrinceWidthByte; ++j) {
+    k1 |= static_cast<uint64_t>(key[j]) << (8 * j);
+    k0 |= static_cast<uint64_t>(key[j + kPrinceWidthByte]) << (8 * j);
+  }
 
-    // Apply PRINCE to IV to produce keystream
-    std::vector<uint8_t> keystream_block(kPrinceWidthByte);
-    prince_enc_dec(&iv[0], &key_be[0], &keystream_block[0], 0, num_half_rounds,
-                   0);
+  // Apply PRINCE to all IVs at once to produce keystream blocks
+  std::vector<uint64_t> keystream_blocks(num_princes);
+  if (prince_fast_checked()) {
+    prince_enc_dec_uint64_batch(ivs.data(), keystream_blocks.data(),
+                                num_princes, k0, k1, 0, num_half_rounds, 0);
+  } else {
+    for (uint32_t i = 0; i < num_princes; ++i) {
+      keystream_blocks[i] =
+          prince_enc_dec_uint64(ivs[i], k0, k1, 0, num_half_rounds, 0);
+    }
+  }
 
-    // Flip keystream into little endian order and add to keystream vector
-    keystream_block = byte_reverse_vector(keystream_block);
-    // Repeat the output of a single PRINCE instance if needed
+  // Add keystream blocks in little endian order, repeating the output of a
+  // single PRINCE instance if needed
+  std::vector<uint8_t> keystream;
+  keystream.reserve(num_princes * num_repetitions * kPrinceWidthByte);
+  for (uint64_t block : keystream_blocks) {
     for (uint32_t k = 0; k < num_repetitions; ++k) {
-      keystream.insert(keystream.end(), keystream_block.begin(),
-                       keystream_block.end());
+      for (uint32_t j = 0; j < kPrinceWidthByte; ++j) {
+        keystream.push_back(static_cast<uint8_t>(block >> (8 * j)));
+      }
     }
   }
 
@@ -8,7 +8,9 @@
 #include <vector>
 
 #include "verilated_toplevel.h"
+#include "verilator_coverage_dumper.h"
 #include "verilator_memutil.h"
+#include "verilator_pc_profiler.h"
 #include "verilator_sim_ctrl.h"
 
 int main(int argc, char **argv) {
@@ -50,6 +52,14 @@ int main(int argc, char **argv) {
   memutil.RegisterMemoryArea("otp", 0x40000000u /* (bogus LMA) */, &otp);
   simctrl.RegisterExtension(&memutil);
 
+  // Off unless enabled with --pc-profile, needs a build with RVFI.
+  VerilatorPcProfiler pc_profiler(memutil.GetUnderlying());
+  simctrl.RegisterExtension(&pc_profiler);
+
+  // Off unless enabled with --coverage-dump, reads counters from main SRAM.
+  VerilatorCoverageDumper coverage_dumper(memutil.GetUnderlying());
+  simctrl.RegisterExtension(&coverage_dumper);
+
   // The initial reset delay must be long enough such that pwr/rst/clkmgr will
   // release clocks to the entire design.  This allows for synchronous resets
   // to appropriately propagate.
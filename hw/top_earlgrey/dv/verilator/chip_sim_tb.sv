@@ -208,6 +208,18 @@ module chip_sim_tb (
     end
   end
 
+`ifdef RVFI
+  // Report retired instructions to the PC profiler (verilator_pc_profiler.h).
+  import "DPI-C" function void pc_profiler_retire(bit [31:0] pc, bit [31:0] insn, bit trap);
+
+  always @(posedge `RV_CORE_IBEX.clk_i) begin
+    if (`RV_CORE_IBEX.rvfi_valid) begin
+      pc_profiler_retire(`RV_CORE_IBEX.rvfi_pc_rdata, `RV_CORE_IBEX.rvfi_insn,
+                         `RV_CORE_IBEX.rvfi_trap);
+    end
+  end
+`endif
+
   `undef RV_CORE_IBEX
   `undef SIM_SRAM_IF
 
@@ -10,7 +10,9 @@ module top #(
   parameter string DMEM_INIT_HEX = "/home/xinting/opentitan_minrot/playground/secure_boot_v0/test_sw/hex/rom_with_image.dmem.hex",
   // parameter string ESRAM_INIT_HEX = "/home/xinting/opentitan_minrot/playground/secure_boot_v0/test_sw/hex/esram_bk.hex",
   parameter int IMEM_BASE = 32'h0000_0000,
-  parameter int UART_BASE = 32'h0003_0000
+  parameter int UART_BASE = 32'h0003_0000,
+  // Ibex performance counters, read by the TB for per boot stage reports
+  parameter int unsigned MHPMCounterNum = 10
 ) (
   input  logic clk_i,
   input  logic rst_ni,
@@ -100,7 +102,9 @@ module top #(
   logic core_sleep;
 
   // Ibex core (upstream ibex_top)
-  ibex_top u_ibex (
+  ibex_top #(
+    .MHPMCounterNum(MHPMCounterNum)
+  ) u_ibex (
     .clk_i(clk_i),
     .rst_ni(rst_ni),
     .test_en_i(1'b0),
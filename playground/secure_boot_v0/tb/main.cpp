@@ -55,6 +55,9 @@ int main(int argc, char **argv) {
   svSetScope(svGetScopeFromName("TOP.top_tb"));
   dump_esram("esram_dump.hex");
 
+  // Run the final blocks (co-simulation summary).
+  top.final();
+
   tfp.close();
   return 0;
 }
@@ -0,0 +1,1268 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "rv32_cosim.h"
+
+#include <cassert>
+#include <cstring>
+#include <sstream>
+#include <utility>
+
+namespace {
+
+// Machine mode CSRs modelled by Rv32Cosim
+constexpr uint32_t kCsrMstatus = 0x300;
+constexpr uint32_t kCsrMisa = 0x301;
+constexpr uint32_t kCsrMie = 0x304;
+constexpr uint32_t kCsrMtvec = 0x305;
+constexpr uint32_t kCsrMscratch = 0x340;
+constexpr uint32_t kCsrMepc = 0x341;
+constexpr uint32_t kCsrMcause = 0x342;
+constexpr uint32_t kCsrMtval = 0x343;
+constexpr uint32_t kCsrMip = 0x344;
+
+constexpr uint32_t kMstatusMie = 1u << 3;
+constexpr uint32_t kMstatusMpie = 1u << 7;
+constexpr uint32_t kMstatusMppShift = 11;
+constexpr uint32_t kMstatusMpp = 3u << kMstatusMppShift;
+constexpr uint32_t kMstatusMprv = 1u << 17;
+constexpr uint32_t kMstatusTw = 1u << 21;
+constexpr uint32_t kMstatusMask =
+    kMstatusMie | kMstatusMpie | kMstatusMpp | kMstatusMprv | kMstatusTw;
+
+// Software, timer, external and fast interrupts
+constexpr uint32_t kMieMask = 0x7fff0888;
+
+// misa of an RV32IMC Ibex with U mode
+constexpr uint32_t kMisa = (1u << 30) | (1u << 20) | (1u << 12) | (1u << 8) |
+                           (1u << 2);
+
+constexpr uint32_t kPrivU = 0;
+constexpr uint32_t kPrivM = 3;
+
+constexpr uint32_t kExcInstrAccessFault = 1;
+constexpr uint32_t kExcIllegalInsn = 2;
+constexpr uint32_t kExcBreakpoint = 3;
+constexpr uint32_t kExcLoadAccessFault = 5;
+constexpr uint32_t kExcStoreAccessFault = 7;
+constexpr uint32_t kExcEcallUMode = 8;
+constexpr uint32_t kExcEcallMMode = 11;
+
+constexpr uint32_t kCauseIrq = 0x80000000;
+constexpr uint32_t kCauseNmi = 0x8000001f;
+constexpr uint32_t kCauseNmiInt = 0xffffffe0;
+constexpr uint32_t kNmiVectorOffset = 0x7c;
+
+uint32_t bits(uint32_t val, int hi, int lo) {
+  return (val >> lo) & ((1u << (hi - lo + 1)) - 1);
+}
+
+uint32_t sext(uint32_t val, int width) {
+  uint32_t sign = 1u << (width - 1);
+  return (val ^ sign) - sign;
+}
+
+}  // namespace
+
+Rv32Cosim::Rv32Cosim(uint32_t start_pc, uint32_t start_mtvec)
+    : pending_iside_error_(false),
+      pending_iside_err_addr_(0),
+      insn_cnt_(0),
+      pc_(start_pc),
+      priv_(kPrivM),
+      mstatus_(kPrivM << kMstatusMppShift),
+      mie_(0),
+      mip_(0),
+      mtvec_(start_mtvec),
+      mscratch_(0),
+      mepc_(0),
+      mcause_(0),
+      mtval_(0),
+      pre_mip_(0),
+      post_mip_(0),
+      nmi_(false),
+      nmi_int_(false),
+      nmi_mode_(false),
+      exception_(false),
+      exception_cause_(0),
+      exception_tval_(0),
+      reg_written_(false),
+      reg_written_idx_(0),
+      reg_written_data_(0),
+      next_pc_(start_pc) {
+  memset(regs_, 0, sizeof(regs_));
+}
+
+void Rv32Cosim::add_memory(uint32_t base_addr, size_t size) {
+  Memory mem;
+  mem.base = base_addr;
+  mem.data.assign(size, 0);
+  mem.attrs.assign(size, 0);
+  mems_.push_back(std::move(mem));
+}
+
+void Rv32Cosim::set_attr(uint32_t base_addr, size_t size, uint8_t attr) {
+  for (size_t i = 0; i < size; ++i) {
+    Memory *mem = find_memory(base_addr + i, 1);
+    assert(mem);
+    mem->attrs[base_addr + i - mem->base] |= attr;
+  }
+}
+
+void Rv32Cosim::set_read_only(uint32_t base_addr, size_t size) {
+  set_attr(base_addr, size, kMemAttrReadOnly);
+}
+
+void Rv32Cosim::set_no_exec(uint32_t base_addr, size_t size) {
+  set_attr(base_addr, size, kMemAttrNoExec);
+}
+
+Rv32Cosim::Memory *Rv32Cosim::find_memory(uint32_t addr, size_t len) {
+  for (auto &mem : mems_) {
+    if (addr >= mem.base && (addr - mem.base) + len <= mem.data.size()) {
+      return &mem;
+    }
+  }
+  return nullptr;
+}
+
+bool Rv32Cosim::backdoor_write_mem(uint32_t addr, size_t len,
+                                   const uint8_t *data_in) {
+  Memory *mem = find_memory(addr, len);
+  if (!mem) {
+    return false;
+  }
+  memcpy(&mem->data[addr - mem->base], data_in, len);
+  return true;
+}
+
+bool Rv32Cosim::backdoor_read_mem(uint32_t addr, size_t len,
+                                  uint8_t *data_out) {
+  Memory *mem = find_memory(addr, len);
+  if (!mem) {
+    return false;
+  }
+  memcpy(data_out, &mem->data[addr - mem->base], len);
+  return true;
+}
+
+void Rv32Cosim::error(const std::string &msg) { errors_.push_back(msg); }
+
+bool Rv32Cosim::step(uint32_t write_reg, uint32_t write_reg_data, uint32_t pc,
+                     bool sync_trap, bool suppress_reg_write) {
+  assert(write_reg < 32);
+
+  // An interrupt is taken between instructions, the DUT reports the first
+  // instruction of the handler.
+  take_pending_interrupt();
+
+  exception_ = false;
+  reg_written_ = false;
+
+  if (pc_ != pc) {
+    std::stringstream err_str;
+    err_str << "PC mismatch, DUT retired : " << std::hex << pc
+            << " , but the ISS retired: " << std::hex << pc_;
+    error(err_str.str());
+    return false;
+  }
+
+  Insn insn;
+  if (fetch(insn)) {
+    execute(insn, sync_trap, write_reg, write_reg_data);
+  }
+
+  // Memory access checks may have failed during execution.
+  if (!errors_.empty()) {
+    return false;
+  }
+
+  if (exception_) {
+    if (!sync_trap) {
+      std::stringstream err_str;
+      err_str << "Synchronous trap (cause " << std::dec << exception_cause_
+              << ") was expected at ISS PC: " << std::hex << pc_
+              << " but the DUT didn't report one";
+      error(err_str.str());
+      return false;
+    }
+
+    if (write_reg != 0) {
+      std::stringstream err_str;
+      err_str << "Synchronous trap occurred at PC: " << std::hex << pc
+              << " but DUT wrote to register: x" << std::dec << write_reg;
+      error(err_str.str());
+      return false;
+    }
+
+    take_trap(exception_cause_, exception_tval_, pc_);
+    return true;
+  }
+
+  if (sync_trap) {
+    std::stringstream err_str;
+    err_str << "DUT reported a synchronous trap at PC: " << std::hex << pc
+            << " but the ISS retired the instruction";
+    error(err_str.str());
+    return false;
+  }
+
+  if (pending_iside_error_) {
+    std::stringstream err_str;
+    err_str << "DUT generated an iside error for address: " << std::hex
+            << pending_iside_err_addr_ << " but the ISS didn't produce one";
+    error(err_str.str());
+    pending_iside_error_ = false;
+    return false;
+  }
+
+  if (!pending_dside_accesses_.empty()) {
+    const DSideAccessInfo &access = pending_dside_accesses_.front();
+    std::stringstream err_str;
+    err_str << "DUT generated " << (access.store ? "store" : "load")
+            << " at address " << std::hex << access.addr
+            << " but the instruction at PC " << pc << " doesn't access memory";
+    error(err_str.str());
+    return false;
+  }
+
+  // Check register writes from the retired instruction
+  if (reg_written_ && !suppress_reg_write) {
+    if (write_reg != reg_written_idx_) {
+      std::stringstream err_str;
+      err_str << "Register write index mismatch at PC " << std::hex << pc
+              << ", DUT: x" << std::dec << write_reg << " expected: x"
+              << reg_written_idx_;
+      error(err_str.str());
+      return false;
+    }
+    if (write_reg_data != reg_written_data_) {
+      std::stringstream err_str;
+      err_str << "Register write data mismatch to x" << std::dec
+              << write_reg << " at PC " << std::hex << pc << ", DUT: "
+              << write_reg_data << " expected: " << reg_written_data_;
+      error(err_str.str());
+      return false;
+    }
+  } else if (!reg_written_ && write_reg != 0) {
+    std::stringstream err_str;
+    err_str << "DUT wrote register x" << std::dec << write_reg << " at PC "
+            << std::hex << pc << " but a write was not expected";
+    error(err_str.str());
+    return false;
+  }
+
+  // If Ibex suppressed the register write (load data with bad integrity)
+  // leave the destination register untouched.
+  if (reg_written_ && !suppress_reg_write) {
+    regs_[reg_written_idx_] = reg_written_data_;
+  }
+
+  pc_ = next_pc_;
+  insn_cnt_++;
+  return true;
+}
+
+bool Rv32Cosim::take_pending_interrupt() {
+  bool nmi = (nmi_ || nmi_int_) && !nmi_mode_;
+  uint32_t pending = pre_mip_ & mie_;
+  bool irq_enabled = (priv_ == kPrivU) || (mstatus_ & kMstatusMie);
+
+  // The interrupted instruction observes the post-trap MIP value
+  mip_ = post_mip_;
+
+  if (nmi) {
+    nmi_mode_ = true;
+    take_trap(nmi_ ? kCauseNmi : kCauseNmiInt, 0, pc_);
+    pc_ = (mtvec_ & ~0xffu) + kNmiVectorOffset;
+    return true;
+  }
+
+  if (!irq_enabled || pending == 0) {
+    return false;
+  }
+
+  // Ibex priority: fast interrupts (lowest index first), external, software,
+  // timer.
+  uint32_t irq = 0;
+  if (pending & 0x7fff0000) {
+    for (irq = 16; !(pending & (1u << irq)); ++irq) {
+    }
+  } else if (pending & (1u << 11)) {
+    irq = 11;
+  } else if (pending & (1u << 3)) {
+    irq = 3;
+  } else {
+    irq = 7;
+  }
+
+  take_trap(kCauseIrq | irq, 0, pc_);
+  pc_ = (mtvec_ & ~0xffu) + (irq << 2);
+  return true;
+}
+
+void Rv32Cosim::take_trap(uint32_t cause, uint32_t tval, uint32_t epc) {
+  mepc_ = epc;
+  mcause_ = cause;
+  mtval_ = tval;
+
+  uint32_t mie = (mstatus_ & kMstatusMie) ? kMstatusMpie : 0;
+  mstatus_ &= ~(kMstatusMie | kMstatusMpie | kMstatusMpp);
+  mstatus_ |= mie | (priv_ << kMstatusMppShift);
+  priv_ = kPrivM;
+
+  pc_ = mtvec_ & ~0xffu;
+}
+
+void Rv32Cosim::raise_exception(uint32_t cause, uint32_t tval) {
+  // Only the first exception of an instruction counts
+  if (exception_) {
+    return;
+  }
+  exception_ = true;
+  exception_cause_ = cause;
+  exception_tval_ = tval;
+}
+
+void Rv32Cosim::write_reg(uint32_t reg, uint32_t value) {
+  if (reg == 0) {
+    return;
+  }
+  reg_written_ = true;
+  reg_written_idx_ = reg;
+  reg_written_data_ = value;
+}
+
+bool Rv32Cosim::fetch_half(uint32_t addr, uint16_t &half) {
+  if (pending_iside_error_ && (addr & ~3u) == pending_iside_err_addr_) {
+    pending_iside_error_ = false;
+    return false;
+  }
+
+  Memory *mem = find_memory(addr, 2);
+  if (!mem) {
+    return false;
+  }
+
+  uint32_t offset = addr - mem->base;
+  if ((mem->attrs[offset] | mem->attrs[offset + 1]) & kMemAttrNoExec) {
+    return false;
+  }
+  half = mem->data[offset] | (mem->data[offset + 1] << 8);
+  return true;
+}
+
+bool Rv32Cosim::fetch(Insn &insn) {
+  uint16_t lo, hi;
+  if (!fetch_half(pc_, lo)) {
+    raise_exception(kExcInstrAccessFault, pc_);
+    return false;
+  }
+
+  if ((lo & 3) != 3) {
+    insn = decode_compressed(lo);
+    return true;
+  }
+
+  if (!fetch_half(pc_ + 2, hi)) {
+    raise_exception(kExcInstrAccessFault, pc_ + 2);
+    return false;
+  }
+  insn = decode(lo | (hi << 16));
+  return true;
+}
+
+Rv32Cosim::Insn Rv32Cosim::decode(uint32_t insn) {
+  uint32_t opcode = bits(insn, 6, 0);
+  uint32_t rd = bits(insn, 11, 7);
+  uint32_t funct3 = bits(insn, 14, 12);
+  uint32_t rs1 = bits(insn, 19, 15);
+  uint32_t rs2 = bits(insn, 24, 20);
+  uint32_t funct7 = bits(insn, 31, 25);
+
+  uint32_t imm_i = sext(bits(insn, 31, 20), 12);
+  uint32_t imm_s = sext((bits(insn, 31, 25) << 5) | bits(insn, 11, 7), 12);
+  uint32_t imm_b = sext((bits(insn, 31, 31) << 12) | (bits(insn, 7, 7) << 11) |
+                            (bits(insn, 30, 25) << 5) | (bits(insn, 11, 8) << 1),
+                        13);
+  uint32_t imm_u = insn & 0xfffff000;
+  uint32_t imm_j =
+      sext((bits(insn, 31, 31) << 20) | (bits(insn, 19, 12) << 12) |
+               (bits(insn, 20, 20) << 11) | (bits(insn, 30, 21) << 1),
+           21);
+
+  Insn out;
+  out.op = kOpIllegal;
+  out.rd = rd;
+  out.rs1 = rs1;
+  out.rs2 = rs2;
+  out.imm = 0;
+  out.bits = insn;
+  out.len = 4;
+
+  switch (opcode) {
+    case 0x37:
+      out.op = kOpLui;
+      out.imm = imm_u;
+      break;
+    case 0x17:
+      out.op = kOpAuipc;
+      out.imm = imm_u;
+      break;
+    case 0x6f:
+      out.op = kOpJal;
+      out.imm = imm_j;
+      break;
+    case 0x67:
+      if (funct3 == 0) {
+        out.op = kOpJalr;
+        out.imm = imm_i;
+      }
+      break;
+    case 0x63: {
+      static const Op kBranchOps[8] = {kOpBeq,     kOpBne,  kOpIllegal,
+                                       kOpIllegal, kOpBlt,  kOpBge,
+                                       kOpBltu,    kOpBgeu};
+      out.op = kBranchOps[funct3];
+      out.imm = imm_b;
+      break;
+    }
+    case 0x03: {
+      static const Op kLoadOps[8] = {kOpLb,  kOpLh,  kOpLw,      kOpIllegal,
+                                     kOpLbu, kOpLhu, kOpIllegal, kOpIllegal};
+      out.op = kLoadOps[funct3];
+      out.imm = imm_i;
+      break;
+    }
+    case 0x23: {
+      static const Op kStoreOps[8] = {kOpSb,      kOpSh,      kOpSw,
+                                      kOpIllegal, kOpIllegal, kOpIllegal,
+                                      kOpIllegal, kOpIllegal};
+      out.op = kStoreOps[funct3];
+      out.imm = imm_s;
+      break;
+    }
+    case 0x13: {
+      static const Op kOpImmOps[8] = {kOpAddi, kOpIllegal, kOpSlti, kOpSltiu,
+                                      kOpXori, kOpIllegal, kOpOri,  kOpAndi};
+      out.imm = imm_i;
+      if (funct3 == 1) {
+        out.op = (funct7 == 0) ? kOpSlli : kOpIllegal;
+        out.imm = rs2;
+      } else if (funct3 == 5) {
+        out.op = (funct7 == 0) ? kOpSrli : (funct7 == 0x20) ? kOpSrai
+                                                             : kOpIllegal;
+        out.imm = rs2;
+      } else {
+        out.op = kOpImmOps[funct3];
+      }
+      break;
+    }
+    case 0x33: {
+      static const Op kBaseOps[8] = {kOpAdd, kOpSll, kOpSlt, kOpSltu,
+                                     kOpXor, kOpSrl, kOpOr,  kOpAnd};
+      static const Op kMulDivOps[8] = {kOpMul, kOpMulh, kOpMulhsu, kOpMulhu,
+                                       kOpDiv, kOpDivu, kOpRem,    kOpRemu};
+      if (funct7 == 0) {
+        out.op = kBaseOps[funct3];
+      } else if (funct7 == 1) {
+        out.op = kMulDivOps[funct3];
+      } else if (funct7 == 0x20 && funct3 == 0) {
+        out.op = kOpSub;
+      } else if (funct7 == 0x20 && funct3 == 5) {
+        out.op = kOpSra;
+      }
+      break;
+    }
+    case 0x0f:
+      // fence and fence.i
+      if (funct3 == 0 || funct3 == 1) {
+        out.op = kOpFence;
+      }
+      break;
+    case 0x73:
+      switch (funct3) {
+        case 0:
+          if (insn == 0x00000073) {
+            out.op = kOpEcall;
+          } else if (insn == 0x00100073) {
+            out.op = kOpEbreak;
+          } else if (insn == 0x30200073) {
+            out.op = kOpMret;
+          } else if (insn == 0x10500073) {
+            out.op = kOpWfi;
+          }
+          break;
+        case 1:
+          out.op = kOpCsrrw;
+          break;
+        case 2:
+          out.op = kOpCsrrs;
+          break;
+        case 3:
+          out.op = kOpCsrrc;
+          break;
+        case 5:
+          out.op = kOpCsrrwi;
+          break;
+        case 6:
+          out.op = kOpCsrrsi;
+          break;
+        case 7:
+          out.op = kOpCsrrci;
+          break;
+        default:
+          break;
+      }
+      out.imm = bits(insn, 31, 20);
+      break;
+    default:
+      break;
+  }
+
+  return out;
+}
+
+Rv32Cosim::Insn Rv32Cosim::decode_compressed(uint32_t insn) {
+  uint32_t funct3 = bits(insn, 15, 13);
+  uint32_t rd = bits(insn, 11, 7);
+  uint32_t rs2 = bits(insn, 6, 2);
+  uint32_t rd_p = bits(insn, 4, 2) + 8;
+  uint32_t rs1_p = bits(insn, 9, 7) + 8;
+
+  Insn out;
+  out.op = kOpIllegal;
+  out.rd = 0;
+  out.rs1 = 0;
+  out.rs2 = 0;
+  out.imm = 0;
+  out.bits = insn;
+  out.len = 2;
+
+  auto set = [&out](Op op, uint32_t rd, uint32_t rs1, uint32_t rs2,
+                    uint32_t imm) {
+    out.op = op;
+    out.rd = rd;
+    out.rs1 = rs1;
+    out.rs2 = rs2;
+    out.imm = imm;
+  };
+
+  uint32_t imm6 = sext((bits(insn, 12, 12) << 5) | bits(insn, 6, 2), 6);
+  uint32_t shamt = bits(insn, 6, 2);
+  uint32_t j_imm =
+      sext((bits(insn, 12, 12) << 11) | (bits(insn, 11, 11) << 4) |
+               (bits(insn, 10, 9) << 8) | (bits(insn, 8, 8) << 10) |
+               (bits(insn, 7, 7) << 6) | (bits(insn, 6, 6) << 7) |
+               (bits(insn, 5, 3) << 1) | (bits(insn, 2, 2) << 5),
+           12);
+  uint32_t b_imm = sext((bits(insn, 12, 12) << 8) | (bits(insn, 11, 10) << 3) |
+                            (bits(insn, 6, 5) << 6) | (bits(insn, 4, 3) << 1) |
+                            (bits(insn, 2, 2) << 5),
+                        9);
+  uint32_t lw_imm = (bits(insn, 12, 10) << 3) | (bits(insn, 6, 6) << 2) |
+                    (bits(insn, 5, 5) << 6);
+
+  switch (bits(insn, 1, 0)) {
+    case 0:
+      switch (funct3) {
+        case 0: {
+          // c.addi4spn
+          uint32_t nzuimm = (bits(insn, 12, 11) << 4) |
+                            (bits(insn, 10, 7) << 6) |
+                            (bits(insn, 6, 6) << 2) | (bits(insn, 5, 5) << 3);
+          if (nzuimm != 0) {
+            set(kOpAddi, rd_p, 2, 0, nzuimm);
+          }
+          break;
+        }
+        case 2:
+          set(kOpLw, rd_p, rs1_p, 0, lw_imm);
+          break;
+        case 6:
+          set(kOpSw, 0, rs1_p, rd_p, lw_imm);
+          break;
+        default:
+          break;
+      }
+      break;
+    case 1:
+      switch (funct3) {
+        case 0:
+          set(kOpAddi, rd, rd, 0, imm6);
+          break;
+        case 1:
+          set(kOpJal, 1, 0, 0, j_imm);
+          break;
+        case 2:
+          set(kOpAddi, rd, 0, 0, imm6);
+          break;
+        case 3:
+          if (bits(insn, 12, 12) == 0 && bits(insn, 6, 2) == 0) {
+            break;
+          }
+          if (rd == 2) {
+            // c.addi16sp
+            uint32_t imm = sext((bits(insn, 12, 12) << 9) |
+                                    (bits(insn, 6, 6) << 4) |
+                                    (bits(insn, 5, 5) << 6) |
+                                    (bits(insn, 4, 3) << 7) |
+                                    (bits(insn, 2, 2) << 5),
+                                10);
+            set(kOpAddi, 2, 2, 0, imm);
+          } else {
+            set(kOpLui, rd, 0, 0, imm6 << 12);
+          }
+          break;
+        case 4:
+          switch (bits(insn, 11, 10)) {
+            case 0:
+              if (!bits(insn, 12, 12)) {
+                set(kOpSrli, rs1_p, rs1_p, 0, shamt);
+              }
+              break;
+            case 1:
+              if (!bits(insn, 12, 12)) {
+                set(kOpSrai, rs1_p, rs1_p, 0, shamt);
+              }
+              break;
+            case 2:
+              set(kOpAndi, rs1_p, rs1_p, 0, imm6);
+              break;
+            case 3: {
+              static const Op kArithOps[4] = {kOpSub, kOpXor, kOpOr, kOpAnd};
+              if (!bits(insn, 12, 12)) {
+                set(kArithOps[bits(insn, 6, 5)], rs1_p, rs1_p, rd_p, 0);
+              }
+              break;
+            }
+          }
+          break;
+        case 5:
+          set(kOpJal, 0, 0, 0, j_imm);
+          break;
+        case 6:
+          set(kOpBeq, 0, rs1_p, 0, b_imm);
+          break;
+        case 7:
+          set(kOpBne, 0, rs1_p, 0, b_imm);
+          break;
+      }
+      break;
+    case 2:
+      switch (funct3) {
+        case 0:
+          if (!bits(insn, 12, 12)) {
+            set(kOpSlli, rd, rd, 0, shamt);
+          }
+          break;
+        case 2:
+          if (rd != 0) {
+            uint32_t imm = (bits(insn, 12, 12) << 5) |
+                           (bits(insn, 6, 4) << 2) | (bits(insn, 3, 2) << 6);
+            set(kOpLw, rd, 2, 0, imm);
+          }
+          break;
+        case 4:
+          if (!bits(insn, 12, 12)) {
+            if (rs2 == 0) {
+              // c.jr
+              if (rd != 0) {
+                set(kOpJalr, 0, rd, 0, 0);
+              }
+            } else {
+              // c.mv
+              set(kOpAdd, rd, 0, rs2, 0);
+            }
+          } else {
+            if (rd == 0 && rs2 == 0) {
+              set(kOpEbreak, 0, 0, 0, 0);
+            } else if (rs2 == 0) {
+              // c.jalr
+              set(kOpJalr, 1, rd, 0, 0);
+            } else {
+              // c.add
+              set(kOpAdd, rd, rd, rs2, 0);
+            }
+          }
+          break;
+        case 6: {
+          uint32_t imm = (bits(insn, 12, 9) << 2) | (bits(insn, 8, 7) << 6);
+          set(kOpSw, 0, 2, rs2, imm);
+          break;
+        }
+        default:
+          break;
+      }
+      break;
+  }
+
+  return out;
+}
+
+void Rv32Cosim::execute(const Insn &insn, bool dut_sync_trap,
+                        uint32_t dut_write_reg, uint32_t dut_write_reg_data) {
+  uint32_t pc = pc_;
+  uint32_t a = regs_[insn.rs1];
+  uint32_t b = regs_[insn.rs2];
+  uint32_t imm = insn.imm;
+  uint32_t value;
+
+  next_pc_ = pc + insn.len;
+
+  auto branch = [&](bool taken) {
+    if (taken) {
+      next_pc_ = pc + imm;
+    }
+  };
+
+  switch (insn.op) {
+    case kOpIllegal:
+      raise_exception(kExcIllegalInsn, insn.bits);
+      break;
+    case kOpLui:
+      write_reg(insn.rd, imm);
+      break;
+    case kOpAuipc:
+      write_reg(insn.rd, pc + imm);
+      break;
+    case kOpJal:
+      write_reg(insn.rd, pc + insn.len);
+      next_pc_ = pc + imm;
+      break;
+    case kOpJalr:
+      write_reg(insn.rd, pc + insn.len);
+      next_pc_ = (a + imm) & ~1u;
+      break;
+    case kOpBeq:
+      branch(a == b);
+      break;
+    case kOpBne:
+      branch(a != b);
+      break;
+    case kOpBlt:
+      branch((int32_t)a < (int32_t)b);
+      break;
+    case kOpBge:
+      branch((int32_t)a >= (int32_t)b);
+      break;
+    case kOpBltu:
+      branch(a < b);
+      break;
+    case kOpBgeu:
+      branch(a >= b);
+      break;
+    case kOpLb:
+      if (load(a + imm, 1, value)) {
+        write_reg(insn.rd, sext(value, 8));
+      }
+      break;
+    case kOpLh:
+      if (load(a + imm, 2, value)) {
+        write_reg(insn.rd, sext(value, 16));
+      }
+      break;
+    case kOpLw:
+      if (load(a + imm, 4, value)) {
+        write_reg(insn.rd, value);
+      }
+      break;
+    case kOpLbu:
+      if (load(a + imm, 1, value)) {
+        write_reg(insn.rd, value);
+      }
+      break;
+    case kOpLhu:
+      if (load(a + imm, 2, value)) {
+        write_reg(insn.rd, value);
+      }
+      break;
+    case kOpSb:
+      store(a + imm, 1, b);
+      break;
+    case kOpSh:
+      store(a + imm, 2, b);
+      break;
+    case kOpSw:
+      store(a + imm, 4, b);
+      break;
+    case kOpAddi:
+      write_reg(insn.rd, a + imm);
+      break;
+    case kOpSlti:
+      write_reg(insn.rd, (int32_t)a < (int32_t)imm);
+      break;
+    case kOpSltiu:
+      write_reg(insn.rd, a < imm);
+      break;
+    case kOpXori:
+      write_reg(insn.rd, a ^ imm);
+      break;
+    case kOpOri:
+      write_reg(insn.rd, a | imm);
+      break;
+    case kOpAndi:
+      write_reg(insn.rd, a & imm);
+      break;
+    case kOpSlli:
+      write_reg(insn.rd, a << imm);
+      break;
+    case kOpSrli:
+      write_reg(insn.rd, a >> imm);
+      break;
+    case kOpSrai:
+      write_reg(insn.rd, (uint32_t)((int32_t)a >> imm));
+      break;
+    case kOpAdd:
+      write_reg(insn.rd, a + b);
+      break;
+    case kOpSub:
+      write_reg(insn.rd, a - b);
+      break;
+    case kOpSll:
+      write_reg(insn.rd, a << (b & 31));
+      break;
+    case kOpSlt:
+      write_reg(insn.rd, (int32_t)a < (int32_t)b);
+      break;
+    case kOpSltu:
+      write_reg(insn.rd, a < b);
+      break;
+    case kOpXor:
+      write_reg(insn.rd, a ^ b);
+      break;
+    case kOpSrl:
+      write_reg(insn.rd, a >> (b & 31));
+      break;
+    case kOpSra:
+      write_reg(insn.rd, (uint32_t)((int32_t)a >> (b & 31)));
+      break;
+    case kOpOr:
+      write_reg(insn.rd, a | b);
+      break;
+    case kOpAnd:
+      write_reg(insn.rd, a & b);
+      break;
+    case kOpMul:
+      write_reg(insn.rd, a * b);
+      break;
+    case kOpMulh:
+      write_reg(insn.rd, (uint32_t)(((int64_t)(int32_t)a *
+                                     (int64_t)(int32_t)b) >>
+                                    32));
+      break;
+    case kOpMulhsu:
+      write_reg(insn.rd,
+                (uint32_t)(((int64_t)(int32_t)a * (int64_t)(uint64_t)b) >> 32));
+      break;
+    case kOpMulhu:
+      write_reg(insn.rd, (uint32_t)(((uint64_t)a * (uint64_t)b) >> 32));
+      break;
+    case kOpDiv:
+      if (b == 0) {
+        value = 0xffffffff;
+      } else if (a == 0x80000000 && b == 0xffffffff) {
+        value = a;
+      } else {
+        value = (uint32_t)((int32_t)a / (int32_t)b);
+      }
+      write_reg(insn.rd, value);
+      break;
+    case kOpDivu:
+      write_reg(insn.rd, b == 0 ? 0xffffffff : a / b);
+      break;
+    case kOpRem:
+      if (b == 0) {
+        value = a;
+      } else if (a == 0x80000000 && b == 0xffffffff) {
+        value = 0;
+      } else {
+        value = (uint32_t)((int32_t)a % (int32_t)b);
+      }
+      write_reg(insn.rd, value);
+      break;
+    case kOpRemu:
+      write_reg(insn.rd, b == 0 ? a : a % b);
+      break;
+    case kOpFence:
+      break;
+    case kOpEcall:
+      raise_exception(priv_ == kPrivM ? kExcEcallMMode : kExcEcallUMode, 0);
+      break;
+    case kOpEbreak:
+      raise_exception(kExcBreakpoint, 0);
+      break;
+    case kOpMret: {
+      if (priv_ != kPrivM) {
+        raise_exception(kExcIllegalInsn, insn.bits);
+        break;
+      }
+      uint32_t mpp = (mstatus_ & kMstatusMpp) >> kMstatusMppShift;
+      uint32_t mie = (mstatus_ & kMstatusMpie) ? kMstatusMie : 0;
+      mstatus_ &= ~(kMstatusMie | kMstatusMpp);
+      mstatus_ |= mie | kMstatusMpie | (kPrivU << kMstatusMppShift);
+      priv_ = mpp;
+      nmi_mode_ = false;
+      next_pc_ = mepc_;
+      break;
+    }
+    case kOpWfi:
+      if (priv_ != kPrivM && (mstatus_ & kMstatusTw)) {
+        raise_exception(kExcIllegalInsn, insn.bits);
+      }
+      break;
+    case kOpCsrrw:
+      csr_op(insn, a, true, dut_sync_trap, dut_write_reg, dut_write_reg_data);
+      break;
+    case kOpCsrrs:
+    case kOpCsrrc:
+      csr_op(insn, a, insn.rs1 != 0, dut_sync_trap, dut_write_reg,
+             dut_write_reg_data);
+      break;
+    case kOpCsrrwi:
+      csr_op(insn, insn.rs1, true, dut_sync_trap, dut_write_reg,
+             dut_write_reg_data);
+      break;
+    case kOpCsrrsi:
+    case kOpCsrrci:
+      csr_op(insn, insn.rs1, insn.rs1 != 0, dut_sync_trap, dut_write_reg,
+             dut_write_reg_data);
+      break;
+  }
+}
+
+void Rv32Cosim::csr_op(const Insn &insn, uint32_t src, bool write,
+                       bool dut_sync_trap, uint32_t dut_write_reg,
+                       uint32_t dut_write_reg_data) {
+  uint32_t csr = insn.imm;
+
+  // Privilege and read-only checks
+  if (bits(csr, 9, 8) > priv_ || (write && bits(csr, 11, 10) == 3)) {
+    raise_exception(kExcIllegalInsn, insn.bits);
+    return;
+  }
+
+  uint32_t old_value;
+  if (!csr_read(csr, old_value)) {
+    // Not modelled: follow the DUT. Ibex raises an illegal instruction
+    // exception for CSRs it doesn't implement, otherwise take the value it
+    // read.
+    if (dut_sync_trap) {
+      raise_exception(kExcIllegalInsn, insn.bits);
+    } else {
+      write_reg(insn.rd, dut_write_reg == insn.rd ? dut_write_reg_data : 0);
+    }
+    return;
+  }
+
+  if (write) {
+    uint32_t new_value;
+    switch (insn.op) {
+      case kOpCsrrw:
+      case kOpCsrrwi:
+        new_value = src;
+        break;
+      case kOpCsrrs:
+      case kOpCsrrsi:
+        new_value = old_value | src;
+        break;
+      default:
+        new_value = old_value & ~src;
+        break;
+    }
+    csr_write(csr, new_value);
+  }
+
+  write_reg(insn.rd, old_value);
+}
+
+uint32_t Rv32Cosim::read_mcause() const {
+  // Ibex stores the interrupt flags and a 5 bit cause, internal NMIs set all
+  // upper bits.
+  bool irq_int = (mcause_ & 0xc0000000) == 0xc0000000;
+  bool irq = mcause_ & 0x80000000;
+  return (irq ? 0x80000000 : 0) | (irq_int ? 0x7fffffe0 : 0) |
+         (mcause_ & 0x1f);
+}
+
+bool Rv32Cosim::csr_read(uint32_t csr, uint32_t &value) {
+  switch (csr) {
+    case kCsrMstatus:
+      value = mstatus_;
+      return true;
+    case kCsrMisa:
+      value = kMisa;
+      return true;
+    case kCsrMie:
+      value = mie_;
+      return true;
+    case kCsrMtvec:
+      value = mtvec_;
+      return true;
+    case kCsrMscratch:
+      value = mscratch_;
+      return true;
+    case kCsrMepc:
+      value = mepc_;
+      return true;
+    case kCsrMcause:
+      value = read_mcause();
+      return true;
+    case kCsrMtval:
+      value = mtval_;
+      return true;
+    case kCsrMip:
+      value = mip_;
+      return true;
+    default:
+      return false;
+  }
+}
+
+void Rv32Cosim::csr_write(uint32_t csr, uint32_t value) {
+  switch (csr) {
+    case kCsrMstatus: {
+      // Only M and U mode exist, any other MPP value is turned into U.
+      uint32_t mpp = (value & kMstatusMpp) >> kMstatusMppShift;
+      if (mpp != kPrivM) {
+        mpp = kPrivU;
+      }
+      mstatus_ = (value & kMstatusMask & ~kMstatusMpp) |
+                 (mpp << kMstatusMppShift);
+      break;
+    }
+    case kCsrMie:
+      mie_ = value & kMieMask;
+      break;
+    case kCsrMtvec:
+      // Ibex only supports vectored mode with a 256 byte aligned base
+      mtvec_ = (value & ~0xffu) | 1;
+      break;
+    case kCsrMscratch:
+      mscratch_ = value;
+      break;
+    case kCsrMepc:
+      mepc_ = value & ~1u;
+      break;
+    case kCsrMcause:
+      mcause_ = value;
+      break;
+    case kCsrMtval:
+      mtval_ = value;
+      break;
+    default:
+      // misa and mip ignore writes
+      break;
+  }
+}
+
+// Split an access into the aligned 32-bit words the DUT accesses
+static int split_access(uint32_t addr, uint32_t len, uint32_t parts_addr[2],
+                        uint32_t parts_offset[2], uint32_t parts_len[2]) {
+  uint32_t offset = addr & 3;
+  uint32_t first_len = (offset + len > 4) ? 4 - offset : len;
+  parts_addr[0] = addr & ~3u;
+  parts_offset[0] = offset;
+  parts_len[0] = first_len;
+  if (first_len == len) {
+    return 1;
+  }
+  parts_addr[1] = parts_addr[0] + 4;
+  parts_offset[1] = 0;
+  parts_len[1] = len - first_len;
+  return 2;
+}
+
+bool Rv32Cosim::match_dside_access(bool store, const MemPart &part,
+                                   DSideAccessInfo &access) {
+  std::string iss_action = store ? "store" : "load";
+
+  if (pending_dside_accesses_.empty()) {
+    std::stringstream err_str;
+    err_str << "A " << iss_action << " at address " << std::hex << part.addr
+            << " was expected but there are no pending accesses";
+    error(err_str.str());
+    return false;
+  }
+
+  access = pending_dside_accesses_.front();
+  pending_dside_accesses_.pop_front();
+
+  std::string dut_action = access.store ? "store" : "load";
+
+  if (access.addr != part.addr || access.store != store) {
+    std::stringstream err_str;
+    err_str << "DUT generated " << dut_action << " at address " << std::hex
+            << access.addr << " but " << iss_action << " at address "
+            << part.addr << " was expected";
+    error(err_str.str());
+    return false;
+  }
+
+  if (access.be != part.be) {
+    std::stringstream err_str;
+    err_str << "DUT generated " << dut_action << " at address " << std::hex
+            << access.addr << " with BE " << access.be << " but BE "
+            << part.be << " was expected";
+    error(err_str.str());
+    return false;
+  }
+
+  return true;
+}
+
+bool Rv32Cosim::load(uint32_t addr, uint32_t len, uint32_t &value) {
+  uint32_t parts_addr[2], parts_offset[2], parts_len[2];
+  int num_parts =
+      split_access(addr, len, parts_addr, parts_offset, parts_len);
+
+  bool fault = false;
+  uint32_t fault_addr = 0;
+  uint32_t shift = 0;
+  value = 0;
+
+  for (int i = 0; i < num_parts; ++i) {
+    MemPart part;
+    part.addr = parts_addr[i];
+    part.be = ((1u << parts_len[i]) - 1) << parts_offset[i];
+    part.offset = parts_offset[i];
+    part.len = parts_len[i];
+
+    DSideAccessInfo access;
+    if (!match_dside_access(false, part, access)) {
+      return false;
+    }
+
+    if (access.error) {
+      if (!fault) {
+        fault = true;
+        fault_addr = (i == 0) ? addr : part.addr;
+      }
+      shift += part.len * 8;
+      continue;
+    }
+
+    for (uint32_t b = 0; b < part.len; ++b) {
+      uint32_t byte_addr = part.addr + part.offset + b;
+      uint8_t dut_byte = access.data >> ((part.offset + b) * 8);
+      uint8_t byte = dut_byte;
+
+      Memory *mem = find_memory(byte_addr, 1);
+      if (mem) {
+        byte = mem->data[byte_addr - mem->base];
+        if (byte != dut_byte) {
+          std::stringstream err_str;
+          err_str << "DUT loaded " << std::hex << (uint32_t)dut_byte
+                  << " from address " << byte_addr << " but " << (uint32_t)byte
+                  << " was expected";
+          error(err_str.str());
+          return false;
+        }
+      }
+
+      value |= (uint32_t)byte << shift;
+      shift += 8;
+    }
+  }
+
+  if (fault) {
+    raise_exception(kExcLoadAccessFault, fault_addr);
+    return false;
+  }
+
+  return true;
+}
+
+bool Rv32Cosim::store(uint32_t addr, uint32_t len, uint32_t value) {
+  uint32_t parts_addr[2], parts_offset[2], parts_len[2];
+  int num_parts =
+      split_access(addr, len, parts_addr, parts_offset, parts_len);
+
+  bool fault = false;
+  uint32_t fault_addr = 0;
+
+  for (int i = 0; i < num_parts; ++i) {
+    MemPart part;
+    part.addr = parts_addr[i];
+    part.be = ((1u << parts_len[i]) - 1) << parts_offset[i];
+    part.offset = parts_offset[i];
+    part.len = parts_len[i];
+
+    DSideAccessInfo access;
+    if (!match_dside_access(true, part, access)) {
+      return false;
+    }
+
+    for (uint32_t b = 0; b < part.len; ++b) {
+      uint32_t byte_addr = part.addr + part.offset + b;
+      uint8_t byte = value;
+      uint8_t dut_byte = access.data >> ((part.offset + b) * 8);
+      value >>= 8;
+
+      if (byte != dut_byte) {
+        std::stringstream err_str;
+        err_str << "DUT stored " << std::hex << (uint32_t)dut_byte
+                << " to address " << byte_addr << " but " << (uint32_t)byte
+                << " was expected";
+        error(err_str.str());
+        return false;
+      }
+
+      Memory *mem = find_memory(byte_addr, 1);
+      if (!access.error && mem &&
+          !(mem->attrs[byte_addr - mem->base] & kMemAttrReadOnly)) {
+        mem->data[byte_addr - mem->base] = byte;
+      }
+    }
+
+    if (access.error && !fault) {
+      fault = true;
+      fault_addr = (i == 0) ? addr : part.addr;
+    }
+  }
+
+  if (fault) {
+    raise_exception(kExcStoreAccessFault, fault_addr);
+    return false;
+  }
+
+  return true;
+}
+
+void Rv32Cosim::set_mip(uint32_t pre_mip, uint32_t post_mip) {
+  pre_mip_ = pre_mip;
+  post_mip_ = post_mip;
+}
+
+void Rv32Cosim::set_nmi(bool nmi) { nmi_ = nmi; }
+
+void Rv32Cosim::set_nmi_int(bool nmi_int) { nmi_int_ = nmi_int; }
+
+void Rv32Cosim::set_debug_req(bool debug_req) {
+  if (debug_req) {
+    error("Debug requests are not supported by the RV32 reference model");
+  }
+}
+
+// Counters are not modelled; reads of them take the DUT value.
+void Rv32Cosim::set_mcycle(uint64_t /*mcycle*/) {}
+
+void Rv32Cosim::set_csr(const int /*csr_num*/, const uint32_t /*new_val*/) {}
+
+void Rv32Cosim::set_ic_scr_key_valid(bool /*valid*/) {}
+
+void Rv32Cosim::notify_dside_access(const DSideAccessInfo &access_info) {
+  pending_dside_accesses_.push_back(access_info);
+}
+
+void Rv32Cosim::set_iside_error(uint32_t addr) {
+  pending_iside_error_ = true;
+  pending_iside_err_addr_ = addr;
+}
+
+const std::vector<std::string> &Rv32Cosim::get_errors() { return errors_; }
+
+void Rv32Cosim::clear_errors() { errors_.clear(); }
+
+unsigned int Rv32Cosim::get_insn_cnt() { return insn_cnt_; }
@@ -0,0 +1,216 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_PLAYGROUND_SECURE_BOOT_V0_TB_RV32_COSIM_H_
+#define OPENTITAN_PLAYGROUND_SECURE_BOOT_V0_TB_RV32_COSIM_H_
+
+#include <stdint.h>
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "cosim.h"
+
+// Lightweight RV32IMC reference model implementing the Ibex `Cosim`
+// interface.
+//
+// This is a stand-in for `SpikeCosim` for builds that do not have the Ibex
+// Spike fork installed. It models what the secure_boot_v0 top can exercise:
+// RV32IMC in M and U mode, the machine trap CSRs (mstatus, misa, mie, mip,
+// mtvec, mscratch, mepc, mcause, mtval), exceptions and interrupts. Reads of
+// any other CSR (counters, Ibex custom CSRs, ...) take the value the DUT
+// retired and are not checked; writes to them are ignored. Debug mode and PMP
+// are not modelled.
+//
+// Loads and stores are matched against the D-side accesses notified via
+// `notify_dside_access` in order. Load data is checked against the model's
+// memory for addresses inside a memory added with `add_memory`; for any other
+// address (MMIO) the data observed on the DUT bus is used.
+class Rv32Cosim : public Cosim {
+ public:
+  Rv32Cosim(uint32_t start_pc, uint32_t start_mtvec);
+
+  // Mark a region of a memory added with `add_memory` as read-only. Stores to
+  // it are still checked against the DUT but leave the contents unchanged,
+  // matching a ROM that ignores writes.
+  void set_read_only(uint32_t base_addr, size_t size);
+
+  // Mark a region of a memory added with `add_memory` as not executable.
+  // Instruction fetches from it produce an instruction access fault.
+  void set_no_exec(uint32_t base_addr, size_t size);
+
+  // Cosim implementation
+  void add_memory(uint32_t base_addr, size_t size) override;
+  bool backdoor_write_mem(uint32_t addr, size_t len,
+                          const uint8_t *data_in) override;
+  bool backdoor_read_mem(uint32_t addr, size_t len, uint8_t *data_out) override;
+  bool step(uint32_t write_reg, uint32_t write_reg_data, uint32_t pc,
+            bool sync_trap, bool suppress_reg_write) override;
+  void set_mip(uint32_t pre_mip, uint32_t post_mip) override;
+  void set_nmi(bool nmi) override;
+  void set_nmi_int(bool nmi_int) override;
+  void set_debug_req(bool debug_req) override;
+  void set_mcycle(uint64_t mcycle) override;
+  void set_csr(const int csr_num, const uint32_t new_val) override;
+  void set_ic_scr_key_valid(bool valid) override;
+  void notify_dside_access(const DSideAccessInfo &access_info) override;
+  void set_iside_error(uint32_t addr) override;
+  const std::vector<std::string> &get_errors() override;
+  void clear_errors() override;
+  unsigned int get_insn_cnt() override;
+
+ private:
+  enum Op {
+    kOpIllegal,
+    kOpLui,
+    kOpAuipc,
+    kOpJal,
+    kOpJalr,
+    kOpBeq,
+    kOpBne,
+    kOpBlt,
+    kOpBge,
+    kOpBltu,
+    kOpBgeu,
+    kOpLb,
+    kOpLh,
+    kOpLw,
+    kOpLbu,
+    kOpLhu,
+    kOpSb,
+    kOpSh,
+    kOpSw,
+    kOpAddi,
+    kOpSlti,
+    kOpSltiu,
+    kOpXori,
+    kOpOri,
+    kOpAndi,
+    kOpSlli,
+    kOpSrli,
+    kOpSrai,
+    kOpAdd,
+    kOpSub,
+    kOpSll,
+    kOpSlt,
+    kOpSltu,
+    kOpXor,
+    kOpSrl,
+    kOpSra,
+    kOpOr,
+    kOpAnd,
+    kOpMul,
+    kOpMulh,
+    kOpMulhsu,
+    kOpMulhu,
+    kOpDiv,
+    kOpDivu,
+    kOpRem,
+    kOpRemu,
+    kOpFence,
+    kOpEcall,
+    kOpEbreak,
+    kOpMret,
+    kOpWfi,
+    kOpCsrrw,
+    kOpCsrrs,
+    kOpCsrrc,
+    kOpCsrrwi,
+    kOpCsrrsi,
+    kOpCsrrci,
+  };
+
+  struct Insn {
+    Op op;
+    uint32_t rd;
+    uint32_t rs1;
+    uint32_t rs2;
+    uint32_t imm;
+    uint32_t bits;
+    uint32_t len;
+  };
+
+  enum MemAttr {
+    kMemAttrReadOnly = 1 << 0,
+    kMemAttrNoExec = 1 << 1,
+  };
+
+  struct Memory {
+    uint32_t base;
+    std::vector<uint8_t> data;
+    // Per byte `MemAttr` flags.
+    std::vector<uint8_t> attrs;
+  };
+
+  struct MemPart {
+    uint32_t addr;
+    uint32_t be;
+    uint32_t offset;
+    uint32_t len;
+  };
+
+  static Insn decode(uint32_t bits);
+  static Insn decode_compressed(uint32_t bits);
+
+  Memory *find_memory(uint32_t addr, size_t len);
+  void set_attr(uint32_t base_addr, size_t size, uint8_t attr);
+  bool fetch_half(uint32_t addr, uint16_t &half);
+  bool fetch(Insn &insn);
+  void execute(const Insn &insn, bool dut_sync_trap, uint32_t dut_write_reg,
+               uint32_t dut_write_reg_data);
+  bool load(uint32_t addr, uint32_t len, uint32_t &value);
+  bool store(uint32_t addr, uint32_t len, uint32_t value);
+  bool match_dside_access(bool store, const MemPart &part,
+                          DSideAccessInfo &access);
+  void csr_op(const Insn &insn, uint32_t src, bool write, bool dut_sync_trap,
+              uint32_t dut_write_reg, uint32_t dut_write_reg_data);
+  bool csr_read(uint32_t csr, uint32_t &value);
+  void csr_write(uint32_t csr, uint32_t value);
+  uint32_t read_mcause() const;
+
+  void write_reg(uint32_t reg, uint32_t value);
+  void raise_exception(uint32_t cause, uint32_t tval);
+  void take_trap(uint32_t cause, uint32_t tval, uint32_t epc);
+  bool take_pending_interrupt();
+  void error(const std::string &msg);
+
+  std::vector<Memory> mems_;
+  std::deque<DSideAccessInfo> pending_dside_accesses_;
+  bool pending_iside_error_;
+  uint32_t pending_iside_err_addr_;
+  std::vector<std::string> errors_;
+  unsigned int insn_cnt_;
+
+  // Architectural state
+  uint32_t regs_[32];
+  uint32_t pc_;
+  uint32_t priv_;
+  uint32_t mstatus_;
+  uint32_t mie_;
+  uint32_t mip_;
+  uint32_t mtvec_;
+  uint32_t mscratch_;
+  uint32_t mepc_;
+  uint32_t mcause_;
+  uint32_t mtval_;
+
+  // Interrupt and NMI inputs
+  uint32_t pre_mip_;
+  uint32_t post_mip_;
+  bool nmi_;
+  bool nmi_int_;
+  bool nmi_mode_;
+
+  // Per step results
+  bool exception_;
+  uint32_t exception_cause_;
+  uint32_t exception_tval_;
+  bool reg_written_;
+  uint32_t reg_written_idx_;
+  uint32_t reg_written_data_;
+  uint32_t next_pc_;
+};
+
+#endif  // OPENTITAN_PLAYGROUND_SECURE_BOOT_V0_TB_RV32_COSIM_H_
@@ -0,0 +1,98 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// DPI entry points creating the lockstep co-simulation model checked by
+// secure_boot_cosim_checker.
+//
+// By default the built-in RV32IMC reference model (Rv32Cosim) is used. Build
+// with SECURE_BOOT_SPIKE_COSIM defined (see the sim_cosim_spike target) to
+// check against the Ibex fork of Spike instead.
+
+#include <svdpi.h>
+
+#include <cassert>
+
+#include "cosim.h"
+#include "rv32_cosim.h"
+#ifdef SECURE_BOOT_SPIKE_COSIM
+#include "spike_cosim.h"
+#endif
+
+namespace {
+
+#ifdef SECURE_BOOT_SPIKE_COSIM
+// Parameters of the ibex_top instance in top.sv
+constexpr uint32_t kDmStartAddr = 0x1A110000;
+constexpr uint32_t kDmEndAddr = 0x1A111000;
+constexpr uint32_t kMhpmCounterNum = 10;
+
+// UART window of the crossbar. Spike has no notion of MMIO so it is backed by
+// plain memory; software polling UART status registers will mismatch, use the
+// built-in model for such code.
+constexpr uint32_t kUartBase = 0x00030000;
+constexpr uint32_t kUartSize = 0x00010000;
+#endif
+
+// Use raw pointer as destruction outside main can cause segment fault (due to
+// undefined destruction order vs the Verilator model).
+Cosim *secure_boot_cosim = nullptr;
+
+}  // namespace
+
+extern "C" {
+void *secure_boot_cosim_create(const svBitVecVal *start_pc,
+                               const svBitVecVal *start_mtvec) {
+  assert(!secure_boot_cosim);
+
+#ifdef SECURE_BOOT_SPIKE_COSIM
+  secure_boot_cosim =
+      new SpikeCosim("rv32imc", start_pc[0], start_mtvec[0],
+                     "secure_boot_cosim.log", false, false, 0, 0,
+                     kMhpmCounterNum, kDmStartAddr, kDmEndAddr);
+  secure_boot_cosim->add_memory(kUartBase, kUartSize);
+#else
+  secure_boot_cosim = new Rv32Cosim(start_pc[0], start_mtvec[0]);
+#endif
+
+  return secure_boot_cosim;
+}
+
+void secure_boot_cosim_add_memory(void *cosim_handle, const svBitVecVal *base,
+                                  const svBitVecVal *size, svBit read_only,
+                                  svBit no_exec) {
+  Cosim *cosim = static_cast<Cosim *>(cosim_handle);
+  assert(cosim);
+
+  cosim->add_memory(base[0], size[0]);
+
+  // Only the built-in model distinguishes ROM and non-executable memories.
+  Rv32Cosim *rv32_cosim = dynamic_cast<Rv32Cosim *>(cosim);
+  if (rv32_cosim) {
+    if (read_only) {
+      rv32_cosim->set_read_only(base[0], size[0]);
+    }
+    if (no_exec) {
+      rv32_cosim->set_no_exec(base[0], size[0]);
+    }
+  }
+}
+
+void secure_boot_cosim_write_mem_word(void *cosim_handle,
+                                      const svBitVecVal *addr,
+                                      const svBitVecVal *data) {
+  Cosim *cosim = static_cast<Cosim *>(cosim_handle);
+  assert(cosim);
+
+  uint8_t bytes[4] = {(uint8_t)data[0], (uint8_t)(data[0] >> 8),
+                      (uint8_t)(data[0] >> 16), (uint8_t)(data[0] >> 24)};
+  cosim->backdoor_write_mem(addr[0], sizeof(bytes), bytes);
+}
+
+void secure_boot_cosim_destroy(void *cosim_handle) {
+  assert(cosim_handle == secure_boot_cosim);
+
+  delete secure_boot_cosim;
+  secure_boot_cosim = nullptr;
+}
+}
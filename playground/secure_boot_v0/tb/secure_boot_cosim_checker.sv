@@ -0,0 +1,168 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Lockstep co-simulation checker for secure_boot_v0.
+//
+// Every instruction retired on the RVFI port is stepped in the co-simulation
+// model (see secure_boot_cosim.cc) and every data bus transaction is passed on
+// via riscv_cosim_notify_dside_access. Simulation stops with $fatal at the
+// first divergence.
+//
+// Instantiated next to `dut` in top_tb, Ibex internals and the memory
+// contents are accessed hierarchically through it.
+module secure_boot_cosim_checker #(
+  parameter logic [31:0] BootAddr   = 32'h0000_0080,
+  parameter logic [31:0] RomBase    = 32'h0000_0000,
+  parameter logic [31:0] EsramBase  = 32'h0001_0000,
+  parameter logic [31:0] DmemBase   = 32'h0002_0000,
+  parameter int unsigned MemSize    = 32'h0001_0000
+) (
+  input logic        clk_i,
+  input logic        rst_ni,
+
+  // RVFI
+  input logic        rvfi_valid,
+  input logic        rvfi_trap,
+  input logic [4:0]  rvfi_rd_addr,
+  input logic [31:0] rvfi_rd_wdata,
+  input logic [31:0] rvfi_pc_rdata,
+  input logic [31:0] rvfi_ext_pre_mip,
+  input logic [31:0] rvfi_ext_post_mip,
+  input logic        rvfi_ext_nmi,
+  input logic        rvfi_ext_nmi_int,
+  input logic        rvfi_ext_debug_req,
+  input logic        rvfi_ext_rf_wr_suppress,
+  input logic [63:0] rvfi_ext_mcycle,
+  input logic [31:0] rvfi_ext_mhpmcounters [10],
+  input logic [31:0] rvfi_ext_mhpmcountersh [10],
+  input logic        rvfi_ext_ic_scr_key_valid,
+
+  // Ibex data interface
+  input logic        data_req,
+  input logic        data_gnt,
+  input logic        data_we,
+  input logic [31:0] data_addr,
+  input logic [3:0]  data_be,
+  input logic [31:0] data_wdata,
+  input logic        data_rvalid,
+  input logic [31:0] data_rdata,
+  input logic        data_err
+);
+  import "DPI-C" function chandle secure_boot_cosim_create(bit [31:0] start_pc,
+    bit [31:0] start_mtvec);
+  import "DPI-C" function void secure_boot_cosim_add_memory(chandle cosim_handle,
+    bit [31:0] base, bit [31:0] size, bit read_only, bit no_exec);
+  import "DPI-C" function void secure_boot_cosim_write_mem_word(chandle cosim_handle,
+    bit [31:0] addr, bit [31:0] data);
+  import "DPI-C" function void secure_boot_cosim_destroy(chandle cosim_handle);
+
+  import ibex_pkg::*;
+
+  localparam int unsigned MemWords = MemSize / 4;
+
+  chandle cosim_handle;
+  bit     mem_loaded;
+
+  initial begin
+    // Ibex resets mtvec to the 256 byte aligned boot address in vectored mode
+    cosim_handle = secure_boot_cosim_create(BootAddr, {BootAddr[31:8], 8'h01});
+    secure_boot_cosim_add_memory(cosim_handle, RomBase, MemSize, 1'b1, 1'b0);
+    secure_boot_cosim_add_memory(cosim_handle, EsramBase, MemSize, 1'b0, 1'b0);
+    // The D-SRAM adapter rejects instruction fetches
+    secure_boot_cosim_add_memory(cosim_handle, DmemBase, MemSize, 1'b0, 1'b1);
+  end
+
+  final begin
+    $display("[COSIM] Co-simulation matched %0d instructions",
+             riscv_cosim_get_insn_cnt(cosim_handle));
+    secure_boot_cosim_destroy(cosim_handle);
+  end
+
+  // Copy the memory images into the model once $readmemh has run, well before
+  // the first instruction retires.
+  always @(posedge clk_i) begin
+    if (rst_ni && !mem_loaded) begin
+      for (int unsigned i = 0; i < MemWords; i++) begin
+        secure_boot_cosim_write_mem_word(cosim_handle, RomBase + 4 * i, dut.u_imem.mem[i]);
+        secure_boot_cosim_write_mem_word(cosim_handle, EsramBase + 4 * i, dut.u_esram.mem[i]);
+        secure_boot_cosim_write_mem_word(cosim_handle, DmemBase + 4 * i, dut.u_dmem.mem[i]);
+      end
+      mem_loaded = 1'b1;
+    end
+  end
+
+  always @(posedge clk_i) begin
+    if (rvfi_valid) begin
+      riscv_cosim_set_nmi(cosim_handle, rvfi_ext_nmi);
+      riscv_cosim_set_nmi_int(cosim_handle, rvfi_ext_nmi_int);
+      riscv_cosim_set_mip(cosim_handle, rvfi_ext_pre_mip, rvfi_ext_post_mip);
+      riscv_cosim_set_debug_req(cosim_handle, rvfi_ext_debug_req);
+      riscv_cosim_set_mcycle(cosim_handle, rvfi_ext_mcycle);
+      for (int i = 0; i < 10; i++) begin
+        riscv_cosim_set_csr(cosim_handle, int'(CSR_MHPMCOUNTER3) + i,
+          rvfi_ext_mhpmcounters[i]);
+        riscv_cosim_set_csr(cosim_handle, int'(CSR_MHPMCOUNTER3H) + i,
+          rvfi_ext_mhpmcountersh[i]);
+      end
+      riscv_cosim_set_ic_scr_key_valid(cosim_handle, rvfi_ext_ic_scr_key_valid);
+
+      if (riscv_cosim_step(cosim_handle, rvfi_rd_addr, rvfi_rd_wdata, rvfi_pc_rdata, rvfi_trap,
+                           rvfi_ext_rf_wr_suppress) == 0)
+      begin
+        $display("[COSIM] FAILURE: Co-simulation mismatch at time %t", $time());
+        for (int i = 0; i < riscv_cosim_get_num_errors(cosim_handle); ++i) begin
+          $display("[COSIM] %s", riscv_cosim_get_error(cosim_handle, i));
+        end
+        riscv_cosim_clear_errors(cosim_handle);
+
+        $fatal(1, "Co-simulation mismatch seen");
+      end
+    end
+  end
+
+  // Record each data request when granted and notify the model once its
+  // response comes back.
+  logic        outstanding_store;
+  logic [31:0] outstanding_addr;
+  logic [3:0]  outstanding_be;
+  logic [31:0] outstanding_store_data;
+  logic        outstanding_misaligned_first;
+  logic        outstanding_misaligned_second;
+  logic        outstanding_misaligned_first_saw_error;
+  logic        outstanding_m_mode_access;
+
+  always @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      outstanding_store <= 1'b0;
+    end else begin
+      if (data_req && data_gnt) begin
+        outstanding_store      <= data_we;
+        outstanding_addr       <= data_addr;
+        outstanding_be         <= data_be;
+        outstanding_store_data <= data_wdata;
+        outstanding_misaligned_first <=
+          dut.u_ibex.u_ibex_core.load_store_unit_i.handle_misaligned_d |
+          ((dut.u_ibex.u_ibex_core.load_store_unit_i.lsu_type_i == 2'b01) &
+           (dut.u_ibex.u_ibex_core.load_store_unit_i.data_offset == 2'b01));
+
+        outstanding_misaligned_second <=
+          dut.u_ibex.u_ibex_core.load_store_unit_i.addr_incr_req_o;
+
+        outstanding_misaligned_first_saw_error <=
+          dut.u_ibex.u_ibex_core.load_store_unit_i.addr_incr_req_o &
+          dut.u_ibex.u_ibex_core.load_store_unit_i.lsu_err_d;
+
+        outstanding_m_mode_access <=
+          dut.u_ibex.u_ibex_core.priv_mode_lsu == ibex_pkg::PRIV_LVL_M;
+      end
+
+      if (data_rvalid) begin
+        riscv_cosim_notify_dside_access(cosim_handle, outstanding_store, outstanding_addr,
+          outstanding_store ? outstanding_store_data : data_rdata, outstanding_be,
+          data_err, outstanding_misaligned_first, outstanding_misaligned_second,
+          outstanding_misaligned_first_saw_error, outstanding_m_mode_access);
+      end
+    end
+  end
+endmodule
@@ -0,0 +1,143 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Per boot stage Ibex performance counter report.
+//
+// top_tb calls `secure_boot_pcount_stage` when execution enters a boot stage
+// (ROM, ROM_EXT, BL0) and `secure_boot_pcount_report` from a final block. The
+// counters are snapshotted at each boundary and the per stage deltas are
+// written as CSV, or as JSON if the output file name ends in `.json`. The
+// output file defaults to `secure_boot_pcounts.csv` and can be changed with
+// `+pcount_file=<path>`.
+
+#include <svdpi.h>
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "ibex_pcounts.h"
+#include "verilated.h"
+
+extern "C" {
+extern unsigned int mhpmcounter_num();
+extern unsigned long long mhpmcounter_get(int index);
+}
+
+namespace {
+
+struct StageSnapshot {
+  std::string name;
+  uint32_t entry_pc;
+  std::vector<uint64_t> counters;
+};
+
+std::vector<StageSnapshot> stages;
+
+// Index 1 is the unused "NONE" slot, see ibex_pcounts.cc.
+bool counter_present(unsigned int index) {
+  return index != 1 && index < mhpmcounter_num();
+}
+
+std::vector<uint64_t> read_counters() {
+  std::vector<uint64_t> counters(ibex_counter_names.size(), 0);
+  for (unsigned int i = 0; i < counters.size(); ++i) {
+    if (counter_present(i)) {
+      counters[i] = mhpmcounter_get(i);
+    }
+  }
+  return counters;
+}
+
+bool ends_with(const std::string &s, const char *suffix) {
+  size_t len = strlen(suffix);
+  return s.size() >= len && s.compare(s.size() - len, len, suffix) == 0;
+}
+
+void write_csv(FILE *f, const std::vector<uint64_t> &end) {
+  fprintf(f, "Stage,Entry PC");
+  for (unsigned int i = 0; i < ibex_counter_names.size(); ++i) {
+    if (counter_present(i)) {
+      fprintf(f, ",%s", ibex_counter_names[i].c_str());
+    }
+  }
+  fprintf(f, "\n");
+
+  for (size_t s = 0; s < stages.size(); ++s) {
+    const std::vector<uint64_t> &next =
+        s + 1 < stages.size() ? stages[s + 1].counters : end;
+    fprintf(f, "%s,0x%08" PRIx32, stages[s].name.c_str(), stages[s].entry_pc);
+    for (unsigned int i = 0; i < ibex_counter_names.size(); ++i) {
+      if (counter_present(i)) {
+        fprintf(f, ",%" PRIu64, next[i] - stages[s].counters[i]);
+      }
+    }
+    fprintf(f, "\n");
+  }
+}
+
+void write_json(FILE *f, const std::vector<uint64_t> &end) {
+  fprintf(f, "{\n  \"stages\": [");
+  for (size_t s = 0; s < stages.size(); ++s) {
+    const std::vector<uint64_t> &next =
+        s + 1 < stages.size() ? stages[s + 1].counters : end;
+    fprintf(f, "%s\n    {\n", s ? "," : "");
+    fprintf(f, "      \"stage\": \"%s\",\n", stages[s].name.c_str());
+    fprintf(f, "      \"entry_pc\": \"0x%08" PRIx32 "\",\n",
+            stages[s].entry_pc);
+    fprintf(f, "      \"counters\": {");
+    bool first = true;
+    for (unsigned int i = 0; i < ibex_counter_names.size(); ++i) {
+      if (counter_present(i)) {
+        fprintf(f, "%s\n        \"%s\": %" PRIu64, first ? "" : ",",
+                ibex_counter_names[i].c_str(),
+                next[i] - stages[s].counters[i]);
+        first = false;
+      }
+    }
+    fprintf(f, "\n      }\n    }");
+  }
+  fprintf(f, "\n  ]\n}\n");
+}
+
+}  // namespace
+
+extern "C" {
+void secure_boot_pcount_stage(const char *name, const svBitVecVal *pc) {
+  stages.push_back({name, pc[0], read_counters()});
+  VL_PRINTF("[PCOUNT] Entering %s at pc=0x%08x, cycle %" PRIu64 "\n", name,
+            pc[0], stages.back().counters[0]);
+}
+
+void secure_boot_pcount_report() {
+  if (stages.empty()) {
+    return;
+  }
+
+  std::string path = "secure_boot_pcounts.csv";
+  const char *arg = Verilated::commandArgsPlusMatch("pcount_file=");
+  if (arg && arg[0]) {
+    path = strchr(arg, '=') + 1;
+  }
+
+  FILE *f = fopen(path.c_str(), "w");
+  if (!f) {
+    VL_PRINTF("[PCOUNT] Unable to open %s\n", path.c_str());
+    return;
+  }
+
+  std::vector<uint64_t> end = read_counters();
+  if (ends_with(path, ".json")) {
+    write_json(f, end);
+  } else {
+    write_csv(f, end);
+  }
+  fclose(f);
+
+  VL_PRINTF("[PCOUNT] Per stage performance counters written to %s\n",
+            path.c_str());
+}
+}
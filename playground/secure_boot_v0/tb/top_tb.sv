@@ -439,6 +439,91 @@ module top_tb(
       end
     end
   end
+
+  // Per boot stage performance counters, see secure_boot_pcounts.cc. A stage
+  // starts at the first retirement from its entry PC; the defaults follow the
+  // sw/ image layout (ROM_EXT at EXEC_BASE, BL0 at EXEC_BASE + 0x2000) and can
+  // be overridden with +rom_ext_entry=<hex> and +bl0_entry=<hex>.
+  import "DPI-C" context function void secure_boot_pcount_stage(string name,
+    bit [31:0] pc);
+  import "DPI-C" context function void secure_boot_pcount_report();
+
+  export "DPI-C" function mhpmcounter_num;
+  export "DPI-C" function mhpmcounter_get;
+
+  // Number of counter indices (mcycle, the unused mtime slot, minstret and
+  // the mhpmcounters) as expected by ibex_pcounts.cc.
+  function automatic int unsigned mhpmcounter_num();
+    return 3 + dut.u_ibex.u_ibex_core.cs_registers_i.MHPMCounterNum;
+  endfunction
+
+  function automatic longint unsigned mhpmcounter_get(int index);
+    return dut.u_ibex.u_ibex_core.cs_registers_i.mhpmcounter[index];
+  endfunction
+
+  logic [31:0] rom_ext_entry = 32'h0001_0000;
+  logic [31:0] bl0_entry     = 32'h0001_2000;
+  initial begin
+    void'($value$plusargs("rom_ext_entry=%h", rom_ext_entry));
+    void'($value$plusargs("bl0_entry=%h", bl0_entry));
+  end
+
+  typedef enum logic [1:0] {STAGE_RESET, STAGE_ROM, STAGE_ROM_EXT, STAGE_BL0} boot_stage_e;
+  boot_stage_e boot_stage;
+
+  always_ff @(posedge clk) begin
+    if (!rst_n) begin
+      boot_stage <= STAGE_RESET;
+    end else if (rvfi_valid) begin
+      if (boot_stage == STAGE_RESET) begin
+        secure_boot_pcount_stage("ROM", rvfi_pc_rdata);
+        boot_stage <= STAGE_ROM;
+      end else if (boot_stage == STAGE_ROM && rvfi_pc_rdata == rom_ext_entry) begin
+        secure_boot_pcount_stage("ROM_EXT", rvfi_pc_rdata);
+        boot_stage <= STAGE_ROM_EXT;
+      end else if (boot_stage == STAGE_ROM_EXT && rvfi_pc_rdata == bl0_entry) begin
+        secure_boot_pcount_stage("BL0", rvfi_pc_rdata);
+        boot_stage <= STAGE_BL0;
+      end
+    end
+  end
+
+  final secure_boot_pcount_report();
+
+`ifdef COSIM
+  // Lockstep co-simulation against a reference model, see
+  // secure_boot_cosim_checker.sv
+  secure_boot_cosim_checker u_cosim_checker (
+    .clk_i                     (clk),
+    .rst_ni                    (rst_n),
+
+    .rvfi_valid                (rvfi_valid),
+    .rvfi_trap                 (rvfi_trap),
+    .rvfi_rd_addr              (rvfi_rd_addr),
+    .rvfi_rd_wdata             (rvfi_rd_wdata),
+    .rvfi_pc_rdata             (rvfi_pc_rdata),
+    .rvfi_ext_pre_mip          (rvfi_ext_pre_mip),
+    .rvfi_ext_post_mip         (rvfi_ext_post_mip),
+    .rvfi_ext_nmi              (rvfi_ext_nmi),
+    .rvfi_ext_nmi_int          (rvfi_ext_nmi_int),
+    .rvfi_ext_debug_req        (rvfi_ext_debug_req),
+    .rvfi_ext_rf_wr_suppress   (rvfi_ext_rf_wr_suppress),
+    .rvfi_ext_mcycle           (rvfi_ext_mcycle),
+    .rvfi_ext_mhpmcounters     (rvfi_ext_mhpmcounters),
+    .rvfi_ext_mhpmcountersh    (rvfi_ext_mhpmcountersh),
+    .rvfi_ext_ic_scr_key_valid (rvfi_ext_ic_scr_key_valid),
+
+    .data_req                  (dut.data_req),
+    .data_gnt                  (dut.data_gnt),
+    .data_we                   (dut.data_we),
+    .data_addr                 (dut.data_addr),
+    .data_be                   (dut.data_be),
+    .data_wdata                (dut.data_wdata),
+    .data_rvalid               (dut.data_rvalid),
+    .data_rdata                (dut.data_rdata),
+    .data_err                  (dut.data_err)
+  );
+`endif
 `endif
 
 //   // Monitor UART TL host requests
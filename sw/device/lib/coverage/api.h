@@ -25,6 +25,8 @@ void coverage_init(void);
  *
  * If the coverage data is valid, it compresses the counter data and sends the
  * report.
+ * If `coverage_flush()` was called before, the report only carries the
+ * coverage collected since the last flush.
  *
  * The function is usually called from shutdown hooks (e.g., shutdown_finalize),
  * before boot stage handoff, or at the end of a test.
@@ -33,6 +35,26 @@ void coverage_init(void);
  */
 void coverage_report(void);
 
+/**
+ * Streams the coverage collected since the previous flush.
+ *
+ * If the coverage data is valid, it sends a report of the counters covered
+ * since the previous flush and marks them as uncovered again, so that each
+ * flush only carries new coverage. Host tools merge the reports of a run.
+ *
+ * The function is usually called periodically by long-running tests so that
+ * coverage is not lost if the test hangs or crashes before
+ * `coverage_report()`.
+ *
+ * Streaming is opt-in with `--define ot_coverage_stream=true`, since it leaves
+ * only the coverage since the last flush in the counters for backdoor readers
+ * such as the Verilator coverage dumper. Without it, this function is no-op
+ * and the counters keep the coverage of the whole run.
+ *
+ * This function is no-op in non-coverage builds.
+ */
+void coverage_flush(void);
+
 /**
  * Invalidates the coverage data.
  *
@@ -52,6 +74,9 @@ void coverage_invalidate(void);
 #define coverage_report(...) \
   do {                       \
   } while (0)
+#define coverage_flush(...) \
+  do {                      \
+  } while (0)
 #define coverage_invalidate(...) \
   do {                           \
   } while (0)
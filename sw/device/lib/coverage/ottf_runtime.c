@@ -25,6 +25,16 @@ void coverage_report(void) {
   }
 }
 
+void coverage_flush(void) {
+#ifdef OT_COVERAGE_STREAM
+  if (coverage_is_valid()) {
+    base_printf("== COVERAGE PROFILE START ==\r\n");
+    coverage_printer_run_delta();
+    base_printf("== COVERAGE PROFILE END ==\r\n");
+  }
+#endif
+}
+
 void coverage_printer_sink(const void *data, size_t size) {
   for (size_t i = 0; i < size; ++i) {
     base_printf("%02x", ((uint8_t *)data)[i]);
@@ -14,4 +14,6 @@ void coverage_init(void) {}
 
 void coverage_report(void) { base_printf("== COVERAGE PROFILE SKIP ==\r\n"); }
 
+void coverage_flush(void) {}
+
 void coverage_invalidate(void) {}
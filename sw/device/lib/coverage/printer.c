@@ -81,7 +81,19 @@ void coverage_compress_rle(uint8_t tag, uint32_t size) {
   }
 }
 
-void coverage_compress(unsigned char *data, size_t size) {
+/**
+ * Marks the given counters as uncovered.
+ *
+ * @param data Counters to reset.
+ * @param size Number of counters.
+ */
+static void coverage_reset(unsigned char *data, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = 0xff;
+  }
+}
+
+void coverage_compress(unsigned char *data, size_t size, bool reset) {
   size_t i = 0;
 
   // assumption: `coverage_is_valid` checks all bytes are either 0x00 or 0xff.
@@ -100,9 +112,17 @@ void coverage_compress(unsigned char *data, size_t size) {
       for (uint8_t k = 0; k < 8; ++k) {
         packed_byte |= ((data[start + k] + 1) << k);
       }
-      coverage_printer_sink_with_crc(&packed_byte, 1);
       i = start + 8;
+      // Counters are reset before they are sent so that coverage hit by the
+      // sink itself is kept for the next report.
+      if (reset) {
+        coverage_reset(&data[start], 8);
+      }
+      coverage_printer_sink_with_crc(&packed_byte, 1);
     } else {
+      if (reset) {
+        coverage_reset(&data[start], span_size);
+      }
       coverage_compress_rle(tag, span_size);
     }
   }
@@ -122,7 +142,12 @@ void coverage_init(void) {
   }
 }
 
-void coverage_printer_run(void) {
+/**
+ * Sends a profile report of the counters, optionally resetting them.
+ *
+ * @param reset Whether to mark the counters as uncovered while sending them.
+ */
+static void coverage_printer_run_impl(bool reset) {
   crc32_init(&coverage_crc);
 
   const uint64_t magic = kFileMagic;
@@ -132,12 +157,16 @@ void coverage_printer_run(void) {
   size_t cnts_size =
       (size_t)__llvm_prf_cnts_end - (size_t)__llvm_prf_cnts_start;
   uint8_t *cnts = (uint8_t *)__llvm_prf_cnts_start;
-  coverage_compress(cnts, cnts_size);
+  coverage_compress(cnts, cnts_size, reset);
 
   coverage_crc = crc32_finish(&coverage_crc);
   coverage_printer_sink(&coverage_crc, sizeof(coverage_crc));
 }
 
+void coverage_printer_run(void) { coverage_printer_run_impl(false); }
+
+void coverage_printer_run_delta(void) { coverage_printer_run_impl(true); }
+
 void coverage_invalidate(void) { coverage_status = 0x42; }
 
 bool coverage_is_valid(void) {
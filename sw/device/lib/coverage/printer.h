@@ -65,6 +65,18 @@ extern void coverage_printer_sink(const void *data, size_t size);
  */
 void coverage_printer_run(void);
 
+/**
+ * @brief Sends the counters covered since the previous delta report and marks
+ * them as uncovered again.
+ *
+ * The report has the same format as the one sent by `coverage_printer_run()`.
+ * Since coverage counters only ever go from uncovered to covered, the full
+ * coverage of a run is the union of all delta reports and the final report,
+ * which lets long-running tests stream their coverage in small increments
+ * instead of risking all of it on a single report at the end.
+ */
+void coverage_printer_run_delta(void);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
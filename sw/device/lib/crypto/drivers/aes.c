@@ -335,6 +335,51 @@ status_t aes_update(aes_block_t *dest, const aes_block_t *src) {
   return OTCRYPTO_OK;
 }
 
+status_t aes_update_blocks(aes_block_t *dest, const aes_block_t *src,
+                           size_t num_blocks) {
+  if (num_blocks == 0) {
+    return OTCRYPTO_OK;
+  }
+  if (dest == NULL || src == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  uint32_t data_in = aes_base() + AES_DATA_IN_0_REG_OFFSET;
+  uint32_t data_out = aes_base() + AES_DATA_OUT_0_REG_OFFSET;
+
+  // Up to three blocks are in flight: one waiting in the output registers,
+  // one in the cipher core and one waiting in the input registers. Reading an
+  // output block does not consume the input registers, so a single status
+  // read serves both directions.
+  size_t num_in = 0;
+  size_t num_out = 0;
+  while (launder32(num_out) < num_blocks) {
+    uint32_t reg = abs_mmio_read32(aes_base() + AES_STATUS_REG_OFFSET);
+    if (bitfield_bit32_read(reg, AES_STATUS_ALERT_RECOV_CTRL_UPDATE_ERR_BIT) ||
+        bitfield_bit32_read(reg, AES_STATUS_ALERT_FATAL_FAULT_BIT)) {
+      return OTCRYPTO_RECOV_ERR;
+    }
+    if (num_out < num_in &&
+        bitfield_bit32_read(reg, AES_STATUS_OUTPUT_VALID_BIT)) {
+      HARDENED_TRY(hardened_memcpy(dest[num_out].data,
+                                   (const uint32_t *)data_out,
+                                   kAesBlockNumWords));
+      ++num_out;
+    }
+    if (num_in < num_blocks &&
+        bitfield_bit32_read(reg, AES_STATUS_INPUT_READY_BIT)) {
+      HARDENED_TRY(hardened_memcpy((uint32_t *)data_in, src[num_in].data,
+                                   kAesBlockNumWords));
+      ++num_in;
+    }
+  }
+  // Check that the loop ran for the correct number of iterations.
+  HARDENED_CHECK_EQ(num_in, num_blocks);
+  HARDENED_CHECK_EQ(num_out, num_blocks);
+
+  return OTCRYPTO_OK;
+}
+
 status_t aes_end(aes_block_t *iv) {
   uint32_t ctrl_reg = AES_CTRL_SHADOWED_REG_RESVAL;
   ctrl_reg = bitfield_bit32_write(ctrl_reg,
@@ -363,6 +408,208 @@ status_t aes_end(aes_block_t *iv) {
   return spin_until(AES_STATUS_IDLE_BIT);
 }
 
+status_t aes_gcm_hw_supported(hardened_bool_t *supported) {
+  HARDENED_TRY(spin_until(AES_STATUS_IDLE_BIT));
+
+  // Select GCM in manual operation so that nothing is started. If GCM support
+  // was disabled at compile time, the mode reads back as AES_NONE.
+  uint32_t ctrl_reg = AES_CTRL_SHADOWED_REG_RESVAL;
+  ctrl_reg = bitfield_field32_write(ctrl_reg, AES_CTRL_SHADOWED_MODE_FIELD,
+                                    AES_CTRL_SHADOWED_MODE_VALUE_AES_GCM);
+  ctrl_reg = bitfield_bit32_write(ctrl_reg,
+                                  AES_CTRL_SHADOWED_MANUAL_OPERATION_BIT, true);
+  abs_mmio_write32_shadowed(aes_base() + AES_CTRL_SHADOWED_REG_OFFSET,
+                            ctrl_reg);
+  uint32_t mode = bitfield_field32_read(
+      abs_mmio_read32(aes_base() + AES_CTRL_SHADOWED_REG_OFFSET),
+      AES_CTRL_SHADOWED_MODE_FIELD);
+  *supported = mode == AES_CTRL_SHADOWED_MODE_VALUE_AES_GCM
+                   ? kHardenedBoolTrue
+                   : kHardenedBoolFalse;
+
+  // Restore the configuration that `aes_end` leaves behind.
+  ctrl_reg = bitfield_bit32_write(AES_CTRL_SHADOWED_REG_RESVAL,
+                                  AES_CTRL_SHADOWED_MANUAL_OPERATION_BIT, true);
+  abs_mmio_write32_shadowed(aes_base() + AES_CTRL_SHADOWED_REG_OFFSET,
+                            ctrl_reg);
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Select the GCM phase and the number of valid bytes of the next block.
+ *
+ * The GCM control register can only be written while the AES block is idle,
+ * so this waits for all previous blocks to be processed.
+ *
+ * @param phase Hardware encoding of the GCM phase.
+ * @param num_valid_bytes Number of valid bytes in the next block (1 to 16).
+ * @return result, OK or error.
+ */
+static status_t gcm_set_phase(uint32_t phase, size_t num_valid_bytes) {
+  HARDENED_TRY(spin_until(AES_STATUS_IDLE_BIT));
+
+  uint32_t reg = bitfield_field32_write(
+      0, AES_CTRL_GCM_SHADOWED_NUM_VALID_BYTES_FIELD, num_valid_bytes);
+  reg = bitfield_field32_write(reg, AES_CTRL_GCM_SHADOWED_PHASE_FIELD, phase);
+  abs_mmio_write32_shadowed(aes_base() + AES_CTRL_GCM_SHADOWED_REG_OFFSET,
+                            reg);
+
+  // Read back the GCM configuration and compare to the expected configuration.
+  HARDENED_CHECK_EQ(
+      abs_mmio_read32(aes_base() + AES_CTRL_GCM_SHADOWED_REG_OFFSET),
+      launder32(reg));
+  return OTCRYPTO_OK;
+}
+
+status_t aes_gcm_hw_begin(const aes_key_t key, const uint32_t *iv,
+                          hardened_bool_t encrypt) {
+  if (iv == NULL || launder32(key.mode) != kAesCipherModeCtr) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(key.mode, kAesCipherModeCtr);
+
+  // Ensure the entropy complex is in an appropriate state. The AES block seeds
+  // its PRNG from EDN for masking every time a new key is provided.
+  HARDENED_TRY(entropy_complex_check());
+
+  // Wait for the AES block to be idle.
+  HARDENED_TRY(spin_until(AES_STATUS_IDLE_BIT));
+
+  // AES-GCM keys are CTR keys; replace the mode once the rest of the
+  // configuration has been checked.
+  uint32_t ctrl_reg;
+  HARDENED_TRY(compute_ctrl_reg(key, encrypt, &ctrl_reg));
+  ctrl_reg = bitfield_field32_write(ctrl_reg, AES_CTRL_SHADOWED_MODE_FIELD,
+                                    AES_CTRL_SHADOWED_MODE_VALUE_AES_GCM);
+
+  abs_mmio_write32_shadowed(aes_base() + AES_CTRL_SHADOWED_REG_OFFSET,
+                            ctrl_reg);
+  HARDENED_TRY(spin_until(AES_STATUS_IDLE_BIT));
+
+  // Put AES-GCM into the init phase, in which the hardware derives the hash
+  // subkey and the encrypted initial counter block from the key and IV.
+  HARDENED_TRY(gcm_set_phase(AES_CTRL_GCM_SHADOWED_PHASE_VALUE_GCM_INIT,
+                             kAesBlockNumBytes));
+
+  // Write the key (if it is not sideloaded). This waits for the PRNG reseed
+  // triggered by the new key, after which the IV can be written.
+  HARDENED_TRY(aes_write_key(key));
+
+  // The hardware appends the 32-bit counter to the 96-bit IV itself.
+  uint32_t iv_offset = aes_base() + AES_IV_0_REG_OFFSET;
+  size_t i;
+  for (i = 0; launder32(i) < kAesBlockNumWords - 1; ++i) {
+    abs_mmio_write32(iv_offset + i * sizeof(uint32_t), iv[i]);
+  }
+  HARDENED_CHECK_EQ(i, kAesBlockNumWords - 1);
+  abs_mmio_write32(iv_offset + i * sizeof(uint32_t), 0);
+
+  // Read back the AES configuration and compare to the expected configuration.
+  HARDENED_CHECK_EQ(abs_mmio_read32(aes_base() + AES_CTRL_SHADOWED_REG_OFFSET),
+                    launder32(ctrl_reg));
+  return OTCRYPTO_OK;
+}
+
+status_t aes_gcm_hw_aad(size_t aad_len, const uint8_t *aad) {
+  if (aad_len == 0) {
+    return OTCRYPTO_OK;
+  }
+  if (aad == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Full blocks of associated data produce no output, so they can be written
+  // back to back.
+  aes_block_t block;
+  if (aad_len >= kAesBlockNumBytes) {
+    HARDENED_TRY(gcm_set_phase(AES_CTRL_GCM_SHADOWED_PHASE_VALUE_GCM_AAD,
+                               kAesBlockNumBytes));
+    for (; aad_len >= kAesBlockNumBytes; aad_len -= kAesBlockNumBytes) {
+      HARDENED_TRY(randomized_bytecopy(block.data, aad, kAesBlockNumBytes));
+      HARDENED_TRY(aes_update(/*dest=*/NULL, &block));
+      aad += kAesBlockNumBytes;
+    }
+  }
+
+  // The last partial block is zero-padded and marked as partially valid.
+  if (aad_len > 0) {
+    HARDENED_TRY(
+        gcm_set_phase(AES_CTRL_GCM_SHADOWED_PHASE_VALUE_GCM_AAD, aad_len));
+    memset(block.data, 0, kAesBlockNumBytes);
+    HARDENED_TRY(randomized_bytecopy(block.data, aad, aad_len));
+    HARDENED_TRY(aes_update(/*dest=*/NULL, &block));
+  }
+  return OTCRYPTO_OK;
+}
+
+status_t aes_gcm_hw_text(size_t len, const uint8_t *input, uint8_t *output) {
+  if (len == 0) {
+    return OTCRYPTO_OK;
+  }
+  if (input == NULL || output == NULL) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  aes_block_t block_in;
+  aes_block_t block_out;
+  size_t num_blocks = len / kAesBlockNumBytes;
+  if (num_blocks > 0) {
+    HARDENED_TRY(gcm_set_phase(AES_CTRL_GCM_SHADOWED_PHASE_VALUE_GCM_TEXT,
+                               kAesBlockNumBytes));
+
+    // Keep one block in flight: the next input is loaded before the previous
+    // output is read back.
+    HARDENED_TRY(randomized_bytecopy(block_in.data, input, kAesBlockNumBytes));
+    HARDENED_TRY(aes_update(/*dest=*/NULL, &block_in));
+    input += kAesBlockNumBytes;
+    for (size_t i = 1; i < num_blocks; ++i) {
+      HARDENED_TRY(
+          randomized_bytecopy(block_in.data, input, kAesBlockNumBytes));
+      HARDENED_TRY(aes_update(&block_out, &block_in));
+      HARDENED_TRY(
+          randomized_bytecopy(output, block_out.data, kAesBlockNumBytes));
+      input += kAesBlockNumBytes;
+      output += kAesBlockNumBytes;
+    }
+    HARDENED_TRY(aes_update(&block_out, /*src=*/NULL));
+    HARDENED_TRY(
+        randomized_bytecopy(output, block_out.data, kAesBlockNumBytes));
+    output += kAesBlockNumBytes;
+  }
+
+  // The last partial block is zero-padded and marked as partially valid; the
+  // hardware excludes the padding from the tag.
+  size_t partial_len = len % kAesBlockNumBytes;
+  if (partial_len > 0) {
+    HARDENED_TRY(gcm_set_phase(AES_CTRL_GCM_SHADOWED_PHASE_VALUE_GCM_TEXT,
+                               partial_len));
+    memset(block_in.data, 0, kAesBlockNumBytes);
+    HARDENED_TRY(randomized_bytecopy(block_in.data, input, partial_len));
+    HARDENED_TRY(aes_update(/*dest=*/NULL, &block_in));
+    HARDENED_TRY(aes_update(&block_out, /*src=*/NULL));
+    HARDENED_TRY(randomized_bytecopy(output, block_out.data, partial_len));
+  }
+  return OTCRYPTO_OK;
+}
+
+status_t aes_gcm_hw_tag(size_t aad_len, size_t text_len, aes_block_t *tag) {
+  HARDENED_TRY(gcm_set_phase(AES_CTRL_GCM_SHADOWED_PHASE_VALUE_GCM_TAG,
+                             kAesBlockNumBytes));
+
+  // The final GHASH block is len64(A) || len64(C), with the lengths in bits
+  // as big-endian integers.
+  uint64_t aad_bits = ((uint64_t)aad_len) * 8;
+  uint64_t text_bits = ((uint64_t)text_len) * 8;
+  aes_block_t len_block = {.data = {
+                               __builtin_bswap32((uint32_t)(aad_bits >> 32)),
+                               __builtin_bswap32((uint32_t)aad_bits),
+                               __builtin_bswap32((uint32_t)(text_bits >> 32)),
+                               __builtin_bswap32((uint32_t)text_bits),
+                           }};
+  HARDENED_TRY(aes_update(/*dest=*/NULL, &len_block));
+  return aes_update(tag, /*src=*/NULL);
+}
+
 uint32_t aes_key_integrity_checksum(const aes_key_t *key) {
   uint32_t ctx;
   crc32_init(&ctx);
@@ -161,6 +161,29 @@ status_t aes_decrypt_begin(const aes_key_t key, const aes_block_t *iv);
 OT_WARN_UNUSED_RESULT
 status_t aes_update(aes_block_t *dest, const aes_block_t *src);
 
+/**
+ * Streams a sequence of whole blocks through the AES hardware.
+ *
+ * Equivalent to feeding `src[0..num_blocks)` through `aes_update` and
+ * collecting all outputs in `dest`, but keeps both the input and output
+ * registers busy: each input block is written as soon as the hardware can
+ * accept it and each output block is read as soon as it is valid, with a
+ * single status read per step. Blocks are copied straight between the buffers
+ * and the hardware registers.
+ *
+ * Must be called with no blocks in flight (i.e. not between an
+ * `aes_update(NULL, src)` and the matching read), and returns with all output
+ * read. `dest` may be equal to `src`.
+ *
+ * @param[out] dest Output blocks.
+ * @param src Input blocks.
+ * @param num_blocks Number of blocks in `src` and `dest`.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t aes_update_blocks(aes_block_t *dest, const aes_block_t *src,
+                           size_t num_blocks);
+
 /**
  * Completes an AES session by clearing control settings and key material.
  *
@@ -173,6 +196,92 @@ status_t aes_update(aes_block_t *dest, const aes_block_t *src);
 OT_WARN_UNUSED_RESULT
 status_t aes_end(aes_block_t *iv);
 
+/**
+ * Checks whether the AES hardware supports Galois/Counter Mode.
+ *
+ * GCM support is a compile-time option of the AES block; if it was disabled,
+ * selecting the mode reads back as an invalid mode. Callers must fall back to
+ * a software implementation if this returns `kHardenedBoolFalse`.
+ *
+ * Must not be called while an AES operation is in progress.
+ *
+ * @param[out] supported Whether the hardware GCM mode is available.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t aes_gcm_hw_supported(hardened_bool_t *supported);
+
+/**
+ * Prepares the AES hardware to perform an AES-GCM operation.
+ *
+ * The hardware computes the hash subkey, the encrypted initial counter block
+ * and the GHASH of the message itself, so the key stays loaded for the whole
+ * message. Only 96-bit IVs are supported.
+ *
+ * AES-GCM keys are CTR keys, so `key.mode` must be `kAesCipherModeCtr`. If
+ * `key.sideload` is true, then this routine does not load the key; the caller
+ * must separately call keymgr to write the key into the AES block.
+ *
+ * Operation of the driver will look something like this:
+ * ```
+ * aes_gcm_hw_begin(...);
+ * aes_gcm_hw_aad(...);
+ * aes_gcm_hw_text(...);
+ * aes_gcm_hw_tag(...);
+ * aes_end(NULL);
+ * ```
+ *
+ * The caller must check `aes_gcm_hw_supported` first.
+ *
+ * @param key AES key.
+ * @param iv IV, 96 bits.
+ * @param encrypt True for encryption, false for decryption.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t aes_gcm_hw_begin(const aes_key_t key, const uint32_t *iv,
+                          hardened_bool_t encrypt);
+
+/**
+ * Feeds the associated data of an AES-GCM operation to the hardware.
+ *
+ * Must be called at most once per operation, before `aes_gcm_hw_text`.
+ *
+ * @param aad_len Length of the associated data in bytes.
+ * @param aad Associated data (may be NULL if `aad_len` is 0).
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t aes_gcm_hw_aad(size_t aad_len, const uint8_t *aad);
+
+/**
+ * Encrypts or decrypts the text of an AES-GCM operation.
+ *
+ * Blocks are streamed through the hardware without reloading the key; the
+ * output is delayed by one block as for `aes_update`. `output` may be equal
+ * to `input`.
+ *
+ * Must be called at most once per operation.
+ *
+ * @param len Length of the input and output in bytes.
+ * @param input Input data (may be NULL if `len` is 0).
+ * @param[out] output Output data (may be NULL if `len` is 0).
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t aes_gcm_hw_text(size_t len, const uint8_t *input, uint8_t *output);
+
+/**
+ * Computes the full-length tag of an AES-GCM operation.
+ *
+ * @param aad_len Total length of the associated data in bytes.
+ * @param text_len Total length of the text in bytes.
+ * @param[out] tag Authentication tag.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t aes_gcm_hw_tag(size_t aad_len, size_t text_len, aes_block_t *tag);
+
 /**
  * Compute the checksum of an AES key.
  *
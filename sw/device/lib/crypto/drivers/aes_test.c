@@ -114,11 +114,47 @@ static status_t run_aes_test(void) {
   return OTCRYPTO_OK;
 }
 
+static status_t run_aes_blocks_test(void) {
+  const uint32_t share0[8] = {~kSecretKey[0],
+                              ~kSecretKey[1],
+                              ~kSecretKey[2],
+                              ~kSecretKey[3],
+                              0,
+                              0,
+                              0,
+                              0};
+  const uint32_t share1[8] = {UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX,
+                              0,          0,          0,          0};
+
+  aes_key_t key = {
+      .mode = kAesCipherModeCtr,
+      .sideload = kHardenedBoolFalse,
+      .key_len = 4,
+      .key_shares = {share0, share1},
+  };
+  key.checksum = aes_key_integrity_checksum(&key);
+
+  LOG_INFO("Processing all blocks at once.");
+  TRY(aes_encrypt_begin(key, &kIv));
+  aes_block_t ciphertext[ARRAYSIZE(kCiphertext)] = {0};
+  TRY(aes_update_blocks(ciphertext, kPlaintext, ARRAYSIZE(kPlaintext)));
+
+  CHECK_ARRAYS_EQ((uint32_t *)ciphertext, (uint32_t *)kCiphertext,
+                  sizeof(ciphertext) / (sizeof(uint32_t)));
+
+  aes_block_t final_iv;
+  TRY(aes_end(&final_iv));
+  CHECK_ARRAYS_EQ(final_iv.data, kFinalIv.data, kAesBlockNumWords);
+
+  return OTCRYPTO_OK;
+}
+
 OTTF_DEFINE_TEST_CONFIG();
 
 bool test_main(void) {
   CHECK_STATUS_OK(entropy_complex_init());
   CHECK_STATUS_OK(run_aes_test());
+  CHECK_STATUS_OK(run_aes_blocks_test());
 
   return true;
 }
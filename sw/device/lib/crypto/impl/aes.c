@@ -374,9 +374,23 @@ static otcrypto_status_t otcrypto_aes_impl(
   // avoid that multiple cases were executed.
   HARDENED_CHECK_EQ(launder32(aes_operation_started), aes_operation);
 
-  // Perform the cipher operation for all full blocks. The input and output are
-  // offset by `block_offset` number of blocks, where `block_offset` can be 1
-  // or 2. So if unrolled, these loops would look like:
+  // If both buffers are word-aligned, stream all blocks that need no padding
+  // straight between memory and the hardware, which keeps the AES block busy
+  // without staging each block in a local copy. Only the padded block, if
+  // any, is left for the block-by-block loops below.
+  size_t first_block = 0;
+  if (misalignment32_of((uintptr_t)cipher_input.data) == 0 &&
+      misalignment32_of((uintptr_t)cipher_output.data) == 0) {
+    first_block = cipher_input.len / kAesBlockNumBytes;
+    HARDENED_CHECK_LE(first_block, input_nblocks);
+    HARDENED_TRY(aes_update_blocks((aes_block_t *)cipher_output.data,
+                                   (const aes_block_t *)cipher_input.data,
+                                   first_block));
+  }
+
+  // Perform the cipher operation for the remaining blocks. The input and
+  // output are offset by `block_offset` number of blocks, where
+  // `block_offset` can be 1 or 2. So if unrolled, these loops would look like:
   //
   // - block_offset == 1
   //   aes_update(NULL, input[0]);
@@ -399,49 +413,53 @@ static otcrypto_status_t otcrypto_aes_impl(
   // - Software provides  Block x+1 via the data input registers.
   //
   // See the AES driver for details.
-  const size_t block_offset = input_nblocks >= 3 ? 2 : 1;
-  aes_block_t block_in;
-  aes_block_t block_out;
-  size_t i;
-
-  // Provide the first `block_offset` number of input blocks and call the AES
-  // cipher.
-  for (i = 0; launder32(i) < block_offset; ++i) {
-    HARDENED_TRY(get_block(cipher_input, aes_padding, i, &block_in));
-    HARDENED_TRY(aes_update(/*dest=*/NULL, &block_in));
-  }
-  // Check that the loop ran for the correct number of iterations.
-  HARDENED_CHECK_EQ(i, block_offset);
-
-  // Call the AES cipher while providing new input and copying data to the
-  // output buffer.
-  for (i = block_offset; launder32(i) < input_nblocks; ++i) {
-    HARDENED_TRY(get_block(cipher_input, aes_padding, i, &block_in));
-    HARDENED_TRY(hardened_memshred(block_out.data, ARRAYSIZE(block_out.data)));
-    HARDENED_TRY(aes_update(&block_out, &block_in));
-    // Byte buffers passed as input may not be word-aligned, so we cannot
-    // use `hardened_memcpy`.
-    // Hence, use `randomized_bytecopy` instead.
-    HARDENED_TRY(randomized_bytecopy(
-        &cipher_output.data[(i - block_offset) * kAesBlockNumBytes],
-        block_out.data, kAesBlockNumBytes));
-  }
-  // Check that the loop ran for the correct number of iterations.
-  HARDENED_CHECK_EQ(i, input_nblocks);
-
-  // Retrieve the output from the final `block_offset` blocks (providing no
-  // input).
-  for (i = block_offset; i > 0; --i) {
-    HARDENED_TRY(aes_update(&block_out, /*src=*/NULL));
-    // Byte buffers passed as input may not be word-aligned, so we cannot
-    // use `hardened_memcpy`.
-    // Hence, use `randomized_bytecopy` instead.
-    HARDENED_TRY(randomized_bytecopy(
-        &cipher_output.data[(input_nblocks - i) * kAesBlockNumBytes],
-        block_out.data, kAesBlockNumBytes));
+  size_t remaining_nblocks = input_nblocks - first_block;
+  if (remaining_nblocks > 0) {
+    const size_t block_offset = remaining_nblocks >= 3 ? 2 : 1;
+    aes_block_t block_in;
+    aes_block_t block_out;
+    size_t i;
+
+    // Provide the first `block_offset` number of input blocks and call the
+    // AES cipher.
+    for (i = first_block; launder32(i) < first_block + block_offset; ++i) {
+      HARDENED_TRY(get_block(cipher_input, aes_padding, i, &block_in));
+      HARDENED_TRY(aes_update(/*dest=*/NULL, &block_in));
+    }
+    // Check that the loop ran for the correct number of iterations.
+    HARDENED_CHECK_EQ(i, first_block + block_offset);
+
+    // Call the AES cipher while providing new input and copying data to the
+    // output buffer.
+    for (; launder32(i) < input_nblocks; ++i) {
+      HARDENED_TRY(get_block(cipher_input, aes_padding, i, &block_in));
+      HARDENED_TRY(
+          hardened_memshred(block_out.data, ARRAYSIZE(block_out.data)));
+      HARDENED_TRY(aes_update(&block_out, &block_in));
+      // Byte buffers passed as input may not be word-aligned, so we cannot
+      // use `hardened_memcpy`.
+      // Hence, use `randomized_bytecopy` instead.
+      HARDENED_TRY(randomized_bytecopy(
+          &cipher_output.data[(i - block_offset) * kAesBlockNumBytes],
+          block_out.data, kAesBlockNumBytes));
+    }
+    // Check that the loop ran for the correct number of iterations.
+    HARDENED_CHECK_EQ(i, input_nblocks);
+
+    // Retrieve the output from the final `block_offset` blocks (providing no
+    // input).
+    for (i = block_offset; i > 0; --i) {
+      HARDENED_TRY(aes_update(&block_out, /*src=*/NULL));
+      // Byte buffers passed as input may not be word-aligned, so we cannot
+      // use `hardened_memcpy`.
+      // Hence, use `randomized_bytecopy` instead.
+      HARDENED_TRY(randomized_bytecopy(
+          &cipher_output.data[(input_nblocks - i) * kAesBlockNumBytes],
+          block_out.data, kAesBlockNumBytes));
+    }
+    // Check that the loop ran for the correct number of iterations.
+    HARDENED_CHECK_EQ(launder32(i), 0);
   }
-  // Check that the loop ran for the correct number of iterations.
-  HARDENED_CHECK_EQ(launder32(i), 0);
 
   // Verify the CTRL and CTRL_AUX registers.
 
@@ -43,6 +43,32 @@ enum {
   kAesGcmContextNumWords = sizeof(aes_gcm_context_t) / sizeof(uint32_t),
 };
 
+#if defined(OTCRYPTO_GHASH_8BIT_TABLES) || defined(OTCRYPTO_GHASH_AGGREGATE)
+static_assert(alignof(otcrypto_aes_gcm_context_t) >= alignof(aes_gcm_context_t),
+              "AES-GCM context object for top-level API must be aligned for "
+              "use as the internal context.");
+
+/**
+ * Declares `name_` as a pointer to the internal context of `api_ctx_`.
+ *
+ * The GHASH product tables make the internal context too large for the stack
+ * in this configuration (see `kGhashWindowNumBits`), so operations work on the
+ * API-facing context object in place, and saving and restoring it are no-ops.
+ */
+#define GCM_CONTEXT_DECLARE(name_, api_ctx_) \
+  aes_gcm_context_t *name_ = (aes_gcm_context_t *)(api_ctx_)->data
+#else
+/**
+ * Declares `name_` as a pointer to an internal context on the stack.
+ *
+ * Use `gcm_context_restore()` and `gcm_context_save()` to copy it from and to
+ * the API-facing context object `api_ctx_`.
+ */
+#define GCM_CONTEXT_DECLARE(name_, api_ctx_) \
+  aes_gcm_context_t name_##_stack;           \
+  aes_gcm_context_t *name_ = &name_##_stack
+#endif
+
 /**
  * Save an AES-GCM context.
  *
@@ -52,6 +78,9 @@ enum {
  */
 static inline status_t gcm_context_save(aes_gcm_context_t *internal_ctx,
                                         otcrypto_aes_gcm_context_t *api_ctx) {
+  if ((void *)internal_ctx == (void *)api_ctx->data) {
+    return OTCRYPTO_OK;
+  }
   return hardened_memcpy(api_ctx->data, (uint32_t *)internal_ctx,
                          kAesGcmContextNumWords);
 }
@@ -65,6 +94,9 @@ static inline status_t gcm_context_save(aes_gcm_context_t *internal_ctx,
  */
 static inline status_t gcm_context_restore(otcrypto_aes_gcm_context_t *api_ctx,
                                            aes_gcm_context_t *internal_ctx) {
+  if ((void *)internal_ctx == (void *)api_ctx->data) {
+    return OTCRYPTO_OK;
+  }
   return hardened_memcpy((uint32_t *)internal_ctx, api_ctx->data,
                          kAesGcmContextNumWords);
 }
@@ -327,7 +359,8 @@ otcrypto_status_t otcrypto_aes_gcm_encrypt(otcrypto_blinded_key_t *key,
 
   // Call the core encryption operation.
   HARDENED_TRY(aes_gcm_encrypt(aes_key, iv.len, iv.data, plaintext.len,
-                               plaintext.data, aad.len, aad.data, auth_tag.len,
+                               plaintext.data, aad.len, aad.data,
+                               key->config.security_level, auth_tag.len,
                                auth_tag.data, ciphertext.data));
 
   HARDENED_TRY(clear_key_if_sideloaded(aes_key));
@@ -380,7 +413,8 @@ otcrypto_status_t otcrypto_aes_gcm_decrypt(
 
   // Call the core decryption operation.
   HARDENED_TRY(aes_gcm_decrypt(aes_key, iv.len, iv.data, ciphertext.len,
-                               ciphertext.data, aad.len, aad.data, auth_tag.len,
+                               ciphertext.data, aad.len, aad.data,
+                               key->config.security_level, auth_tag.len,
                                auth_tag.data, plaintext.data, success));
 
   HARDENED_TRY(clear_key_if_sideloaded(aes_key));
@@ -411,13 +445,13 @@ otcrypto_status_t otcrypto_aes_gcm_encrypt_init(
   HARDENED_TRY(load_key_if_sideloaded(aes_key));
 
   // Call the internal init operation.
-  aes_gcm_context_t internal_ctx;
-  internal_ctx.security_level = key->config.security_level;
-  HARDENED_TRY(aes_gcm_encrypt_init(aes_key, iv.len, iv.data, &internal_ctx));
+  GCM_CONTEXT_DECLARE(internal_ctx, ctx);
+  internal_ctx->security_level = key->config.security_level;
+  HARDENED_TRY(aes_gcm_encrypt_init(aes_key, iv.len, iv.data, internal_ctx));
 
   // Save the context and clear the key if needed.
-  HARDENED_TRY(gcm_context_save(&internal_ctx, ctx));
-  HARDENED_TRY(clear_key_if_sideloaded(internal_ctx.key));
+  HARDENED_TRY(gcm_context_save(internal_ctx, ctx));
+  HARDENED_TRY(clear_key_if_sideloaded(internal_ctx->key));
 
   // Enable the iCache if it was previously enabled.
   ibex_restore_icache(icache_saved_state);
@@ -445,13 +479,13 @@ otcrypto_status_t otcrypto_aes_gcm_decrypt_init(
   HARDENED_TRY(load_key_if_sideloaded(aes_key));
 
   // Call the internal init operation.
-  aes_gcm_context_t internal_ctx;
-  internal_ctx.security_level = key->config.security_level;
-  HARDENED_TRY(aes_gcm_decrypt_init(aes_key, iv.len, iv.data, &internal_ctx));
+  GCM_CONTEXT_DECLARE(internal_ctx, ctx);
+  internal_ctx->security_level = key->config.security_level;
+  HARDENED_TRY(aes_gcm_decrypt_init(aes_key, iv.len, iv.data, internal_ctx));
 
   // Save the context and clear the key if needed.
-  HARDENED_TRY(gcm_context_save(&internal_ctx, ctx));
-  HARDENED_TRY(clear_key_if_sideloaded(internal_ctx.key));
+  HARDENED_TRY(gcm_context_save(internal_ctx, ctx));
+  HARDENED_TRY(clear_key_if_sideloaded(internal_ctx->key));
 
   // Enable the iCache if it was previously enabled.
   ibex_restore_icache(icache_saved_state);
@@ -478,16 +512,16 @@ otcrypto_status_t otcrypto_aes_gcm_update_aad(otcrypto_aes_gcm_context_t *ctx,
   HARDENED_TRY(ibex_disable_icache(&icache_saved_state));
 
   // Restore the AES-GCM context object and load the key if needed.
-  aes_gcm_context_t internal_ctx;
-  HARDENED_TRY(gcm_context_restore(ctx, &internal_ctx));
-  HARDENED_TRY(load_key_if_sideloaded(internal_ctx.key));
+  GCM_CONTEXT_DECLARE(internal_ctx, ctx);
+  HARDENED_TRY(gcm_context_restore(ctx, internal_ctx));
+  HARDENED_TRY(load_key_if_sideloaded(internal_ctx->key));
 
   // Call the internal update operation.
-  HARDENED_TRY(aes_gcm_update_aad(&internal_ctx, aad.len, aad.data));
+  HARDENED_TRY(aes_gcm_update_aad(internal_ctx, aad.len, aad.data));
 
   // Save the context and clear the key if needed.
-  HARDENED_TRY(gcm_context_save(&internal_ctx, ctx));
-  HARDENED_TRY(clear_key_if_sideloaded(internal_ctx.key));
+  HARDENED_TRY(gcm_context_save(internal_ctx, ctx));
+  HARDENED_TRY(clear_key_if_sideloaded(internal_ctx->key));
 
   // Enable the iCache if it was previously enabled.
   ibex_restore_icache(icache_saved_state);
@@ -517,15 +551,15 @@ otcrypto_status_t otcrypto_aes_gcm_update_encrypted_data(
   HARDENED_TRY(ibex_disable_icache(&icache_saved_state));
 
   // Restore the AES-GCM context object and load the key if needed.
-  aes_gcm_context_t internal_ctx;
-  HARDENED_TRY(gcm_context_restore(ctx, &internal_ctx));
-  HARDENED_TRY(load_key_if_sideloaded(internal_ctx.key));
+  GCM_CONTEXT_DECLARE(internal_ctx, ctx);
+  HARDENED_TRY(gcm_context_restore(ctx, internal_ctx));
+  HARDENED_TRY(load_key_if_sideloaded(internal_ctx->key));
   // Remask the key if it is not sideloaded.
-  HARDENED_TRY(gcm_remask_key(&internal_ctx));
+  HARDENED_TRY(gcm_remask_key(internal_ctx));
 
   // The output buffer must be long enough to hold all full blocks that will
   // exist after `input` is added.
-  size_t partial_block_len = internal_ctx.input_len % kAesBlockNumBytes;
+  size_t partial_block_len = internal_ctx->input_len % kAesBlockNumBytes;
   if (input.len > UINT32_MAX - partial_block_len) {
     return OTCRYPTO_BAD_ARGS;
   }
@@ -538,11 +572,11 @@ otcrypto_status_t otcrypto_aes_gcm_update_encrypted_data(
 
   // Call the internal update operation.
   HARDENED_TRY(aes_gcm_update_encrypted_data(
-      &internal_ctx, input.len, input.data, output_bytes_written, output.data));
+      internal_ctx, input.len, input.data, output_bytes_written, output.data));
 
   // Save the context and clear the key if needed.
-  HARDENED_TRY(gcm_context_save(&internal_ctx, ctx));
-  HARDENED_TRY(clear_key_if_sideloaded(internal_ctx.key));
+  HARDENED_TRY(gcm_context_save(internal_ctx, ctx));
+  HARDENED_TRY(clear_key_if_sideloaded(internal_ctx->key));
 
   // Enable the iCache if it was previously enabled.
   ibex_restore_icache(icache_saved_state);
@@ -577,27 +611,29 @@ otcrypto_status_t otcrypto_aes_gcm_encrypt_final(
   HARDENED_TRY(aes_gcm_check_tag_length(auth_tag.len, tag_len));
 
   // Restore the AES-GCM context object and load the key if needed.
-  aes_gcm_context_t internal_ctx;
-  HARDENED_TRY(gcm_context_restore(ctx, &internal_ctx));
-  HARDENED_TRY(load_key_if_sideloaded(internal_ctx.key));
+  GCM_CONTEXT_DECLARE(internal_ctx, ctx);
+  HARDENED_TRY(gcm_context_restore(ctx, internal_ctx));
+  HARDENED_TRY(load_key_if_sideloaded(internal_ctx->key));
   // Remask the key if it is not sideloaded.
-  HARDENED_TRY(gcm_remask_key(&internal_ctx));
+  HARDENED_TRY(gcm_remask_key(internal_ctx));
 
   // If the partial block is nonempty, the output must be at least as long as
   // the partial block.
-  size_t partial_block_len = internal_ctx.input_len % kAesBlockNumBytes;
+  size_t partial_block_len = internal_ctx->input_len % kAesBlockNumBytes;
   if (ciphertext.len < partial_block_len) {
     return OTCRYPTO_BAD_ARGS;
   }
 
   // Call the internal final operation.
-  HARDENED_TRY(aes_gcm_encrypt_final(&internal_ctx, auth_tag.len, auth_tag.data,
+  HARDENED_TRY(aes_gcm_encrypt_final(internal_ctx, auth_tag.len, auth_tag.data,
                                      ciphertext_bytes_written,
                                      ciphertext.data));
 
-  // Clear the context and the key if needed.
+  // Clear the context and the key if needed. The internal context can be the
+  // API-facing one, so keep the key before clearing it.
+  aes_key_t key = internal_ctx->key;
   HARDENED_TRY(hardened_memshred(ctx->data, ARRAYSIZE(ctx->data)));
-  HARDENED_TRY(clear_key_if_sideloaded(internal_ctx.key));
+  HARDENED_TRY(clear_key_if_sideloaded(key));
 
   // Enable the iCache if it was previously enabled.
   ibex_restore_icache(icache_saved_state);
@@ -630,27 +666,29 @@ otcrypto_status_t otcrypto_aes_gcm_decrypt_final(
   HARDENED_TRY(aes_gcm_check_tag_length(auth_tag.len, tag_len));
 
   // Restore the AES-GCM context object and load the key if needed.
-  aes_gcm_context_t internal_ctx;
-  HARDENED_TRY(gcm_context_restore(ctx, &internal_ctx));
-  HARDENED_TRY(load_key_if_sideloaded(internal_ctx.key));
+  GCM_CONTEXT_DECLARE(internal_ctx, ctx);
+  HARDENED_TRY(gcm_context_restore(ctx, internal_ctx));
+  HARDENED_TRY(load_key_if_sideloaded(internal_ctx->key));
   // Remask the key if it is not sideloaded.
-  HARDENED_TRY(gcm_remask_key(&internal_ctx));
+  HARDENED_TRY(gcm_remask_key(internal_ctx));
 
   // If the partial block is nonempty, the output must be at least as long as
   // the partial block.
-  size_t partial_block_len = internal_ctx.input_len % kAesBlockNumBytes;
+  size_t partial_block_len = internal_ctx->input_len % kAesBlockNumBytes;
   if (plaintext.len < partial_block_len) {
     return OTCRYPTO_BAD_ARGS;
   }
 
   // Call the internal final operation.
-  HARDENED_TRY(aes_gcm_decrypt_final(&internal_ctx, auth_tag.len, auth_tag.data,
+  HARDENED_TRY(aes_gcm_decrypt_final(internal_ctx, auth_tag.len, auth_tag.data,
                                      plaintext_bytes_written, plaintext.data,
                                      success));
 
-  // Clear the context and the key if needed.
+  // Clear the context and the key if needed. The internal context can be the
+  // API-facing one, so keep the key before clearing it.
+  aes_key_t key = internal_ctx->key;
   HARDENED_TRY(hardened_memshred(ctx->data, ARRAYSIZE(ctx->data)));
-  HARDENED_TRY(clear_key_if_sideloaded(internal_ctx.key));
+  HARDENED_TRY(clear_key_if_sideloaded(key));
 
   // Enable the iCache if it was previously enabled.
   ibex_restore_icache(icache_saved_state);
@@ -27,6 +27,29 @@ enum {
 static_assert(kAesBlockNumBytes == (1 << kAesBlockLog2NumBytes),
               "kAesBlockLog2NumBytes does not match kAesBlockNumBytes");
 
+#if defined(OTCRYPTO_GHASH_8BIT_TABLES) || defined(OTCRYPTO_GHASH_AGGREGATE)
+/**
+ * Context object for one-shot operations.
+ *
+ * The GHASH product tables make the context too large for the stack in this
+ * configuration (see `kGhashWindowNumBits`), so one-shot operations share this
+ * statically allocated one.
+ */
+static aes_gcm_context_t oneshot_ctx;
+
+/**
+ * Declares `name_` as a pointer to the context for a one-shot operation.
+ */
+#define ONESHOT_CONTEXT_DECLARE(name_) aes_gcm_context_t *name_ = &oneshot_ctx
+#else
+/**
+ * Declares `name_` as a pointer to the context for a one-shot operation.
+ */
+#define ONESHOT_CONTEXT_DECLARE(name_) \
+  aes_gcm_context_t name_##_stack;     \
+  aes_gcm_context_t *name_ = &name_##_stack
+#endif
+
 /**
  * Increment a 32-bit big-endian word.
  *
@@ -240,6 +263,7 @@ static status_t aes_gcm_hash_subkey(
   // Set the key for the GHASH context.
   HARDENED_TRY(ghash_init_subkey(hash_subkey_share0.data, ctx->tbl0));
   ghash_init_subkey(hash_subkey_share1.data, ctx->tbl1);
+  HARDENED_TRY(ghash_init_subkey_powers(hash_subkey.data, ctx));
 
   return OTCRYPTO_OK;
 }
@@ -353,19 +377,103 @@ static status_t aes_gcm_get_tag(aes_gcm_context_t *ctx, size_t tag_len,
   return OTCRYPTO_OK;
 }
 
+/**
+ * Run a one-shot AES-GCM operation on the hardware GCM mode.
+ *
+ * Returns `kHardenedBoolFalse` in `used_hw` without producing any output if
+ * the operation has to be done in software instead: the hardware only
+ * supports 96-bit IVs, may have been built without GCM, and does not provide
+ * the per-block FI redundancy of the software path, so it is only used for
+ * keys with a low security level.
+ *
+ * @param key AES key.
+ * @param iv_len Length of the IV in 32-bit words.
+ * @param iv IV value.
+ * @param encrypt True for encryption, false for decryption.
+ * @param input_len Length of the input and output in bytes.
+ * @param input Input (plaintext or ciphertext).
+ * @param aad_len Length of the AAD in bytes.
+ * @param aad AAD value.
+ * @param security_level Security level of the key.
+ * @param[out] tag Full-length tag.
+ * @param[out] output Output (ciphertext or plaintext).
+ * @param[out] used_hw Whether the operation was done in hardware.
+ * @return Error status; OK if no errors.
+ */
+OT_WARN_UNUSED_RESULT
+static status_t aes_gcm_hw(const aes_key_t key, const size_t iv_len,
+                           const uint32_t *iv, hardened_bool_t encrypt,
+                           const size_t input_len, const uint8_t *input,
+                           const size_t aad_len, const uint8_t *aad,
+                           otcrypto_key_security_level_t security_level,
+                           aes_block_t *tag, uint8_t *output,
+                           hardened_bool_t *used_hw) {
+  *used_hw = kHardenedBoolFalse;
+  if (iv_len != 3 ||
+      launder32(security_level) != kOtcryptoKeySecurityLevelLow) {
+    return OTCRYPTO_OK;
+  }
+  HARDENED_CHECK_EQ(security_level, kOtcryptoKeySecurityLevelLow);
+
+  // Check that the total lengths are < 2^32 bytes, like the streaming API.
+  if (input_len > UINT32_MAX || aad_len > UINT32_MAX) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  if (iv == NULL || (input_len != 0 && (input == NULL || output == NULL)) ||
+      (aad_len != 0 && aad == NULL)) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  HARDENED_CHECK_EQ(key.checksum, aes_key_integrity_checksum(&key));
+
+  hardened_bool_t supported;
+  HARDENED_TRY(aes_gcm_hw_supported(&supported));
+  if (supported != kHardenedBoolTrue) {
+    return OTCRYPTO_OK;
+  }
+
+  // The key stays loaded for the whole message; the hardware computes the
+  // hash subkey, GCTR and GHASH itself.
+  HARDENED_TRY(aes_gcm_hw_begin(key, iv, encrypt));
+  HARDENED_TRY(aes_gcm_hw_aad(aad_len, aad));
+  HARDENED_TRY(aes_gcm_hw_text(input_len, input, output));
+  HARDENED_TRY(aes_gcm_hw_tag(aad_len, input_len, tag));
+  HARDENED_TRY(aes_end(NULL));
+
+  *used_hw = kHardenedBoolTrue;
+  return OTCRYPTO_OK;
+}
+
 status_t aes_gcm_encrypt(const aes_key_t key, const size_t iv_len,
                          const uint32_t *iv, const size_t plaintext_len,
                          const uint8_t *plaintext, const size_t aad_len,
-                         const uint8_t *aad, const size_t tag_len,
-                         uint32_t *tag, uint8_t *ciphertext) {
-  aes_gcm_context_t ctx;
-  HARDENED_TRY(aes_gcm_encrypt_init(key, iv_len, iv, &ctx));
-  HARDENED_TRY(aes_gcm_update_aad(&ctx, aad_len, aad));
+                         const uint8_t *aad,
+                         otcrypto_key_security_level_t security_level,
+                         const size_t tag_len, uint32_t *tag,
+                         uint8_t *ciphertext) {
+  if (tag == NULL || tag_len == 0 || tag_len > kAesBlockNumWords) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Try the hardware GCM mode first.
+  aes_block_t full_tag;
+  hardened_bool_t used_hw;
+  HARDENED_TRY(aes_gcm_hw(key, iv_len, iv, kHardenedBoolTrue, plaintext_len,
+                          plaintext, aad_len, aad, security_level, &full_tag,
+                          ciphertext, &used_hw));
+  if (used_hw == kHardenedBoolTrue) {
+    // Truncate the tag if needed, as `aes_gcm_get_tag` does.
+    return hardened_memcpy(tag, full_tag.data, tag_len);
+  }
+
+  ONESHOT_CONTEXT_DECLARE(ctx);
+  ctx->security_level = security_level;
+  HARDENED_TRY(aes_gcm_encrypt_init(key, iv_len, iv, ctx));
+  HARDENED_TRY(aes_gcm_update_aad(ctx, aad_len, aad));
   size_t ciphertext_bytes_written;
   HARDENED_TRY(aes_gcm_update_encrypted_data(
-      &ctx, plaintext_len, plaintext, &ciphertext_bytes_written, ciphertext));
+      ctx, plaintext_len, plaintext, &ciphertext_bytes_written, ciphertext));
   ciphertext += ciphertext_bytes_written;
-  return aes_gcm_encrypt_final(&ctx, tag_len, tag, &ciphertext_bytes_written,
+  return aes_gcm_encrypt_final(ctx, tag_len, tag, &ciphertext_bytes_written,
                                ciphertext);
 }
 
@@ -654,17 +762,41 @@ status_t aes_gcm_encrypt_final(aes_gcm_context_t *ctx, size_t tag_len,
 status_t aes_gcm_decrypt(const aes_key_t key, const size_t iv_len,
                          const uint32_t *iv, const size_t ciphertext_len,
                          const uint8_t *ciphertext, const size_t aad_len,
-                         const uint8_t *aad, const size_t tag_len,
-                         const uint32_t *tag, uint8_t *plaintext,
-                         hardened_bool_t *success) {
-  aes_gcm_context_t ctx;
-  HARDENED_TRY(aes_gcm_decrypt_init(key, iv_len, iv, &ctx));
-  HARDENED_TRY(aes_gcm_update_aad(&ctx, aad_len, aad));
+                         const uint8_t *aad,
+                         otcrypto_key_security_level_t security_level,
+                         const size_t tag_len, const uint32_t *tag,
+                         uint8_t *plaintext, hardened_bool_t *success) {
+  if (tag == NULL || tag_len == 0 || tag_len > kAesBlockNumWords) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+
+  // Try the hardware GCM mode first.
+  aes_block_t full_tag;
+  hardened_bool_t used_hw;
+  HARDENED_TRY(aes_gcm_hw(key, iv_len, iv, kHardenedBoolFalse, ciphertext_len,
+                          ciphertext, aad_len, aad, security_level, &full_tag,
+                          plaintext, &used_hw));
+  if (used_hw == kHardenedBoolTrue) {
+    // Compare the expected tag to the actual tag (in constant time).
+    *success = hardened_memeq(full_tag.data, tag, tag_len);
+    if (*success != kHardenedBoolTrue) {
+      // If authentication fails, zero the plaintext so that the caller does
+      // not use the unauthenticated decrypted data.
+      *success = kHardenedBoolFalse;
+      memset(plaintext, 0, ciphertext_len);
+    }
+    return OTCRYPTO_OK;
+  }
+
+  ONESHOT_CONTEXT_DECLARE(ctx);
+  ctx->security_level = security_level;
+  HARDENED_TRY(aes_gcm_decrypt_init(key, iv_len, iv, ctx));
+  HARDENED_TRY(aes_gcm_update_aad(ctx, aad_len, aad));
   size_t plaintext_bytes_written;
   HARDENED_TRY(aes_gcm_update_encrypted_data(
-      &ctx, ciphertext_len, ciphertext, &plaintext_bytes_written, plaintext));
+      ctx, ciphertext_len, ciphertext, &plaintext_bytes_written, plaintext));
   plaintext += plaintext_bytes_written;
-  return aes_gcm_decrypt_final(&ctx, tag_len, tag, &plaintext_bytes_written,
+  return aes_gcm_decrypt_final(ctx, tag_len, tag, &plaintext_bytes_written,
                                plaintext, success);
 }
 
@@ -86,6 +86,9 @@ typedef struct aes_gcm_context {
  *
  * This implementation does not support short tags.
  *
+ * For low-security keys and 96-bit IVs, the operation runs on the GCM mode of
+ * the AES hardware if it is available, and in software otherwise.
+ *
  * @param key AES key
  * @param iv_len length of IV in 32-bit words
  * @param iv IV value (may be NULL if iv_len is 0)
@@ -93,6 +96,7 @@ typedef struct aes_gcm_context {
  * @param plaintext plaintext value (may be NULL if plaintext_len is 0)
  * @param aad_len length of AAD in bytes
  * @param aad AAD value (may be NULL if aad_len is 0)
+ * @param security_level Security level of the key
  * @param tag_len Tag length in 32-bit words
  * @param[out] tag Output buffer for tag
  * @param[out] ciphertext Output buffer for ciphertext (same length as
@@ -103,8 +107,10 @@ OT_WARN_UNUSED_RESULT
 status_t aes_gcm_encrypt(const aes_key_t key, const size_t iv_len,
                          const uint32_t *iv, const size_t plaintext_len,
                          const uint8_t *plaintext, const size_t aad_len,
-                         const uint8_t *aad, const size_t tag_len,
-                         uint32_t *tag, uint8_t *ciphertext);
+                         const uint8_t *aad,
+                         otcrypto_key_security_level_t security_level,
+                         const size_t tag_len, uint32_t *tag,
+                         uint8_t *ciphertext);
 
 /**
  * AES-GCM authenticated decryption as defined in NIST SP800-38D, algorithm 5.
@@ -127,6 +133,9 @@ status_t aes_gcm_encrypt(const aes_key_t key, const size_t iv_len,
  * other than OK, all output from this function should be discarded, including
  * `success`.
  *
+ * For low-security keys and 96-bit IVs, the operation runs on the GCM mode of
+ * the AES hardware if it is available, and in software otherwise.
+ *
  * @param key AES key
  * @param iv_len length of IV in 32-bit words
  * @param iv IV value (may be NULL if iv_len is 0)
@@ -134,6 +143,7 @@ status_t aes_gcm_encrypt(const aes_key_t key, const size_t iv_len,
  * @param ciphertext plaintext value (may be NULL if ciphertext_len is 0)
  * @param aad_len length of AAD in bytes
  * @param aad AAD value (may be NULL if aad_len is 0)
+ * @param security_level Security level of the key
  * @param tag_len Tag length in 32-bit words
  * @param tag Authentication tag
  * @param[out] plaintext Output buffer for plaintext (same length as ciphertext)
@@ -144,9 +154,10 @@ OT_WARN_UNUSED_RESULT
 status_t aes_gcm_decrypt(const aes_key_t key, const size_t iv_len,
                          const uint32_t *iv, const size_t ciphertext_len,
                          const uint8_t *ciphertext, const size_t aad_len,
-                         const uint8_t *aad, const size_t tag_len,
-                         const uint32_t *tag, uint8_t *plaintext,
-                         hardened_bool_t *success);
+                         const uint8_t *aad,
+                         otcrypto_key_security_level_t security_level,
+                         const size_t tag_len, const uint32_t *tag,
+                         uint8_t *plaintext, hardened_bool_t *success);
 
 /**
  * Starts an AES-GCM authenticated encryption operation.
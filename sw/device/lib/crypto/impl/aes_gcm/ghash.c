@@ -20,11 +20,28 @@ enum {
   kGhashBlockLog2NumBytes = 4,
   /**
    * Number of windows for Galois field pre-computed tables.
+   */
+  kNumWindows = (kGhashBlockNumBytes * 8) / kGhashWindowNumBits,
+  /**
+   * Index of 1 * H in a product table (see `ghash_init_subkey`).
+   */
+  kTableIndexOne = 1 << (kGhashWindowNumBits - 1),
+#if defined(OTCRYPTO_GHASH_8BIT_TABLES) || defined(OTCRYPTO_GHASH_AGGREGATE)
+  /**
+   * Whether to check the context integrity after every block.
    *
-   * We suse 4-bit windows, so the number of windows is 2x the number of bytes
-   * in a block.
+   * The checksum covers the product tables of share 0, so with larger tables
+   * it costs more than the multiplications. The tables are not modified after
+   * initialization, so a fault in them is still caught when the context is
+   * checked once at the end of each update.
    */
-  kNumWindows = kGhashBlockNumBytes << 1,
+  kCheckEveryBlock = 0,
+#else
+  /**
+   * Whether to check the context integrity after every block.
+   */
+  kCheckEveryBlock = 1,
+#endif
 };
 static_assert(kGhashBlockNumBytes == (1 << kGhashBlockLog2NumBytes),
               "kGhashBlockLog2NumBytes does not match kGhashBlockNumBytes");
@@ -32,8 +49,8 @@ static_assert(kGhashBlockNumBytes == (1 << kGhashBlockLog2NumBytes),
 /**
  * Precomputed modular reduction constants for Galois field multiplication.
  *
- * This implementation uses 4-bit windows. The bytes here represent 12-bit
- * little-endian values.
+ * The table has one entry per window value. The bytes here represent 12-bit
+ * (4-bit windows) or 16-bit (8-bit windows) little-endian values.
  *
  * The entry with index i in this table is equal to i * 0xe1, where the bytes i
  * and 0xe1 are interpreted as polynomials in the GCM Galois field. For
@@ -46,11 +63,51 @@ static_assert(kGhashBlockNumBytes == (1 << kGhashBlockLog2NumBytes),
  * There is a size/speed tradeoff in window size. For 8-bit windows, GHASH
  * becomes significantly faster, but the overhead for computing the product
  * table of a given hash subkey becomes higher, so larger windows are slower
- * for smaller inputs but faster for large inputs.
+ * for smaller inputs but faster for large inputs. The tables also grow from
+ * 256B to 4KiB each, which is why 8-bit windows are opt-in.
  */
+#ifdef OTCRYPTO_GHASH_8BIT_TABLES
+static const uint16_t kGFReduceTable[256] = {
+    0x0000, 0xc201, 0x8403, 0x4602, 0x0807, 0xca06, 0x8c04, 0x4e05,
+    0x100e, 0xd20f, 0x940d, 0x560c, 0x1809, 0xda08, 0x9c0a, 0x5e0b,
+    0x201c, 0xe21d, 0xa41f, 0x661e, 0x281b, 0xea1a, 0xac18, 0x6e19,
+    0x3012, 0xf213, 0xb411, 0x7610, 0x3815, 0xfa14, 0xbc16, 0x7e17,
+    0x4038, 0x8239, 0xc43b, 0x063a, 0x483f, 0x8a3e, 0xcc3c, 0x0e3d,
+    0x5036, 0x9237, 0xd435, 0x1634, 0x5831, 0x9a30, 0xdc32, 0x1e33,
+    0x6024, 0xa225, 0xe427, 0x2626, 0x6823, 0xaa22, 0xec20, 0x2e21,
+    0x702a, 0xb22b, 0xf429, 0x3628, 0x782d, 0xba2c, 0xfc2e, 0x3e2f,
+    0x8070, 0x4271, 0x0473, 0xc672, 0x8877, 0x4a76, 0x0c74, 0xce75,
+    0x907e, 0x527f, 0x147d, 0xd67c, 0x9879, 0x5a78, 0x1c7a, 0xde7b,
+    0xa06c, 0x626d, 0x246f, 0xe66e, 0xa86b, 0x6a6a, 0x2c68, 0xee69,
+    0xb062, 0x7263, 0x3461, 0xf660, 0xb865, 0x7a64, 0x3c66, 0xfe67,
+    0xc048, 0x0249, 0x444b, 0x864a, 0xc84f, 0x0a4e, 0x4c4c, 0x8e4d,
+    0xd046, 0x1247, 0x5445, 0x9644, 0xd841, 0x1a40, 0x5c42, 0x9e43,
+    0xe054, 0x2255, 0x6457, 0xa656, 0xe853, 0x2a52, 0x6c50, 0xae51,
+    0xf05a, 0x325b, 0x7459, 0xb658, 0xf85d, 0x3a5c, 0x7c5e, 0xbe5f,
+    0x00e1, 0xc2e0, 0x84e2, 0x46e3, 0x08e6, 0xcae7, 0x8ce5, 0x4ee4,
+    0x10ef, 0xd2ee, 0x94ec, 0x56ed, 0x18e8, 0xdae9, 0x9ceb, 0x5eea,
+    0x20fd, 0xe2fc, 0xa4fe, 0x66ff, 0x28fa, 0xeafb, 0xacf9, 0x6ef8,
+    0x30f3, 0xf2f2, 0xb4f0, 0x76f1, 0x38f4, 0xfaf5, 0xbcf7, 0x7ef6,
+    0x40d9, 0x82d8, 0xc4da, 0x06db, 0x48de, 0x8adf, 0xccdd, 0x0edc,
+    0x50d7, 0x92d6, 0xd4d4, 0x16d5, 0x58d0, 0x9ad1, 0xdcd3, 0x1ed2,
+    0x60c5, 0xa2c4, 0xe4c6, 0x26c7, 0x68c2, 0xaac3, 0xecc1, 0x2ec0,
+    0x70cb, 0xb2ca, 0xf4c8, 0x36c9, 0x78cc, 0xbacd, 0xfccf, 0x3ece,
+    0x8091, 0x4290, 0x0492, 0xc693, 0x8896, 0x4a97, 0x0c95, 0xce94,
+    0x909f, 0x529e, 0x149c, 0xd69d, 0x9898, 0x5a99, 0x1c9b, 0xde9a,
+    0xa08d, 0x628c, 0x248e, 0xe68f, 0xa88a, 0x6a8b, 0x2c89, 0xee88,
+    0xb083, 0x7282, 0x3480, 0xf681, 0xb884, 0x7a85, 0x3c87, 0xfe86,
+    0xc0a9, 0x02a8, 0x44aa, 0x86ab, 0xc8ae, 0x0aaf, 0x4cad, 0x8eac,
+    0xd0a7, 0x12a6, 0x54a4, 0x96a5, 0xd8a0, 0x1aa1, 0x5ca3, 0x9ea2,
+    0xe0b5, 0x22b4, 0x64b6, 0xa6b7, 0xe8b2, 0x2ab3, 0x6cb1, 0xaeb0,
+    0xf0bb, 0x32ba, 0x74b8, 0xb6b9, 0xf8bc, 0x3abd, 0x7cbf, 0xbebe,
+};
+#else
 static const uint16_t kGFReduceTable[16] = {
     0x0000, 0x201c, 0x4038, 0x6024, 0x8070, 0xa06c, 0xc048, 0xe054,
     0x00e1, 0x20fd, 0x40d9, 0x60c5, 0x8091, 0xa08d, 0xc0a9, 0xe0b5};
+#endif
+static_assert(ARRAYSIZE(kGFReduceTable) == kGhashTableNumEntries,
+              "kGFReduceTable does not match the window size");
 
 /**
  * Performs a bitwise XOR of two blocks.
@@ -106,6 +163,32 @@ static inline uint8_t block_byte_get(const ghash_block_t *block, size_t index) {
   return ((char *)block->data)[index];
 }
 
+/**
+ * Retrieve a window of a multiplier block.
+ *
+ * Windows are numbered starting with the most significant polynomial terms,
+ * which means starting from the last byte and proceeding to the first.
+ *
+ * @param block Input cipher block
+ * @param index Index of the window (must be < `kNumWindows`)
+ * @return Value of the window, an index into a product table
+ */
+static inline uint8_t block_window_get(const ghash_block_t *block,
+                                       size_t index) {
+#ifdef OTCRYPTO_GHASH_8BIT_TABLES
+  return block_byte_get(block, kNumWindows - 1 - index);
+#else
+  uint8_t byte = block_byte_get(block, (kNumWindows - 1 - index) >> 1);
+  // Select the less significant 4 bits if the index is even, or the more
+  // significant 4 bits if it is odd. This does not need to be constant time,
+  // since the window indices are not secret.
+  if ((index & 1) == 1) {
+    return byte >> 4;
+  }
+  return byte & 0x0f;
+#endif
+}
+
 /**
  * Multiply an element of the GCM Galois field by the polynomial `x`.
  *
@@ -130,16 +213,17 @@ static inline void galois_mulx(const ghash_block_t *p, ghash_block_t *out) {
 }
 
 /**
- * Reverse the bits of a 4-bit number.
+ * Reverse the bits of a window value.
  *
  * @param byte Input byte.
- * @return byte with lower 4 bits reversed and upper 4 unmodified.
+ * @return byte with the lower `kGhashWindowNumBits` bits reversed and the
+ * upper bits cleared.
  */
 static uint8_t reverse_bits(uint8_t byte) {
   /* TODO: replace with rev.n (from 0.93 draft of bitmanip) once bitmanip
    * extension is enabled. */
   uint8_t out = 0;
-  for (size_t i = 0; i < 4; ++i) {
+  for (size_t i = 0; i < kGhashWindowNumBits; ++i) {
     out <<= 1;
     out |= (byte >> i) & 1;
   }
@@ -159,6 +243,12 @@ uint32_t ghash_context_integrity_checksum(const ghash_context_t *ghash_ctx) {
             sizeof(ghash_ctx->correction_term0));
   crc32_add(&ctx, (unsigned char *)&ghash_ctx->enc_initial_counter_block0,
             sizeof(ghash_ctx->enc_initial_counter_block0));
+#ifdef OTCRYPTO_GHASH_AGGREGATE
+  crc32_add(&ctx, (unsigned char *)ghash_ctx->pow_tbl0,
+            sizeof(ghash_ctx->pow_tbl0));
+  crc32_add(&ctx, (unsigned char *)&ghash_ctx->correction_term0_aggregate,
+            sizeof(ghash_ctx->correction_term0_aggregate));
+#endif
   // Note that we do not calculate the crc over the state.
   return crc32_finish(&ctx);
 }
@@ -176,21 +266,22 @@ status_t ghash_init_subkey(const uint32_t *hash_subkey, ghash_block_t *tbl) {
   // Initialize 0 * H = 0.
   memset(tbl[0].data, 0, kGhashBlockNumBytes);
   // Initialize 1 * H = H.
-  HARDENED_TRY(
-      randomized_bytecopy(tbl[0x8].data, hash_subkey, kGhashBlockNumBytes));
+  HARDENED_TRY(randomized_bytecopy(tbl[kTableIndexOne].data, hash_subkey,
+                                   kGhashBlockNumBytes));
 
   // To get remaining entries, we use a variant of "shift and add"; in
   // polynomial terms, a shift is a multiplication by x. Note that, because the
   // processor represents bytes with the MSB on the left and NIST uses a fully
   // little-endian polynomial representation with the MSB on the right, we have
   // to reverse the bits of the indices.
-  for (uint8_t i = 2; i < 16; i += 2) {
+  for (size_t i = 2; i < kGhashTableNumEntries; i += 2) {
     // Find the product corresponding to (i >> 1) * H and multiply by x to
     // shift 1; this will be i * H.
     galois_mulx(&tbl[reverse_bits(i >> 1)], &tbl[reverse_bits(i)]);
 
     // Add H to i * H to get (i + 1) * H.
-    block_xor(&tbl[reverse_bits(i)], &tbl[0x8], &tbl[reverse_bits(i + 1)]);
+    block_xor(&tbl[reverse_bits(i)], &tbl[kTableIndexOne],
+              &tbl[reverse_bits(i + 1)]);
   }
 
   return OTCRYPTO_OK;
@@ -208,6 +299,24 @@ status_t ghash_init(ghash_context_t *ctx) {
   return OTCRYPTO_OK;
 }
 
+/**
+ * Multiply a partial product by x^k and reduce it, where k is the window size.
+ *
+ * @param result Partial product, modified in-place.
+ */
+static inline void galois_mul_window_shift(ghash_block_t *result) {
+  // Save the most significant window of `result` before shifting.
+  uint8_t overflow = block_byte_get(result, kGhashBlockNumBytes - 1) &
+                     (kGhashTableNumEntries - 1);
+  // Shift `result` to the right, discarding high bits.
+  block_shiftr(result, kGhashWindowNumBits);
+  // Look up the product of `overflow` and the low terms of the modulus in the
+  // precomputed table, and add (xor) it to the low bits to complete modular
+  // reduction. This works because (low + x^128 * high) is equivalent to
+  // (low + (x^128 - modulus) * high).
+  result->data[0] ^= kGFReduceTable[overflow];
+}
+
 /**
  * Multiply the GHASH state by the hash subkey.
  *
@@ -225,54 +334,99 @@ status_t ghash_init(ghash_context_t *ctx) {
  * @param tbl Product table for the masked hash subkey.
  * @return Multiplication of the state and the hash subkey.
  */
-static ghash_block_t galois_mul_state_key(ghash_block_t state,
-                                          ghash_block_t tbl[16]) {
+static ghash_block_t galois_mul_state_key(
+    ghash_block_t state, ghash_block_t tbl[kGhashTableNumEntries]) {
   // Initialize the multiplication result to 0.
   ghash_block_t result;
   memset(result.data, 0, kGhashBlockNumBytes);
 
-  // To compute the product, we iterate through the bytes of the input block,
-  // considering the most significant (in polynomial terms) first. For each
-  // byte b, we:
-  //   * multiply `result` by x^8 (shift all coefficients to the right)
+  // To compute the product, we iterate through the windows of the input
+  // block, considering the most significant (in polynomial terms) first. For
+  // each window w, we:
+  //   * multiply `result` by x^k (shift all coefficients to the right), where
+  //     k is the window size
   //   * reduce the shifted `result` modulo the field modulus
-  //   * look up the product `b * H` and add it to `result`
+  //   * look up the product `w * H` and add it to `result`
   //
   // We can skip the shift and reduce steps on the first iteration, since
   // `result` is 0.
   for (size_t i = 0; i < kNumWindows; ++i) {
     if (i != 0) {
-      // Save the most significant half-byte of `result` before shifting.
-      uint8_t overflow =
-          block_byte_get(&result, kGhashBlockNumBytes - 1) & 0x0f;
-      // Shift `result` to the right, discarding high bits.
-      block_shiftr(&result, 4);
-      // Look up the product of `overflow` and the low terms of the modulus in
-      // the precomputed table.
-      uint16_t reduce_term = kGFReduceTable[overflow];
-      // Add (xor) this product to the low bits to complete modular reduction.
-      // This works because (low + x^128 * high) is equivalent to (low + (x^128
-      // - modulus) * high).
-      result.data[0] ^= reduce_term;
+      galois_mul_window_shift(&result);
     }
 
-    // Add the product of the next window and H to `result`. We process the
-    // windows starting with the most significant polynomial terms, which means
-    // starting from the last byte and proceeding to the first.
-    uint8_t tbl_index = block_byte_get(&state, (kNumWindows - 1 - i) >> 1);
-
-    // Select the less significant 4 bits if i is even, or the more significant
-    // 4 bits if i is odd. This does not need to be constant time, since the
-    // values of i in this loop are constant.
-    if ((i & 1) == 1) {
-      tbl_index >>= 4;
-    } else {
-      tbl_index &= 0x0f;
+    // Add the product of the next window and H to `result`.
+    block_xor(&result, &tbl[block_window_get(&state, i)], &result);
+  }
+  return result;
+}
+
+#ifdef OTCRYPTO_GHASH_AGGREGATE
+/**
+ * Compute a sum of products with a single reduction per window.
+ *
+ * Computes in[0] * K0 + in[1] * K1 + ... where Kj is the multiplicand of the
+ * product table `tbls[j]`. The products are accumulated window by window as
+ * in `galois_mul_state_key`, so the shift and reduce steps are shared by all
+ * of them. Like `galois_mul_state_key`, this runs in constant time: there
+ * are no data-dependent branches, and the table lookups do not depend on the
+ * timing of the memory accesses since Ibex has no data cache.
+ *
+ * @param in Multipliers.
+ * @param tbls Product tables of the multiplicands.
+ * @return Sum of the products.
+ */
+static ghash_block_t galois_mul_aggregate(
+    const ghash_block_t in[kGhashAggregateNumBlocks],
+    ghash_block_t *const tbls[kGhashAggregateNumBlocks]) {
+  ghash_block_t result;
+  memset(result.data, 0, kGhashBlockNumBytes);
+
+  for (size_t i = 0; i < kNumWindows; ++i) {
+    if (i != 0) {
+      galois_mul_window_shift(&result);
+    }
+    for (size_t j = 0; j < kGhashAggregateNumBlocks; ++j) {
+      block_xor(&result, &tbls[j][block_window_get(&in[j], i)], &result);
     }
-    block_xor(&result, &tbl[tbl_index], &result);
   }
   return result;
 }
+#endif
+
+status_t ghash_init_subkey_powers(const uint32_t *hash_subkey,
+                                  ghash_context_t *ctx) {
+#ifdef OTCRYPTO_GHASH_AGGREGATE
+  ghash_block_t pow;
+  HARDENED_TRY(
+      randomized_bytecopy(pow.data, hash_subkey, kGhashBlockNumBytes));
+  for (size_t k = 0; k < kGhashAggregateNumBlocks - 1; ++k) {
+    // pow = H^(k + 2) = pow * H0 + pow * H1. Multiplying with the product
+    // tables of the subkey shares avoids building a table for the unmasked
+    // subkey on the stack.
+    ghash_block_t pow_h1 = galois_mul_state_key(pow, ctx->tbl1);
+    pow = galois_mul_state_key(pow, ctx->tbl0);
+    block_xor(&pow, &pow_h1, &pow);
+    HARDENED_TRY(hardened_memshred(pow_h1.data, kGhashBlockNumWords));
+
+    // Share 0: random data, share 1: pow ^ share0.
+    ghash_block_t share0;
+    ghash_block_t share1;
+    HARDENED_TRY(hardened_memshred(share0.data, kGhashBlockNumWords));
+    HARDENED_TRY(hardened_xor(share0.data, pow.data, kGhashBlockNumWords,
+                              share1.data));
+    HARDENED_TRY(ghash_init_subkey(share0.data, ctx->pow_tbl0[k]));
+    HARDENED_TRY(ghash_init_subkey(share1.data, ctx->pow_tbl1[k]));
+  }
+
+  // Clear the unmasked value.
+  HARDENED_TRY(hardened_memshred(pow.data, kGhashBlockNumWords));
+#else
+  OT_DISCARD(hash_subkey);
+  OT_DISCARD(ctx);
+#endif
+  return OTCRYPTO_OK;
+}
 
 /**
  * Single-block update function for GHASH.
@@ -345,8 +499,10 @@ static status_t ghash_process_block(ghash_context_t *ctx,
   }
 
   // Check that the context's checksum is correct.
-  HARDENED_CHECK_EQ(ghash_context_integrity_checksum_check(ctx),
-                    kHardenedBoolTrue);
+  if (kCheckEveryBlock) {
+    HARDENED_CHECK_EQ(ghash_context_integrity_checksum_check(ctx),
+                      kHardenedBoolTrue);
+  }
 
   // Increment the number of processed ghash block counter.
   ctx->ghash_block_cnt++;
@@ -354,6 +510,63 @@ static status_t ghash_process_block(ghash_context_t *ctx,
   return OTCRYPTO_OK;
 }
 
+#ifdef OTCRYPTO_GHASH_AGGREGATE
+/**
+ * Aggregated update function for GHASH.
+ *
+ * Incorporates `kGhashAggregateNumBlocks` blocks X1..X4 at once, computing
+ * (Y + X1) * H^4 + X2 * H^3 + X3 * H^2 + X4 * H with a single reduction per
+ * window. The masking follows the single-block update, with the shares Pk0
+ * and Pk1 of the powers H^k in place of the subkey shares:
+ *
+ *   tmp = (share0 + X1) + share1
+ *   share0 = tmp * P40 + X2 * P30 + X3 * P20 + X4 * H0 + (S0 * (P40 + 1))
+ *   share1 = tmp * P41 + X2 * P31 + X3 * P21 + X4 * H1 + (S0 * P41)
+ *
+ * Must not be used for the first block of a GHASH operation, which is masked
+ * with the encrypted initial counter block instead of the state.
+ *
+ * Does not check the context integrity; the caller does (see
+ * `kCheckEveryBlock`).
+ *
+ * @param ctx GHASH context.
+ * @param blocks Blocks to incorporate; the first one is overwritten.
+ */
+static status_t ghash_process_blocks_aggregate(
+    ghash_context_t *ctx, ghash_block_t blocks[kGhashAggregateNumBlocks]) {
+  // Product tables, highest power of H first.
+  ghash_block_t *tbls0[kGhashAggregateNumBlocks];
+  ghash_block_t *tbls1[kGhashAggregateNumBlocks];
+  for (size_t j = 0; j < kGhashAggregateNumBlocks - 1; ++j) {
+    tbls0[j] = ctx->pow_tbl0[kGhashAggregateNumBlocks - 2 - j];
+    tbls1[j] = ctx->pow_tbl1[kGhashAggregateNumBlocks - 2 - j];
+  }
+  tbls0[kGhashAggregateNumBlocks - 1] = ctx->tbl0;
+  tbls1[kGhashAggregateNumBlocks - 1] = ctx->tbl1;
+
+  // tmp = (share0+X1)+share1
+  hardened_xor_in_place(blocks[0].data, ctx->state0.data, kGhashBlockNumWords);
+  hardened_xor_in_place(blocks[0].data, ctx->state1.data, kGhashBlockNumWords);
+
+  // Process share 0.
+  ghash_block_t s0_tmp = galois_mul_aggregate(blocks, tbls0);
+  hardened_memcpy(ctx->state0.data, s0_tmp.data, kGhashBlockNumWords);
+  hardened_xor_in_place(ctx->state0.data, ctx->correction_term0_aggregate.data,
+                        kGhashBlockNumWords);
+
+  // Process share 1.
+  ghash_block_t s1_tmp = galois_mul_aggregate(blocks, tbls1);
+  hardened_memcpy(ctx->state1.data, s1_tmp.data, kGhashBlockNumWords);
+  hardened_xor_in_place(ctx->state1.data, ctx->correction_term1_aggregate.data,
+                        kGhashBlockNumWords);
+
+  // Increment the number of processed ghash block counter.
+  ctx->ghash_block_cnt += kGhashAggregateNumBlocks;
+
+  return OTCRYPTO_OK;
+}
+#endif
+
 status_t ghash_process_full_blocks(ghash_context_t *ctx, size_t partial_len,
                                    ghash_block_t *partial, size_t input_len,
                                    const uint8_t *input) {
@@ -372,6 +585,18 @@ status_t ghash_process_full_blocks(ghash_context_t *ctx, size_t partial_len,
     // Process the block.
     HARDENED_TRY(ghash_process_block(ctx, partial));
 
+#ifdef OTCRYPTO_GHASH_AGGREGATE
+    // Process groups of full blocks with a single reduction per group. The
+    // first block of the GHASH operation has been processed above.
+    while (input_len >= kGhashAggregateNumBlocks * kGhashBlockNumBytes) {
+      ghash_block_t blocks[kGhashAggregateNumBlocks];
+      randomized_bytecopy(blocks, input, sizeof(blocks));
+      HARDENED_TRY(ghash_process_blocks_aggregate(ctx, blocks));
+      input += sizeof(blocks);
+      input_len -= sizeof(blocks);
+    }
+#endif
+
     // Process any remaining full blocks of input.
     while (input_len >= kGhashBlockNumBytes) {
       randomized_bytecopy(partial->data, input, kGhashBlockNumBytes);
@@ -382,6 +607,13 @@ status_t ghash_process_full_blocks(ghash_context_t *ctx, size_t partial_len,
 
     // Copy any remaining input into the partial block.
     randomized_bytecopy(partial->data, input, input_len);
+
+    // Check that the context's checksum is correct, if this has not been done
+    // for every block.
+    if (!kCheckEveryBlock) {
+      HARDENED_CHECK_EQ(ghash_context_integrity_checksum_check(ctx),
+                        kHardenedBoolTrue);
+    }
   }
 
   return OTCRYPTO_OK;
@@ -400,6 +632,10 @@ status_t ghash_update(ghash_context_t *ctx, size_t input_len,
     unsigned char *partial_bytes = (unsigned char *)partial.data;
     memset(partial_bytes + partial_len, 0, kGhashBlockNumBytes - partial_len);
     HARDENED_TRY(ghash_process_block(ctx, &partial));
+    if (!kCheckEveryBlock) {
+      HARDENED_CHECK_EQ(ghash_context_integrity_checksum_check(ctx),
+                        kHardenedBoolTrue);
+    }
   }
 
   return OTCRYPTO_OK;
@@ -407,18 +643,30 @@ status_t ghash_update(ghash_context_t *ctx, size_t input_len,
 
 status_t ghash_update_redundant(ghash_context_t *ctx, size_t input_len,
                                 const uint8_t *input) {
-  // Copy ctx.
-  ghash_context_t ctx_redundant;
-  randomized_bytecopy(&ctx_redundant, ctx, sizeof(ctx_redundant));
+  // Save the part of the context that an update modifies. The product tables
+  // and correction terms are only read, so both computations share them
+  // instead of copying the whole context.
+  ghash_block_t state0;
+  ghash_block_t state1;
+  hardened_memcpy(state0.data, ctx->state0.data, kGhashBlockNumWords);
+  hardened_memcpy(state1.data, ctx->state1.data, kGhashBlockNumWords);
+  size_t ghash_block_cnt = ctx->ghash_block_cnt;
 
   HARDENED_TRY(ghash_update(ctx, input_len, input));
-
-  ghash_update(&ctx_redundant, input_len, input);
+  ghash_block_t state0_redundant;
+  hardened_memcpy(state0_redundant.data, ctx->state0.data,
+                  kGhashBlockNumWords);
+
+  // Restore the saved state and repeat the update.
+  hardened_memcpy(ctx->state0.data, state0.data, kGhashBlockNumWords);
+  hardened_memcpy(ctx->state1.data, state1.data, kGhashBlockNumWords);
+  ctx->ghash_block_cnt = ghash_block_cnt;
+  HARDENED_TRY(ghash_update(ctx, input_len, input));
 
   // Compare the GHASH state. Do this only at a single share to avoid
   // introducing SCA leakage. Use consttime_memeq_byte() to avoid DFA.
   HARDENED_CHECK_EQ(
-      consttime_memeq_byte(&ctx->state0.data, ctx_redundant.state0.data,
+      consttime_memeq_byte(&ctx->state0.data, state0_redundant.data,
                            kGhashBlockNumBytes),
       kHardenedBoolTrue);
 
@@ -442,6 +690,17 @@ status_t ghash_handle_enc_initial_counter_block(
   hardened_memcpy(s1.data, enc_initial_counter_block1, kGhashBlockNumWords);
   ctx->correction_term1_init = galois_mul_state_key(s1, ctx->tbl1);
 
+#ifdef OTCRYPTO_GHASH_AGGREGATE
+  // correction_term0_aggregate = S0 * (P0 + 1), with P0 share 0 of H^4.
+  mul_tmp =
+      galois_mul_state_key(s0, ctx->pow_tbl0[kGhashAggregateNumBlocks - 2]);
+  block_xor(&mul_tmp, &s0, &ctx->correction_term0_aggregate);
+
+  // correction_term1_aggregate = S0 * P1, with P1 share 1 of H^4.
+  ctx->correction_term1_aggregate =
+      galois_mul_state_key(s0, ctx->pow_tbl1[kGhashAggregateNumBlocks - 2]);
+#endif
+
   // Save the encrypted initial counter blocks into the ghash context as we
   // need them throughout the ghash computations.
   hardened_memcpy(ctx->enc_initial_counter_block0.data,
@@ -24,6 +24,48 @@ enum {
    * Size of a GHASH cipher block (128 bits) in words.
    */
   kGhashBlockNumWords = kGhashBlockNumBytes / sizeof(uint32_t),
+#ifdef OTCRYPTO_GHASH_8BIT_TABLES
+  /**
+   * Width of the windows in which the multiplier is processed.
+   *
+   * Set by `--define ghash_8bit_tables=true`. 8-bit windows halve the number
+   * of shift-and-reduce steps per multiplication, at the price of 4KiB per
+   * product table instead of 256B. This grows `otcrypto_aes_gcm_context_t`
+   * from 776B to 8.3KiB, or to 32.3KiB together with `ghash_aggregate`.
+   *
+   * Contexts of this size do not fit on the stack. In these configurations,
+   * one-shot AES-GCM operations use a statically allocated context, which
+   * costs as much RAM, and streaming operations work on the caller's context
+   * in place. Callers must not put the streaming context on the stack either.
+   */
+  kGhashWindowNumBits = 8,
+#else
+  /**
+   * Width of the windows in which the multiplier is processed.
+   */
+  kGhashWindowNumBits = 4,
+#endif
+  /**
+   * Number of entries in a product table (one per window value).
+   */
+  kGhashTableNumEntries = 1 << kGhashWindowNumBits,
+#ifdef OTCRYPTO_GHASH_AGGREGATE
+  /**
+   * Number of blocks folded into the state per modular reduction.
+   *
+   * Set by `--define ghash_aggregate=true`. Consecutive blocks are processed
+   * as X1*H^4 + X2*H^3 + X3*H^2 + X4*H, which needs product tables for the
+   * powers of the hash subkey. This grows `otcrypto_aes_gcm_context_t` from
+   * 776B to 2.3KiB, and the context is not kept on the stack, see
+   * `kGhashWindowNumBits`.
+   */
+  kGhashAggregateNumBlocks = 4,
+#else
+  /**
+   * Number of blocks folded into the state per modular reduction.
+   */
+  kGhashAggregateNumBlocks = 1,
+#endif
 };
 
 /**
@@ -37,11 +79,31 @@ typedef struct ghash_context {
   /**
    * Precomputed product table for the hash subkey share 0.
    */
-  ghash_block_t tbl0[16];
+  ghash_block_t tbl0[kGhashTableNumEntries];
   /**
    * Precomputed product table for the hash subkey share 1.
    */
-  ghash_block_t tbl1[16];
+  ghash_block_t tbl1[kGhashTableNumEntries];
+#ifdef OTCRYPTO_GHASH_AGGREGATE
+  /**
+   * Precomputed product tables for share 0 of H^2, H^3 and H^4.
+   */
+  ghash_block_t pow_tbl0[kGhashAggregateNumBlocks - 1][kGhashTableNumEntries];
+  /**
+   * Precomputed product tables for share 1 of H^2, H^3 and H^4.
+   */
+  ghash_block_t pow_tbl1[kGhashAggregateNumBlocks - 1][kGhashTableNumEntries];
+  /**
+   * Precomputed correction term (S0 * (P0+1)) for state share 0 after an
+   * aggregated update, where P0 is share 0 of H^4.
+   */
+  ghash_block_t correction_term0_aggregate;
+  /**
+   * Precomputed correction term (S0 * P1) for state share 1 after an
+   * aggregated update, where P1 is share 1 of H^4.
+   */
+  ghash_block_t correction_term1_aggregate;
+#endif
   /**
    * Cipher block representing the current GHASH state for share 0.
    */
@@ -120,6 +182,24 @@ hardened_bool_t ghash_context_integrity_checksum_check(
  */
 status_t ghash_init_subkey(const uint32_t *hash_subkey, ghash_block_t *tbl);
 
+/**
+ * Precompute the product tables for the powers of the hash subkey.
+ *
+ * Only does work in builds with aggregated reduction; otherwise this is a
+ * no-op. Computes H^2, H^3 and H^4, splits each of them into two fresh random
+ * shares and populates the power tables of the context. Call this routine
+ * once per key, after `ghash_init_subkey` has populated the product tables of
+ * both subkey shares, and before `ghash_handle_enc_initial_counter_block`.
+ *
+ * The caller already holds the unmasked hash subkey when it creates the
+ * shares for `ghash_init_subkey`, so this routine takes it unmasked as well.
+ *
+ * @param hash_subkey Unmasked hash subkey (`kGhashBlockNumWords` words).
+ * @param ctx Context object.
+ */
+status_t ghash_init_subkey_powers(const uint32_t *hash_subkey,
+                                  ghash_context_t *ctx);
+
 /**
  * Start a GHASH operation.
  *
@@ -171,8 +251,9 @@ status_t ghash_update(ghash_context_t *ctx, size_t input_len,
 /**
  * Redundant version of ghash_update().
  *
- * Creates a copy of ctx and executes ghash_update() twice.
- * Compares the GHASH state stored in ctx after the redundant comparison.
+ * Saves the GHASH state of ctx and executes ghash_update() twice from it.
+ * Both computations share the product tables, so this needs no copy of the
+ * whole context. Compares the GHASH state after the redundant computation.
  * The comparison is done on share s0 to avoid introducing SCA leakage.
  * If the comparison fails, trap.
  *
@@ -190,6 +271,11 @@ status_t ghash_update_redundant(ghash_context_t *ctx, size_t input_len,
  * correction_term1 = S0 * H1.
  * correction_term1_init = S1 * H1.
  *
+ * With aggregated reduction, also the terms for the shares P0, P1 of H^4:
+ *
+ * correction_term0_aggregate = S0 * (P0 + 1).
+ * correction_term1_aggregate = S0 * P1.
+ *
  * @param enc_initial_counter_block0 Pointer to S0.
  * @param enc_initial_counter_block1 Pointer to S1.
  * @param ctx Context object.
@@ -36,11 +36,21 @@ typedef enum otcrypto_aes_gcm_tag_len {
  * Context for a streaming AES-GCM operation.
  *
  * Representation is internal to the AES-GCM implementation and subject to
- * change.
+ * change. The size depends on the GHASH configuration of the library build
+ * (`--define ghash_8bit_tables=true` and `--define ghash_aggregate=true`),
+ * which grows the precomputed product tables.
  */
 typedef struct otcrypto_aes_gcm_context {
   // TODO: update the size and the restore and save context functions.
+#if defined(OTCRYPTO_GHASH_8BIT_TABLES) && defined(OTCRYPTO_GHASH_AGGREGATE)
+  uint32_t data[8266];
+#elif defined(OTCRYPTO_GHASH_8BIT_TABLES)
+  uint32_t data[2114];
+#elif defined(OTCRYPTO_GHASH_AGGREGATE)
+  uint32_t data[586];
+#else
   uint32_t data[194];
+#endif
 } otcrypto_aes_gcm_context_t;
 
 /**
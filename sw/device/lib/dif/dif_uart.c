@@ -336,6 +336,17 @@ dif_result_t dif_uart_byte_send_polled(const dif_uart_t *uart, uint8_t byte) {
   return kDifOk;
 }
 
+dif_result_t dif_uart_wait_until_tx_idle(const dif_uart_t *uart) {
+  if (uart == NULL) {
+    return kDifBadArg;
+  }
+
+  while (!uart_tx_idle(uart)) {
+  }
+
+  return kDifOk;
+}
+
 dif_result_t dif_uart_byte_receive_polled(const dif_uart_t *uart,
                                           uint8_t *byte) {
   if (uart == NULL || byte == NULL) {
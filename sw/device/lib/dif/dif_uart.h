@@ -278,6 +278,18 @@ dif_result_t dif_uart_bytes_receive(const dif_uart_t *uart,
 OT_WARN_UNUSED_RESULT
 dif_result_t dif_uart_byte_send_polled(const dif_uart_t *uart, uint8_t byte);
 
+/**
+ * Waits until the UART has sent all bytes in the TX FIFO (polled).
+ *
+ * This operation is polled, and will busy wait until the TX FIFO is drained
+ * and HW has finished sending the last byte.
+ *
+ * @param uart A UART handle.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_uart_wait_until_tx_idle(const dif_uart_t *uart);
+
 /**
  * Receives a single UART byte (polled).
  *
@@ -458,6 +458,20 @@ TEST_F(BytesSendPolledTest, Success) {
   EXPECT_DIF_OK(dif_uart_byte_send_polled(&uart_, 'X'));
 }
 
+class WaitUntilTxIdleTest : public UartTest {};
+
+TEST_F(WaitUntilTxIdleTest, NullArgs) {
+  EXPECT_DIF_BADARG(dif_uart_wait_until_tx_idle(nullptr));
+}
+
+TEST_F(WaitUntilTxIdleTest, Success) {
+  // Busy loop 1 iteration (waiting for the FIFO to be sent out by the HW)
+  EXPECT_READ32(UART_STATUS_REG_OFFSET, {{UART_STATUS_TXIDLE_BIT, false}});
+  EXPECT_READ32(UART_STATUS_REG_OFFSET, {{UART_STATUS_TXIDLE_BIT, true}});
+
+  EXPECT_DIF_OK(dif_uart_wait_until_tx_idle(&uart_));
+}
+
 class BytesReceivePolledTest : public UartTest {};
 
 TEST_F(BytesReceivePolledTest, NullArgs) {
@@ -16,6 +16,12 @@ extern "C" {
     field(crc, uint32_t)
 UJSON_SERDE_STRUCT(OttfCrc, ottf_crc_t, STRUCT_OTTF_CRC);
 
+// Values match `ujson_encoding_t`.
+#define ENUM_OTTF_ENCODING(_, value) \
+    value(_, Json) \
+    value(_, Binary)
+UJSON_SERDE_ENUM(OttfEncoding, ottf_encoding_t, ENUM_OTTF_ENCODING);
+
 #undef MODULE_ID
 
 // clang-format on
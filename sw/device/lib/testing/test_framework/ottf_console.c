@@ -55,6 +55,14 @@ void ottf_console_init(void) {
       if (kOttfTestConfig.enable_uart_flow_control) {
         ottf_console_uart_flow_control_enable(&main_console);
       }
+      // Initialize/Configure interrupt-driven TX (if requested).
+      if (kOttfTestConfig.console.uart_tx_buffered) {
+        size_t main_tx_ring_sz;
+        char *main_tx_ring =
+            ottf_console_uart_get_main_tx_ring(&main_tx_ring_sz);
+        ottf_console_uart_tx_irq_enable(&main_console, main_tx_ring,
+                                        main_tx_ring_sz);
+      }
       break;
 #endif
 #ifdef OTTF_CONSOLE_HAS_SPI_DEVICE
@@ -84,7 +92,13 @@ void ottf_console_init(void) {
 
 uint32_t ottf_console_get_flow_control_irqs(void) { return flow_control_irqs; }
 
-bool ottf_console_flow_control_isr(uint32_t *exc_info) {
+bool ottf_console_flow_control_isr(uint32_t *exc_info, uint32_t plic_irq_id) {
+#ifdef OTTF_CONSOLE_HAS_UART
+  if (main_console.type == kOttfConsoleUart &&
+      ottf_console_uart_tx_isr(exc_info, &main_console, plic_irq_id)) {
+    return true;
+  }
+#endif
   flow_control_irqs += 1;
 #ifdef OTTF_CONSOLE_HAS_UART
   return ottf_console_uart_flow_control_isr(exc_info, &main_console);
@@ -116,7 +130,7 @@ void ottf_console_set_buffering(ottf_console_t *console, bool enabled,
   console->buf_end = 0;
 }
 
-status_t ottf_console_flush(ottf_console_t *console) {
+static status_t ottf_console_flush_staging(ottf_console_t *console) {
   if (console->buffered && console->buf_end > 0) {
     size_t written_len = console->sink(console, console->buf, console->buf_end);
     size_t lost = console->buf_end - written_len;
@@ -130,6 +144,24 @@ status_t ottf_console_flush(ottf_console_t *console) {
   return OK_STATUS(0);
 }
 
+status_t ottf_console_flush(ottf_console_t *console) {
+  status_t res = ottf_console_flush_staging(console);
+#ifdef OTTF_CONSOLE_HAS_UART
+  if (console->type == kOttfConsoleUart) {
+    TRY(ottf_console_uart_tx_flush(console));
+  }
+#endif
+  return res;
+}
+
+void test_status_flush_console(void) {
+#ifdef OTTF_CONSOLE_HAS_UART
+  if (main_console.type == kOttfConsoleUart) {
+    OT_DISCARD(ottf_console_uart_tx_flush(&main_console));
+  }
+#endif
+}
+
 static status_t ottf_console_write_unbuffered(ottf_console_t *console,
                                               const char *buf, size_t len) {
   size_t written_len = console->sink(console, buf, len);
@@ -144,7 +176,7 @@ static status_t ottf_console_write_buffered(ottf_console_t *console,
                                             const char *buf, size_t len) {
   if (len > console->buf_size) {
     // Flush and skip the staging buffer if the payload is already the max size.
-    TRY(ottf_console_flush(console));
+    TRY(ottf_console_flush_staging(console));
     return ottf_console_write_unbuffered(console, buf, len);
   } else if ((console->buf_end + len) <= console->buf_size) {
     // There is room for the data in the staging buffer, copy it over.
@@ -153,7 +185,7 @@ static status_t ottf_console_write_buffered(ottf_console_t *console,
     return OK_STATUS((int32_t)len);
   } else {
     // The staging buffer is almost full; flush it before staging more data.
-    TRY(ottf_console_flush(console));
+    TRY(ottf_console_flush_staging(console));
     memcpy(&console->buf[console->buf_end], buf, len);
     console->buf_end += len;
     return OK_STATUS((int32_t)len);
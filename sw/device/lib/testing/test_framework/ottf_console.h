@@ -89,13 +89,15 @@ status_t ottf_console_flow_control(ottf_console_t *console,
 /**
  * Manage console flow control *for the main console* from interrupt context.
  *
- * Call this when a console UART interrupt triggers.
+ * Call this when a console UART interrupt triggers. This also refills the UART
+ * TX FIFO if the main console transmits from interrupts.
  *
  * @param exc_info The OTTF execution info passed to all ISRs.
- * @return True if an RX Watermark IRQ was detected and handled. False
+ * @param plic_irq_id The IRQ ID claimed at the PLIC.
+ * @return True if an RX or TX Watermark IRQ was detected and handled. False
  * otherwise.
  */
-bool ottf_console_flow_control_isr(uint32_t *exc_info);
+bool ottf_console_flow_control_isr(uint32_t *exc_info, uint32_t plic_irq_id);
 
 /**
  * Returns the number of OTTF console flow control interrupts that have
@@ -116,6 +118,9 @@ status_t ottf_console_putbuf(void *io, const char *buf, size_t len);
 /**
  * Flush remaining buffered data to the OTTF console.
  *
+ * This flushes the staging buffer, and for a UART console transmitting from
+ * interrupts, waits until all queued output has been sent.
+ *
  * On success, an OK_STATUS is returned with the number of flushed bytes.
  * On error, the unflushed data will be lost.
  *
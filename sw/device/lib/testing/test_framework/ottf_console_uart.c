@@ -5,6 +5,10 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "sw/device/lib/base/bitfield.h"
+#include "sw/device/lib/base/csr.h"
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/base/mmio.h"
 #include "sw/device/lib/base/status.h"
 #include "sw/device/lib/dif/dif_pinmux.h"
@@ -15,6 +19,8 @@
 #include "sw/device/lib/testing/test_framework/ottf_console.h"
 #include "sw/device/lib/testing/test_framework/ottf_isrs.h"
 
+#include "hw/top/uart_regs.h"  // Generated.
+
 #define MODULE_ID MAKE_MODULE_ID('o', 'c', 'u')
 
 /**
@@ -27,6 +33,16 @@ enum {
   kFlowControlLowWatermark = 4,   // bytes
   kFlowControlHighWatermark = 8,  // bytes
   kFlowControlRxWatermark = kDifUartWatermarkByte8,
+  /**
+   * Interrupt-driven TX parameters. The TX watermark IRQ fires while fewer
+   * than 16 bytes are queued in the TX FIFO.
+   */
+  kTxWatermark = kDifUartWatermarkByte16,
+  kMainTxRingSize = 1024,  // bytes
+  /**
+   * Global interrupt enable bit of the `mstatus` CSR.
+   */
+  kMstatusMieBit = 3,
   /**
    * HART PLIC Target.
    */
@@ -43,15 +59,165 @@ static status_t ottf_console_uart_getc(void *io) {
 
 static size_t ottf_console_uart_sink(void *io, const char *buf, size_t len) {
   ottf_console_t *console = io;
-  for (size_t i = 0; i < len; ++i) {
-    if (dif_uart_byte_send_polled(&console->data.uart.dif, (uint8_t)buf[i]) !=
-        kDifOk) {
-      return i;
+  const dif_uart_t *uart = &console->data.uart.dif;
+  // Keep the TX FIFO topped up and only wait for the transmitter to go idle
+  // once the whole buffer is queued.
+  size_t sent = 0;
+  while (sent < len) {
+    size_t written;
+    if (dif_uart_bytes_send(uart, (const uint8_t *)&buf[sent], len - sent,
+                            &written) != kDifOk) {
+      return sent;
     }
+    sent += written;
+  }
+  // The bytes are in the TX FIFO even if waiting for them to go out fails.
+  OT_DISCARD(dif_uart_wait_until_tx_idle(uart));
+  return sent;
+}
+
+static char main_tx_ring[kMainTxRingSize];
+
+char *ottf_console_uart_get_main_tx_ring(size_t *size) {
+  *size = sizeof(main_tx_ring);
+  return main_tx_ring;
+}
+
+static bool cpu_irqs_enabled(void) {
+  uint32_t mstatus;
+  CSR_READ(CSR_REG_MSTATUS, &mstatus);
+  return bitfield_bit32_read(mstatus, kMstatusMieBit);
+}
+
+/**
+ * Takes ownership of the TX ring buffer.
+ *
+ * Interrupts are disabled at the CPU so that no ISR, including ISRs that log,
+ * can touch the ring buffer until `tx_ring_unlock()`. All interrupts of the
+ * UART are masked as well, and their previous state saved in `snapshot`.
+ *
+ * @return Whether interrupts were enabled at the CPU.
+ */
+static bool tx_ring_lock(ottf_console_uart_t *uart,
+                         dif_uart_irq_enable_snapshot_t *snapshot) {
+  bool irqs_enabled = cpu_irqs_enabled();
+  irq_global_ctrl(false);
+  CHECK_DIF_OK(dif_uart_irq_disable_all(&uart->dif, snapshot));
+  uart->tx_locked = true;
+  return irqs_enabled;
+}
+
+/**
+ * Restores the UART interrupts, with the TX watermark IRQ enabled only if
+ * `pending` bytes are left for the TX ISR to send, then re-enables interrupts
+ * at the CPU if they were enabled when the ring buffer was locked.
+ */
+static void tx_ring_unlock(ottf_console_uart_t *uart,
+                           dif_uart_irq_enable_snapshot_t *snapshot,
+                           size_t pending, bool irqs_enabled) {
+  uart->tx_locked = false;
+  *snapshot = bitfield_bit32_write(*snapshot, UART_INTR_COMMON_TX_WATERMARK_BIT,
+                                   pending > 0);
+  CHECK_DIF_OK(dif_uart_irq_restore_all(&uart->dif, snapshot));
+  if (irqs_enabled) {
+    irq_global_ctrl(true);
+  }
+}
+
+/**
+ * Copies as much of `buf` as fits into the TX ring buffer.
+ *
+ * @return The number of bytes copied.
+ */
+static size_t tx_ring_push(ottf_console_uart_t *uart, const char *buf,
+                           size_t len) {
+  uint32_t head = uart->tx_head;
+  size_t level = head - uart->tx_tail;
+  len = MIN(len, uart->tx_ring_size - level);
+  size_t offset = head & (uart->tx_ring_size - 1);
+  size_t first = MIN(len, uart->tx_ring_size - offset);
+  memcpy(&uart->tx_ring[offset], buf, first);
+  memcpy(uart->tx_ring, &buf[first], len - first);
+  uart->tx_head = head + len;
+
+  level += len;
+  if (level > uart->tx_stats.max_level) {
+    uart->tx_stats.max_level = level;
   }
   return len;
 }
 
+/**
+ * Moves bytes from the TX ring buffer to the TX FIFO until either the ring
+ * buffer is empty or the FIFO is full.
+ *
+ * Must be called with the TX ring buffer locked or from the TX ISR.
+ *
+ * @return The number of bytes left in the ring buffer.
+ */
+static size_t tx_ring_drain(ottf_console_uart_t *uart) {
+  uint32_t head = uart->tx_head;
+  uint32_t tail = uart->tx_tail;
+  while (head != tail) {
+    size_t offset = tail & (uart->tx_ring_size - 1);
+    size_t chunk = MIN(head - tail, uart->tx_ring_size - offset);
+    size_t written;
+    if (dif_uart_bytes_send(&uart->dif, (const uint8_t *)&uart->tx_ring[offset],
+                            chunk, &written) != kDifOk) {
+      break;
+    }
+    tail += written;
+    if (written < chunk) {
+      break;
+    }
+  }
+  uart->tx_tail = tail;
+  return head - tail;
+}
+
+/**
+ * Sends everything in the TX ring buffer and waits for the transmitter to go
+ * idle. Must be called with the TX ring buffer locked.
+ */
+static void tx_ring_flush(ottf_console_uart_t *uart) {
+  while (tx_ring_drain(uart) > 0) {
+  }
+  OT_DISCARD(dif_uart_wait_until_tx_idle(&uart->dif));
+}
+
+static size_t ottf_console_uart_sink_irq(void *io, const char *buf,
+                                         size_t len) {
+  ottf_console_t *console = io;
+  ottf_console_uart_t *uart = &console->data.uart;
+  // The TX ISR cannot run while the CPU has interrupts disabled, e.g. when
+  // called from an ISR, so in that case everything queued so far is sent
+  // before returning.
+  bool sync = !cpu_irqs_enabled();
+  size_t queued = 0;
+  bool stalled = false;
+  while (true) {
+    dif_uart_irq_enable_snapshot_t snapshot;
+    bool irqs_enabled = tx_ring_lock(uart, &snapshot);
+    queued += tx_ring_push(uart, &buf[queued], len - queued);
+    size_t pending = tx_ring_drain(uart);
+    if (queued == len && sync) {
+      tx_ring_flush(uart);
+      pending = 0;
+    }
+    tx_ring_unlock(uart, &snapshot, pending, irqs_enabled);
+    if (queued == len) {
+      break;
+    }
+    // The ring buffer is full, retry once the UART has made some room.
+    stalled = true;
+  }
+  if (stalled) {
+    ++uart->tx_stats.stalls;
+  }
+  uart->tx_stats.bytes += len;
+  return len;
+}
+
 void ottf_console_configure_uart(ottf_console_t *console, uintptr_t base_addr) {
   console->type = kOttfConsoleUart;
   CHECK_DIF_OK(
@@ -70,19 +236,35 @@ void ottf_console_configure_uart(ottf_console_t *console, uintptr_t base_addr) {
                              .rx_enable = kDifToggleEnabled,
                          }));
 
+  console->data.uart.tx_ring = NULL;
+  console->data.uart.tx_ring_size = 0;
+  console->data.uart.tx_stats = (ottf_console_uart_tx_stats_t){0};
+
   console->getc = ottf_console_uart_getc;
   console->sink = ottf_console_uart_sink;
 }
 
-static uint32_t get_flow_control_watermark_plic_id(ottf_console_t *console) {
+static uint32_t get_plic_id(ottf_console_t *console, dt_uart_irq_t irq) {
   for (size_t i = 0; i < kDtUartCount; i++) {
     dt_uart_t uart = (dt_uart_t)i;
     if (console->data.uart.dif.base_addr.base ==
         (void *)dt_uart_primary_reg_block(uart)) {
-      return dt_uart_irq_to_plic_id(uart, kDtUartIrqRxWatermark);
+      return dt_uart_irq_to_plic_id(uart, irq);
     }
   }
-  return dt_uart_irq_to_plic_id(kDtUart0, kDtUartIrqRxWatermark);
+  return dt_uart_irq_to_plic_id(kDtUart0, irq);
+}
+
+static void plic_irq_enable(uint32_t plic_id) {
+  // Set IRQ priorities to MAX
+  CHECK_DIF_OK(
+      dif_rv_plic_irq_set_priority(&ottf_plic, plic_id, kDifRvPlicMaxPriority));
+  // Set Ibex IRQ priority threshold level
+  CHECK_DIF_OK(dif_rv_plic_target_set_threshold(&ottf_plic, kPlicTarget,
+                                                kDifRvPlicMinPriority));
+  // Enable IRQs in PLIC
+  CHECK_DIF_OK(dif_rv_plic_irq_set_enabled(&ottf_plic, plic_id, kPlicTarget,
+                                           kDifToggleEnabled));
 }
 
 void ottf_console_uart_flow_control_enable(ottf_console_t *console) {
@@ -92,17 +274,7 @@ void ottf_console_uart_flow_control_enable(ottf_console_t *console) {
   CHECK_DIF_OK(dif_uart_irq_set_enabled(uart, kDifUartIrqRxWatermark,
                                         kDifToggleEnabled));
 
-  // Set IRQ priorities to MAX
-  CHECK_DIF_OK(dif_rv_plic_irq_set_priority(
-      &ottf_plic, get_flow_control_watermark_plic_id(console),
-      kDifRvPlicMaxPriority));
-  // Set Ibex IRQ priority threshold level
-  CHECK_DIF_OK(dif_rv_plic_target_set_threshold(&ottf_plic, kPlicTarget,
-                                                kDifRvPlicMinPriority));
-  // Enable IRQs in PLIC
-  CHECK_DIF_OK(dif_rv_plic_irq_set_enabled(
-      &ottf_plic, get_flow_control_watermark_plic_id(console), kPlicTarget,
-      kDifToggleEnabled));
+  plic_irq_enable(get_plic_id(console, kDtUartIrqRxWatermark));
 
   console->data.uart.flow_control_state = kOttfConsoleFlowControlAuto;
   irq_global_ctrl(true);
@@ -111,6 +283,84 @@ void ottf_console_uart_flow_control_enable(ottf_console_t *console) {
   ottf_console_flow_control(console, kOttfConsoleFlowControlResume);
 }
 
+void ottf_console_uart_tx_irq_enable(ottf_console_t *console, char *buf,
+                                     size_t size) {
+  CHECK(console->type == kOttfConsoleUart);
+  CHECK(size > 0 && (size & (size - 1)) == 0,
+        "TX ring size must be a power of two");
+  ottf_console_uart_t *uart = &console->data.uart;
+  CHECK_DIF_OK(dif_uart_irq_set_enabled(&uart->dif, kDifUartIrqTxWatermark,
+                                        kDifToggleDisabled));
+  CHECK_DIF_OK(dif_uart_watermark_tx_set(&uart->dif, kTxWatermark));
+  uart->tx_ring = buf;
+  uart->tx_ring_size = size;
+  uart->tx_head = 0;
+  uart->tx_tail = 0;
+  uart->tx_locked = false;
+  uart->tx_stats = (ottf_console_uart_tx_stats_t){0};
+
+  plic_irq_enable(get_plic_id(console, kDtUartIrqTxWatermark));
+  irq_global_ctrl(true);
+  irq_external_ctrl(true);
+  console->sink = ottf_console_uart_sink_irq;
+}
+
+bool ottf_console_uart_tx_isr(uint32_t *exc_info, ottf_console_t *console,
+                              uint32_t plic_irq_id) {
+  CHECK(console->type == kOttfConsoleUart);
+  ottf_console_uart_t *uart = &console->data.uart;
+  if (uart->tx_ring == NULL ||
+      plic_irq_id != get_plic_id(console, kDtUartIrqTxWatermark)) {
+    return false;
+  }
+  if (uart->tx_locked) {
+    // Interrupts are disabled at the CPU while the ring buffer is locked, so
+    // this is only reached if they were re-enabled in between. Leave the ring
+    // buffer alone and disable the status type TX watermark IRQ so that it
+    // does not fire again straight away; unlocking re-enables it if needed.
+    CHECK_DIF_OK(dif_uart_irq_set_enabled(&uart->dif, kDifUartIrqTxWatermark,
+                                          kDifToggleDisabled));
+    return true;
+  }
+  dif_toggle_t enabled;
+  CHECK_DIF_OK(
+      dif_uart_irq_get_enabled(&uart->dif, kDifUartIrqTxWatermark, &enabled));
+  bool pending;
+  CHECK_DIF_OK(
+      dif_uart_irq_is_pending(&uart->dif, kDifUartIrqTxWatermark, &pending));
+  if (enabled != kDifToggleEnabled || !pending) {
+    // The IRQ was disabled, e.g. by locking the ring buffer, after it had been
+    // raised at the PLIC. It is ours, so there is nothing else to handle.
+    return true;
+  }
+  uart->tx_stats.irqs += 1;
+  if (tx_ring_drain(uart) == 0) {
+    // TX watermark is a status type IRQ, disable it until there is more to
+    // send to avoid an infinite loop of ISRs.
+    CHECK_DIF_OK(dif_uart_irq_set_enabled(&uart->dif, kDifUartIrqTxWatermark,
+                                          kDifToggleDisabled));
+  }
+  return true;
+}
+
+status_t ottf_console_uart_tx_flush(ottf_console_t *console) {
+  TRY_CHECK(console->type == kOttfConsoleUart);
+  ottf_console_uart_t *uart = &console->data.uart;
+  if (uart->tx_ring == NULL) {
+    return OK_STATUS();
+  }
+  dif_uart_irq_enable_snapshot_t snapshot;
+  bool irqs_enabled = tx_ring_lock(uart, &snapshot);
+  tx_ring_flush(uart);
+  tx_ring_unlock(uart, &snapshot, 0, irqs_enabled);
+  return OK_STATUS();
+}
+
+ottf_console_uart_tx_stats_t ottf_console_uart_get_tx_stats(
+    const ottf_console_t *console) {
+  return console->data.uart.tx_stats;
+}
+
 // This version of the function is safe to call from within the ISR.
 static status_t manage_flow_control(ottf_console_t *console,
                                     ottf_console_flow_control_t ctrl) {
@@ -5,15 +5,50 @@
 #ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_TEST_FRAMEWORK_OTTF_CONSOLE_UART_H_
 #define OPENTITAN_SW_DEVICE_LIB_TESTING_TEST_FRAMEWORK_OTTF_CONSOLE_UART_H_
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/status.h"
 #include "sw/device/lib/dif/dif_uart.h"
 #include "sw/device/lib/testing/test_framework/ottf_console_types.h"
 
+/**
+ * Statistics of the interrupt-driven TX path.
+ */
+typedef struct ottf_console_uart_tx_stats {
+  /** Number of bytes queued into the TX ring buffer. */
+  uint32_t bytes;
+  /** Number of TX watermark interrupts serviced. */
+  uint32_t irqs;
+  /**
+   * Number of writes that found the TX ring buffer full and had to wait for
+   * it to drain (backpressure).
+   */
+  uint32_t stalls;
+  /** Highest number of bytes queued in the TX ring buffer. */
+  uint32_t max_level;
+} ottf_console_uart_tx_stats_t;
+
 typedef struct ottf_console_uart {
   // DIF handle.
   dif_uart_t dif;
   // This variable is shared between the interrupt service handler and user
   // code.
   volatile ottf_console_flow_control_t flow_control_state;
+  // TX ring buffer, NULL if the console transmits synchronously.
+  char *tx_ring;
+  // Size of `tx_ring`, a power of two.
+  size_t tx_ring_size;
+  // Free-running indices into `tx_ring`. Bytes are written at `tx_head` and
+  // sent from `tx_tail`. Shared with the TX interrupt service handler.
+  volatile uint32_t tx_head;
+  volatile uint32_t tx_tail;
+  // Set while user code owns the TX ring buffer, with interrupts disabled at
+  // the CPU and UART interrupts masked.
+  volatile bool tx_locked;
+  // TX statistics.
+  ottf_console_uart_tx_stats_t tx_stats;
 } ottf_console_uart_t;
 
 /**
@@ -58,6 +93,70 @@ void ottf_console_uart_flow_control_enable(ottf_console_t *console);
 bool ottf_console_uart_flow_control_isr(uint32_t *exc_info,
                                         ottf_console_t *console);
 
+/**
+ * Enable interrupt-driven transmission for the OTTF console.
+ *
+ * Output is queued in `buf` and moved to the UART TX FIFO by the TX watermark
+ * IRQ, so printing only waits for the serial line when the ring buffer is
+ * full. Output written while interrupts are disabled at the CPU (e.g. from an
+ * ISR or a fault handler) is sent synchronously along with everything queued
+ * before it, so that nothing is lost if the CPU never re-enables interrupts.
+ *
+ * Like flow control, this configures UART interrupts at the PLIC and enables
+ * interrupts at the CPU. The main console services the TX IRQ from
+ * `ottf_console_flow_control_isr`; for non-main consoles, you must call
+ * `ottf_console_uart_tx_isr` manually from your IRQ handler.
+ *
+ * @param console Pointer to the console.
+ * @param buf TX ring buffer.
+ * @param size Length of the TX ring buffer, must be a power of two.
+ */
+void ottf_console_uart_tx_irq_enable(ottf_console_t *console, char *buf,
+                                     size_t size);
+
+/**
+ * Returns the TX ring buffer used by the main console.
+ *
+ * @param[out] size Length of the buffer.
+ * @return Pointer to the buffer.
+ */
+char *ottf_console_uart_get_main_tx_ring(size_t *size);
+
+/**
+ * Refill the UART TX FIFO from interrupt context.
+ *
+ * You should only call this function directly for *non-main* consoles.
+ *
+ * @param exc_info The OTTF execution info passed to all ISRs.
+ * @param console Pointer to the console.
+ * @param plic_irq_id The IRQ ID claimed at the PLIC.
+ * @return True if `plic_irq_id` is the TX Watermark IRQ of the console and it
+ * was handled. False otherwise.
+ */
+bool ottf_console_uart_tx_isr(uint32_t *exc_info, ottf_console_t *console,
+                              uint32_t plic_irq_id);
+
+/**
+ * Wait until all queued output has been sent.
+ *
+ * Returns immediately if interrupt-driven transmission is not enabled, as the
+ * output is sent synchronously in that case.
+ *
+ * @param console Pointer to the console.
+ * @return OK or an error.
+ */
+status_t ottf_console_uart_tx_flush(ottf_console_t *console);
+
+/**
+ * Returns the TX statistics of the console.
+ *
+ * @param console Pointer to the console.
+ * @return A copy of the statistics, all zero if interrupt-driven transmission
+ * is not enabled.
+ */
+ottf_console_uart_tx_stats_t ottf_console_uart_get_tx_stats(
+    const ottf_console_t *console);
+
 /**
  * Manage flow control for UART.
  *
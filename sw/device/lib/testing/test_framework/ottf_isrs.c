@@ -191,7 +191,9 @@ void ottf_timer_isr(uint32_t *exc_info) {
 }
 
 OT_WEAK
-bool ottf_console_flow_control_isr(uint32_t *exc_info) { return false; }
+bool ottf_console_flow_control_isr(uint32_t *exc_info, uint32_t plic_irq_id) {
+  return false;
+}
 
 OT_WEAK
 void ottf_external_isr(uint32_t *exc_info) {
@@ -203,7 +205,7 @@ void ottf_external_isr(uint32_t *exc_info) {
   // See if the test code wants to handle it.
   bool handled = ottf_handle_irq(exc_info, devid, plic_irq_id);
   // If not, see if that interrupt corresponds to an OTTF console IRQ.
-  if (handled || ottf_console_flow_control_isr(exc_info)) {
+  if (handled || ottf_console_flow_control_isr(exc_info, plic_irq_id)) {
     // Complete the IRQ at PLIC.
     CHECK_DIF_OK(
         dif_rv_plic_irq_complete(&ottf_plic, kPlicTarget, plic_irq_id));
@@ -8,6 +8,7 @@
 #include <stdbool.h>
 
 #include "sw/device/lib/base/status.h"
+#include "sw/device/lib/coverage/api.h"
 #include "sw/device/lib/runtime/ibex.h"
 #include "sw/device/lib/runtime/log.h"
 #include "sw/device/lib/testing/test_framework/FreeRTOSConfig.h"
@@ -108,6 +109,9 @@ char *ottf_task_get_self_name(void);
 /**
  * Execute a test function, profile the execution and log the test result.
  * Update the result value if there is a failure code.
+ *
+ * In coverage builds with streaming enabled, the coverage collected by the
+ * test function is streamed afterwards, see `coverage_flush()`.
  */
 #define EXECUTE_TEST(result_, test_function_, ...)                       \
   do {                                                                   \
@@ -134,6 +138,7 @@ char *ottf_task_get_self_name(void);
       result_ = local_status;                                            \
       LOG_ERROR("Finished test " #test_function_ ": %r.", local_status); \
     }                                                                    \
+    coverage_flush();                                                    \
   } while (0)
 
 /**
@@ -40,6 +40,16 @@ typedef struct ottf_console_opt {
    * transmissions.
    */
   bool putbuf_buffered;
+  /**
+   * Indicates if the UART console should queue output in a ring buffer that is
+   * sent from the UART TX watermark interrupt, instead of waiting for every
+   * write to go out on the wire. Note that this will unmask the external
+   * interrupt and enable interrupt handling before `test_main` begins.
+   *
+   * Output is flushed before the test status is set, and written
+   * synchronously while interrupts are disabled at the CPU.
+   */
+  bool uart_tx_buffered;
 } ottf_console_opt_t;
 
 typedef struct ottf_console_tx_indicator {
@@ -0,0 +1,122 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hw/top/dt/api.h"       // Generated
+#include "hw/top/dt/rv_timer.h"  // Generated
+#include "sw/device/lib/arch/device.h"
+#include "sw/device/lib/base/status.h"
+#include "sw/device/lib/dif/dif_rv_timer.h"
+#include "sw/device/lib/runtime/ibex.h"
+#include "sw/device/lib/runtime/irq.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_console.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+OTTF_DEFINE_TEST_CONFIG(.console.uart_tx_buffered = true);
+
+static_assert(kDtRvTimerCount >= 1,
+              "This test requires at least one RV Timer instance");
+
+enum {
+  /**
+   * Enough lines to overflow the main console TX ring buffer.
+   */
+  kNumLines = 64,
+  /**
+   * Number of lines logged from the timer ISR while `test_main` is logging.
+   */
+  kNumIsrLines = 4,
+  kHart = 0,
+  kComparator = 0,
+  kTickFreqHz = 1000 * 1000,  // 1 MHz.
+};
+
+static dif_rv_timer_t timer;
+static volatile uint32_t isr_lines;
+
+/**
+ * Returns the time between two timer ISRs in microseconds, a few lines worth
+ * of UART time so that they land while `test_main` is logging.
+ */
+static uint64_t isr_period_us(void) {
+  return kDeviceType == kDeviceSimDV ? 100 : 10000;
+}
+
+static void timer_arm(void) {
+  uint64_t now;
+  CHECK_DIF_OK(dif_rv_timer_counter_read(&timer, kHart, &now));
+  CHECK_DIF_OK(
+      dif_rv_timer_arm(&timer, kHart, kComparator, now + isr_period_us()));
+}
+
+void ottf_timer_isr(uint32_t *exc_info) {
+  // Interrupts are disabled at the CPU here, so this line must go out
+  // synchronously, after all the output queued by `test_main` before it.
+  LOG_INFO("Line %d of %d from the timer ISR", isr_lines, kNumIsrLines);
+  isr_lines += 1;
+  CHECK_DIF_OK(dif_rv_timer_irq_acknowledge(
+      &timer, kDtRvTimerIrqTimerExpiredHart0Timer0));
+  if (isr_lines < kNumIsrLines) {
+    timer_arm();
+  } else {
+    CHECK_DIF_OK(
+        dif_rv_timer_counter_set_enabled(&timer, kHart, kDifToggleDisabled));
+  }
+}
+
+static void timer_start(void) {
+  dt_rv_timer_t dt = (dt_rv_timer_t)0;
+  CHECK_DIF_OK(dif_rv_timer_init_from_dt(dt, &timer));
+  CHECK_DIF_OK(dif_rv_timer_reset(&timer));
+  dif_rv_timer_tick_params_t tick_params;
+  CHECK_DIF_OK(dif_rv_timer_approximate_tick_params(
+      dt_clock_frequency(dt_rv_timer_clock(dt, kDtRvTimerClockClk)),
+      kTickFreqHz, &tick_params));
+  CHECK_DIF_OK(dif_rv_timer_set_tick_params(&timer, kHart, tick_params));
+  CHECK_DIF_OK(dif_rv_timer_irq_set_enabled(
+      &timer, kDtRvTimerIrqTimerExpiredHart0Timer0, kDifToggleEnabled));
+  timer_arm();
+  irq_timer_ctrl(true);
+  CHECK_DIF_OK(
+      dif_rv_timer_counter_set_enabled(&timer, kHart, kDifToggleEnabled));
+}
+
+bool test_main(void) {
+  ottf_console_t *console = ottf_console_get();
+
+  uint64_t start = ibex_mcycle_read();
+  for (size_t i = 0; i < kNumLines; ++i) {
+    LOG_INFO("Line %d of %d from the buffered console", i, kNumLines);
+  }
+  uint64_t queued = ibex_mcycle_read() - start;
+  CHECK_STATUS_OK(ottf_console_flushbuf(console));
+  uint64_t sent = ibex_mcycle_read() - start;
+
+  // Output written with interrupts disabled must go out synchronously.
+  irq_global_ctrl(false);
+  LOG_INFO("Printed with interrupts disabled");
+  irq_global_ctrl(true);
+
+  ottf_console_uart_tx_stats_t stats = ottf_console_uart_get_tx_stats(console);
+  LOG_INFO("Queued in %u cycles, sent in %u cycles", (uint32_t)queued,
+           (uint32_t)sent);
+  LOG_INFO("TX stats: bytes=%u irqs=%u stalls=%u max_level=%u", stats.bytes,
+           stats.irqs, stats.stalls, stats.max_level);
+  CHECK(stats.irqs > 0);
+  CHECK(stats.stalls > 0);
+  CHECK(stats.bytes > stats.max_level);
+
+  // Log from an ISR while the ring buffer is being filled and drained.
+  timer_start();
+  for (size_t i = 0; isr_lines < kNumIsrLines; ++i) {
+    LOG_INFO("Line %d from the buffered console next to the timer ISR", i);
+  }
+  irq_timer_ctrl(false);
+  CHECK_STATUS_OK(ottf_console_flushbuf(console));
+  return true;
+}
@@ -7,6 +7,7 @@
 #include <stdatomic.h>
 
 #include "sw/device/lib/arch/device.h"
+#include "sw/device/lib/base/macros.h"
 #include "sw/device/lib/base/mmio.h"
 #include "sw/device/lib/runtime/hart.h"
 #include "sw/device/lib/runtime/log.h"
@@ -17,6 +18,7 @@
  * @param test_status current status of the test.
  */
 static void test_status_device_write(test_status_t test_status) {
+  test_status_flush_console();
   uintptr_t status_addr = device_test_status_address();
   if (status_addr != 0) {
     mmio_region_t test_status_device_addr = mmio_region_from_addr(status_addr);
@@ -24,6 +26,9 @@ static void test_status_device_write(test_status_t test_status) {
   }
 }
 
+OT_WEAK
+void test_status_flush_console(void) {}
+
 void test_status_set(test_status_t test_status) {
   // This function is used to convey info to test harness, which may poke at
   // backdoor variables. Add a fence to provide corrrect synchronization.
@@ -86,4 +86,13 @@ typedef enum test_status {
  */
 void test_status_set(test_status_t test_status);
 
+/**
+ * Sends console output that is still buffered in software.
+ *
+ * Called by `test_status_set()` before writing the status, so that messages
+ * are not lost when this ends the simulation. The default implementation does
+ * nothing; it is overridden by consoles that transmit asynchronously.
+ */
+void test_status_flush_console(void);
+
 #endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_TEST_FRAMEWORK_STATUS_H_
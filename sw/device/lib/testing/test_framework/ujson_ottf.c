@@ -13,3 +13,26 @@ ujson_t ujson_ottf_console(void) {
   return ujson_init(ottf_console_get(), ottf_console_getc, ottf_console_putbuf,
                     ottf_console_flushbuf);
 }
+
+status_t ujson_ottf_set_encoding(ujson_t *uj) {
+  ottf_encoding_t encoding;
+  TRY(ujson_deserialize_ottf_encoding_t(uj, &encoding));
+  switch (encoding) {
+    case kOttfEncodingJson:
+    case kOttfEncodingBinary:
+      break;
+    default:
+      return INVALID_ARGUMENT();
+  }
+  // Switch first so that a failure is reported before anything is
+  // acknowledged, then acknowledge in the old encoding, which is the one the
+  // host is still reading.  The new encoding only takes effect once the
+  // acknowledgement has been sent.
+  ujson_encoding_t previous = uj->encoding;
+  TRY(ujson_set_encoding(uj, (ujson_encoding_t)encoding));
+  ujson_encoding_t next = uj->encoding;
+  uj->encoding = previous;
+  RESP_OK(ujson_serialize_ottf_encoding_t, uj, &encoding);
+  uj->encoding = next;
+  return OK_STATUS();
+}
@@ -33,6 +33,23 @@ extern "C" {
  */
 ujson_t ujson_ottf_console(void);
 
+/**
+ * Negotiates the wire encoding of a ujson connection.
+ *
+ * Reads the encoding requested by the host as an `ottf_encoding_t` and
+ * switches `uj` to it for all subsequent messages in both directions.  The
+ * switch is acknowledged with `RESP_OK` in the old encoding only once it has
+ * succeeded; on error `uj` keeps the old encoding and the caller reports the
+ * error in it, e.g. with `RESP_ERR`.
+ *
+ * The host side is `opentitanlib::test_utils::rpc`, whose `*_binary` methods
+ * speak the binary encoding.
+ *
+ * @param uj A ujson IO context.
+ * @return OK or an error.
+ */
+status_t ujson_ottf_set_encoding(ujson_t *uj);
+
 /**
  * Deserialize a ujson message with a CRC.
  * This macro will deserialize the message and then deserialize the CRC and
@@ -65,16 +82,23 @@ ujson_t ujson_ottf_console(void);
  * Should not be used directly.
  * It is used by other macros such as `RESP_ERR`.
  *
+ * With the binary encoding the CRC directly follows the message as a
+ * little-endian `uint32_t`, without the ` CRC:` prefix and newline.
+ *
  * @param uj_ctx_ A `ujson_t` representing the IO context.
  */
-#define RESP_CRC(uj_ctx_)                         \
-  ({                                              \
-    uint32_t crc = ujson_crc32_finish(uj_ctx_);   \
-    TRY(ujson_putbuf(uj_ctx_, " CRC:", 5));       \
-    TRY(ujson_serialize_uint32_t(uj_ctx_, &crc)); \
-    TRY(ujson_putbuf(uj_ctx_, "\n", 1));          \
-    TRY(ujson_flushbuf(uj));                      \
-    OK_STATUS();                                  \
+#define RESP_CRC(uj_ctx_)                              \
+  ({                                                   \
+    uint32_t crc = ujson_crc32_finish(uj_ctx_);        \
+    if ((uj_ctx_)->encoding == kUjsonEncodingBinary) { \
+      TRY(ujson_serialize_uint32_t(uj_ctx_, &crc));    \
+    } else {                                           \
+      TRY(ujson_putbuf(uj_ctx_, " CRC:", 5));          \
+      TRY(ujson_serialize_uint32_t(uj_ctx_, &crc));    \
+      TRY(ujson_putbuf(uj_ctx_, "\n", 1));             \
+    }                                                  \
+    TRY(ujson_flushbuf(uj));                           \
+    OK_STATUS();                                       \
   })
 
 /**
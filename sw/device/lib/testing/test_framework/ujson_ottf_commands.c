@@ -24,6 +24,9 @@ status_t ujson_ottf_dispatch(ujson_t *uj, test_command_t command) {
     case kTestCommandMemWrite:
       RESP_ERR(uj, ujcmd_mem_write(uj));
       break;
+    case kTestCommandSetEncoding:
+      RESP_ERR(uj, ujson_ottf_set_encoding(uj));
+      break;
     default:
       return UNIMPLEMENTED();
   }
@@ -14,7 +14,8 @@ extern "C" {
 #endif
 
 /**
- * Handles basic memory commands known to the OTTF ujson framework.
+ * Handles basic memory and encoding commands known to the OTTF ujson
+ * framework.
  *
  * For unrecognized command codes, no response is sent back to the requester.
  * This function returns a status with code `kUnimplemented`, and the caller
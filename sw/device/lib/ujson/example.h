@@ -107,6 +107,26 @@ C_ONLY(UJSON_SERDE_ENUM(FuzzyBool, fuzzy_bool, ENUM_FUZZY_BOOL, WITH_UNKNOWN));
     field(status, status_t)
 UJSON_SERDE_STRUCT(Misc, misc_t, STRUCT_MISC);
 
+/////////////////////////////////////////////////////////////////////////////
+// Byte arrays, bool arrays and string arrays
+//
+// Arrays of single-byte integers are copied in one call by the binary
+// encoding (see `kUjsonEncodingBinary`), which is how bulk data such as
+// plaintexts and traces should be declared.
+//
+// typedef struct Blob {
+//     uint16_t id;
+//     uint8_t data[2][3];
+//     bool flags[2];
+//     char names[2][4];
+// } blob_t;
+#define STRUCT_BLOB(field, string) \
+    field(id, uint16_t) \
+    field(data, uint8_t, 2, 3) \
+    field(flags, bool, 2) \
+    string(names, 4, 2)
+UJSON_SERDE_STRUCT(Blob, blob_t, STRUCT_BLOB);
+
 #undef MODULE_ID
 
 // clang-format on
@@ -23,7 +23,11 @@ status_t stdio_putbuf(void *context, const char *buf, size_t len) {
 status_t check_crc32(ujson_t *uj) {
   uint32_t expected = ujson_crc32_finish(uj);
   uint32_t actual;
-  scanf("%x", &actual);
+  if (uj->encoding == kUjsonEncodingBinary) {
+    TRY(ujson_deserialize_uint32_t(uj, &actual));
+  } else {
+    scanf("%x", &actual);
+  }
 
   if (expected != actual) {
     fprintf(stderr, "CRC32 Error: expected = %x, actual = %x\n", expected,
@@ -33,43 +37,53 @@ status_t check_crc32(ujson_t *uj) {
   return OK_STATUS();
 }
 
-status_t roundtrip(const char *name) {
+status_t send_crc32(ujson_t *uj) {
+  uint32_t crc = ujson_crc32_finish(uj);
+  if (uj->encoding == kUjsonEncodingBinary) {
+    return ujson_serialize_uint32_t(uj, &crc);
+  }
+  printf("\n%x", crc);
+  return OK_STATUS();
+}
+
+status_t roundtrip(const char *name, ujson_encoding_t encoding) {
   ujson_t uj = ujson_init(NULL, stdio_getc, stdio_putbuf, NULL);
+  TRY(ujson_set_encoding(&uj, encoding));
   if (!strcmp(name, "foo")) {
     foo x = {0};
     TRY(ujson_deserialize_foo(&uj, &x));
     TRY(check_crc32(&uj));
     ujson_crc32_reset(&uj);
     TRY(ujson_serialize_foo(&uj, &x));
-    printf("\n%x", ujson_crc32_finish(&uj));
+    TRY(send_crc32(&uj));
   } else if (!strcmp(name, "rect")) {
     rect x = {0};
     TRY(ujson_deserialize_rect(&uj, &x));
     TRY(check_crc32(&uj));
     ujson_crc32_reset(&uj);
     TRY(ujson_serialize_rect(&uj, &x));
-    printf("\n%x", ujson_crc32_finish(&uj));
+    TRY(send_crc32(&uj));
   } else if (!strcmp(name, "matrix")) {
     matrix x = {0};
     TRY(ujson_deserialize_matrix(&uj, &x));
     TRY(check_crc32(&uj));
     ujson_crc32_reset(&uj);
     TRY(ujson_serialize_matrix(&uj, &x));
-    printf("\n%x", ujson_crc32_finish(&uj));
+    TRY(send_crc32(&uj));
   } else if (!strcmp(name, "direction")) {
     direction x = {0};
     TRY(ujson_deserialize_direction(&uj, &x));
     TRY(check_crc32(&uj));
     ujson_crc32_reset(&uj);
     TRY(ujson_serialize_direction(&uj, &x));
-    printf("\n%x", ujson_crc32_finish(&uj));
+    TRY(send_crc32(&uj));
   } else if (!strcmp(name, "fuzzy_bool")) {
     fuzzy_bool x = {0};
     TRY(ujson_deserialize_fuzzy_bool(&uj, &x));
     TRY(check_crc32(&uj));
     ujson_crc32_reset(&uj);
     TRY(ujson_serialize_fuzzy_bool(&uj, &x));
-    printf("\n%x", ujson_crc32_finish(&uj));
+    TRY(send_crc32(&uj));
   } else if (!strcmp(name, "fuzzy_bool_no_crc")) {
     fuzzy_bool x = {0};
     TRY(ujson_deserialize_fuzzy_bool(&uj, &x));
@@ -80,7 +94,14 @@ status_t roundtrip(const char *name) {
     TRY(check_crc32(&uj));
     ujson_crc32_reset(&uj);
     TRY(ujson_serialize_misc_t(&uj, &x));
-    printf("\n%x", ujson_crc32_finish(&uj));
+    TRY(send_crc32(&uj));
+  } else if (!strcmp(name, "blob")) {
+    blob_t x = {0};
+    TRY(ujson_deserialize_blob_t(&uj, &x));
+    TRY(check_crc32(&uj));
+    ujson_crc32_reset(&uj);
+    TRY(ujson_serialize_blob_t(&uj, &x));
+    TRY(send_crc32(&uj));
   } else {
     return INVALID_ARGUMENT();
   }
@@ -88,11 +109,17 @@ status_t roundtrip(const char *name) {
 }
 
 int main(int argc, char *argv[]) {
+  ujson_encoding_t encoding = kUjsonEncodingJson;
+  if (argc > 1 && !strcmp(argv[1], "--binary")) {
+    encoding = kUjsonEncodingBinary;
+    --argc;
+    ++argv;
+  }
   if (argc < 2) {
-    fprintf(stderr, "%s [struct-name]", argv[0]);
+    fprintf(stderr, "%s [--binary] [struct-name]", argv[0]);
     return EXIT_FAILURE;
   }
-  status_t s = roundtrip(argv[1]);
+  status_t s = roundtrip(argv[1], encoding);
 
   return status_ok(s) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -213,4 +213,176 @@ TEST(Derive, FuzzyBoolDeserialize) {
   EXPECT_EQ(ujson_crc32_finish(&uj), 0xe301b3ec);
 }
 
+class BinaryTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    uj_ = ss_.UJson();
+    ASSERT_EQ(status_err(ujson_set_encoding(&uj_, kUjsonEncodingBinary)),
+              kOk);
+  }
+
+  /**
+   * Replays the serialized output as the input of the next deserialization.
+   */
+  void Loopback() {
+    std::string bytes = ss_.Sink();
+    ss_.Reset(bytes);
+    ujson_crc32_reset(&uj_);
+  }
+
+  SourceSink ss_;
+  ujson_t uj_;
+};
+
+TEST_F(BinaryTest, FooSerialize) {
+  foo expected = {-5, 150000, "Kilroy"};
+  EXPECT_TRUE(status_ok(ujson_serialize_foo(&uj_, &expected)));
+  EXPECT_EQ(ss_.Sink(), std::string("\xfb\xff\xff\xff"
+                                    "\xf0\x49\x02\x00"
+                                    "\x06\x00Kilroy",
+                                    16));
+  uint32_t crc = ujson_crc32_finish(&uj_);
+
+  foo foo{};
+  Loopback();
+  EXPECT_TRUE(status_ok(ujson_deserialize_foo(&uj_, &foo)));
+  EXPECT_EQ(memcmp(&foo, &expected, sizeof(foo)), 0);
+  EXPECT_EQ(ujson_crc32_finish(&uj_), crc);
+}
+
+TEST_F(BinaryTest, FooDeserializeTruncated) {
+  foo foo{};
+  ss_.Reset(std::string("\xfb\xff\xff\xff\xf0\x49", 6));
+  EXPECT_EQ(status_err(ujson_deserialize_foo(&uj_, &foo)), kResourceExhausted);
+}
+
+TEST_F(BinaryTest, RectRoundtrip) {
+  rect r = {{10, -20}, {30, 40}};
+  rect r2{};
+  EXPECT_TRUE(status_ok(ujson_serialize_rect(&uj_, &r)));
+  EXPECT_EQ(ss_.Sink().size(), 4 * sizeof(int32_t));
+  Loopback();
+  EXPECT_TRUE(status_ok(ujson_deserialize_rect(&uj_, &r2)));
+  EXPECT_EQ(memcmp(&r, &r2, sizeof(r)), 0);
+}
+
+TEST_F(BinaryTest, MatrixRoundtrip) {
+  matrix m = {
+      {{0, 1, 2, 3, 4}, {5, 6, 7, 8, 9}, {-1, -2, -3, -4, -5}},
+  };
+  matrix m2{};
+  EXPECT_TRUE(status_ok(ujson_serialize_matrix(&uj_, &m)));
+  // Every dimension carries its element count.
+  EXPECT_EQ(ss_.Sink().size(), 2 + 3 * (2 + 5 * sizeof(int32_t)));
+  EXPECT_EQ(ss_.Sink().substr(0, 8), std::string("\x03\x00\x05\x00"
+                                                 "\x00\x00\x00\x00",
+                                                 8));
+  Loopback();
+  EXPECT_TRUE(status_ok(ujson_deserialize_matrix(&uj_, &m2)));
+  EXPECT_EQ(memcmp(&m, &m2, sizeof(m)), 0);
+}
+
+TEST_F(BinaryTest, MatrixDeserializeShort) {
+  matrix m;
+  memset(&m, 0x5a, sizeof(m));
+  // Two rows, the second with only one element, as in JSON `[[..], [7]]`.
+  ss_.Reset(std::string("\x02\x00"
+                        "\x05\x00"
+                        "\x00\x00\x00\x00\x01\x00\x00\x00\x02\x00\x00\x00"
+                        "\x03\x00\x00\x00\x04\x00\x00\x00"
+                        "\x01\x00"
+                        "\x07\x00\x00\x00",
+                        30));
+  EXPECT_TRUE(status_ok(ujson_deserialize_matrix(&uj_, &m)));
+  EXPECT_EQ(m.k[0][4], 4);
+  EXPECT_EQ(m.k[1][0], 7);
+  EXPECT_EQ(m.k[1][1], 0x5a5a5a5a);
+  EXPECT_EQ(m.k[2][0], 0x5a5a5a5a);
+}
+
+TEST_F(BinaryTest, MatrixDeserializeTooLong) {
+  matrix m{};
+  ss_.Reset(std::string("\x04\x00", 2));
+  EXPECT_EQ(status_err(ujson_deserialize_matrix(&uj_, &m)), kOutOfRange);
+  ss_.Reset(std::string("\x03\x00\x06\x00", 4));
+  EXPECT_EQ(status_err(ujson_deserialize_matrix(&uj_, &m)), kOutOfRange);
+}
+
+TEST_F(BinaryTest, EnumRoundtrip) {
+  struct {
+    direction value;
+    std::string bytes;
+  } cases[] = {
+      {kDirectionNorth, std::string("\x00\x00\x00\x00", 4)},
+      {kDirectionWest, std::string("\x03\x00\x00\x00", 4)},
+      // Unnamed values follow the index one past the last named value.
+      {static_cast<direction>(120),
+       std::string("\x04\x00\x00\x00\x78\x00\x00\x00", 8)},
+  };
+  for (const auto &c : cases) {
+    direction d;
+    ss_.Reset();
+    EXPECT_TRUE(status_ok(ujson_serialize_direction(&uj_, &c.value)));
+    EXPECT_EQ(ss_.Sink(), c.bytes);
+    Loopback();
+    EXPECT_TRUE(status_ok(ujson_deserialize_direction(&uj_, &d)));
+    EXPECT_EQ(d, c.value);
+  }
+}
+
+TEST_F(BinaryTest, EnumDeserializeBadIndex) {
+  direction d;
+  ss_.Reset(std::string("\x05\x00\x00\x00", 4));
+  EXPECT_EQ(status_err(ujson_deserialize_direction(&uj_, &d)),
+            kInvalidArgument);
+}
+
+TEST_F(BinaryTest, WithUnknownEnumUnimplemented) {
+  fuzzy_bool f = kFuzzyBoolTrue;
+  EXPECT_EQ(status_err(ujson_serialize_fuzzy_bool(&uj_, &f)), kUnimplemented);
+  ss_.Reset(std::string("\x64\x00\x00\x00", 4));
+  EXPECT_EQ(status_err(ujson_deserialize_fuzzy_bool(&uj_, &f)),
+            kUnimplemented);
+}
+
+TEST_F(BinaryTest, MiscRoundtrip) {
+  misc_t m = {true, INVALID_ARGUMENT()};
+  misc_t m2{};
+  EXPECT_TRUE(status_ok(ujson_serialize_misc_t(&uj_, &m)));
+  EXPECT_EQ(ss_.Sink().size(), 1 + sizeof(int32_t));
+  Loopback();
+  EXPECT_TRUE(status_ok(ujson_deserialize_misc_t(&uj_, &m2)));
+  EXPECT_EQ(m2.value, m.value);
+  EXPECT_EQ(m2.status.value, m.status.value);
+}
+
+TEST_F(BinaryTest, BlobRoundtrip) {
+  blob_t b = {0x1234, {{1, 2, 3}, {4, 5, 6}}, {true, false}, {"ab", "cde"}};
+  blob_t b2{};
+  EXPECT_TRUE(status_ok(ujson_serialize_blob_t(&uj_, &b)));
+  EXPECT_EQ(ss_.Sink(), std::string("\x34\x12"
+                                    "\x02\x00"
+                                    "\x03\x00\x01\x02\x03"
+                                    "\x03\x00\x04\x05\x06"
+                                    "\x02\x00\x01\x00"
+                                    "\x02\x00"
+                                    "\x02\x00"
+                                    "ab"
+                                    "\x03\x00"
+                                    "cde",
+                                    29));
+  Loopback();
+  EXPECT_TRUE(status_ok(ujson_deserialize_blob_t(&uj_, &b2)));
+  EXPECT_EQ(memcmp(&b, &b2, sizeof(b)), 0);
+}
+
+TEST_F(BinaryTest, BlobDeserializeBadBool) {
+  blob_t b{};
+  ss_.Reset(std::string("\x34\x12"
+                        "\x00\x00"
+                        "\x02\x00\x01\x02",
+                        8));
+  EXPECT_EQ(status_err(ujson_deserialize_blob_t(&uj_, &b)), kOutOfRange);
+}
+
 }  // namespace
@@ -5,6 +5,7 @@
 use anyhow::Result;
 use crc::{CRC_32_ISO_HDLC, Crc};
 use opentitanlib::test_utils::status::Status;
+use opentitanlib::test_utils::ujson_bin;
 use opentitanlib::with_unknown;
 use std::io::{Read, Write};
 use std::process::{Command, Stdio};
@@ -59,6 +60,35 @@ fn roundtrip(name: &str, data: &str, check_crc: bool) -> Result<String> {
     Ok(msg)
 }
 
+fn roundtrip_binary(name: &str, data: &[u8]) -> Result<Vec<u8>> {
+    let mut command = Command::new(std::env::var("ROUNDTRIP_CLIENT")?);
+    command.args(["--binary", name]);
+    let mut child = command
+        .stdin(Stdio::piped())
+        .stdout(Stdio::piped())
+        .stderr(Stdio::inherit())
+        .spawn()?;
+
+    let crc = Crc::<u32>::new(&CRC_32_ISO_HDLC);
+    let mut stdin = child.stdin.take().unwrap();
+    eprintln!("sending: {data:02x?}");
+    stdin.write_all(data)?;
+    stdin.write_all(&crc.checksum(data).to_le_bytes())?;
+
+    let exit_code = child.wait()?;
+    if !exit_code.success() {
+        panic!("{exit_code}");
+    }
+
+    let mut msg = Vec::new();
+    let mut stdout = child.stdout.take().unwrap();
+    stdout.read_to_end(&mut msg)?;
+    eprintln!("recv: {msg:02x?}");
+    let (data, crc32) = msg.split_at(msg.len() - 4);
+    assert_eq!(crc.checksum(data).to_le_bytes(), crc32);
+    Ok(data.to_vec())
+}
+
 #[cfg(test)]
 mod test {
     use super::*;
@@ -165,4 +195,64 @@ mod test {
         assert_eq!(before, after);
         Ok(())
     }
+
+    #[test]
+    fn test_binary_foo() -> Result<()> {
+        let before = example::Foo {
+            foo: -5,
+            bar: 150000,
+            message: "Kilroy".into(),
+        };
+        let after = roundtrip_binary("foo", &ujson_bin::to_vec(&before)?)?;
+        assert_eq!(before, ujson_bin::from_slice::<example::Foo>(&after)?);
+        Ok(())
+    }
+
+    #[test]
+    fn test_binary_matrix() -> Result<()> {
+        let before = example::Matrix {
+            k: [
+                [0, 1, 2, 3, 4].into(),
+                [100, 200, 300, 400, 500].into(),
+                [-1, -2, -3, -4, -5].into(),
+            ]
+            .into(),
+        };
+        let after = roundtrip_binary("matrix", &ujson_bin::to_vec(&before)?)?;
+        assert_eq!(before, ujson_bin::from_slice::<example::Matrix>(&after)?);
+        Ok(())
+    }
+
+    #[test]
+    fn test_binary_direction() -> Result<()> {
+        for before in [example::Direction::West, example::Direction::IntValue(45)] {
+            let after = roundtrip_binary("direction", &ujson_bin::to_vec(&before)?)?;
+            assert_eq!(before, ujson_bin::from_slice::<example::Direction>(&after)?);
+        }
+        Ok(())
+    }
+
+    #[test]
+    fn test_binary_misc() -> Result<()> {
+        let before = example::Misc {
+            value: true,
+            status: Status::InvalidArgument("FOO".into(), 5),
+        };
+        let after = roundtrip_binary("misc", &ujson_bin::to_vec(&before)?)?;
+        assert_eq!(before, ujson_bin::from_slice::<example::Misc>(&after)?);
+        Ok(())
+    }
+
+    #[test]
+    fn test_binary_blob() -> Result<()> {
+        let before = example::Blob {
+            id: 0x1234,
+            data: [[1, 2, 3].into(), [4, 5, 6].into()].into(),
+            flags: [true, false].into(),
+            names: ["ab".to_string(), "cde".to_string()].into(),
+        };
+        let after = roundtrip_binary("blob", &ujson_bin::to_vec(&before)?)?;
+        assert_eq!(before, ujson_bin::from_slice::<example::Blob>(&after)?);
+        Ok(())
+    }
 }
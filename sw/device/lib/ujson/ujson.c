@@ -27,6 +27,30 @@ void ujson_crc32_reset(ujson_t *uj) { crc32_init(&uj->crc32); }
 
 uint32_t ujson_crc32_finish(ujson_t *uj) { return crc32_finish(&uj->crc32); }
 
+status_t ujson_set_encoding(ujson_t *uj, ujson_encoding_t encoding) {
+  switch (encoding) {
+    case kUjsonEncodingJson:
+    case kUjsonEncodingBinary:
+      break;
+    default:
+      return INVALID_ARGUMENT();
+  }
+  if (uj->buffer >= 0) {
+    // A pushed-back character belongs to the old encoding.  Whitespace only
+    // separated tokens there, anything else would be misread.
+    if (uj->encoding != kUjsonEncodingJson || !is_space(uj->buffer)) {
+      return FAILED_PRECONDITION();
+    }
+    uj->buffer = -1;
+  }
+  uj->encoding = encoding;
+  return OK_STATUS();
+}
+
+static bool is_binary(const ujson_t *uj) {
+  return uj->encoding == kUjsonEncodingBinary;
+}
+
 status_t ujson_putbuf(ujson_t *uj, const char *buf, size_t len) {
   crc32_add(&uj->crc32, buf, len);
   return uj->putbuf(uj->io_context, buf, len);
@@ -56,11 +80,19 @@ status_t ujson_getc(ujson_t *uj) {
   }
 }
 
+status_t ujson_getbuf(ujson_t *uj, char *buf, size_t len) {
+  for (size_t i = 0; i < len; ++i) {
+    buf[i] = (char)TRY(ujson_getc(uj));
+  }
+  return OK_STATUS();
+}
+
 status_t ujson_ungetc(ujson_t *uj, char ch) {
   if (uj->buffer >= 0) {
     return FAILED_PRECONDITION();
   }
-  uj->buffer = ch;
+  // Characters >= 0x80 must not be sign extended into the empty marker.
+  uj->buffer = (uint8_t)ch;
   return OK_STATUS();
 }
 
@@ -118,7 +150,46 @@ status_t ujson_consume_maybe(ujson_t *uj, char ch) {
   return OK_STATUS(1);
 }
 
+// Reads a little-endian integer of `size` bytes.
+static status_t parse_binary(ujson_t *uj, uint64_t *value, size_t size) {
+  *value = 0;
+  for (size_t i = 0; i < size; ++i) {
+    uint8_t ch = (uint8_t)TRY(ujson_getc(uj));
+    *value |= (uint64_t)ch << (8 * i);
+  }
+  return OK_STATUS();
+}
+
+// Writes the low `size` bytes of `value` in little-endian order.
+static status_t serialize_binary(ujson_t *uj, uint64_t value, size_t size) {
+  char buf[sizeof(uint64_t)];
+  for (size_t i = 0; i < size; ++i) {
+    buf[i] = (char)(value >> (8 * i));
+  }
+  return ujson_putbuf(uj, buf, size);
+}
+
+static status_t parse_binary_string(ujson_t *uj, char *str, size_t len) {
+  uint64_t size;
+  int n = 0;
+  len--;  // One char for the nul terminator.
+  TRY(parse_binary(uj, &size, sizeof(uint16_t)));
+  for (; size > 0; --size) {
+    char ch = (char)TRY(ujson_getc(uj));
+    if (len > 0) {
+      *str++ = ch;
+      --len;
+      n++;
+    }
+  }
+  *str = '\0';
+  return OK_STATUS(n);
+}
+
 status_t ujson_parse_qs(ujson_t *uj, char *str, size_t len) {
+  if (is_binary(uj)) {
+    return parse_binary_string(uj, str, len);
+  }
   char ch;
   int n = 0;
   len--;  // One char for the nul terminator.
@@ -167,6 +238,13 @@ status_t ujson_parse_qs(ujson_t *uj, char *str, size_t len) {
 }
 
 status_t ujson_parse_integer(ujson_t *uj, void *result, size_t rsz) {
+  if (is_binary(uj)) {
+    uint64_t value;
+    TRY(parse_binary(uj, &value, rsz));
+    memcpy(result, &value, rsz);
+    return OK_STATUS();
+  }
+
   char ch = (char)TRY(consume_whitespace(uj));
   bool neg = false;
   bool quoted = false;
@@ -232,6 +310,14 @@ status_t ujson_parse_integer(ujson_t *uj, void *result, size_t rsz) {
 }
 
 status_t ujson_deserialize_bool(ujson_t *uj, bool *value) {
+  if (is_binary(uj)) {
+    uint8_t byte = (uint8_t)TRY(ujson_getc(uj));
+    if (byte > 1) {
+      return OUT_OF_RANGE();
+    }
+    *value = byte;
+    return OK_STATUS();
+  }
   char got = (char)TRY(consume_whitespace(uj));
   if (got == 't') {
     TRY(ujson_consume(uj, 'r'));
@@ -264,6 +350,16 @@ status_t ujson_deserialize_uint8_t(ujson_t *uj, uint8_t *value) {
   return ujson_parse_integer(uj, (void *)value, sizeof(*value));
 }
 status_t ujson_deserialize_size_t(ujson_t *uj, size_t *value) {
+  if (is_binary(uj)) {
+    // Always 8 bytes on the wire so that host and device agree.
+    uint64_t wide;
+    TRY(parse_binary(uj, &wide, sizeof(wide)));
+    if (wide > SIZE_MAX) {
+      return OUT_OF_RANGE();
+    }
+    *value = (size_t)wide;
+    return OK_STATUS();
+  }
   return ujson_parse_integer(uj, (void *)value, sizeof(*value));
 }
 status_t ujson_deserialize_int64_t(ujson_t *uj, int64_t *value) {
@@ -279,9 +375,28 @@ status_t ujson_deserialize_int8_t(ujson_t *uj, int8_t *value) {
   return ujson_parse_integer(uj, (void *)value, sizeof(*value));
 }
 
+status_t ujson_deserialize_array_length(ujson_t *uj, size_t capacity,
+                                        size_t *count) {
+  uint64_t value;
+  TRY(parse_binary(uj, &value, sizeof(uint16_t)));
+  if (value > capacity) {
+    return OUT_OF_RANGE();
+  }
+  *count = (size_t)value;
+  return OK_STATUS();
+}
+
 static const char hex[] = "0123456789abcdef";
 
 status_t ujson_serialize_string(ujson_t *uj, const char *buf) {
+  if (is_binary(uj)) {
+    size_t len = strlen(buf);
+    if (len > UINT16_MAX) {
+      return OUT_OF_RANGE();
+    }
+    TRY(serialize_binary(uj, len, sizeof(uint16_t)));
+    return ujson_putbuf(uj, buf, len);
+  }
   uint8_t ch;
   TRY(ujson_putbuf(uj, "\"", 1));
   while ((ch = (uint8_t)*buf) != '\0') {
@@ -323,7 +438,10 @@ status_t ujson_serialize_string(ujson_t *uj, const char *buf) {
 }
 
 static status_t ujson_serialize_integer64(ujson_t *uj, uint64_t value,
-                                          bool neg) {
+                                          bool neg, size_t size) {
+  if (is_binary(uj)) {
+    return serialize_binary(uj, value, size);
+  }
   char buf[24];
   char *end = buf + sizeof(buf);
   size_t len = 0;
@@ -348,7 +466,10 @@ static status_t ujson_serialize_integer64(ujson_t *uj, uint64_t value,
 }
 
 static status_t ujson_serialize_integer32(ujson_t *uj, uint32_t value,
-                                          bool neg) {
+                                          bool neg, size_t size) {
+  if (is_binary(uj)) {
+    return serialize_binary(uj, value, size);
+  }
   char buf[24];
   char *end = buf + sizeof(buf);
   size_t len = 0;
@@ -370,7 +491,17 @@ static status_t ujson_serialize_integer32(ujson_t *uj, uint32_t value,
   return OK_STATUS();
 }
 
+status_t ujson_serialize_array_length(ujson_t *uj, size_t count) {
+  if (count > UINT16_MAX) {
+    return OUT_OF_RANGE();
+  }
+  return serialize_binary(uj, count, sizeof(uint16_t));
+}
+
 status_t ujson_serialize_bool(ujson_t *uj, const bool *value) {
+  if (is_binary(uj)) {
+    return serialize_binary(uj, *value, 1);
+  }
   if (*value) {
     TRY(ujson_putbuf(uj, "true", 4));
   } else {
@@ -380,45 +511,52 @@ status_t ujson_serialize_bool(ujson_t *uj, const bool *value) {
 }
 
 status_t ujson_serialize_uint64_t(ujson_t *uj, const uint64_t *value) {
-  return ujson_serialize_integer64(uj, *value, false);
+  return ujson_serialize_integer64(uj, *value, false, sizeof(*value));
 }
 status_t ujson_serialize_uint32_t(ujson_t *uj, const uint32_t *value) {
-  return ujson_serialize_integer32(uj, *value, false);
+  return ujson_serialize_integer32(uj, *value, false, sizeof(*value));
 }
 
 status_t ujson_serialize_uint16_t(ujson_t *uj, const uint16_t *value) {
-  return ujson_serialize_integer32(uj, *value, false);
+  return ujson_serialize_integer32(uj, *value, false, sizeof(*value));
 }
 
 status_t ujson_serialize_uint8_t(ujson_t *uj, const uint8_t *value) {
-  return ujson_serialize_integer32(uj, *value, false);
+  return ujson_serialize_integer32(uj, *value, false, sizeof(*value));
 }
 
 status_t ujson_serialize_size_t(ujson_t *uj, const size_t *value) {
-  if (sizeof(size_t) == sizeof(uint64_t)) {
-    return ujson_serialize_integer64(uj, *value, false);
+  if (sizeof(size_t) == sizeof(uint64_t) || is_binary(uj)) {
+    return ujson_serialize_integer64(uj, *value, false, sizeof(uint64_t));
   } else {
-    return ujson_serialize_integer32(uj, *value, false);
+    return ujson_serialize_integer32(uj, *value, false, sizeof(*value));
   }
 }
 
 status_t ujson_serialize_int64_t(ujson_t *uj, const int64_t *value) {
-  return ujson_serialize_integer64(uj, (uint64_t)*value, *value < 0);
+  return ujson_serialize_integer64(uj, (uint64_t)*value, *value < 0,
+                                   sizeof(*value));
 }
 
 status_t ujson_serialize_int32_t(ujson_t *uj, const int32_t *value) {
-  return ujson_serialize_integer32(uj, (uint32_t)*value, *value < 0);
+  return ujson_serialize_integer32(uj, (uint32_t)*value, *value < 0,
+                                   sizeof(*value));
 }
 
 status_t ujson_serialize_int16_t(ujson_t *uj, const int16_t *value) {
-  return ujson_serialize_integer32(uj, (uint32_t)*value, *value < 0);
+  return ujson_serialize_integer32(uj, (uint32_t)*value, *value < 0,
+                                   sizeof(*value));
 }
 
 status_t ujson_serialize_int8_t(ujson_t *uj, const int8_t *value) {
-  return ujson_serialize_integer32(uj, (uint32_t)*value, *value < 0);
+  return ujson_serialize_integer32(uj, (uint32_t)*value, *value < 0,
+                                   sizeof(*value));
 }
 
 status_t ujson_deserialize_status_t(ujson_t *uj, status_t *value) {
+  if (is_binary(uj)) {
+    return ujson_deserialize_int32_t(uj, &value->value);
+  }
   private_status_t code;
   uint32_t module_id = 0;
   uint32_t arg = 0;
@@ -442,6 +580,9 @@ status_t ujson_deserialize_status_t(ujson_t *uj, status_t *value) {
 }
 
 status_t ujson_serialize_status_t(ujson_t *uj, const status_t *value) {
+  if (is_binary(uj)) {
+    return ujson_serialize_int32_t(uj, &value->value);
+  }
   buffer_sink_t out = {
       .data = uj,
       .sink = (sink_func_ptr)ujson_putbuf_sink,
@@ -11,6 +11,40 @@
 extern "C" {
 #endif
 
+/**
+ * Wire encodings understood by ujson.
+ */
+typedef enum ujson_encoding {
+  /**
+   * JSON text; the default.
+   */
+  kUjsonEncodingJson = 0,
+  /**
+   * Compact binary encoding generated from the same `ujson_derive.h`
+   * declarations as the JSON encoding.
+   *
+   * - Integers are fixed-width little-endian; `size_t` is always 8 bytes.
+   * - Booleans are a single byte, 0 or 1; any other byte is rejected.
+   * - `status_t` is its 32-bit integer value.
+   * - Enums are the 32-bit index of the value in declaration order.  A value
+   *   without a name is encoded as the number of named values followed by
+   *   the 32-bit value itself.  Enums declared `WITH_UNKNOWN` are not
+   *   supported.
+   * - Strings are a 16-bit little-endian length followed by the characters,
+   *   without a nul terminator.
+   * - Structs are their fields in declaration order, without keys.
+   * - Each array dimension is a 16-bit little-endian element count followed
+   *   by the elements.  A shorter array leaves the remaining elements of the
+   *   destination untouched, as in JSON; a longer one is rejected.
+   *
+   * This is the encoding implemented by `opentitanlib::test_utils::ujson_bin`
+   * for the Rust types generated from the same declarations.  Both peers
+   * must agree on the encoding out of band, e.g. with the OTTF `SetEncoding`
+   * command.
+   */
+  kUjsonEncodingBinary = 1,
+} ujson_encoding_t;
+
 /**
  * Input/Output context for ujson.
  */
@@ -27,6 +61,8 @@ typedef struct ujson {
   int16_t buffer;
   /** Holds the rolling CRC32 of characters that are sent and received.*/
   uint32_t crc32;
+  /** The wire encoding used by the serialize and deserialize functions. */
+  ujson_encoding_t encoding;
 } ujson_t;
 
 // clang-format off
@@ -38,6 +74,7 @@ typedef struct ujson {
       .getc = (getc_),                                  \
       .buffer = -1,                                     \
       .crc32 = UINT32_MAX,                              \
+      .encoding = kUjsonEncodingJson,                   \
   }
 // clang-format on
 
@@ -70,6 +107,16 @@ status_t ujson_getc(ujson_t *uj);
  */
 status_t ujson_ungetc(ujson_t *uj, char ch);
 
+/**
+ * Reads a buffer from the input.
+ *
+ * @param uj A ujson IO context.
+ * @param buf The buffer to read into.
+ * @param len The number of bytes to read.
+ * @return OK or an error.
+ */
+status_t ujson_getbuf(ujson_t *uj, char *buf, size_t len);
+
 /**
  * Writes a buffer to the output.
  *
@@ -93,6 +140,20 @@ status_t ujson_putbuf(ujson_t *uj, const char *buf, size_t len);
  */
 status_t ujson_flushbuf(ujson_t *uj);
 
+/**
+ * Selects the wire encoding of a ujson context.
+ *
+ * A pushed-back whitespace character is a separator in the old encoding and
+ * is discarded.  Any other pushed-back character would be misread by the new
+ * encoding, so the switch fails with `FAILED_PRECONDITION` and the context is
+ * left unchanged.
+ *
+ * @param uj A ujson IO context.
+ * @param encoding The encoding to use for subsequent messages.
+ * @return OK or an error.
+ */
+status_t ujson_set_encoding(ujson_t *uj, ujson_encoding_t encoding);
+
 /**
  * Resets the CRC32 calculation to an initial state.
  *
@@ -154,6 +215,8 @@ status_t ujson_consume_maybe(ujson_t *uj, char ch);
  * buffer will contain a truncated string and the entire input json string
  * will be consumed.
  *
+ * With the binary encoding, parses a length-prefixed string instead.
+ *
  * @param uj A ujson IO context.
  * @param str A buffer to write the string into.
  * @param len The length of the target buffer.
@@ -164,6 +227,8 @@ status_t ujson_parse_qs(ujson_t *uj, char *str, size_t len);
 /**
  * Parse a JSON integer.
  *
+ * With the binary encoding, parses a little-endian integer of `rsz` bytes.
+ *
  * @param uj A ujson IO context.
  * @param result: The parsed integer.
  * @param rsz: The size of the integer (in bytes).
@@ -202,6 +267,26 @@ status_t ujson_deserialize_bool(ujson_t *uj, bool *value);
  */
 status_t ujson_deserialize_status_t(ujson_t *uj, status_t *value);
 
+/**
+ * Deserialize the element count of a binary-encoded array dimension.
+ *
+ * @param uj A ujson IO context.
+ * @param capacity The number of elements in the destination.
+ * @param[out] count The number of elements that follow on the wire.
+ * @return OK, or `OUT_OF_RANGE` if `count` would exceed `capacity`.
+ */
+status_t ujson_deserialize_array_length(ujson_t *uj, size_t capacity,
+                                        size_t *count);
+
+/**
+ * Serialize the element count of a binary-encoded array dimension.
+ *
+ * @param uj A ujson IO context.
+ * @param count The number of elements that follow.
+ * @return OK or an error.
+ */
+status_t ujson_serialize_array_length(ujson_t *uj, size_t count);
+
 /**
  * Serialize a string.
  *
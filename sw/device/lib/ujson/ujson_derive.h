@@ -119,8 +119,68 @@
         if (--nfield) TRY(ujson_putbuf(uj, ",", 1)); \
     }
 
+// True for the element types whose binary encoding is the byte itself, so
+// that arrays of them can be sent and received in one call.  `bool` is not one
+// of them: its bytes must be checked on the way in.
+#define ujson_bin_is_byte(x_) \
+    _Generic((x_), uint8_t: true, int8_t: true, char: true, default: false)
+
+// In the binary encoding each array dimension is an element count followed by
+// the elements.  `elems_` handles the innermost dimension and advances `p`.
+#define ujson_ser_bin_loop_indirect() ujson_ser_bin_loop
+#define ujson_ser_bin_loop(elems_, arg_, count, ...) \
+    TRY(ujson_serialize_array_length(uj, count)); \
+    OT_IIF(OT_NOT(OT_VA_ARGS_COUNT(dummy, ##__VA_ARGS__))) \
+    ( /*then*/ \
+        elems_(arg_, count) \
+    , /*else*/ \
+        for(size_t x=0; x < count; ++x) { \
+            OT_OBSTRUCT(ujson_ser_bin_loop_indirect)()(elems_, arg_, __VA_ARGS__) \
+        } \
+    ) /*endif*/
+
+#define ujson_ser_bin_elems(fn_, count_) \
+    if (ujson_bin_is_byte(*p)) { \
+        TRY(ujson_putbuf(uj, (const char*)p, count_)); \
+        p += count_; \
+    } else { \
+        for(size_t i=0; i < count_; ++i) { \
+            TRY(fn_(uj, p++)); \
+        } \
+    }
+
+#define ujson_ser_bin_strings(size_, count_) \
+    for(size_t i=0; i < count_; ++i, p+=size_) { \
+        TRY(ujson_serialize_string(uj, p)); \
+    }
+
+#define ujson_ser_bin_field(name_, type_, ...) { \
+        OT_IIF(OT_NOT(OT_VA_ARGS_COUNT(dummy, ##__VA_ARGS__))) \
+        ( /*then*/ \
+            TRY(ujson_serialize_##type_(uj, &self->name_)); \
+        , /*else*/ \
+            const type_ *p = (const type_*)self->name_; \
+            OT_EVAL(ujson_ser_bin_loop(ujson_ser_bin_elems, \
+                ujson_serialize_##type_, __VA_ARGS__)) \
+        ) /*endif*/ \
+    }
+
+#define ujson_ser_bin_string(name_, size_, ...) { \
+        OT_IIF(OT_NOT(OT_VA_ARGS_COUNT(dummy, ##__VA_ARGS__))) \
+        ( /*then*/ \
+            TRY(ujson_serialize_string(uj, self->name_)); \
+        , /*else*/ \
+            const char *p = (const char*)self->name_; \
+            OT_EVAL(ujson_ser_bin_loop(ujson_ser_bin_strings, size_, __VA_ARGS__)) \
+        ) /*endif*/ \
+    }
+
 #define UJSON_IMPL_SERIALIZE_STRUCT(name_, decl_) \
     status_t ujson_serialize_##name_(ujson_t *uj, const name_ *self) { \
+        if (uj->encoding == kUjsonEncodingBinary) { \
+            decl_(ujson_ser_bin_field, ujson_ser_bin_string) \
+            return OK_STATUS(); \
+        } \
         size_t nfield = decl_(ujson_count, ujson_count); \
         TRY(ujson_putbuf(uj, "{", 1)); \
         decl_(ujson_ser_field, ujson_ser_string) \
@@ -133,8 +193,26 @@
     case k ##formal_name_ ## name_: \
         TRY(ujson_serialize_string(uj, #name_)); break;
 
+// The binary encoding of an enum is the index of its value in declaration
+// order; `index` ends up as the number of named values if there is no match.
+#define ujson_ser_bin_enum(formal_name_, name_, ...) \
+    if (*self == k ##formal_name_ ## name_) { \
+        return ujson_serialize_uint32_t(uj, &index); \
+    } \
+    ++index;
+
 #define UJSON_IMPL_SERIALIZE_ENUM(formal_name_, name_, decl_, ...) \
     status_t ujson_serialize_##name_(ujson_t *uj, const name_ *self) { \
+        if (uj->encoding == kUjsonEncodingBinary) { \
+            if (ujson_get_flags(__VA_ARGS__) & WITH_UNKNOWN) { \
+                return UNIMPLEMENTED(); \
+            } \
+            uint32_t index = 0; \
+            decl_(formal_name_, ujson_ser_bin_enum) \
+            const uint32_t value = (uint32_t)(*self); \
+            TRY(ujson_serialize_uint32_t(uj, &index)); \
+            return ujson_serialize_uint32_t(uj, &value); \
+        } \
         switch(*self) { \
             decl_(formal_name_, ujson_ser_enum) \
             default: { \
@@ -201,8 +279,67 @@
         ) /*endif*/ \
     }
 
+// Mirrors `ujson_ser_bin_loop`.  A short dimension skips the elements it
+// leaves untouched; `total_` is the number of `p` units in this dimension.
+#define ujson_de_bin_loop_indirect() ujson_de_bin_loop
+#define ujson_de_bin_loop(elems_, arg_, total_, count, ...) { \
+        size_t n; \
+        TRY(ujson_deserialize_array_length(uj, count, &n)); \
+        OT_IIF(OT_NOT(OT_VA_ARGS_COUNT(dummy, ##__VA_ARGS__))) \
+        ( /*then*/ \
+            elems_(arg_, n) \
+        , /*else*/ \
+            for(size_t x=0; x < n; ++x) { \
+                OT_OBSTRUCT(ujson_de_bin_loop_indirect)()(elems_, arg_, (total_) / (count), __VA_ARGS__) \
+            } \
+        ) /*endif*/ \
+        p += (count - n) * ((total_) / (count)); \
+    }
+
+#define ujson_de_bin_elems(fn_, count_) \
+    if (ujson_bin_is_byte(*p)) { \
+        TRY(ujson_getbuf(uj, (char*)p, count_)); \
+        p += count_; \
+    } else { \
+        for(size_t i=0; i < count_; ++i) { \
+            TRY(fn_(uj, p++)); \
+        } \
+    }
+
+#define ujson_de_bin_strings(size_, count_) \
+    for(size_t i=0; i < count_; ++i, p+=size_) { \
+        TRY(ujson_parse_qs(uj, p, size_)); \
+    }
+
+#define ujson_de_bin_field(name_, type_, ...) { \
+        OT_IIF(OT_NOT(OT_VA_ARGS_COUNT(dummy, ##__VA_ARGS__))) \
+        ( /*then*/ \
+            TRY(ujson_deserialize_##type_(uj, &self->name_)); \
+        , /*else*/ \
+            type_ *p = (type_*)self->name_; \
+            OT_EVAL(ujson_de_bin_loop(ujson_de_bin_elems, \
+                ujson_deserialize_##type_, \
+                sizeof(self->name_) / sizeof(type_), __VA_ARGS__)) \
+        ) /*endif*/ \
+    }
+
+#define ujson_de_bin_string(name_, size_, ...) { \
+        OT_IIF(OT_NOT(OT_VA_ARGS_COUNT(dummy, ##__VA_ARGS__))) \
+        ( /*then*/ \
+            TRY(ujson_parse_qs(uj, self->name_, sizeof(self->name_))); \
+        , /*else*/ \
+            char *p = (char*)self->name_; \
+            OT_EVAL(ujson_de_bin_loop(ujson_de_bin_strings, size_, \
+                sizeof(self->name_), __VA_ARGS__)) \
+        ) /*endif*/ \
+    }
+
 #define UJSON_IMPL_DESERIALIZE_STRUCT(name_, decl_) \
     status_t ujson_deserialize_##name_(ujson_t *uj, name_ *self) { \
+        if (uj->encoding == kUjsonEncodingBinary) { \
+            decl_(ujson_de_bin_field, ujson_de_bin_string) \
+            return OK_STATUS(); \
+        } \
         size_t nfield = 0; \
         char key[128]; \
         TRY(ujson_consume(uj, '{')); \
@@ -225,8 +362,26 @@
 #define ujson_de_enum(formal_name_, name_, ...) \
     else if (ujson_streq(value, #name_)) { *self = k ##formal_name_ ## name_; }
 
+#define ujson_de_bin_enum(formal_name_, name_, ...) \
+    if (index == named++) { \
+        *self = k ##formal_name_ ## name_; \
+        return OK_STATUS(); \
+    }
+
 #define UJSON_IMPL_DESERIALIZE_ENUM(formal_name_, name_, decl_, ...) \
     status_t ujson_deserialize_##name_(ujson_t *uj, name_ *self) { \
+        if (uj->encoding == kUjsonEncodingBinary) { \
+            if (ujson_get_flags(__VA_ARGS__) & WITH_UNKNOWN) { \
+                return UNIMPLEMENTED(); \
+            } \
+            uint32_t index, named = 0; \
+            TRY(ujson_deserialize_uint32_t(uj, &index)); \
+            decl_(formal_name_, ujson_de_bin_enum) \
+            if (index != named) { \
+                return INVALID_ARGUMENT(); \
+            } \
+            return ujson_deserialize_uint32_t(uj, (uint32_t*)self); \
+        } \
         char value[128]; \
         if (TRY(ujson_consume_maybe(uj, '"'))) { \
             TRY(ujson_ungetc(uj, '"')); \
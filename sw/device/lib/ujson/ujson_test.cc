@@ -267,4 +267,129 @@ TEST(UJson, DeerializeStatus) {
   EXPECT_EQ(arg, 77);
 }
 
+TEST(UJson, SetEncoding) {
+  SourceSink ss("x");
+  ujson_t uj = ss.UJson();
+  EXPECT_EQ(uj.encoding, kUjsonEncodingJson);
+
+  EXPECT_EQ(status_err(ujson_set_encoding(&uj, kUjsonEncodingBinary)), kOk);
+  EXPECT_EQ(uj.encoding, kUjsonEncodingBinary);
+  EXPECT_EQ(status_err(ujson_set_encoding(
+                &uj, static_cast<ujson_encoding_t>(7))),
+            kInvalidArgument);
+
+  // A pushed-back character must be consumed before switching.
+  EXPECT_EQ(status_err(ujson_ungetc(&uj, 'x')), kOk);
+  EXPECT_EQ(status_err(ujson_set_encoding(&uj, kUjsonEncodingJson)),
+            kFailedPrecondition);
+  EXPECT_EQ(uj.encoding, kUjsonEncodingBinary);
+  EXPECT_EQ(ujson_getc(&uj).value, 'x');
+  EXPECT_EQ(status_err(ujson_set_encoding(&uj, kUjsonEncodingJson)), kOk);
+
+  // Whitespace pushed back by the JSON parser only separated tokens and is
+  // dropped.
+  EXPECT_EQ(status_err(ujson_ungetc(&uj, '\n')), kOk);
+  EXPECT_EQ(status_err(ujson_set_encoding(&uj, kUjsonEncodingBinary)), kOk);
+  EXPECT_EQ(ujson_getc(&uj).value, 'x');
+}
+
+TEST(UJson, UngetHighCharacter) {
+  SourceSink ss;
+  ujson_t uj = ss.UJson();
+  EXPECT_EQ(status_err(ujson_ungetc(&uj, '\xff')), kOk);
+  EXPECT_EQ(ujson_getc(&uj).value, 0xff);
+}
+
+#define BIN_INT(type_, bytes_, value_)                                  \
+  do {                                                                  \
+    SourceSink ss;                                                      \
+    ujson_t uj = ss.UJson();                                            \
+    ASSERT_EQ(status_err(ujson_set_encoding(&uj, kUjsonEncodingBinary)), \
+              kOk);                                                     \
+    type_ t = value_;                                                   \
+    EXPECT_EQ(status_err(ujson_serialize_##type_(&uj, &t)), kOk);       \
+    EXPECT_EQ(ss.Sink(), std::string(bytes_, sizeof(bytes_) - 1));      \
+    std::string bytes = ss.Sink();                                      \
+    ss.Reset(bytes);                                                    \
+    type_ u = 0;                                                        \
+    EXPECT_EQ(status_err(ujson_deserialize_##type_(&uj, &u)), kOk);     \
+    EXPECT_EQ(u, t);                                                    \
+  } while (0)
+
+TEST(UJson, BinaryIntegers) {
+  BIN_INT(uint64_t, "\x08\x07\x06\x05\x04\x03\x02\x01",
+          0x0102030405060708);
+  BIN_INT(uint32_t, "\xff\xff\xff\xff", 0xFFFFFFFF);
+  BIN_INT(uint16_t, "\x00\x80", 0x8000);
+  BIN_INT(uint8_t, "\x81", 129);
+  BIN_INT(size_t, "\x2a\x00\x00\x00\x00\x00\x00\x00", 42);
+
+  BIN_INT(int64_t, "\xfe\xff\xff\xff\xff\xff\xff\xff", -2);
+  BIN_INT(int32_t, "\xff\xff\xff\xff", -1);
+  BIN_INT(int16_t, "\x00\x80", -32768);
+  BIN_INT(int8_t, "\xfe", -2);
+}
+#undef BIN_INT
+
+TEST(UJson, BinaryBool) {
+  SourceSink ss;
+  ujson_t uj = ss.UJson();
+  ASSERT_EQ(status_err(ujson_set_encoding(&uj, kUjsonEncodingBinary)), kOk);
+  bool val = true;
+
+  EXPECT_TRUE(status_ok(ujson_serialize_bool(&uj, &val)));
+  EXPECT_EQ(ss.Sink(), std::string("\x01", 1));
+
+  ss.Reset(std::string("\x00\x02", 2));
+  EXPECT_TRUE(status_ok(ujson_deserialize_bool(&uj, &val)));
+  EXPECT_FALSE(val);
+  EXPECT_EQ(status_err(ujson_deserialize_bool(&uj, &val)), kOutOfRange);
+}
+
+TEST(UJson, BinaryString) {
+  SourceSink ss;
+  ujson_t uj = ss.UJson();
+  ASSERT_EQ(status_err(ujson_set_encoding(&uj, kUjsonEncodingBinary)), kOk);
+  char buf[4];
+  status_t s;
+
+  // No escaping is needed in the binary encoding.
+  EXPECT_TRUE(status_ok(ujson_serialize_string(&uj, "a\"\n\xff")));
+  EXPECT_EQ(ss.Sink(), std::string("\x04\x00"
+                                   "a\"\n\xff",
+                                   6));
+
+  // The whole string is consumed even if the buffer is too short.
+  ss.Reset(std::string(ss.Sink()) + std::string("\x01\x00z", 3));
+  s = ujson_parse_qs(&uj, buf, sizeof(buf));
+  EXPECT_TRUE(status_ok(s));
+  EXPECT_EQ(s.value, 3);
+  EXPECT_EQ(std::string(buf), "a\"\n");
+  s = ujson_parse_qs(&uj, buf, sizeof(buf));
+  EXPECT_TRUE(status_ok(s));
+  EXPECT_EQ(std::string(buf), "z");
+
+  // Truncated input.
+  ss.Reset(std::string("\x05\x00"
+                       "ab",
+                       4));
+  EXPECT_EQ(status_err(ujson_parse_qs(&uj, buf, sizeof(buf))),
+            kResourceExhausted);
+}
+
+TEST(UJson, BinaryStatus) {
+  SourceSink ss;
+  ujson uj = ss.UJson();
+  ASSERT_EQ(status_err(ujson_set_encoding(&uj, kUjsonEncodingBinary)), kOk);
+  status_t val = INVALID_ARGUMENT();
+  status_t got;
+
+  EXPECT_TRUE(status_ok(ujson_serialize_status_t(&uj, &val)));
+  EXPECT_EQ(ss.Sink().size(), sizeof(int32_t));
+  std::string bytes = ss.Sink();
+  ss.Reset(bytes);
+  EXPECT_TRUE(status_ok(ujson_deserialize_status_t(&uj, &got)));
+  EXPECT_EQ(got.value, val.value);
+}
+
 }  // namespace
@@ -314,12 +314,134 @@ typedef struct active_page_info {
   size_t last_valid_index;
 } active_page_info_t;
 
+/**
+ * Sniff results for the entries of a page, see `boot_data_sniff()`.
+ *
+ * Searching a page for its first empty and last valid entries sniffs some
+ * entries more than once. This cache makes sure that each entry is read from
+ * flash at most once for this purpose.
+ */
+typedef struct sniff_cache {
+  /**
+   * Masked identifiers of the entries of the page.
+   */
+  uint32_t masked_identifier[kBootDataEntriesPerPage];
+  /**
+   * Bit `i` is set if `masked_identifier[i]` is known.
+   */
+  uint32_t known;
+} sniff_cache_t;
+
+static_assert(kBootDataEntriesPerPage <= sizeof((sniff_cache_t){0}.known) * 8,
+              "`known` must have a bit for each entry of a page.");
+
+/**
+ * Stores the masked identifier of the entry at the given index in the cache.
+ *
+ * @param cache A sniff cache.
+ * @param index Index of an entry.
+ * @param masked_identifier Masked identifier of the entry.
+ */
+static void sniff_cache_set(sniff_cache_t *cache, size_t index,
+                            uint32_t masked_identifier) {
+  cache->masked_identifier[index] = masked_identifier;
+  cache->known |= 1u << index;
+}
+
+/**
+ * Returns the masked identifier of the entry at the given index, sniffing it
+ * only if it is not already in the cache.
+ *
+ * @param page A boot data page.
+ * @param cache Sniff cache of the given page.
+ * @param index Index of the entry in the given page.
+ * @param[out] masked_identifier Identifier masked with the words of `is_valid`.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t boot_data_sniff_cached(const flash_ctrl_info_page_t *page,
+                                          sniff_cache_t *cache, size_t index,
+                                          uint32_t *masked_identifier) {
+  if (((cache->known >> index) & 1) == 0) {
+    HARDENED_RETURN_IF_ERROR(boot_data_sniff(page, index, masked_identifier));
+    sniff_cache_set(cache, index, *masked_identifier);
+  }
+  *masked_identifier = cache->masked_identifier[index];
+  return kErrorOk;
+}
+
+/**
+ * Finds the first entry in the given page that can be empty.
+ *
+ * Entries are appended to a page in order and pages are only erased as a
+ * whole, so the empty entries of a page always form a contiguous range at the
+ * end of the page. This function uses this to locate that range with
+ * `O(log(kBootDataEntriesPerPage))` sniffs instead of sniffing every entry:
+ * it first probes entries `0, 1, 2, 4, 8, ...` and the last entry to bound the
+ * range quickly, and then performs a binary search between the last two
+ * probes. Probing the first entries one by one keeps erased and lightly used
+ * pages at most as expensive as a linear scan.
+ *
+ * The binary search stops as soon as a single candidate is left. That entry
+ * is not sniffed since callers read it in full anyway.
+ *
+ * Since sniffing only reads the `is_valid` and `identifier` fields, an entry
+ * found by this function can still be non-empty, e.g. if a write was
+ * interrupted. Callers must check the returned entry and the ones following it
+ * in full, see `boot_data_page_info_update_impl()`. The returned index is never
+ * greater than the index of the first empty entry.
+ *
+ * @param page A boot data page.
+ * @param cache Sniff cache of the given page.
+ * @param[out] index Index of the first entry that can be empty, or
+ * `kBootDataEntriesPerPage` if all entries are known to be non-empty.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t boot_data_empty_search(const flash_ctrl_info_page_t *page,
+                                          sniff_cache_t *cache, size_t *index) {
+  uint32_t masked_identifier;
+  // Invariant: entries before `lo` are non-empty and the entry at `hi`, if
+  // any, can be empty.
+  size_t lo = 0, hi = kBootDataEntriesPerPage;
+  size_t probe = 0;
+  while (launder32(probe) < kBootDataEntriesPerPage) {
+    HARDENED_RETURN_IF_ERROR(
+        boot_data_sniff_cached(page, cache, probe, &masked_identifier));
+    if (masked_identifier == kFlashCtrlErasedWord) {
+      hi = probe;
+      break;
+    }
+    lo = probe + 1;
+    probe = probe == 0 ? 1 : 2 * probe;
+    if (probe >= kBootDataEntriesPerPage && lo < kBootDataEntriesPerPage) {
+      probe = kBootDataEntriesPerPage - 1;
+    }
+  }
+  while (launder32(lo) + 1 < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    HARDENED_RETURN_IF_ERROR(
+        boot_data_sniff_cached(page, cache, mid, &masked_identifier));
+    if (masked_identifier == kFlashCtrlErasedWord) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  HARDENED_CHECK_LE(lo, hi);
+  HARDENED_CHECK_LE(hi - lo, 1);
+  HARDENED_CHECK_LE(lo, kBootDataEntriesPerPage);
+  *index = lo;
+  return kErrorOk;
+}
+
 /**
  * Updates the given active page info struct and last valid boot data entry
  * using the given page.
  *
- * This function performs a forward search to find the first empty boot data
- * entry followed by a backward search to find the last valid boot data entry.
+ * This function searches for the first empty boot data entry, see
+ * `boot_data_empty_search()`, followed by a backward search to find the last
+ * valid boot data entry.
  * If the page has an entry that is newer than the one passed in, this function
  * updates `page_info` and `boot_data`. Reads must be enabled for the given page
  * before this function is called, see `boot_data_page_info_get()`.
@@ -335,22 +457,32 @@ OT_WARN_UNUSED_RESULT
 static rom_error_t boot_data_page_info_update_impl(
     const flash_ctrl_info_page_t *page, active_page_info_t *page_info,
     boot_data_t *boot_data) {
-  uint32_t sniff_results[kBootDataEntriesPerPage];
-
   boot_data_t buf;
-
-  // Perform a forward search to find the first empty entry.
+  uint32_t masked_identifier;
+  sniff_cache_t cache = {.known = 0};
+
+  // Find the first entry that can be empty and perform a forward search from
+  // there to find the first empty entry. The entry at `start` can be empty, so
+  // it is read in full without sniffing it first.
+  size_t start;
+  HARDENED_RETURN_IF_ERROR(boot_data_empty_search(page, &cache, &start));
   hardened_bool_t has_empty_entry = kHardenedBoolFalse;
-  size_t i = 0, r = kBootDataEntriesPerPage - 1;
+  size_t i = start, r = kBootDataEntriesPerPage - 1 - start;
   for (; launder32(i) < kBootDataEntriesPerPage &&
          launder32(r) < kBootDataEntriesPerPage;
        ++i, --r) {
-    // Read and cache the identifier to quickly determine if an entry can be
-    // empty or valid.
-    HARDENED_RETURN_IF_ERROR(boot_data_sniff(page, i, &sniff_results[i]));
+    masked_identifier = kFlashCtrlErasedWord;
+    if (i != start) {
+      // Read the identifier to quickly determine if an entry can be empty.
+      HARDENED_RETURN_IF_ERROR(
+          boot_data_sniff_cached(page, &cache, i, &masked_identifier));
+    }
     // Check all words of this entry only if it can be empty.
-    if (sniff_results[i] == kFlashCtrlErasedWord) {
+    if (masked_identifier == kFlashCtrlErasedWord) {
       HARDENED_RETURN_IF_ERROR(boot_data_entry_read(page, i, &buf));
+      sniff_cache_set(&cache, i,
+                      (uint32_t)buf.is_valid &
+                          (uint32_t)(buf.is_valid >> 32) & buf.identifier);
       has_empty_entry = boot_data_is_empty(&buf);
       if (launder32(has_empty_entry) == kHardenedBoolTrue) {
         HARDENED_CHECK_EQ(has_empty_entry, kHardenedBoolTrue);
@@ -371,7 +503,9 @@ static rom_error_t boot_data_page_info_update_impl(
                  launder32(r) < kBootDataEntriesPerPage;
        --i, ++r) {
     // Check the digest only if this entry can be valid.
-    if (sniff_results[i] == kBootDataIdentifier) {
+    HARDENED_RETURN_IF_ERROR(
+        boot_data_sniff_cached(page, &cache, i, &masked_identifier));
+    if (masked_identifier == kBootDataIdentifier) {
       HARDENED_RETURN_IF_ERROR(boot_data_entry_read(page, i, &buf));
       rom_error_t is_valid = boot_data_check(&buf);
       if (launder32(is_valid) == kErrorOk) {
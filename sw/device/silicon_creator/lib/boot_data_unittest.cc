@@ -6,6 +6,7 @@
 
 #include <array>
 #include <cstring>
+#include <map>
 
 #include "gtest/gtest.h"
 #include "sw/device/silicon_creator/lib/drivers/mock_flash_ctrl.h"
@@ -171,6 +172,51 @@ class BootDataTest : public rom_test::RomTest {
         });
   }
 
+  /**
+   * Contents of a boot data info page, one array of words per entry.
+   */
+  using PageImage = std::array<std::array<uint32_t, kBootDataNumWords>,
+                               kBootDataEntriesPerPage>;
+
+  /**
+   * Number of `flash_ctrl_info_read()` calls made for each info page.
+   */
+  std::map<const flash_ctrl_info_page_t *, size_t> flash_reads_;
+
+  /**
+   * Returns a page image with all entries erased.
+   */
+  PageImage ErasedImage() {
+    PageImage image;
+    image.fill(erased_entry_);
+    return image;
+  }
+
+  /**
+   * Sets an expectation that the given info page is read any number of times
+   * and serves those reads from the given page image.
+   *
+   * Unlike `ExpectRead` and `ExpectSniff`, this does not check the order of
+   * the reads, only their number, which is counted in `flash_reads_`.
+   *
+   * @param page  The info page to serve reads for.
+   * @param image Contents of the info page.
+   */
+  void ExpectReads(const flash_ctrl_info_page_t *page, PageImage image) {
+    EXPECT_CALL(flash_ctrl_, InfoRead(page, _, _, _))
+        .WillRepeatedly([this, image](const flash_ctrl_info_page_t *page,
+                                      uint32_t offset, uint32_t num_words,
+                                      void *out) {
+          ++flash_reads_[page];
+          EXPECT_EQ(offset % sizeof(uint32_t), 0);
+          EXPECT_LE(offset + num_words * sizeof(uint32_t), sizeof(image));
+          std::memcpy(out,
+                      reinterpret_cast<const char *>(image.data()) + offset,
+                      num_words * sizeof(uint32_t));
+          return kErrorOk;
+        });
+  }
+
   /**
    * Sets an expectation that a digest for the given `boot` data is computed.
    *
@@ -266,13 +312,16 @@ class BootDataTest : public rom_test::RomTest {
     // #3. Entry with sniffed area erased but the rest not.
     // #4. Fully erased entry.
     return [=](const flash_ctrl_info_page_t *page) {
-      // Expect to sniff each entry, fully reading if it could be erased.
+      // Expect to probe entries 0, 1, 2, and 4 to find the first entry that
+      // could be erased. Entry 3 is the only candidate left after that.
       ExpectSniff(page, 0, non_erased_entry_, kErrorOk);
       ExpectSniff(page, 1, boot_data_raw, kErrorOk);
       ExpectSniff(page, 2, boot_data_raw, kErrorOk);
-      ExpectSniff(page, 3, part_erased_entry_, kErrorOk);
-      ExpectRead(page, 3, part_erased_entry_, kErrorOk);
       ExpectSniff(page, 4, erased_entry_, kErrorOk);
+
+      // Expect to fully read each entry from there that could be erased.
+      // Entries that were already sniffed are not sniffed again.
+      ExpectRead(page, 3, part_erased_entry_, kErrorOk);
       ExpectRead(page, 4, erased_entry_, kErrorOk);
 
       // Check the last seen bootable entry's digest (mocked as invalid).
@@ -280,6 +329,8 @@ class BootDataTest : public rom_test::RomTest {
       ExpectDigestCompute(boot_data, false);
 
       // Step back to the previously seen bootable entry (provided `boot_data`).
+      // If that is also invalid, the search steps back to the non-bootable
+      // entry, which is not read again.
       ExpectRead(page, 1, boot_data_raw, kErrorOk);
       ExpectDigestCompute(boot_data, valid_digest);
     };
@@ -445,5 +496,108 @@ TEST_F(BootDataReadTest, ReadV1AsV2Test) {
   EXPECT_EQ(boot_data, kValidEntry0);
 }
 
+TEST_F(BootDataReadTest, ReadFullPageFlashReadsTest) {
+  // Fill the first page with invalidated entries followed by a valid one.
+  boot_data_t invalidated = kValidEntry0;
+  invalidated.is_valid = kBootDataInvalidEntry;
+  PageImage image;
+  for (size_t i = 0; i < kBootDataEntriesPerPage - 1; ++i) {
+    std::memcpy(image[i].data(), &invalidated, sizeof(boot_data_t));
+  }
+  std::memcpy(image[kBootDataEntriesPerPage - 1].data(), &kValidEntry1,
+              sizeof(boot_data_t));
+
+  ExpectPageScan(&kFlashCtrlInfoPageBootData0, [&](auto page) {
+    ExpectReads(page, image);
+    ExpectDigestCompute(kValidEntry1, true);
+  });
+  ExpectPageScan(&kFlashCtrlInfoPageBootData1,
+                 [&](auto page) { ExpectReads(page, ErasedImage()); });
+
+  boot_data_t boot_data = {{0}};
+  EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
+  EXPECT_EQ(boot_data, kValidEntry1);
+
+  // A full page is probed at entries 0, 1, 2, 4, 8, and 15 before the last
+  // entry is read in full. An erased page is sniffed and read once.
+  EXPECT_EQ(flash_reads_[&kFlashCtrlInfoPageBootData0], 7);
+  EXPECT_EQ(flash_reads_[&kFlashCtrlInfoPageBootData1], 2);
+}
+
+TEST_F(BootDataReadTest, ReadPartialPageFlashReadsTest) {
+  // Fill the first half of the first page with invalidated entries followed by
+  // a valid one.
+  constexpr size_t kValidIndex = kBootDataEntriesPerPage / 2 - 1;
+  boot_data_t invalidated = kValidEntry0;
+  invalidated.is_valid = kBootDataInvalidEntry;
+  PageImage image = ErasedImage();
+  for (size_t i = 0; i < kValidIndex; ++i) {
+    std::memcpy(image[i].data(), &invalidated, sizeof(boot_data_t));
+  }
+  std::memcpy(image[kValidIndex].data(), &kValidEntry1, sizeof(boot_data_t));
+
+  ExpectPageScan(&kFlashCtrlInfoPageBootData0, [&](auto page) {
+    ExpectReads(page, image);
+    ExpectDigestCompute(kValidEntry1, true);
+  });
+  ExpectPageScan(&kFlashCtrlInfoPageBootData1,
+                 [&](auto page) { ExpectReads(page, ErasedImage()); });
+
+  boot_data_t boot_data = {{0}};
+  EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
+  EXPECT_EQ(boot_data, kValidEntry1);
+
+  // Probes at entries 0, 1, 2, 4, and 8, a sniff of entry 6 by the binary
+  // search, full reads of entries 7 and 8 by the forward search, and a full
+  // read of entry 7 by the backward search.
+  EXPECT_EQ(flash_reads_[&kFlashCtrlInfoPageBootData0], 9);
+  EXPECT_EQ(flash_reads_[&kFlashCtrlInfoPageBootData1], 2);
+}
+
+TEST_F(BootDataReadTest, ReadOneEntryPageFlashReadsTest) {
+  PageImage image = ErasedImage();
+  std::memcpy(image[0].data(), &kValidEntry1, sizeof(boot_data_t));
+
+  ExpectPageScan(&kFlashCtrlInfoPageBootData0, [&](auto page) {
+    ExpectReads(page, image);
+    ExpectDigestCompute(kValidEntry1, true);
+  });
+  ExpectPageScan(&kFlashCtrlInfoPageBootData1,
+                 [&](auto page) { ExpectReads(page, ErasedImage()); });
+
+  boot_data_t boot_data = {{0}};
+  EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
+  EXPECT_EQ(boot_data, kValidEntry1);
+
+  // Probes at entries 0 and 1 and full reads of entries 1 and 0, as many as a
+  // linear scan of the page.
+  EXPECT_EQ(flash_reads_[&kFlashCtrlInfoPageBootData0], 4);
+  EXPECT_EQ(flash_reads_[&kFlashCtrlInfoPageBootData1], 2);
+}
+
+TEST_F(BootDataReadTest, ReadTwoEntryPageFlashReadsTest) {
+  boot_data_t invalidated = kValidEntry0;
+  invalidated.is_valid = kBootDataInvalidEntry;
+  PageImage image = ErasedImage();
+  std::memcpy(image[0].data(), &invalidated, sizeof(boot_data_t));
+  std::memcpy(image[1].data(), &kValidEntry1, sizeof(boot_data_t));
+
+  ExpectPageScan(&kFlashCtrlInfoPageBootData0, [&](auto page) {
+    ExpectReads(page, image);
+    ExpectDigestCompute(kValidEntry1, true);
+  });
+  ExpectPageScan(&kFlashCtrlInfoPageBootData1,
+                 [&](auto page) { ExpectReads(page, ErasedImage()); });
+
+  boot_data_t boot_data = {{0}};
+  EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
+  EXPECT_EQ(boot_data, kValidEntry1);
+
+  // Probes at entries 0, 1, and 2 and full reads of entries 2 and 1, as many
+  // as a linear scan of the page.
+  EXPECT_EQ(flash_reads_[&kFlashCtrlInfoPageBootData0], 5);
+  EXPECT_EQ(flash_reads_[&kFlashCtrlInfoPageBootData1], 2);
+}
+
 }  // namespace
 }  // namespace boot_data_unittest
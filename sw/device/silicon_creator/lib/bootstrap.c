@@ -11,8 +11,10 @@
 #include "sw/device/lib/base/bitfield.h"
 #include "sw/device/lib/base/hardened.h"
 #include "sw/device/silicon_creator/lib/drivers/flash_ctrl.h"
+#include "sw/device/silicon_creator/lib/drivers/ibex.h"
 #include "sw/device/silicon_creator/lib/drivers/rstmgr.h"
 #include "sw/device/silicon_creator/lib/drivers/spi_device.h"
+#include "sw/device/silicon_creator/lib/drivers/uart.h"
 #include "sw/device/silicon_creator/lib/error.h"
 #include "sw/device/silicon_creator/lib/stack_utilization.h"
 
@@ -24,6 +26,10 @@ enum {
    */
   kMaxAddress =
       FLASH_CTRL_PARAM_BYTES_PER_BANK * FLASH_CTRL_PARAM_REG_NUM_BANKS,
+  /**
+   * Mask for checking that an address is flash word aligned.
+   */
+  kFlashWordMask = FLASH_CTRL_PARAM_BYTES_PER_WORD - 1,
 };
 
 static_assert(FLASH_CTRL_PARAM_REG_NUM_BANKS == 2, "Flash must have 2 banks");
@@ -61,6 +67,122 @@ typedef enum bootstrap_state {
   kBootstrapStateProgram = 0xbdd8ca60,
 } bootstrap_state_t;
 
+#ifdef BOOTSTRAP_PIPELINED
+/**
+ * State of the PAGE_PROGRAM pipeline.
+ *
+ * In pipelined mode, a PAGE_PROGRAM command is acknowledged (WIP cleared) as
+ * soon as its payload is copied out of the SPI device, so that the SPI device
+ * receives the next page while this one is programmed.  The last program
+ * transaction of a page is left running while the next command is fetched,
+ * and completed by `bootstrap_program_finish()`.
+ */
+static struct {
+  /**
+   * Whether a PAGE_PROGRAM command is in progress, i.e. write permission is
+   * granted.
+   */
+  bool pending;
+  /**
+   * Whether a program transaction is in progress.
+   */
+  bool busy;
+  /**
+   * Number of bytes programmed, for the throughput report.
+   */
+  uint32_t byte_count;
+  /**
+   * Value of `mcycle` at the first PAGE_PROGRAM command.
+   */
+  uint32_t start_cycles;
+} pipeline;
+
+/**
+ * Blocks until the program transaction in progress, if any, is complete.
+ *
+ * @return Result of the transaction.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t bootstrap_program_wait(void) {
+  if (!pipeline.busy) {
+    return kErrorOk;
+  }
+  pipeline.busy = false;
+  bool done;
+  rom_error_t error;
+  do {
+    error = flash_ctrl_data_write_poll(&done);
+  } while (!done);
+  return error;
+}
+
+/**
+ * Completes the PAGE_PROGRAM command in progress, if any, and revokes the
+ * write permission it was granted.
+ *
+ * Must be called before handling the next command.
+ *
+ * @return Result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t bootstrap_program_finish(void) {
+  if (!pipeline.pending) {
+    return kErrorOk;
+  }
+  pipeline.pending = false;
+  rom_error_t error = bootstrap_program_wait();
+  flash_ctrl_data_default_perms_set((flash_ctrl_perms_t){
+      .read = kMultiBitBool4False,
+      .write = kMultiBitBool4False,
+      .erase = kMultiBitBool4False,
+  });
+  return error;
+}
+
+/**
+ * Programs a contiguous range of the data partition, feeding the flash
+ * controller one program window after the other and returning while the last
+ * one is still being programmed.
+ *
+ * @param addr Address to write to.
+ * @param word_count Number of bus words to write.
+ * @param data Data to write, must be word aligned.
+ * @return Result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t bootstrap_program_start(uint32_t addr, size_t word_count,
+                                           const uint8_t *data) {
+  while (word_count > 0) {
+    HARDENED_RETURN_IF_ERROR(bootstrap_program_wait());
+    uint32_t window_word_count =
+        flash_ctrl_data_write_start(addr, word_count, data);
+    pipeline.busy = true;
+    addr += window_word_count * sizeof(uint32_t);
+    data += window_word_count * sizeof(uint32_t);
+    word_count -= window_word_count;
+  }
+  return kErrorOk;
+}
+
+/**
+ * Prints the number of bytes programmed and the number of cycles since the
+ * first PAGE_PROGRAM command.
+ */
+static void bootstrap_throughput_print(void) {
+#ifdef OT_PLATFORM_RV32
+  uint32_t cycles = ibex_mcycle32() - pipeline.start_cycles;
+  //                          : P T B
+  const uint32_t kPrefix = 0x3a505442;
+  uart_write_imm(kPrefix);
+  uart_write_hex(pipeline.byte_count, sizeof(pipeline.byte_count), '/');
+  uart_write_hex(cycles, sizeof(cycles), '\r');
+  // Send the last char with putchar so we'll wait for the
+  // transmitter to finish.
+  uart_putchar('\n');
+#endif
+}
+#endif
+
 /**
  * Handles access permissions and erases a 4 KiB region in the data partition of
  * the embedded flash.
@@ -105,6 +227,21 @@ static rom_error_t bootstrap_sector_erase(uint32_t addr) {
   return err_1;
 }
 
+/**
+ * Checks that `addr` is a valid PAGE_PROGRAM address.
+ *
+ * @param addr Address to write to.
+ * @return `kErrorOk` if `addr` is flash word aligned and within the data
+ * partition, `kErrorBootstrapProgramAddress` otherwise.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t bootstrap_program_addr_check(uint32_t addr) {
+  if (addr & kFlashWordMask || addr >= kMaxAddress) {
+    return kErrorBootstrapProgramAddress;
+  }
+  return kErrorOk;
+}
+
 /**
  * Handles access permissions and programs up to 256 bytes of flash memory
  * starting at `addr`.
@@ -119,6 +256,9 @@ static rom_error_t bootstrap_sector_erase(uint32_t addr) {
  * multiple of flash word size, `data` must have enough space until the next
  * flash word.
  * @return Result of the operation.
+ *
+ * In pipelined mode, this returns while the last program transaction is still
+ * in progress, and `bootstrap_program_finish()` completes it.
  */
 OT_WARN_UNUSED_RESULT
 static rom_error_t bootstrap_page_program(uint32_t addr, size_t byte_count,
@@ -126,10 +266,6 @@ static rom_error_t bootstrap_page_program(uint32_t addr, size_t byte_count,
   static_assert(__builtin_popcount(FLASH_CTRL_PARAM_BYTES_PER_WORD) == 1,
                 "Bytes per flash word must be a power of two.");
   enum {
-    /**
-     * Mask for checking that `addr` is flash word aligned.
-     */
-    kFlashWordMask = FLASH_CTRL_PARAM_BYTES_PER_WORD - 1,
     /**
      * SPI flash programming page size in bytes.
      */
@@ -143,9 +279,7 @@ static rom_error_t bootstrap_page_program(uint32_t addr, size_t byte_count,
     kFlashProgPageMask = kFlashProgPageSize - 1,
   };
 
-  if (addr & kFlashWordMask || addr >= kMaxAddress) {
-    return kErrorBootstrapProgramAddress;
-  }
+  HARDENED_RETURN_IF_ERROR(bootstrap_program_addr_check(addr));
 
   // Round up to next flash word and fill missing bytes with `0xff`.
   size_t flash_word_misalignment = byte_count & kFlashWordMask;
@@ -163,6 +297,15 @@ static rom_error_t bootstrap_page_program(uint32_t addr, size_t byte_count,
       .write = kMultiBitBool4True,
       .erase = kMultiBitBool4False,
   });
+#ifdef BOOTSTRAP_PIPELINED
+  pipeline.pending = true;
+#ifdef OT_PLATFORM_RV32
+  if (pipeline.byte_count == 0) {
+    pipeline.start_cycles = ibex_mcycle32();
+  }
+#endif
+  pipeline.byte_count += byte_count;
+#endif
   // Perform two writes if the start address is not page-aligned (256 bytes).
   // Note: Address is flash-word-aligned (8 bytes) due to the check above.
   rom_error_t err_0 = kErrorOk;
@@ -173,7 +316,11 @@ static rom_error_t bootstrap_page_program(uint32_t addr, size_t byte_count,
     if (word_count > rem_word_count) {
       word_count = rem_word_count;
     }
+#ifdef BOOTSTRAP_PIPELINED
+    err_0 = bootstrap_program_start(addr, word_count, data);
+#else
     err_0 = flash_ctrl_data_write(addr, word_count, data);
+#endif
     rem_word_count -= word_count;
     data += word_count * sizeof(uint32_t);
     // Wrap to the beginning of the current page since PAGE_PROGRAM modifies
@@ -182,13 +329,28 @@ static rom_error_t bootstrap_page_program(uint32_t addr, size_t byte_count,
   }
   rom_error_t err_1 = kErrorOk;
   if (rem_word_count > 0) {
+#ifdef BOOTSTRAP_PIPELINED
+    // Do not start the second write after the first one failed.
+    if (err_0 == kErrorOk) {
+      err_1 = bootstrap_program_start(addr, rem_word_count, data);
+    }
+#else
     err_1 = flash_ctrl_data_write(addr, rem_word_count, data);
+#endif
+  }
+#ifdef BOOTSTRAP_PIPELINED
+  if (err_0 != kErrorOk || err_1 != kErrorOk) {
+    // Revoke write permission now rather than when the next command is
+    // received, since the caller returns the error right away.
+    OT_DISCARD(bootstrap_program_finish());
   }
+#else
   flash_ctrl_data_default_perms_set((flash_ctrl_perms_t){
       .read = kMultiBitBool4False,
       .write = kMultiBitBool4False,
       .erase = kMultiBitBool4False,
   });
+#endif
 
   HARDENED_RETURN_IF_ERROR(err_0);
   return err_1;
@@ -276,6 +438,10 @@ static rom_error_t bootstrap_handle_program(bootstrap_state_t *state) {
 
   spi_device_cmd_t cmd;
   RETURN_IF_ERROR(spi_device_cmd_get(&cmd));
+#ifdef BOOTSTRAP_PIPELINED
+  // The previous page was programmed while this command was received.
+  HARDENED_RETURN_IF_ERROR(bootstrap_program_finish());
+#endif
   // Erase and program require WREN, ignore if WEL is not set.
   if (cmd.opcode != kSpiDeviceOpcodeReset &&
       !bitfield_bit32_read(spi_device_flash_status_get(), kSpiDeviceWelBit)) {
@@ -291,10 +457,25 @@ static rom_error_t bootstrap_handle_program(bootstrap_state_t *state) {
       error = bootstrap_sector_erase(cmd.address);
       break;
     case kSpiDeviceOpcodePageProgram:
+#ifdef BOOTSTRAP_PIPELINED
+      // The payload has been copied out of the SPI device, so the host can
+      // send the next page while this one is programmed.  WIP must not be
+      // cleared again below: it may already belong to the next command.
+      // An invalid address is rejected first, so that the host does not see
+      // the command acknowledged.
+      HARDENED_RETURN_IF_ERROR(bootstrap_program_addr_check(cmd.address));
+      spi_device_flash_status_clear();
+      return bootstrap_page_program(cmd.address, cmd.payload_byte_count,
+                                    cmd.payload);
+#else
       error = bootstrap_page_program(cmd.address, cmd.payload_byte_count,
                                      cmd.payload);
       break;
+#endif
     case kSpiDeviceOpcodeReset:
+#ifdef BOOTSTRAP_PIPELINED
+      bootstrap_throughput_print();
+#endif
       // In a normal build, this function inlines to nothing.
       stack_utilization_print();
       rstmgr_reset();
@@ -320,6 +501,11 @@ static rom_error_t bootstrap_handle_program(bootstrap_state_t *state) {
 
 rom_error_t enter_bootstrap(void) {
   spi_device_init_bootstrap();
+#ifdef BOOTSTRAP_PIPELINED
+  pipeline.pending = false;
+  pipeline.busy = false;
+  pipeline.byte_count = 0;
+#endif
 
   // Bootstrap event loop.
   bootstrap_state_t state = kBootstrapStateErase;
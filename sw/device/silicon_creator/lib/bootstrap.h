@@ -31,6 +31,13 @@ extern "C" {
  * This function only returns on error; a successful session ends with a chip
  * reset.
  *
+ * When built with `BOOTSTRAP_PIPELINED` defined, PAGE_PROGRAM commands are
+ * acknowledged as soon as their payload is received, and each page is
+ * programmed while the host sends the next command.  A programming error is
+ * then returned while handling the following command.  The number of bytes
+ * programmed and the cycles spent since the first PAGE_PROGRAM are printed on
+ * the console before RESET.
+ *
  * @return The result of the flash loop.
  */
 OT_WARN_UNUSED_RESULT
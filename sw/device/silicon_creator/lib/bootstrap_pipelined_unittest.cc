@@ -0,0 +1,223 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sw/device/silicon_creator/lib/bootstrap.h"
+#include "sw/device/silicon_creator/lib/drivers/mock_flash_ctrl.h"
+#include "sw/device/silicon_creator/lib/drivers/mock_rstmgr.h"
+#include "sw/device/silicon_creator/lib/drivers/mock_spi_device.h"
+#include "sw/device/silicon_creator/testing/rom_test.h"
+
+#include "hw/top/flash_ctrl_regs.h"
+
+bool operator==(flash_ctrl_perms_t lhs, flash_ctrl_perms_t rhs) {
+  return std::memcmp(&lhs, &rhs, sizeof(flash_ctrl_perms_t)) == 0;
+}
+
+// This test is built with `BOOTSTRAP_PIPELINED`, and provides the abstract
+// functions of `bootstrap.h` itself.
+extern "C" {
+rom_error_t bootstrap_chip_erase(void) { return kErrorOk; }
+rom_error_t bootstrap_erase_verify(void) { return kErrorOk; }
+}
+
+namespace bootstrap_pipelined_unittest {
+namespace {
+
+using ::testing::_;
+using ::testing::DoAll;
+using ::testing::InSequence;
+using ::testing::NotNull;
+using ::testing::Return;
+using ::testing::SetArgPointee;
+
+enum {
+  /**
+   * Words programmed per transaction by the mocked flash controller.
+   */
+  kWindowWordCount = 16,
+};
+
+MATCHER_P(HasBytes, bytes, "") {
+  return std::memcmp(arg, bytes.data(), bytes.size()) == 0;
+}
+
+class BootstrapPipelinedTest : public rom_test::RomTest {
+ protected:
+  void ExpectSpiCmd(spi_device_cmd_t cmd) {
+    EXPECT_CALL(spi_device_, CmdGet(NotNull()))
+        .WillOnce(DoAll(SetArgPointee<0>(cmd), Return(kErrorOk)));
+  }
+
+  void ExpectSpiFlashStatusGet(bool wel) {
+    EXPECT_CALL(spi_device_, FlashStatusGet())
+        .WillOnce(Return(wel << kSpiDeviceWelBit));
+  }
+
+  void ExpectPermsSet(multi_bit_bool_t write) {
+    EXPECT_CALL(flash_ctrl_, DataDefaultPermsSet((flash_ctrl_perms_t){
+                                 .read = kMultiBitBool4False,
+                                 .write = write,
+                                 .erase = kMultiBitBool4False,
+                             }));
+  }
+
+  void ExpectWritePoll(rom_error_t error) {
+    EXPECT_CALL(flash_ctrl_, DataWritePoll(NotNull()))
+        .WillOnce(DoAll(SetArgPointee<0>(false), Return(kErrorOk)))
+        .WillOnce(DoAll(SetArgPointee<0>(true), Return(error)));
+  }
+
+  /**
+   * Sets expectations for the chip erase that starts a bootstrap session.
+   */
+  void ExpectErase() {
+    EXPECT_CALL(spi_device_, InitBootstrap());
+    ExpectSpiCmd({
+        .opcode = kSpiDeviceOpcodeChipErase,
+        .address = kSpiDeviceNoAddress,
+        .payload_byte_count = 0,
+        .payload = {},
+    });
+    ExpectSpiFlashStatusGet(true);
+    EXPECT_CALL(spi_device_, FlashStatusClear());
+  }
+
+  /**
+   * Sets expectations for a full-page PAGE_PROGRAM that is queued without
+   * waiting for its last program transaction.
+   *
+   * @param cmd PAGE_PROGRAM command.
+   * @param previous_pending Whether a previous page is still being programmed.
+   */
+  void ExpectPageProgramQueued(const spi_device_cmd_t &cmd,
+                               bool previous_pending) {
+    ExpectSpiCmd(cmd);
+    if (previous_pending) {
+      // The last transaction of the previous page completes after this
+      // command has been received.
+      ExpectWritePoll(kErrorOk);
+      ExpectPermsSet(kMultiBitBool4False);
+    }
+    ExpectSpiFlashStatusGet(true);
+    // The host is released before the page is programmed.
+    EXPECT_CALL(spi_device_, FlashStatusClear());
+    ExpectPermsSet(kMultiBitBool4True);
+    for (size_t i = 0; i < cmd.payload_byte_count / sizeof(uint32_t);
+         i += kWindowWordCount) {
+      if (i > 0) {
+        ExpectWritePoll(kErrorOk);
+      }
+      std::vector<uint8_t> bytes(
+          cmd.payload + i * sizeof(uint32_t),
+          cmd.payload + (i + kWindowWordCount) * sizeof(uint32_t));
+      EXPECT_CALL(flash_ctrl_,
+                  DataWriteStart(cmd.address + i * sizeof(uint32_t), _,
+                                 HasBytes(bytes)))
+          .WillOnce(Return(kWindowWordCount));
+    }
+  }
+
+  spi_device_cmd_t PageProgramCmd(uint32_t address) {
+    spi_device_cmd_t cmd{
+        .opcode = kSpiDeviceOpcodePageProgram,
+        .address = address,
+        .payload_byte_count = kSpiDevicePayloadAreaNumBytes,
+    };
+    for (size_t i = 0; i < cmd.payload_byte_count; ++i) {
+      cmd.payload[i] = static_cast<uint8_t>(i + address);
+    }
+    return cmd;
+  }
+
+  rom_test::MockFlashCtrl flash_ctrl_;
+  rom_test::MockRstmgr rstmgr_;
+  rom_test::MockSpiDevice spi_device_;
+};
+
+TEST_F(BootstrapPipelinedTest, ProgramOverlapsNextCommand) {
+  InSequence seq;
+  ExpectErase();
+  ExpectPageProgramQueued(PageProgramCmd(0), false);
+  ExpectPageProgramQueued(PageProgramCmd(kSpiDevicePayloadAreaNumBytes), true);
+  ExpectSpiCmd({
+      .opcode = kSpiDeviceOpcodeReset,
+      .address = kSpiDeviceNoAddress,
+      .payload_byte_count = 0,
+      .payload = {},
+  });
+  ExpectWritePoll(kErrorOk);
+  ExpectPermsSet(kMultiBitBool4False);
+  EXPECT_CALL(rstmgr_, Reset());
+
+  EXPECT_EQ(enter_bootstrap(), kErrorUnknown);
+}
+
+TEST_F(BootstrapPipelinedTest, ProgramErrorOnNextCommand) {
+  InSequence seq;
+  ExpectErase();
+  ExpectPageProgramQueued(PageProgramCmd(0), false);
+  // The error of the last transaction is returned once the next command is
+  // received, and write permission is revoked.
+  ExpectSpiCmd(PageProgramCmd(kSpiDevicePayloadAreaNumBytes));
+  ExpectWritePoll(kErrorFlashCtrlDataWrite);
+  ExpectPermsSet(kMultiBitBool4False);
+
+  EXPECT_EQ(enter_bootstrap(), kErrorFlashCtrlDataWrite);
+}
+
+TEST_F(BootstrapPipelinedTest, EraseWaitsForProgram) {
+  InSequence seq;
+  ExpectErase();
+  ExpectPageProgramQueued(PageProgramCmd(0), false);
+  ExpectSpiCmd({
+      .opcode = kSpiDeviceOpcodeChipErase,
+      .address = kSpiDeviceNoAddress,
+      .payload_byte_count = 0,
+      .payload = {},
+  });
+  ExpectWritePoll(kErrorOk);
+  ExpectPermsSet(kMultiBitBool4False);
+  ExpectSpiFlashStatusGet(true);
+  EXPECT_CALL(spi_device_, FlashStatusClear());
+  EXPECT_CALL(spi_device_, CmdGet(NotNull()))
+      .WillOnce(Return(kErrorSpiDevicePayloadOverflow));
+
+  EXPECT_EQ(enter_bootstrap(), kErrorSpiDevicePayloadOverflow);
+}
+
+TEST_F(BootstrapPipelinedTest, ProgramStartErrorRevokesWrite) {
+  InSequence seq;
+  ExpectErase();
+  // A misaligned page is programmed with two writes. The first one fails
+  // before its last window, so the second one is not started and write
+  // permission is revoked before returning.
+  ExpectSpiCmd(PageProgramCmd(64));
+  ExpectSpiFlashStatusGet(true);
+  EXPECT_CALL(spi_device_, FlashStatusClear());
+  ExpectPermsSet(kMultiBitBool4True);
+  EXPECT_CALL(flash_ctrl_, DataWriteStart(64, _, _))
+      .WillOnce(Return(kWindowWordCount));
+  ExpectWritePoll(kErrorFlashCtrlDataWrite);
+  ExpectPermsSet(kMultiBitBool4False);
+
+  EXPECT_EQ(enter_bootstrap(), kErrorFlashCtrlDataWrite);
+}
+
+TEST_F(BootstrapPipelinedTest, BadProgramAddressNotAcknowledged) {
+  InSequence seq;
+  ExpectErase();
+  // WIP is not cleared for a PAGE_PROGRAM outside of the data partition.
+  ExpectSpiCmd(PageProgramCmd(FLASH_CTRL_PARAM_BYTES_PER_BANK *
+                              FLASH_CTRL_PARAM_REG_NUM_BANKS));
+  ExpectSpiFlashStatusGet(true);
+
+  EXPECT_EQ(enter_bootstrap(), kErrorBootstrapProgramAddress);
+}
+
+}  // namespace
+}  // namespace bootstrap_pipelined_unittest
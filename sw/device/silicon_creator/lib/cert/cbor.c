@@ -70,6 +70,15 @@ size_t cbor_write_raw_bytes(cbor_out_t *p, const uint8_t *raw,
   return raw_size;
 }
 
+size_t cbor_patch_raw_bytes(cbor_out_t *p, const size_t offset,
+                            const uint8_t *raw, const size_t raw_size) {
+  if (p) {
+    memcpy(p->start + offset, raw, raw_size);
+  }
+
+  return raw_size;
+}
+
 static size_t cbor_write_type(cbor_out_t *p, cbor_type_t type,
                               const uint64_t arg) {
   const size_t sz = cbor_calc_arg_size(arg);
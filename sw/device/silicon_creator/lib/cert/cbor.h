@@ -7,6 +7,10 @@
 
 #include "sw/device/silicon_creator/lib/error.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 struct cbor_out {
   uint8_t *start;
   size_t offset;
@@ -21,7 +25,7 @@ typedef struct cbor_out cbor_out_t;
  * @param buf buffer to be written
  */
 static inline void cbor_out_init(cbor_out_t *p, void *buf) {
-  p->start = buf;
+  p->start = (uint8_t *)buf;
   p->offset = 0;
 }
 
@@ -59,6 +63,21 @@ size_t cbor_calc_int_size(int64_t value);
  */
 size_t cbor_write_raw_bytes(cbor_out_t *p, const uint8_t *raw, size_t raw_size);
 
+/**
+ * Overwrite raw bytes already written at `offset` if cbor_out is not NULL.
+ *
+ * Used to fill in the variables of a fixed-size structure after writing its
+ * whole encoding at once.
+ *
+ * @param[in,out] p cbor_out structure
+ * @param offset offset of the bytes to overwrite
+ * @param raw pointer to raw bytes
+ * @param raw_size the size of raw bytes
+ * @return size written
+ */
+size_t cbor_patch_raw_bytes(cbor_out_t *p, size_t offset, const uint8_t *raw,
+                            size_t raw_size);
+
 /**
  * Write the integer if cbor_out is not NULL.
  *
@@ -136,4 +155,8 @@ size_t cbor_write_array_header(cbor_out_t *p, size_t num_elements);
  */
 size_t cbor_write_map_header(cbor_out_t *p, size_t num_pairs);
 
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
 #endif  // OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_CERT_CBOR_H_
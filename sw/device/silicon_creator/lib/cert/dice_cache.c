@@ -0,0 +1,159 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/silicon_creator/lib/cert/dice_cache.h"
+
+#include "sw/device/lib/base/hardened_memory.h"
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/silicon_creator/lib/base/util.h"
+#include "sw/device/silicon_creator/lib/otbn_boot_services.h"
+
+void dice_cache_uds_inputs_digest(const dice_cache_uds_inputs_t *inputs,
+                                  hmac_digest_t *digest) {
+  hmac_sha256_init();
+  hmac_sha256_update(&inputs->device_id, sizeof(inputs->device_id));
+  hmac_sha256_update(&inputs->lc_state, sizeof(inputs->lc_state));
+  hmac_sha256_update(inputs->otp_digests, sizeof(inputs->otp_digests));
+  hmac_sha256_update(&inputs->rom_ext_measurement,
+                     sizeof(inputs->rom_ext_measurement));
+  hmac_sha256_process();
+  hmac_sha256_final(digest);
+}
+
+void dice_cache_cdi_0_inputs_digest(const hmac_digest_t *uds_digest,
+                                    const dice_cache_cdi_0_inputs_t *inputs,
+                                    hmac_digest_t *digest) {
+  hmac_sha256_init();
+  hmac_sha256_update(uds_digest, sizeof(*uds_digest));
+  hmac_sha256_update(&inputs->seal_binding, sizeof(inputs->seal_binding));
+  hmac_sha256_update(&inputs->attest_binding, sizeof(inputs->attest_binding));
+  hmac_sha256_update(&inputs->max_key_version,
+                     sizeof(inputs->max_key_version));
+  hmac_sha256_update(&inputs->owner_history, sizeof(inputs->owner_history));
+  hmac_sha256_process();
+  hmac_sha256_final(digest);
+}
+
+/**
+ * Keymgr diversifier of the key of the cache tags.
+ *
+ * The version is 0 so that the key is always valid from the perspective of the
+ * keymgr hardware.
+ */
+static const sc_keymgr_diversification_t kDiceCacheTagKeyDiversifier = {
+    .salt =
+        {
+            0x4d379fce,
+            0x58f6dc5e,
+            0xba1c0a07,
+            0x2eb65b9c,
+            0x9d1e23c9,
+            0x5f47f62c,
+            0x159dbd67,
+            0x7cc98f15,
+        },
+    .version = 0,
+};
+
+rom_error_t dice_cache_tag_key_derive(hmac_key_t *tag_key) {
+  static_assert(sizeof(tag_key->key) ==
+                    kScKeymgrOutputNumWords * sizeof(uint32_t),
+                "Unexpected HMAC key size.");
+  HARDENED_RETURN_IF_ERROR(sc_keymgr_state_check(kScKeymgrStateCreatorRootKey));
+  return sc_keymgr_generate_key_sw(kScKeymgrKeyTypeAttestation,
+                                   kDiceCacheTagKeyDiversifier, tag_key->key);
+}
+
+/**
+ * Data covered by the tag of a cache entry.
+ */
+typedef struct dice_cache_tag_data {
+  sc_keymgr_diversification_t diversifier;
+  hmac_digest_t inputs;
+  ecdsa_p256_public_key_t pubkey;
+} dice_cache_tag_data_t;
+
+/**
+ * Computes the tag of a cached DICE public key.
+ *
+ * @param tag_key Key of the cache tags.
+ * @param key The key the public key belongs to.
+ * @param inputs Digest of the inputs of the key.
+ * @param pubkey The public key.
+ * @param[out] tag The tag.
+ */
+static void dice_cache_tag(const hmac_key_t *tag_key, sc_keymgr_ecc_key_t key,
+                           const hmac_digest_t *inputs,
+                           const ecdsa_p256_public_key_t *pubkey,
+                           hmac_digest_t *tag) {
+  dice_cache_tag_data_t data = {
+      .diversifier = *key.keymgr_diversifier,
+      .inputs = *inputs,
+      .pubkey = *pubkey,
+  };
+  sc_hmac_hmac_sha256(&data, sizeof(data), *tag_key,
+                      /*big_endian_digest=*/false, tag);
+}
+
+/**
+ * Generates a DICE key and updates its cache entry.
+ *
+ * The caller must check the keymgr state.
+ *
+ * @param tag_key Key of the cache tags.
+ * @param key The key to generate.
+ * @param inputs Digest of the inputs of the key.
+ * @param[out] entry Cache entry of the key.
+ * @param[out] pubkey_id The public key ID.
+ * @param[out] pubkey The public key.
+ * @return errors encountered during the operation.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t dice_cache_entry_update(const hmac_key_t *tag_key,
+                                           sc_keymgr_ecc_key_t key,
+                                           const hmac_digest_t *inputs,
+                                           dice_cache_key_t *entry,
+                                           hmac_digest_t *pubkey_id,
+                                           ecdsa_p256_public_key_t *pubkey) {
+  HARDENED_RETURN_IF_ERROR(
+      otbn_boot_cert_ecc_p256_keygen(key, pubkey_id, pubkey));
+  entry->pubkey = *pubkey;
+  dice_cache_tag(tag_key, key, inputs, pubkey, &entry->tag);
+  return kErrorOk;
+}
+
+rom_error_t dice_cache_keygen(const hmac_key_t *tag_key,
+                              sc_keymgr_ecc_key_t key,
+                              const hmac_digest_t *inputs,
+                              dice_cache_key_t *entry, hmac_digest_t *pubkey_id,
+                              ecdsa_p256_public_key_t *pubkey,
+                              hardened_bool_t *hit) {
+  HARDENED_RETURN_IF_ERROR(sc_keymgr_state_check(key.required_keymgr_state));
+
+  hmac_digest_t tag;
+  dice_cache_tag(tag_key, key, inputs, &entry->pubkey, &tag);
+  *hit = hardened_memeq(tag.digest, entry->tag.digest, ARRAYSIZE(tag.digest));
+  if (launder32(*hit) == kHardenedBoolTrue) {
+    HARDENED_CHECK_EQ(*hit, kHardenedBoolTrue);
+    *pubkey = entry->pubkey;
+    // Same key ID as computed by `otbn_boot_cert_ecc_p256_keygen()`.
+    hmac_sha256(pubkey, sizeof(*pubkey), pubkey_id);
+    util_reverse_bytes(pubkey_id, sizeof(*pubkey_id));
+    return kErrorOk;
+  }
+
+  return dice_cache_entry_update(tag_key, key, inputs, entry, pubkey_id,
+                                 pubkey);
+}
+
+rom_error_t dice_cache_keygen_update(const hmac_key_t *tag_key,
+                                     sc_keymgr_ecc_key_t key,
+                                     const hmac_digest_t *inputs,
+                                     dice_cache_key_t *entry,
+                                     hmac_digest_t *pubkey_id,
+                                     ecdsa_p256_public_key_t *pubkey) {
+  HARDENED_RETURN_IF_ERROR(sc_keymgr_state_check(key.required_keymgr_state));
+  return dice_cache_entry_update(tag_key, key, inputs, entry, pubkey_id,
+                                 pubkey);
+}
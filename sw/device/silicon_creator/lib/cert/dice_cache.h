@@ -0,0 +1,178 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_CERT_DICE_CACHE_H_
+#define OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_CERT_DICE_CACHE_H_
+
+#include <stdint.h>
+
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/silicon_creator/lib/drivers/hmac.h"
+#include "sw/device/silicon_creator/lib/drivers/keymgr.h"
+#include "sw/device/silicon_creator/lib/drivers/lifecycle.h"
+#include "sw/device/silicon_creator/lib/drivers/retention_sram.h"
+#include "sw/device/silicon_creator/lib/error.h"
+#include "sw/device/silicon_creator/lib/keymgr_binding_value.h"
+#include "sw/device/silicon_creator/lib/sigverify/ecdsa_p256_key.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+  /**
+   * Number of OTP partition digests in the inputs of the UDS key.
+   */
+  kDiceCacheOtpDigestCount = 4,
+};
+
+/**
+ * Inputs of the UDS key that software can observe.
+ *
+ * The secret inputs only change during personalization, which also changes the
+ * key of the cache tags, see `dice_cache_tag_key_derive()`.
+ */
+typedef struct dice_cache_uds_inputs {
+  /**
+   * Device ID.
+   */
+  lifecycle_device_id_t device_id;
+  /**
+   * Raw lifecycle state.
+   */
+  uint32_t lc_state;
+  /**
+   * Digests of the SW_CFG and ROT_CREATOR_AUTH OTP partitions.
+   */
+  uint64_t otp_digests[kDiceCacheOtpDigestCount];
+  /**
+   * ROM_EXT measurement, which covers the binding value and maximum key
+   * version of its manifest.
+   */
+  keymgr_binding_value_t rom_ext_measurement;
+} dice_cache_uds_inputs_t;
+
+/**
+ * Inputs of the CDI_0 key on top of the inputs of the UDS key.
+ */
+typedef struct dice_cache_cdi_0_inputs {
+  /**
+   * Sealing binding value of the OwnerIntermediateKey stage.
+   */
+  keymgr_binding_value_t seal_binding;
+  /**
+   * Attestation binding value of the OwnerIntermediateKey stage.
+   */
+  keymgr_binding_value_t attest_binding;
+  /**
+   * Maximum key version of the OwnerIntermediateKey stage.
+   */
+  uint32_t max_key_version;
+  /**
+   * Owner history, which is renewed together with the owner seed.
+   */
+  hmac_digest_t owner_history;
+} dice_cache_cdi_0_inputs_t;
+
+/**
+ * Computes the digest of the inputs of the UDS key.
+ *
+ * @param inputs Inputs of the UDS key.
+ * @param[out] digest Digest of `inputs`.
+ */
+void dice_cache_uds_inputs_digest(const dice_cache_uds_inputs_t *inputs,
+                                  hmac_digest_t *digest);
+
+/**
+ * Computes the digest of the inputs of the CDI_0 key.
+ *
+ * @param uds_digest Digest of the inputs of the UDS key.
+ * @param inputs Inputs of the CDI_0 key.
+ * @param[out] digest Digest of `uds_digest` and `inputs`.
+ */
+void dice_cache_cdi_0_inputs_digest(const hmac_digest_t *uds_digest,
+                                    const dice_cache_cdi_0_inputs_t *inputs,
+                                    hmac_digest_t *digest);
+
+/**
+ * Derives the key of the cache tags.
+ *
+ * The key is a software output of keymgr in the CreatorRootKey state, so it
+ * depends on the creator secrets and on the ROM_EXT measurement. Keymgr has
+ * left that state before any owner code runs, so the owner stages cannot
+ * derive the key, and cannot forge a cache entry even though they can write
+ * to retention SRAM.
+ *
+ * The caller must keep the key out of reach of the owner stages, and wipe it
+ * once the DICE keys have been generated.
+ *
+ * Fails if keymgr is not in the CreatorRootKey state.
+ *
+ * @param[out] tag_key Key of the cache tags.
+ * @return errors encountered during the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t dice_cache_tag_key_derive(hmac_key_t *tag_key);
+
+/**
+ * Generates a DICE key, unless its public key is cached in retention SRAM.
+ *
+ * The cached public key is only used if its tag matches `inputs`, so that any
+ * change of the inputs invalidates it. Otherwise, the key is generated and the
+ * cache entry is updated. The private key is not needed here: it is derived
+ * again by `otbn_boot_attestation_key_save()` to endorse certificates.
+ *
+ * The tag is an HMAC over the inputs and the public key, keyed with
+ * `tag_key`.
+ *
+ * A cached public key must only be compared against an existing certificate.
+ * Certificates must only be built from a generated key: on a hit, call
+ * `dice_cache_keygen_update()` first.
+ *
+ * Fails if keymgr is not in the state required by `key`.
+ *
+ * @param tag_key Key of the cache tags, see `dice_cache_tag_key_derive()`.
+ * @param key The key to generate.
+ * @param inputs Digest of the inputs of the key.
+ * @param[in,out] entry Cache entry of the key.
+ * @param[out] pubkey_id The public key ID.
+ * @param[out] pubkey The public key.
+ * @param[out] hit Whether the public key was taken from `entry`.
+ * @return errors encountered during the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t dice_cache_keygen(const hmac_key_t *tag_key,
+                              sc_keymgr_ecc_key_t key,
+                              const hmac_digest_t *inputs,
+                              dice_cache_key_t *entry, hmac_digest_t *pubkey_id,
+                              ecdsa_p256_public_key_t *pubkey,
+                              hardened_bool_t *hit);
+
+/**
+ * Generates a DICE key and updates its cache entry.
+ *
+ * Fails if keymgr is not in the state required by `key`.
+ *
+ * @param tag_key Key of the cache tags, see `dice_cache_tag_key_derive()`.
+ * @param key The key to generate.
+ * @param inputs Digest of the inputs of the key.
+ * @param[out] entry Cache entry of the key.
+ * @param[out] pubkey_id The public key ID.
+ * @param[out] pubkey The public key.
+ * @return errors encountered during the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t dice_cache_keygen_update(const hmac_key_t *tag_key,
+                                     sc_keymgr_ecc_key_t key,
+                                     const hmac_digest_t *inputs,
+                                     dice_cache_key_t *entry,
+                                     hmac_digest_t *pubkey_id,
+                                     ecdsa_p256_public_key_t *pubkey);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_CERT_DICE_CACHE_H_
@@ -0,0 +1,550 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/silicon_creator/lib/cert/dice_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "hw/top/dt/keymgr.h"
+#include "sw/device/lib/base/global_mock.h"
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/base/mock_abs_mmio.h"
+#include "sw/device/silicon_creator/lib/base/mock_sec_mmio.h"
+#include "sw/device/silicon_creator/lib/drivers/mock_hmac.h"
+#include "sw/device/silicon_creator/lib/error.h"
+#include "sw/device/silicon_creator/lib/otbn_boot_services.h"
+#include "sw/device/silicon_creator/testing/rom_test.h"
+
+#include "hw/top/keymgr_regs.h"  // Generated.
+
+namespace dice_cache_unittest {
+namespace {
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::DoAll;
+using ::testing::ElementsAreArray;
+using ::testing::Field;
+using ::testing::InSequence;
+using ::testing::Not;
+using ::testing::Return;
+using ::testing::SetArgPointee;
+
+namespace internal {
+// Create a mock for the OTBN boot services used by the cache.
+class MockOtbnBootServices
+    : public ::global_mock::GlobalMock<MockOtbnBootServices> {
+ public:
+  MOCK_METHOD(rom_error_t, cert_ecc_p256_keygen,
+              (sc_keymgr_ecc_key_t, hmac_digest_t *,
+               ecdsa_p256_public_key_t *));
+};
+}  // namespace internal
+using MockOtbnBootServices =
+    testing::StrictMock<internal::MockOtbnBootServices>;
+extern "C" {
+rom_error_t otbn_boot_cert_ecc_p256_keygen(sc_keymgr_ecc_key_t key,
+                                           hmac_digest_t *pubkey_id,
+                                           ecdsa_p256_public_key_t *pubkey) {
+  return MockOtbnBootServices::Instance().cert_ecc_p256_keygen(key, pubkey_id,
+                                                               pubkey);
+}
+}  // extern "C"
+
+constexpr sc_keymgr_diversification_t kUdsDiversifier = {
+    .salt = {0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17},
+    .version = 0,
+};
+constexpr sc_keymgr_diversification_t kCdi0Diversifier = {
+    .salt = {0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27},
+    .version = 0,
+};
+
+const sc_keymgr_ecc_key_t kUdsKey = {
+    .type = kScKeymgrKeyTypeAttestation,
+    .keygen_seed_idx = 1,
+    .keymgr_diversifier = &kUdsDiversifier,
+    .required_keymgr_state = kScKeymgrStateCreatorRootKey,
+};
+const sc_keymgr_ecc_key_t kCdi0Key = {
+    .type = kScKeymgrKeyTypeAttestation,
+    .keygen_seed_idx = 2,
+    .keymgr_diversifier = &kCdi0Diversifier,
+    .required_keymgr_state = kScKeymgrStateOwnerIntermediateKey,
+};
+
+constexpr dice_cache_uds_inputs_t kUdsInputs = {
+    .device_id = {{0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7}},
+    .lc_state = 0x5a5a5a5a,
+    .otp_digests = {0xb0, 0xb1, 0xb2, 0xb3},
+    .rom_ext_measurement = {{0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7}},
+};
+constexpr dice_cache_cdi_0_inputs_t kCdi0Inputs = {
+    .seal_binding = {{0xd0, 0xd1, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7}},
+    .attest_binding = {{0xe0, 0xe1, 0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7}},
+    .max_key_version = 3,
+    .owner_history = {{0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7}},
+};
+
+constexpr ecdsa_p256_public_key_t kPubkey = {
+    .x = {0x100, 0x101, 0x102, 0x103, 0x104, 0x105, 0x106, 0x107},
+    .y = {0x108, 0x109, 0x10a, 0x10b, 0x10c, 0x10d, 0x10e, 0x10f},
+};
+constexpr ecdsa_p256_public_key_t kOtherPubkey = {
+    .x = {0x200, 0x201, 0x202, 0x203, 0x204, 0x205, 0x206, 0x207},
+    .y = {0x208, 0x209, 0x20a, 0x20b, 0x20c, 0x20d, 0x20e, 0x20f},
+};
+constexpr hmac_digest_t kPubkeyId = {
+    {0x300, 0x301, 0x302, 0x303, 0x304, 0x305, 0x306, 0x307}};
+
+/**
+ * Deterministic stand-in for SHA-256 in the HMAC mock.
+ *
+ * Any change of `data` changes the digest, which is all the cache relies on.
+ */
+hmac_digest_t FakeDigest(const std::vector<uint8_t> &data) {
+  hmac_digest_t digest;
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < ARRAYSIZE(digest.digest); ++i) {
+    for (uint8_t byte : data) {
+      hash = (hash ^ byte) * 16777619u;
+    }
+    hash = (hash ^ i) * 16777619u;
+    digest.digest[i] = hash;
+  }
+  return digest;
+}
+
+std::vector<uint8_t> Bytes(const void *data, size_t len) {
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  return std::vector<uint8_t>(bytes, bytes + len);
+}
+
+class DiceCacheTest : public rom_test::Unordered<rom_test::RomTest> {
+ protected:
+  void SetUp() override {
+    EXPECT_CALL(hmac_, sha256_configure(_))
+        .Times(AnyNumber())
+        .WillRepeatedly([this](bool) { hmac_data_.clear(); });
+    EXPECT_CALL(hmac_, sha256_start())
+        .Times(AnyNumber())
+        .WillRepeatedly([this]() { hmac_data_.clear(); });
+    EXPECT_CALL(hmac_, sha256_init())
+        .Times(AnyNumber())
+        .WillRepeatedly([this]() { hmac_data_.clear(); });
+    EXPECT_CALL(hmac_, sha256_update(_, _))
+        .Times(AnyNumber())
+        .WillRepeatedly([this](const void *data, size_t len) {
+          std::vector<uint8_t> bytes = Bytes(data, len);
+          hmac_data_.insert(hmac_data_.end(), bytes.begin(), bytes.end());
+        });
+    EXPECT_CALL(hmac_, sha256_process()).Times(AnyNumber());
+    EXPECT_CALL(hmac_, sha256_final_truncated(_, _))
+        .Times(AnyNumber())
+        .WillRepeatedly([this](uint32_t *digest, size_t len) {
+          hmac_digest_t result = FakeDigest(hmac_data_);
+          std::memcpy(digest, result.digest, len * sizeof(uint32_t));
+        });
+    EXPECT_CALL(hmac_, sha256_final(_))
+        .Times(AnyNumber())
+        .WillRepeatedly([this](hmac_digest_t *digest) {
+          *digest = FakeDigest(hmac_data_);
+        });
+    EXPECT_CALL(hmac_, sha256(_, _, _))
+        .Times(AnyNumber())
+        .WillRepeatedly(
+            [](const void *data, size_t len, hmac_digest_t *digest) {
+              *digest = FakeDigest(Bytes(data, len));
+            });
+    EXPECT_CALL(hmac_, hmac_sha256(_, _, _, _, _))
+        .Times(AnyNumber())
+        .WillRepeatedly([](const void *data, size_t len, hmac_key_t key,
+                           bool big_endian_digest, hmac_digest_t *digest) {
+          std::vector<uint8_t> bytes = Bytes(&key, sizeof(key));
+          std::vector<uint8_t> msg = Bytes(data, len);
+          bytes.insert(bytes.end(), msg.begin(), msg.end());
+          bytes.push_back(big_endian_digest);
+          *digest = FakeDigest(bytes);
+        });
+  }
+
+  void ExpectKeymgrState(uint32_t km_state) {
+    EXPECT_ABS_READ32(base_ + KEYMGR_OP_STATUS_REG_OFFSET,
+                      KEYMGR_OP_STATUS_STATUS_VALUE_IDLE);
+    EXPECT_ABS_WRITE32(base_ + KEYMGR_OP_STATUS_REG_OFFSET,
+                       KEYMGR_OP_STATUS_STATUS_VALUE_IDLE);
+    EXPECT_ABS_READ32(base_ + KEYMGR_ERR_CODE_REG_OFFSET, 0);
+    EXPECT_ABS_WRITE32(base_ + KEYMGR_ERR_CODE_REG_OFFSET, 0);
+    EXPECT_SEC_READ32(base_ + KEYMGR_WORKING_STATE_REG_OFFSET, km_state);
+  }
+
+  void ExpectKeygen(const sc_keymgr_ecc_key_t &key,
+                    const ecdsa_p256_public_key_t &pubkey) {
+    EXPECT_CALL(otbn_, cert_ecc_p256_keygen(
+                           Field(&sc_keymgr_ecc_key_t::keygen_seed_idx,
+                                 key.keygen_seed_idx),
+                           _, _))
+        .WillOnce(DoAll(SetArgPointee<1>(kPubkeyId), SetArgPointee<2>(pubkey),
+                        Return(kErrorOk)));
+  }
+
+  /**
+   * Runs `dice_cache_keygen()` with keymgr in the state required by `key`.
+   *
+   * Key generation is only expected if the test set it up with
+   * `ExpectKeygen()`: the OTBN mock is strict.
+   *
+   * @return Whether the public key was taken from the cache.
+   */
+  hardened_bool_t Keygen(const sc_keymgr_ecc_key_t &key,
+                         const hmac_digest_t &inputs) {
+    ExpectKeymgrState(key.required_keymgr_state);
+    hardened_bool_t hit = kHardenedBoolFalse;
+    EXPECT_EQ(dice_cache_keygen(&tag_key_, key, &inputs, &entry_, &pubkey_id_,
+                                &pubkey_, &hit),
+              kErrorOk);
+    return hit;
+  }
+
+  /**
+   * Fills the cache entry as a first boot would.
+   */
+  void Prime(const sc_keymgr_ecc_key_t &key, const hmac_digest_t &inputs) {
+    ExpectKeygen(key, kPubkey);
+    EXPECT_EQ(Keygen(key, inputs), kHardenedBoolFalse);
+    pubkey_ = {};
+    pubkey_id_ = {};
+  }
+
+  hmac_digest_t UdsDigest(const dice_cache_uds_inputs_t &inputs) {
+    hmac_digest_t digest;
+    dice_cache_uds_inputs_digest(&inputs, &digest);
+    return digest;
+  }
+
+  hmac_digest_t Cdi0Digest(const dice_cache_uds_inputs_t &uds_inputs,
+                           const dice_cache_cdi_0_inputs_t &inputs) {
+    hmac_digest_t uds_digest = UdsDigest(uds_inputs);
+    hmac_digest_t digest;
+    dice_cache_cdi_0_inputs_digest(&uds_digest, &inputs, &digest);
+    return digest;
+  }
+
+  uint32_t base_ = dt_keymgr_reg_block(kDtKeymgr, kDtKeymgrRegBlockCore);
+  rom_test::MockAbsMmio mmio_;
+  rom_test::MockSecMmio sec_mmio_;
+  rom_test::MockHmac hmac_;
+  MockOtbnBootServices otbn_;
+  std::vector<uint8_t> hmac_data_;
+
+  hmac_key_t tag_key_ = {
+      .key = {0x400, 0x401, 0x402, 0x403, 0x404, 0x405, 0x406, 0x407}};
+
+  dice_cache_key_t entry_{};
+  hmac_digest_t pubkey_id_{};
+  ecdsa_p256_public_key_t pubkey_{};
+};
+
+TEST_F(DiceCacheTest, EmptyEntryGeneratesKey) {
+  ExpectKeygen(kUdsKey, kPubkey);
+  EXPECT_EQ(Keygen(kUdsKey, UdsDigest(kUdsInputs)), kHardenedBoolFalse);
+
+  EXPECT_THAT(pubkey_.x, ElementsAreArray(kPubkey.x));
+  EXPECT_THAT(pubkey_.y, ElementsAreArray(kPubkey.y));
+  EXPECT_THAT(pubkey_id_.digest, ElementsAreArray(kPubkeyId.digest));
+  EXPECT_THAT(entry_.pubkey.x, ElementsAreArray(kPubkey.x));
+  EXPECT_THAT(entry_.pubkey.y, ElementsAreArray(kPubkey.y));
+  EXPECT_THAT(entry_.tag.digest,
+              Not(ElementsAreArray(hmac_digest_t{}.digest)));
+}
+
+TEST_F(DiceCacheTest, HitSkipsKeygen) {
+  const hmac_digest_t inputs = UdsDigest(kUdsInputs);
+  Prime(kUdsKey, inputs);
+  const dice_cache_key_t primed = entry_;
+
+  EXPECT_EQ(Keygen(kUdsKey, inputs), kHardenedBoolTrue);
+
+  EXPECT_THAT(pubkey_.x, ElementsAreArray(kPubkey.x));
+  EXPECT_THAT(pubkey_.y, ElementsAreArray(kPubkey.y));
+  // The key ID is the byte-reversed digest of the public key.
+  hmac_digest_t pubkey_id = FakeDigest(Bytes(&kPubkey, sizeof(kPubkey)));
+  uint8_t *pubkey_id_bytes = reinterpret_cast<uint8_t *>(&pubkey_id);
+  std::reverse(pubkey_id_bytes, pubkey_id_bytes + sizeof(pubkey_id));
+  EXPECT_THAT(pubkey_id_.digest, ElementsAreArray(pubkey_id.digest));
+  // The entry is left as is.
+  EXPECT_THAT(entry_.tag.digest, ElementsAreArray(primed.tag.digest));
+  EXPECT_THAT(entry_.pubkey.x, ElementsAreArray(primed.pubkey.x));
+  EXPECT_THAT(entry_.pubkey.y, ElementsAreArray(primed.pubkey.y));
+}
+
+TEST_F(DiceCacheTest, TagMismatchRewritesEntry) {
+  const hmac_digest_t inputs = UdsDigest(kUdsInputs);
+  Prime(kUdsKey, inputs);
+  entry_.tag.digest[0] ^= 1;
+
+  ExpectKeygen(kUdsKey, kOtherPubkey);
+  EXPECT_EQ(Keygen(kUdsKey, inputs), kHardenedBoolFalse);
+  EXPECT_THAT(pubkey_.x, ElementsAreArray(kOtherPubkey.x));
+  EXPECT_THAT(entry_.pubkey.x, ElementsAreArray(kOtherPubkey.x));
+  EXPECT_THAT(entry_.pubkey.y, ElementsAreArray(kOtherPubkey.y));
+
+  // The rewritten entry is valid.
+  EXPECT_EQ(Keygen(kUdsKey, inputs), kHardenedBoolTrue);
+  EXPECT_THAT(pubkey_.x, ElementsAreArray(kOtherPubkey.x));
+}
+
+TEST_F(DiceCacheTest, PubkeyMismatchRewritesEntry) {
+  const hmac_digest_t inputs = UdsDigest(kUdsInputs);
+  Prime(kUdsKey, inputs);
+  entry_.pubkey.y[7] ^= 1;
+
+  ExpectKeygen(kUdsKey, kPubkey);
+  EXPECT_EQ(Keygen(kUdsKey, inputs), kHardenedBoolFalse);
+  EXPECT_THAT(entry_.pubkey.y, ElementsAreArray(kPubkey.y));
+
+  EXPECT_EQ(Keygen(kUdsKey, inputs), kHardenedBoolTrue);
+}
+
+TEST_F(DiceCacheTest, EntryOfOtherKeyMisses) {
+  const hmac_digest_t inputs = UdsDigest(kUdsInputs);
+  Prime(kUdsKey, inputs);
+
+  ExpectKeygen(kCdi0Key, kOtherPubkey);
+  EXPECT_EQ(Keygen(kCdi0Key, inputs), kHardenedBoolFalse);
+}
+
+TEST_F(DiceCacheTest, BadKeymgrState) {
+  ExpectKeymgrState(kScKeymgrStateInit);
+  hardened_bool_t hit;
+  EXPECT_EQ(dice_cache_keygen(&tag_key_, kUdsKey, &kPubkeyId, &entry_,
+                              &pubkey_id_, &pubkey_, &hit),
+            kErrorKeymgrInternal);
+}
+
+TEST_F(DiceCacheTest, OtherTagKeyMisses) {
+  const hmac_digest_t inputs = UdsDigest(kUdsInputs);
+  Prime(kUdsKey, inputs);
+
+  // An entry written without the tag key, e.g. by an owner stage, misses.
+  tag_key_.key[0] ^= 1;
+  ExpectKeygen(kUdsKey, kOtherPubkey);
+  EXPECT_EQ(Keygen(kUdsKey, inputs), kHardenedBoolFalse);
+  EXPECT_THAT(entry_.pubkey.x, ElementsAreArray(kOtherPubkey.x));
+}
+
+TEST_F(DiceCacheTest, UpdateRegeneratesCachedKey) {
+  const hmac_digest_t inputs = UdsDigest(kUdsInputs);
+  Prime(kUdsKey, inputs);
+
+  // The entry is valid, but the key is generated again.
+  ExpectKeymgrState(kUdsKey.required_keymgr_state);
+  ExpectKeygen(kUdsKey, kOtherPubkey);
+  EXPECT_EQ(dice_cache_keygen_update(&tag_key_, kUdsKey, &inputs, &entry_,
+                                     &pubkey_id_, &pubkey_),
+            kErrorOk);
+  EXPECT_THAT(pubkey_.x, ElementsAreArray(kOtherPubkey.x));
+  EXPECT_THAT(pubkey_id_.digest, ElementsAreArray(kPubkeyId.digest));
+  EXPECT_THAT(entry_.pubkey.x, ElementsAreArray(kOtherPubkey.x));
+  EXPECT_THAT(entry_.pubkey.y, ElementsAreArray(kOtherPubkey.y));
+
+  // The rewritten entry is valid.
+  EXPECT_EQ(Keygen(kUdsKey, inputs), kHardenedBoolTrue);
+  EXPECT_THAT(pubkey_.x, ElementsAreArray(kOtherPubkey.x));
+}
+
+TEST_F(DiceCacheTest, UpdateBadKeymgrState) {
+  ExpectKeymgrState(kScKeymgrStateInit);
+  EXPECT_EQ(dice_cache_keygen_update(&tag_key_, kUdsKey, &kPubkeyId, &entry_,
+                                     &pubkey_id_, &pubkey_),
+            kErrorKeymgrInternal);
+}
+
+TEST_F(DiceCacheTest, TagKeyDerive) {
+  constexpr uint32_t kShare0 = 0x5a5a5a5a;
+  InSequence seq;
+  ExpectKeymgrState(kScKeymgrStateCreatorRootKey);
+  EXPECT_ABS_READ32(base_ + KEYMGR_OP_STATUS_REG_OFFSET,
+                    KEYMGR_OP_STATUS_STATUS_VALUE_IDLE);
+  EXPECT_ABS_WRITE32_SHADOWED(
+      base_ + KEYMGR_CONTROL_SHADOWED_REG_OFFSET,
+      {
+          {KEYMGR_CONTROL_SHADOWED_DEST_SEL_OFFSET,
+           KEYMGR_CONTROL_SHADOWED_DEST_SEL_VALUE_NONE},
+          {KEYMGR_CONTROL_SHADOWED_CDI_SEL_BIT, true},
+          {KEYMGR_CONTROL_SHADOWED_OPERATION_OFFSET,
+           KEYMGR_CONTROL_SHADOWED_OPERATION_VALUE_GENERATE_SW_OUTPUT},
+      });
+  EXPECT_ABS_WRITE32(base_ + KEYMGR_KEY_VERSION_REG_OFFSET, 0);
+  for (size_t i = 0; i < ARRAYSIZE(sc_keymgr_diversification_t{}.salt); ++i) {
+    EXPECT_CALL(mmio_, Write32(base_ + KEYMGR_SALT_0_REG_OFFSET +
+                                   i * sizeof(uint32_t),
+                               _));
+  }
+  EXPECT_ABS_WRITE32(base_ + KEYMGR_START_REG_OFFSET,
+                     {
+                         {KEYMGR_START_EN_BIT, true},
+                     });
+  EXPECT_ABS_READ32(base_ + KEYMGR_OP_STATUS_REG_OFFSET,
+                    KEYMGR_OP_STATUS_STATUS_VALUE_DONE_SUCCESS);
+  EXPECT_ABS_WRITE32(base_ + KEYMGR_OP_STATUS_REG_OFFSET,
+                     KEYMGR_OP_STATUS_STATUS_VALUE_DONE_SUCCESS);
+  for (size_t i = 0; i < ARRAYSIZE(tag_key_.key); ++i) {
+    EXPECT_ABS_READ32(
+        base_ + KEYMGR_SW_SHARE0_OUTPUT_0_REG_OFFSET + i * sizeof(uint32_t),
+        kShare0);
+    EXPECT_ABS_READ32(
+        base_ + KEYMGR_SW_SHARE1_OUTPUT_0_REG_OFFSET + i * sizeof(uint32_t),
+        kShare0 ^ i);
+  }
+
+  hmac_key_t tag_key{};
+  EXPECT_EQ(dice_cache_tag_key_derive(&tag_key), kErrorOk);
+  for (size_t i = 0; i < ARRAYSIZE(tag_key.key); ++i) {
+    EXPECT_EQ(tag_key.key[i], i);
+  }
+}
+
+TEST_F(DiceCacheTest, TagKeyDeriveBadKeymgrState) {
+  // Owner stages run after keymgr left the CreatorRootKey state.
+  ExpectKeymgrState(kScKeymgrStateOwnerIntermediateKey);
+  hmac_key_t tag_key{};
+  EXPECT_EQ(dice_cache_tag_key_derive(&tag_key), kErrorKeymgrInternal);
+}
+
+TEST_F(DiceCacheTest, KeygenErrorKeepsEntry) {
+  const hmac_digest_t inputs = UdsDigest(kUdsInputs);
+  Prime(kUdsKey, inputs);
+  const dice_cache_key_t primed = entry_;
+  entry_.tag.digest[0] ^= 1;
+
+  ExpectKeymgrState(kUdsKey.required_keymgr_state);
+  EXPECT_CALL(otbn_, cert_ecc_p256_keygen(_, _, _))
+      .WillOnce(Return(kErrorOtbnExecutionFailed));
+  hardened_bool_t hit;
+  EXPECT_EQ(dice_cache_keygen(&tag_key_, kUdsKey, &inputs, &entry_,
+                              &pubkey_id_, &pubkey_, &hit),
+            kErrorOtbnExecutionFailed);
+  EXPECT_THAT(entry_.pubkey.x, ElementsAreArray(primed.pubkey.x));
+  EXPECT_THAT(entry_.pubkey.y, ElementsAreArray(primed.pubkey.y));
+}
+
+struct InputsChangeTestCase {
+  /**
+   * Name of the changed input.
+   */
+  const char *name;
+  /**
+   * Changes one of the inputs.
+   */
+  void (*change)(dice_cache_uds_inputs_t *uds_inputs,
+                 dice_cache_cdi_0_inputs_t *cdi_0_inputs);
+};
+
+constexpr InputsChangeTestCase kUdsInputsChangeTestCases[] = {
+    {"DeviceId",
+     [](dice_cache_uds_inputs_t *uds, dice_cache_cdi_0_inputs_t *) {
+       uds->device_id.device_id[7] ^= 1;
+     }},
+    {"LcState",
+     [](dice_cache_uds_inputs_t *uds, dice_cache_cdi_0_inputs_t *) {
+       uds->lc_state ^= 1;
+     }},
+    {"CreatorSwCfgDigest",
+     [](dice_cache_uds_inputs_t *uds, dice_cache_cdi_0_inputs_t *) {
+       uds->otp_digests[0] ^= 1;
+     }},
+    {"OwnerSwCfgDigest",
+     [](dice_cache_uds_inputs_t *uds, dice_cache_cdi_0_inputs_t *) {
+       uds->otp_digests[1] ^= 1;
+     }},
+    {"RotCreatorAuthCodesignDigest",
+     [](dice_cache_uds_inputs_t *uds, dice_cache_cdi_0_inputs_t *) {
+       uds->otp_digests[2] ^= 1;
+     }},
+    {"RotCreatorAuthStateDigest",
+     [](dice_cache_uds_inputs_t *uds, dice_cache_cdi_0_inputs_t *) {
+       uds->otp_digests[3] ^= 1;
+     }},
+    {"RomExtMeasurement",
+     [](dice_cache_uds_inputs_t *uds, dice_cache_cdi_0_inputs_t *) {
+       uds->rom_ext_measurement.data[0] ^= 1;
+     }},
+};
+
+constexpr InputsChangeTestCase kCdi0InputsChangeTestCases[] = {
+    {"SealBinding",
+     [](dice_cache_uds_inputs_t *, dice_cache_cdi_0_inputs_t *cdi_0) {
+       cdi_0->seal_binding.data[0] ^= 1;
+     }},
+    {"AttestBinding",
+     [](dice_cache_uds_inputs_t *, dice_cache_cdi_0_inputs_t *cdi_0) {
+       cdi_0->attest_binding.data[0] ^= 1;
+     }},
+    {"MaxKeyVersion",
+     [](dice_cache_uds_inputs_t *, dice_cache_cdi_0_inputs_t *cdi_0) {
+       cdi_0->max_key_version ^= 1;
+     }},
+    {"OwnerHistory",
+     [](dice_cache_uds_inputs_t *, dice_cache_cdi_0_inputs_t *cdi_0) {
+       cdi_0->owner_history.digest[7] ^= 1;
+     }},
+};
+
+std::string InputsChangeTestName(
+    const testing::TestParamInfo<InputsChangeTestCase> &info) {
+  return info.param.name;
+}
+
+class UdsInputsChangeTest
+    : public DiceCacheTest,
+      public testing::WithParamInterface<InputsChangeTestCase> {};
+
+TEST_P(UdsInputsChangeTest, InvalidatesEntry) {
+  Prime(kUdsKey, UdsDigest(kUdsInputs));
+
+  dice_cache_uds_inputs_t uds_inputs = kUdsInputs;
+  dice_cache_cdi_0_inputs_t cdi_0_inputs = kCdi0Inputs;
+  GetParam().change(&uds_inputs, &cdi_0_inputs);
+
+  ExpectKeygen(kUdsKey, kOtherPubkey);
+  EXPECT_EQ(Keygen(kUdsKey, UdsDigest(uds_inputs)), kHardenedBoolFalse);
+  EXPECT_THAT(entry_.pubkey.x, ElementsAreArray(kOtherPubkey.x));
+}
+
+INSTANTIATE_TEST_SUITE_P(AllInputs, UdsInputsChangeTest,
+                         testing::ValuesIn(kUdsInputsChangeTestCases),
+                         InputsChangeTestName);
+
+class Cdi0InputsChangeTest
+    : public DiceCacheTest,
+      public testing::WithParamInterface<InputsChangeTestCase> {};
+
+TEST_P(Cdi0InputsChangeTest, InvalidatesEntry) {
+  Prime(kCdi0Key, Cdi0Digest(kUdsInputs, kCdi0Inputs));
+
+  dice_cache_uds_inputs_t uds_inputs = kUdsInputs;
+  dice_cache_cdi_0_inputs_t cdi_0_inputs = kCdi0Inputs;
+  GetParam().change(&uds_inputs, &cdi_0_inputs);
+
+  ExpectKeygen(kCdi0Key, kOtherPubkey);
+  EXPECT_EQ(Keygen(kCdi0Key, Cdi0Digest(uds_inputs, cdi_0_inputs)),
+            kHardenedBoolFalse);
+  EXPECT_THAT(entry_.pubkey.x, ElementsAreArray(kOtherPubkey.x));
+}
+
+// The CDI_0 key also depends on all the inputs of the UDS key.
+INSTANTIATE_TEST_SUITE_P(UdsInputs, Cdi0InputsChangeTest,
+                         testing::ValuesIn(kUdsInputsChangeTestCases),
+                         InputsChangeTestName);
+INSTANTIATE_TEST_SUITE_P(Cdi0Inputs, Cdi0InputsChangeTest,
+                         testing::ValuesIn(kCdi0InputsChangeTestCases),
+                         InputsChangeTestName);
+
+}  // namespace
+}  // namespace dice_cache_unittest
@@ -13,16 +13,23 @@
 #include "sw/device/silicon_creator/lib/base/static_dice_cdi_0.h"
 #include "sw/device/silicon_creator/lib/base/util.h"
 #include "sw/device/silicon_creator/lib/cert/dice.h"
+#include "sw/device/silicon_creator/lib/cert/dice_cache.h"
 #include "sw/device/silicon_creator/lib/dbg_print.h"
 #include "sw/device/silicon_creator/lib/drivers/flash_ctrl.h"
+#include "sw/device/silicon_creator/lib/drivers/ibex.h"
 #include "sw/device/silicon_creator/lib/drivers/kmac.h"
+#include "sw/device/silicon_creator/lib/drivers/lifecycle.h"
+#include "sw/device/silicon_creator/lib/drivers/otp.h"
+#include "sw/device/silicon_creator/lib/drivers/retention_sram.h"
 #include "sw/device/silicon_creator/lib/error.h"
 #include "sw/device/silicon_creator/lib/manifest.h"
 #include "sw/device/silicon_creator/lib/otbn_boot_services.h"
 #include "sw/device/silicon_creator/lib/ownership/datatypes.h"
+#include "sw/device/silicon_creator/lib/ownership/ownership_key.h"
 #include "sw/device/silicon_creator/manuf/base/perso_tlv_data.h"
 
 #include "hw/top/flash_ctrl_regs.h"  // Generated.
+#include "hw/top/otp_ctrl_regs.h"    // Generated.
 
 enum {
   /**
@@ -95,6 +102,18 @@ typedef struct dice_chain {
    */
   hardened_bool_t cert_valid;
 
+  /**
+   * Digest of the inputs of the UDS key, see `dice_chain_keygen_cached()`.
+   */
+  hmac_digest_t uds_inputs;
+
+  /**
+   * Key of the tags of the DICE cache, see `dice_cache_tag_key_derive()`.
+   *
+   * Derived with the UDS key and wiped once the CDI_0 key is generated.
+   */
+  hmac_key_t cache_tag_key;
+
 } dice_chain_t;
 
 static dice_chain_t dice_chain;
@@ -268,6 +287,35 @@ static rom_error_t dice_chain_push_cert(const char *name, const uint8_t *cert,
   return kErrorOk;
 }
 
+/**
+ * Generates a DICE key, unless its public key is cached in retention SRAM.
+ *
+ * See `dice_cache_keygen()`.
+ *
+ * @param key The key to generate.
+ * @param name Name of the key, for printing.
+ * @param inputs Digest of the inputs of the key.
+ * @param[in,out] entry Cache entry of the key.
+ * @param[out] pubkey_id The public key ID.
+ * @param[out] pubkey The public key.
+ * @param[out] hit Whether the public key was taken from `entry`.
+ * @return errors encountered during the operation.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t dice_chain_keygen_cached(
+    sc_keymgr_ecc_key_t key, const char *name, const hmac_digest_t *inputs,
+    dice_cache_key_t *entry, hmac_digest_t *pubkey_id,
+    ecdsa_p256_public_key_t *pubkey, hardened_bool_t *hit) {
+  uint32_t start = ibex_mcycle32();
+  HARDENED_RETURN_IF_ERROR(dice_cache_keygen(&dice_chain.cache_tag_key, key,
+                                             inputs, entry, pubkey_id, pubkey,
+                                             hit));
+  dbg_printf("dice: %s key %s in %u cycles\r\n", name,
+             *hit == kHardenedBoolTrue ? "cached" : "generated",
+             ibex_mcycle32() - start);
+  return kErrorOk;
+}
+
 rom_error_t dice_chain_attestation_silicon(void) {
   // Initialize the entropy complex and KMAC for key manager operations.
   // Note: `OTCRYPTO_OK.value` is equal to `kErrorOk` but we cannot add a static
@@ -288,12 +336,33 @@ rom_error_t dice_chain_attestation_silicon(void) {
   sc_keymgr_advance_state();
   RETURN_IF_ERROR(sc_keymgr_state_check(kScKeymgrStateInit));
 
+  dice_cache_uds_inputs_t uds_inputs = {
+      .lc_state = lifecycle_raw_state_get(),
+      .otp_digests =
+          {
+              otp_read64(OTP_CTRL_PARAM_CREATOR_SW_CFG_DIGEST_OFFSET),
+              otp_read64(OTP_CTRL_PARAM_OWNER_SW_CFG_DIGEST_OFFSET),
+              otp_read64(
+                  OTP_CTRL_PARAM_ROT_CREATOR_AUTH_CODESIGN_DIGEST_OFFSET),
+              otp_read64(OTP_CTRL_PARAM_ROT_CREATOR_AUTH_STATE_DIGEST_OFFSET),
+          },
+      .rom_ext_measurement = boot_measurements.rom_ext,
+  };
+  lifecycle_device_id_get(&uds_inputs.device_id);
+  dice_cache_uds_inputs_digest(&uds_inputs, &dice_chain.uds_inputs);
+
   // Generate UDS keys.
   sc_keymgr_advance_state();
   HARDENED_RETURN_IF_ERROR(sc_keymgr_state_check(kScKeymgrStateCreatorRootKey));
-  HARDENED_RETURN_IF_ERROR(otbn_boot_cert_ecc_p256_keygen(
-      kDiceKeyUds, &static_dice_cdi_0.uds_pubkey_id,
-      &static_dice_cdi_0.uds_pubkey));
+  HARDENED_RETURN_IF_ERROR(
+      dice_cache_tag_key_derive(&dice_chain.cache_tag_key));
+  // The cached UDS public key is only used for its key ID, and is checked
+  // against the factory UDS certificate.
+  hardened_bool_t hit;
+  HARDENED_RETURN_IF_ERROR(dice_chain_keygen_cached(
+      kDiceKeyUds, "UDS", &dice_chain.uds_inputs,
+      &retention_sram_get()->creator.dice_cache.uds,
+      &static_dice_cdi_0.uds_pubkey_id, &static_dice_cdi_0.uds_pubkey, &hit));
 
   // Save UDS key for signing next stage cert.
   RETURN_IF_ERROR(otbn_boot_attestation_key_save(
@@ -303,10 +372,16 @@ rom_error_t dice_chain_attestation_silicon(void) {
   return kErrorOk;
 }
 
-rom_error_t dice_chain_attestation_creator(
+/**
+ * Generates the CDI_0 attestation keys and (potentially) updates the CDI_0
+ * certificate.
+ *
+ * See `dice_chain_attestation_creator()`.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t dice_chain_attestation_cdi_0(
     keymgr_binding_value_t *rom_ext_measurement,
     const manifest_t *rom_ext_manifest) {
-  // Generate CDI_0 attestation keys and (potentially) update certificate.
   keymgr_binding_value_t seal_binding_value = {
       .data = {rom_ext_manifest->identifier, 0}};
   SEC_MMIO_WRITE_INCREMENT(kScKeymgrSecMmioSwBindingSet +
@@ -315,9 +390,23 @@ rom_error_t dice_chain_attestation_creator(
       /*sealing_binding=*/&seal_binding_value,
       /*attest_binding=*/rom_ext_measurement,
       rom_ext_manifest->max_key_version));
-  HARDENED_RETURN_IF_ERROR(otbn_boot_cert_ecc_p256_keygen(
-      kDiceKeyCdi0, &static_dice_cdi_0.cdi_0_pubkey_id,
-      &static_dice_cdi_0.cdi_0_pubkey));
+
+  // If the owner history cannot be read, it defaults to all ones.
+  dice_cache_cdi_0_inputs_t cdi_0_inputs = {
+      .seal_binding = seal_binding_value,
+      .attest_binding = *rom_ext_measurement,
+      .max_key_version = rom_ext_manifest->max_key_version,
+  };
+  OT_DISCARD(ownership_history_get(&cdi_0_inputs.owner_history));
+  hmac_digest_t cdi_0_digest;
+  dice_cache_cdi_0_inputs_digest(&dice_chain.uds_inputs, &cdi_0_inputs,
+                                 &cdi_0_digest);
+  hardened_bool_t hit;
+  HARDENED_RETURN_IF_ERROR(dice_chain_keygen_cached(
+      kDiceKeyCdi0, "CDI_0", &cdi_0_digest,
+      &retention_sram_get()->creator.dice_cache.cdi_0,
+      &static_dice_cdi_0.cdi_0_pubkey_id, &static_dice_cdi_0.cdi_0_pubkey,
+      &hit));
 
   // Switch page for the device generated CDI_0.
   RETURN_IF_ERROR(dice_chain_load_flash(&kFlashCtrlInfoPageDiceCerts));
@@ -328,6 +417,15 @@ rom_error_t dice_chain_attestation_creator(
   // Check if the current CDI_0 cert is valid.
   RETURN_IF_ERROR(dice_chain_load_cert_obj("CDI_0", /*name_size=*/6));
   if (dice_chain.cert_valid == kHardenedBoolFalse) {
+    if (hit != kHardenedBoolFalse) {
+      // Never put a cached public key in a new certificate: generate the key
+      // again.
+      HARDENED_RETURN_IF_ERROR(dice_cache_keygen_update(
+          &dice_chain.cache_tag_key, kDiceKeyCdi0, &cdi_0_digest,
+          &retention_sram_get()->creator.dice_cache.cdi_0,
+          &static_dice_cdi_0.cdi_0_pubkey_id,
+          &static_dice_cdi_0.cdi_0_pubkey));
+    }
     // Update the cert page buffer.
     static_dice_cdi_0.cert_size = sizeof(static_dice_cdi_0.cert_data);
     HARDENED_RETURN_IF_ERROR(dice_cdi_0_cert_build(
@@ -347,6 +445,17 @@ rom_error_t dice_chain_attestation_creator(
   return kErrorOk;
 }
 
+rom_error_t dice_chain_attestation_creator(
+    keymgr_binding_value_t *rom_ext_measurement,
+    const manifest_t *rom_ext_manifest) {
+  rom_error_t error =
+      dice_chain_attestation_cdi_0(rom_ext_measurement, rom_ext_manifest);
+  // The cache tag key is not needed anymore, and must not be left in RAM for
+  // the next boot stages.
+  memset(&dice_chain.cache_tag_key, 0, sizeof(dice_chain.cache_tag_key));
+  return error;
+}
+
 // Compare the UDS identity in the static critical section to the UDS cert
 // cached in the flash.
 static rom_error_t dice_chain_attestation_check_uds(void) {
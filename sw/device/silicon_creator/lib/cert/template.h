@@ -36,6 +36,10 @@ extern "C" {
  * `out_begin` pointer will not change.
  * `out_end` pointer starts from `out_begin` to the actual output size.
  * The actual size is between [kCdi0MinTbsSizeBytes, kCdi0MaxTbsSizeBytes].
+ *
+ * When the minimum and maximum sizes are equal, the const bytes are a skeleton
+ * of the whole output that is copied at once, and `out_end` then jumps back to
+ * each variable field to write it in place.
  */
 typedef struct template_state {
   // Points to the remaining pre-computed const array from codegen.
@@ -198,6 +202,19 @@ static inline void template_asn1_uint32(template_state_t *state, uint8_t tag,
                                               (uint8_t *)&_value, 4);
 }
 
+/**
+ * Move the output position to a fixed offset in the output buffer.
+ *
+ * Fixed-size templates copy their whole skeleton with `template_push_const`
+ * first, then seek to each variable field to write it in place.
+ *
+ * @param state Pointer to the template engine state.
+ * @param offset Offset from the start of the output buffer.
+ */
+static inline void template_seek(template_state_t *state, size_t offset) {
+  state->out_end = (uint8_t *)state->out_begin + offset;
+}
+
 /**
  * Memorize a location to be patched with the actual output size.
  *
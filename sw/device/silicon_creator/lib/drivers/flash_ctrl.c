@@ -120,6 +120,13 @@ static void transaction_start(transaction_params_t params) {
   abs_mmio_write32(flash_ctrl_core_base() + FLASH_CTRL_CONTROL_REG_OFFSET, reg);
 }
 
+enum {
+  /**
+   * Number of words moved per iteration of the unrolled copy loops.
+   */
+  kBurstWordCount = 4,
+};
+
 /**
  * Copies `word_count` words from the read FIFO to the given buffer.
  *
@@ -129,15 +136,25 @@ static void transaction_start(transaction_params_t params) {
  * @param[out] data Output buffer.
  */
 static void fifo_read(size_t word_count, void *data) {
-  size_t i = 0, r = word_count - 1;
-  for (; launder32(i) < word_count && launder32(r) < word_count; ++i, --r) {
-    write_32(
-        abs_mmio_read32(flash_ctrl_core_base() + FLASH_CTRL_RD_FIFO_REG_OFFSET),
-        data);
-    data = (char *)data + sizeof(uint32_t);
+  const uint32_t fifo_addr =
+      flash_ctrl_core_base() + FLASH_CTRL_RD_FIFO_REG_OFFSET;
+  char *dst = data;
+  size_t i = 0, r = word_count;
+  for (; launder32(i) + kBurstWordCount <= word_count &&
+         launder32(r) >= kBurstWordCount;
+       i += kBurstWordCount, r -= kBurstWordCount) {
+    write_32(abs_mmio_read32(fifo_addr), dst);
+    write_32(abs_mmio_read32(fifo_addr), dst + 1 * sizeof(uint32_t));
+    write_32(abs_mmio_read32(fifo_addr), dst + 2 * sizeof(uint32_t));
+    write_32(abs_mmio_read32(fifo_addr), dst + 3 * sizeof(uint32_t));
+    dst += kBurstWordCount * sizeof(uint32_t);
+  }
+  for (; launder32(i) < word_count && launder32(r) > 0; ++i, --r) {
+    write_32(abs_mmio_read32(fifo_addr), dst);
+    dst += sizeof(uint32_t);
   }
   HARDENED_CHECK_EQ(i, word_count);
-  HARDENED_CHECK_EQ(r, SIZE_MAX);
+  HARDENED_CHECK_EQ(r, 0);
 }
 
 /**
@@ -149,29 +166,42 @@ static void fifo_read(size_t word_count, void *data) {
  * @param data Input buffer.
  */
 static void fifo_write(size_t word_count, const void *data) {
-  size_t i = 0, r = word_count - 1;
-  for (; launder32(i) < word_count && launder32(r) < word_count; ++i, --r) {
-    abs_mmio_write32(flash_ctrl_core_base() + FLASH_CTRL_PROG_FIFO_REG_OFFSET,
-                     read_32(data));
-    data = (const char *)data + sizeof(uint32_t);
+  const uint32_t fifo_addr =
+      flash_ctrl_core_base() + FLASH_CTRL_PROG_FIFO_REG_OFFSET;
+  const char *src = data;
+  size_t i = 0, r = word_count;
+  for (; launder32(i) + kBurstWordCount <= word_count &&
+         launder32(r) >= kBurstWordCount;
+       i += kBurstWordCount, r -= kBurstWordCount) {
+    abs_mmio_write32(fifo_addr, read_32(src));
+    abs_mmio_write32(fifo_addr, read_32(src + 1 * sizeof(uint32_t)));
+    abs_mmio_write32(fifo_addr, read_32(src + 2 * sizeof(uint32_t)));
+    abs_mmio_write32(fifo_addr, read_32(src + 3 * sizeof(uint32_t)));
+    src += kBurstWordCount * sizeof(uint32_t);
+  }
+  for (; launder32(i) < word_count && launder32(r) > 0; ++i, --r) {
+    abs_mmio_write32(fifo_addr, read_32(src));
+    src += sizeof(uint32_t);
   }
   HARDENED_CHECK_EQ(i, word_count);
-  HARDENED_CHECK_EQ(r, SIZE_MAX);
+  HARDENED_CHECK_EQ(r, 0);
 }
 
 /**
- * Blocks until the current flash transaction is complete.
+ * Checks once whether the current flash transaction is complete.
  *
  * @param error Error code to return in case of a flash controller error.
- * @return The result of the operation.
+ * @param[out] done Whether the transaction is complete.
+ * @return The result of the operation if it is complete, `kErrorOk` otherwise.
  */
 OT_WARN_UNUSED_RESULT
-static rom_error_t wait_for_done(rom_error_t error) {
-  uint32_t op_status;
-  do {
-    op_status = abs_mmio_read32(flash_ctrl_core_base() +
-                                FLASH_CTRL_OP_STATUS_REG_OFFSET);
-  } while (!bitfield_bit32_read(op_status, FLASH_CTRL_OP_STATUS_DONE_BIT));
+static rom_error_t poll_done(rom_error_t error, bool *done) {
+  uint32_t op_status =
+      abs_mmio_read32(flash_ctrl_core_base() + FLASH_CTRL_OP_STATUS_REG_OFFSET);
+  *done = bitfield_bit32_read(op_status, FLASH_CTRL_OP_STATUS_DONE_BIT);
+  if (!*done) {
+    return kErrorOk;
+  }
   abs_mmio_write32(flash_ctrl_core_base() + FLASH_CTRL_OP_STATUS_REG_OFFSET,
                    0u);
 
@@ -181,6 +211,42 @@ static rom_error_t wait_for_done(rom_error_t error) {
   return kErrorOk;
 }
 
+/**
+ * Blocks until the current flash transaction is complete.
+ *
+ * @param error Error code to return in case of a flash controller error.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t wait_for_done(rom_error_t error) {
+  bool done;
+  rom_error_t result;
+  do {
+    result = poll_done(error, &done);
+  } while (!done);
+  return result;
+}
+
+enum {
+  /**
+   * Number of words in a program window.
+   *
+   * Program transactions can't cross window boundaries.
+   */
+  kWindowWordCount = FLASH_CTRL_PARAM_REG_BUS_PGM_RES_BYTES / sizeof(uint32_t),
+};
+
+/**
+ * Returns the number of words that fit between an address and the end of its
+ * program window.
+ *
+ * @param addr Full byte address.
+ * @return Number of words.
+ */
+static uint32_t window_word_count_get(uint32_t addr) {
+  return kWindowWordCount - ((addr / sizeof(uint32_t)) % kWindowWordCount);
+}
+
 /**
  * Writes data to the given partition.
  *
@@ -195,13 +261,8 @@ OT_WARN_UNUSED_RESULT
 static rom_error_t write(uint32_t addr, flash_ctrl_partition_t partition,
                          uint32_t word_count, const void *data,
                          rom_error_t error) {
-  enum {
-    kWindowWordCount = FLASH_CTRL_PARAM_REG_BUS_PGM_RES_BYTES / sizeof(uint32_t)
-  };
-
   // Find the number of words that can be written in the first window.
-  uint32_t window_word_count =
-      kWindowWordCount - ((addr / sizeof(uint32_t)) % kWindowWordCount);
+  uint32_t window_word_count = window_word_count_get(addr);
   while (word_count > 0) {
     // Program operations can't cross window boundaries.
     window_word_count =
@@ -391,6 +452,28 @@ rom_error_t flash_ctrl_data_write(uint32_t addr, uint32_t word_count,
                kErrorFlashCtrlDataWrite);
 }
 
+uint32_t flash_ctrl_data_write_start(uint32_t addr, uint32_t word_count,
+                                     const void *data) {
+  uint32_t window_word_count = window_word_count_get(addr);
+  window_word_count =
+      word_count < window_word_count ? word_count : window_word_count;
+
+  transaction_start((transaction_params_t){
+      .addr = addr,
+      .op_type = FLASH_CTRL_CONTROL_OP_VALUE_PROG,
+      .partition = kFlashCtrlPartitionData,
+      .word_count = window_word_count,
+      // Does not apply to program transactions.
+      .erase_type = kFlashCtrlEraseTypePage,
+  });
+  fifo_write(window_word_count, data);
+  return window_word_count;
+}
+
+rom_error_t flash_ctrl_data_write_poll(bool *done) {
+  return poll_done(kErrorFlashCtrlDataWrite, done);
+}
+
 rom_error_t flash_ctrl_info_write(const flash_ctrl_info_page_t *info_page,
                                   uint32_t offset, uint32_t word_count,
                                   const void *data) {
@@ -412,6 +495,22 @@ rom_error_t flash_ctrl_data_erase(uint32_t addr,
   return wait_for_done(kErrorFlashCtrlDataErase);
 }
 
+void flash_ctrl_data_erase_start(uint32_t addr,
+                                 flash_ctrl_erase_type_t erase_type) {
+  transaction_start((transaction_params_t){
+      .addr = addr,
+      .op_type = FLASH_CTRL_CONTROL_OP_VALUE_ERASE,
+      .erase_type = erase_type,
+      .partition = kFlashCtrlPartitionData,
+      // Does not apply to erase transactions.
+      .word_count = 1,
+  });
+}
+
+rom_error_t flash_ctrl_data_erase_poll(bool *done) {
+  return poll_done(kErrorFlashCtrlDataErase, done);
+}
+
 rom_error_t flash_ctrl_data_erase_verify(uint32_t addr,
                                          flash_ctrl_erase_type_t erase_type) {
   static_assert(__builtin_popcount(FLASH_CTRL_PARAM_BYTES_PER_BANK) == 1,
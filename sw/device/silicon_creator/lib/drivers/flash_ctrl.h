@@ -371,6 +371,32 @@ OT_WARN_UNUSED_RESULT
 rom_error_t flash_ctrl_data_write(uint32_t addr, uint32_t word_count,
                                   const void *data);
 
+/**
+ * Starts writing data to the data partition without waiting for completion.
+ *
+ * A single transaction can't cross program window boundaries, so this writes
+ * at most up to the end of the window containing `addr`. Poll for completion
+ * with `flash_ctrl_data_write_poll()` before starting another transaction.
+ *
+ * @param addr Address to write to.
+ * @param word_count Number of bus words to write.
+ * @param data Data to write. Must be word aligned.
+ * @return Number of bus words written by this transaction.
+ */
+OT_WARN_UNUSED_RESULT
+uint32_t flash_ctrl_data_write_start(uint32_t addr, uint32_t word_count,
+                                     const void *data);
+
+/**
+ * Checks whether a transaction started by `flash_ctrl_data_write_start()` is
+ * complete.
+ *
+ * @param[out] done Whether the transaction is complete.
+ * @return Result of the transaction if it is complete, `kErrorOk` otherwise.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t flash_ctrl_data_write_poll(bool *done);
+
 /**
  * Writes data to an information page.
  *
@@ -426,6 +452,29 @@ OT_WARN_UNUSED_RESULT
 rom_error_t flash_ctrl_data_erase(uint32_t addr,
                                   flash_ctrl_erase_type_t erase_type);
 
+/**
+ * Starts erasing a page or bank of the data partition without waiting for
+ * completion.
+ *
+ * Poll for completion with `flash_ctrl_data_erase_poll()` before starting
+ * another transaction.
+ *
+ * @param addr Address that falls within the bank or page being deleted.
+ * @param erase_type Whether to erase a page or a bank.
+ */
+void flash_ctrl_data_erase_start(uint32_t addr,
+                                 flash_ctrl_erase_type_t erase_type);
+
+/**
+ * Checks whether a transaction started by `flash_ctrl_data_erase_start()` is
+ * complete.
+ *
+ * @param[out] done Whether the transaction is complete.
+ * @return Result of the transaction if it is complete, `kErrorOk` otherwise.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t flash_ctrl_data_erase_poll(bool *done);
+
 /**
  * Verifies that a data partition page or bank was erased.
  *
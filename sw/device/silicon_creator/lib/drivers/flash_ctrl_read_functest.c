@@ -0,0 +1,205 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hw/top/dt/flash_ctrl.h"
+#include "sw/device/lib/base/abs_mmio.h"
+#include "sw/device/lib/base/bitfield.h"
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/base/multibits.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+#include "sw/device/silicon_creator/lib/drivers/flash_ctrl.h"
+#include "sw/device/silicon_creator/lib/drivers/ibex.h"
+#include "sw/device/silicon_creator/lib/error.h"
+#include "sw/device/silicon_creator/lib/manifest.h"
+
+#include "hw/top/flash_ctrl_regs.h"
+
+enum {
+  /**
+   * Words per read for small reads, the size of the read FIFO.
+   */
+  kSmallChunkWordCount = 32,
+  /**
+   * Words per read for large reads, one page.
+   */
+  kPageChunkWordCount = FLASH_CTRL_PARAM_BYTES_PER_PAGE / sizeof(uint32_t),
+};
+
+static uint32_t buf[kPageChunkWordCount];
+static manifest_t manifest;
+
+/**
+ * Reads the data partition with the single-word FIFO copy loop that
+ * `flash_ctrl_data_read()` used before the loop was unrolled.
+ *
+ * This is the baseline that the driver is measured against.
+ *
+ * @param addr Address to read from.
+ * @param word_count Number of words to read.
+ * @param[out] data Output buffer.
+ * @return Result of the operation.
+ */
+static rom_error_t baseline_data_read(uint32_t addr, uint32_t word_count,
+                                      void *data) {
+  const uint32_t base = dt_flash_ctrl_primary_reg_block(kDtFlashCtrl);
+  abs_mmio_write32(base + FLASH_CTRL_ADDR_REG_OFFSET, addr);
+  uint32_t reg = bitfield_bit32_write(0, FLASH_CTRL_CONTROL_START_BIT, true);
+  reg = bitfield_field32_write(reg, FLASH_CTRL_CONTROL_OP_FIELD,
+                               FLASH_CTRL_CONTROL_OP_VALUE_READ);
+  reg = bitfield_field32_write(reg, FLASH_CTRL_CONTROL_NUM_FIELD,
+                               word_count - 1);
+  abs_mmio_write32(base + FLASH_CTRL_CONTROL_REG_OFFSET, reg);
+
+  size_t i = 0, r = word_count - 1;
+  for (; launder32(i) < word_count && launder32(r) < word_count; ++i, --r) {
+    write_32(abs_mmio_read32(base + FLASH_CTRL_RD_FIFO_REG_OFFSET), data);
+    data = (char *)data + sizeof(uint32_t);
+  }
+  HARDENED_CHECK_EQ(i, word_count);
+  HARDENED_CHECK_EQ(r, SIZE_MAX);
+
+  uint32_t op_status;
+  do {
+    op_status = abs_mmio_read32(base + FLASH_CTRL_OP_STATUS_REG_OFFSET);
+  } while (!bitfield_bit32_read(op_status, FLASH_CTRL_OP_STATUS_DONE_BIT));
+  abs_mmio_write32(base + FLASH_CTRL_OP_STATUS_REG_OFFSET, 0u);
+  if (bitfield_bit32_read(op_status, FLASH_CTRL_OP_STATUS_ERR_BIT)) {
+    return kErrorFlashCtrlDataRead;
+  }
+  return kErrorOk;
+}
+
+/**
+ * Function that reads words from the data partition.
+ */
+typedef rom_error_t (*data_read_fn_t)(uint32_t addr, uint32_t word_count,
+                                      void *data);
+
+/**
+ * Reads the start of the data partition and computes a checksum of it.
+ *
+ * @param read Function used for the reads.
+ * @param byte_count Number of bytes to read, a multiple of the page size.
+ * @param chunk_word_count Number of words per `read` call.
+ * @param[out] checksum Checksum of the data read.
+ * @param[out] cycles Cycles spent in `read`.
+ * @return Result of the operation.
+ */
+static rom_error_t data_read(data_read_fn_t read, uint32_t byte_count,
+                             uint32_t chunk_word_count, uint32_t *checksum,
+                             uint32_t *cycles) {
+  *checksum = 0;
+  *cycles = 0;
+  for (uint32_t addr = 0; addr < byte_count;
+       addr += chunk_word_count * sizeof(uint32_t)) {
+    uint32_t start = ibex_mcycle32();
+    RETURN_IF_ERROR(read(addr, chunk_word_count, buf));
+    *cycles += ibex_mcycle32() - start;
+    for (size_t i = 0; i < chunk_word_count; ++i) {
+      *checksum = *checksum * 31 + buf[i];
+    }
+  }
+  return kErrorOk;
+}
+
+/**
+ * Reads the manifest of slot A, as the ROM does before verifying it.
+ */
+static rom_error_t manifest_read_test(void) {
+  uint32_t start = ibex_mcycle32();
+  RETURN_IF_ERROR(flash_ctrl_data_read(0, sizeof(manifest) / sizeof(uint32_t),
+                                       &manifest));
+  uint32_t whole_cycles = ibex_mcycle32() - start;
+
+  const uint32_t *words = (const uint32_t *)&manifest;
+  uint32_t small_cycles = 0;
+  for (size_t i = 0; i < sizeof(manifest) / sizeof(uint32_t);
+       i += kSmallChunkWordCount) {
+    size_t word_count = sizeof(manifest) / sizeof(uint32_t) - i;
+    if (word_count > kSmallChunkWordCount) {
+      word_count = kSmallChunkWordCount;
+    }
+    start = ibex_mcycle32();
+    RETURN_IF_ERROR(
+        flash_ctrl_data_read(i * sizeof(uint32_t), word_count, buf));
+    small_cycles += ibex_mcycle32() - start;
+    for (size_t j = 0; j < word_count; ++j) {
+      if (buf[j] != words[i + j]) {
+        LOG_ERROR("Manifest mismatch at word %u.", i + j);
+        return kErrorUnknown;
+      }
+    }
+  }
+
+  LOG_INFO("Manifest (%u bytes): small reads %u cycles, one read %u cycles",
+           sizeof(manifest), small_cycles, whole_cycles);
+  return kErrorOk;
+}
+
+/**
+ * Reads the signed region of the image in slot A with small and page-sized
+ * reads, and with page-sized reads through the baseline copy loop.
+ *
+ * Fails if the unrolled copy loop of the driver is slower than the baseline.
+ */
+static rom_error_t image_read_test(void) {
+  uint32_t byte_count = manifest.length;
+  if (byte_count < sizeof(manifest) ||
+      byte_count > FLASH_CTRL_PARAM_BYTES_PER_BANK) {
+    LOG_ERROR("Unexpected image length: %u", byte_count);
+    return kErrorUnknown;
+  }
+  byte_count = (byte_count + FLASH_CTRL_PARAM_BYTES_PER_PAGE - 1) &
+               ~(FLASH_CTRL_PARAM_BYTES_PER_PAGE - 1);
+
+  uint32_t small_checksum, small_cycles;
+  RETURN_IF_ERROR(data_read(flash_ctrl_data_read, byte_count,
+                            kSmallChunkWordCount, &small_checksum,
+                            &small_cycles));
+  uint32_t page_checksum, page_cycles;
+  RETURN_IF_ERROR(data_read(flash_ctrl_data_read, byte_count,
+                            kPageChunkWordCount, &page_checksum,
+                            &page_cycles));
+  uint32_t baseline_checksum, baseline_cycles;
+  RETURN_IF_ERROR(data_read(baseline_data_read, byte_count,
+                            kPageChunkWordCount, &baseline_checksum,
+                            &baseline_cycles));
+  if (small_checksum != page_checksum ||
+      baseline_checksum != page_checksum) {
+    LOG_ERROR("Checksum mismatch: small 0x%08x, page 0x%08x, baseline 0x%08x",
+              small_checksum, page_checksum, baseline_checksum);
+    return kErrorUnknown;
+  }
+
+  const uint32_t kib = byte_count / 1024;
+  LOG_INFO(
+      "Image (%u KiB): small %u cycles/KiB, page %u cycles/KiB, "
+      "baseline page %u cycles/KiB",
+      kib, small_cycles / kib, page_cycles / kib, baseline_cycles / kib);
+  if (page_cycles > baseline_cycles) {
+    LOG_ERROR("Unrolled FIFO reads are slower than the baseline loop");
+    return kErrorUnknown;
+  }
+  return kErrorOk;
+}
+
+OTTF_DEFINE_TEST_CONFIG();
+
+bool test_main(void) {
+  flash_ctrl_data_default_perms_set((flash_ctrl_perms_t){
+      .read = kMultiBitBool4True,
+      .write = kMultiBitBool4False,
+      .erase = kMultiBitBool4False,
+  });
+
+  status_t result = OK_STATUS();
+  EXECUTE_TEST(result, manifest_read_test);
+  EXECUTE_TEST(result, image_read_test);
+  return status_ok(result);
+}
@@ -323,6 +323,23 @@ TEST_F(TransferTest, ReadDataOk) {
   EXPECT_EQ(words_out, words_);
 }
 
+TEST_F(TransferTest, ReadDataLarge) {
+  // Enough words for both the unrolled and the remainder copy loops.
+  const uint32_t addr = 0x1000;
+  std::vector<uint32_t> words(66);
+  for (size_t i = 0; i < words.size(); ++i) {
+    words[i] = 0x9e3779b9 * (i + 1);
+  }
+  ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_READ, addr,
+                      words.size());
+  ExpectReadData(words);
+  ExpectWaitForDone(true, false);
+  std::vector<uint32_t> words_out(words.size());
+  EXPECT_EQ(flash_ctrl_data_read(addr, words.size(), &words_out.front()),
+            kErrorOk);
+  EXPECT_EQ(words_out, words);
+}
+
 TEST_F(TransferTest, ReadInfoOk) {
   // Address of the `kFlashCtrlInfoPageOwnerSlot0` page, see `info_page_addr`.
   const uint32_t addr =
@@ -418,6 +435,52 @@ TEST_F(TransferTest, ProgAcrossWindows) {
             kErrorOk);
 }
 
+TEST_F(TransferTest, ProgDataStartStopsAtWindow) {
+  static const uint32_t kWinWords =
+      FLASH_CTRL_PARAM_REG_BUS_PGM_RES_BYTES / sizeof(uint32_t);
+  std::vector<uint32_t> many_words(2 * kWinWords, 0xa5a5a5a5);
+
+  // Starting mid-window, only the rest of the window is programmed.
+  const uint32_t addr = FLASH_CTRL_PARAM_REG_BUS_PGM_RES_BYTES / 2;
+  ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_PROG, addr,
+                      kWinWords / 2);
+  ExpectProgData(std::vector<uint32_t>(kWinWords / 2, 0xa5a5a5a5));
+  EXPECT_EQ(flash_ctrl_data_write_start(addr, many_words.size(),
+                                        &many_words.front()),
+            kWinWords / 2);
+
+  bool done;
+  ExpectWaitForDone(false, false);
+  EXPECT_EQ(flash_ctrl_data_write_poll(&done), kErrorOk);
+  EXPECT_FALSE(done);
+
+  ExpectWaitForDone(true, false);
+  EXPECT_EQ(flash_ctrl_data_write_poll(&done), kErrorOk);
+  EXPECT_TRUE(done);
+}
+
+TEST_F(TransferTest, ProgDataPollError) {
+  bool done;
+  ExpectWaitForDone(true, true);
+  EXPECT_EQ(flash_ctrl_data_write_poll(&done), kErrorFlashCtrlDataWrite);
+  EXPECT_TRUE(done);
+}
+
+TEST_F(TransferTest, EraseDataPageStartPoll) {
+  ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_ERASE, 0x01234567,
+                      1);
+  flash_ctrl_data_erase_start(0x01234567, kFlashCtrlEraseTypePage);
+
+  bool done;
+  ExpectWaitForDone(false, false);
+  EXPECT_EQ(flash_ctrl_data_erase_poll(&done), kErrorOk);
+  EXPECT_FALSE(done);
+
+  ExpectWaitForDone(true, true);
+  EXPECT_EQ(flash_ctrl_data_erase_poll(&done), kErrorFlashCtrlDataErase);
+  EXPECT_TRUE(done);
+}
+
 TEST_F(TransferTest, TransferInternalError) {
   ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_READ, 0x01234567,
                       words_.size());
@@ -220,14 +220,25 @@ static rom_error_t keymgr_wait_until_done(void) {
   }
 }
 
-rom_error_t sc_keymgr_generate_key(
-    sc_keymgr_dest_t destination, sc_keymgr_key_type_t key_type,
+/**
+ * Starts a keymgr output-generate operation and waits until it is done.
+ *
+ * @param operation `KEYMGR_CONTROL_SHADOWED_OPERATION_VALUE_GENERATE_*`.
+ * @param destination Hardware destination for key material.
+ * @param key_type Key type: attestation or sealing.
+ * @param diversification Diversification input for the key derivation.
+ * @return OK or error.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t keymgr_generate(
+    uint32_t operation, sc_keymgr_dest_t destination,
+    sc_keymgr_key_type_t key_type,
     sc_keymgr_diversification_t diversification) {
   HARDENED_RETURN_IF_ERROR(keymgr_is_idle());
 
   uint32_t ctrl = 0;
 
-  // Select OTBN as the destination.
+  // Select the destination.
   ctrl = bitfield_field32_write(0, KEYMGR_CONTROL_SHADOWED_DEST_SEL_FIELD,
                                 destination);
 
@@ -238,9 +249,8 @@ rom_error_t sc_keymgr_generate_key(
   }
 
   // Select the "generate" operation.
-  ctrl = bitfield_field32_write(
-      ctrl, KEYMGR_CONTROL_SHADOWED_OPERATION_FIELD,
-      KEYMGR_CONTROL_SHADOWED_OPERATION_VALUE_GENERATE_HW_OUTPUT);
+  ctrl = bitfield_field32_write(ctrl, KEYMGR_CONTROL_SHADOWED_OPERATION_FIELD,
+                                operation);
 
   // Write the control register.
   abs_mmio_write32_shadowed(
@@ -264,6 +274,43 @@ rom_error_t sc_keymgr_generate_key(
   return keymgr_wait_until_done();
 }
 
+rom_error_t sc_keymgr_generate_key(
+    sc_keymgr_dest_t destination, sc_keymgr_key_type_t key_type,
+    sc_keymgr_diversification_t diversification) {
+  return keymgr_generate(
+      KEYMGR_CONTROL_SHADOWED_OPERATION_VALUE_GENERATE_HW_OUTPUT, destination,
+      key_type, diversification);
+}
+
+static_assert(KEYMGR_SW_SHARE0_OUTPUT_7_REG_OFFSET ==
+                  KEYMGR_SW_SHARE0_OUTPUT_0_REG_OFFSET +
+                      (kScKeymgrOutputNumWords - 1) * sizeof(uint32_t),
+              "Unexpected number of keymgr software output registers.");
+static_assert(KEYMGR_SW_SHARE1_OUTPUT_7_REG_OFFSET ==
+                  KEYMGR_SW_SHARE1_OUTPUT_0_REG_OFFSET +
+                      (kScKeymgrOutputNumWords - 1) * sizeof(uint32_t),
+              "Unexpected number of keymgr software output registers.");
+
+rom_error_t sc_keymgr_generate_key_sw(
+    sc_keymgr_key_type_t key_type, sc_keymgr_diversification_t diversification,
+    uint32_t output[kScKeymgrOutputNumWords]) {
+  HARDENED_RETURN_IF_ERROR(keymgr_generate(
+      KEYMGR_CONTROL_SHADOWED_OPERATION_VALUE_GENERATE_SW_OUTPUT,
+      kScKeymgrDestNone, key_type, diversification));
+
+  // The output registers are cleared when they are read.
+  const uint32_t share0_addr =
+      sc_keymgr_base() + KEYMGR_SW_SHARE0_OUTPUT_0_REG_OFFSET;
+  const uint32_t share1_addr =
+      sc_keymgr_base() + KEYMGR_SW_SHARE1_OUTPUT_0_REG_OFFSET;
+  for (size_t i = 0; i < kScKeymgrOutputNumWords; ++i) {
+    uint32_t share0 = abs_mmio_read32(share0_addr + i * sizeof(uint32_t));
+    uint32_t share1 = abs_mmio_read32(share1_addr + i * sizeof(uint32_t));
+    output[i] = share0 ^ share1;
+  }
+  return kErrorOk;
+}
+
 rom_error_t sc_keymgr_sideload_clear(sc_keymgr_dest_t destination) {
   HARDENED_RETURN_IF_ERROR(keymgr_is_idle());
 
@@ -62,6 +62,10 @@ enum {
    * Number of 32-bit words for the salt.
    */
   kScKeymgrSaltNumWords = 8,
+  /**
+   * Number of 32-bit words of a software-visible keymgr output.
+   */
+  kScKeymgrOutputNumWords = 8,
 };
 
 /**
@@ -248,6 +252,24 @@ rom_error_t sc_keymgr_generate_key(sc_keymgr_dest_t destination,
                                    sc_keymgr_key_type_t key_type,
                                    sc_keymgr_diversification_t diversification);
 
+/**
+ * Generate a software-visible key manager key.
+ *
+ * Calls the key manager to generate a key in the software output registers,
+ * waits until the operation is complete and combines the two shares of the
+ * output. The caller is responsible for wiping `output` once it is done with
+ * it.
+ *
+ * @param key_type Key type: attestation or sealing.
+ * @param diversification Diversification input for the key derivation.
+ * @param[out] output The generated key.
+ * @return OK or error.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t sc_keymgr_generate_key_sw(
+    sc_keymgr_key_type_t key_type, sc_keymgr_diversification_t diversification,
+    uint32_t output[kScKeymgrOutputNumWords]);
+
 /**
  * Clear the requested sideloaded key slot.
  *
@@ -325,6 +325,105 @@ TEST_F(KeymgrTest, GenOtbnKeyError) {
             kErrorKeymgrInternal);
 }
 
+TEST_F(KeymgrTest, GenSwKey) {
+  sc_keymgr_diversification_t test_diversification = {
+      .salt = {0xf0f1f2f3, 0xf4f5f6f7, 0xf8f9fafb, 0xfcfdfeff, 0xd0d1d2d3,
+               0xd4d5d6d7, 0xd8d9dadb, 0xdcdddedf},
+      .version = 0,
+  };
+  std::array<uint32_t, kScKeymgrOutputNumWords> share0 = {
+      0x01234567, 0x89abcdef, 0xdeadbeef, 0xcafef00d,
+      0x00000000, 0xffffffff, 0x5a5a5a5a, 0xa5a5a5a5,
+  };
+  std::array<uint32_t, kScKeymgrOutputNumWords> share1 = {
+      0x76543210, 0xfedcba98, 0x00000000, 0x12345678,
+      0x9abcdef0, 0xffffffff, 0xa5a5a5a5, 0x5a5a5a5a,
+  };
+
+  ExpectIdleCheck(KEYMGR_OP_STATUS_STATUS_VALUE_IDLE);
+  EXPECT_ABS_WRITE32_SHADOWED(
+      base_ + KEYMGR_CONTROL_SHADOWED_REG_OFFSET,
+      {
+          {KEYMGR_CONTROL_SHADOWED_DEST_SEL_OFFSET,
+           KEYMGR_CONTROL_SHADOWED_DEST_SEL_VALUE_NONE},
+          {KEYMGR_CONTROL_SHADOWED_CDI_SEL_BIT, true},
+          {KEYMGR_CONTROL_SHADOWED_OPERATION_OFFSET,
+           KEYMGR_CONTROL_SHADOWED_OPERATION_VALUE_GENERATE_SW_OUTPUT},
+      });
+  ExpectDiversificationWrite(test_diversification);
+  EXPECT_ABS_WRITE32(base_ + KEYMGR_START_REG_OFFSET,
+                     {
+                         {KEYMGR_START_EN_BIT, true},
+                     });
+  ExpectWaitUntilDone(/*busy_cycles=*/2,
+                      KEYMGR_OP_STATUS_STATUS_VALUE_DONE_SUCCESS);
+  for (size_t i = 0; i < kScKeymgrOutputNumWords; ++i) {
+    EXPECT_ABS_READ32(
+        base_ + KEYMGR_SW_SHARE0_OUTPUT_0_REG_OFFSET + i * sizeof(uint32_t),
+        share0[i]);
+    EXPECT_ABS_READ32(
+        base_ + KEYMGR_SW_SHARE1_OUTPUT_0_REG_OFFSET + i * sizeof(uint32_t),
+        share1[i]);
+  }
+
+  std::array<uint32_t, kScKeymgrOutputNumWords> output{};
+  EXPECT_EQ(sc_keymgr_generate_key_sw(kScKeymgrKeyTypeAttestation,
+                                      test_diversification, output.data()),
+            kErrorOk);
+  for (size_t i = 0; i < kScKeymgrOutputNumWords; ++i) {
+    EXPECT_EQ(output[i], share0[i] ^ share1[i]);
+  }
+}
+
+TEST_F(KeymgrTest, GenSwKeyNotIdle) {
+  sc_keymgr_diversification_t test_diversification = {
+      .salt = {0xf0f1f2f3, 0xf4f5f6f7, 0xf8f9fafb, 0xfcfdfeff, 0xd0d1d2d3,
+               0xd4d5d6d7, 0xd8d9dadb, 0xdcdddedf},
+      .version = 0,
+  };
+  std::array<uint32_t, kScKeymgrOutputNumWords> output{};
+
+  ExpectIdleCheck(KEYMGR_OP_STATUS_STATUS_VALUE_WIP);
+  EXPECT_EQ(sc_keymgr_generate_key_sw(kScKeymgrKeyTypeAttestation,
+                                      test_diversification, output.data()),
+            kErrorKeymgrInternal);
+}
+
+TEST_F(KeymgrTest, GenSwKeyError) {
+  sc_keymgr_diversification_t test_diversification = {
+      .salt = {0xf0f1f2f3, 0xf4f5f6f7, 0xf8f9fafb, 0xfcfdfeff, 0xd0d1d2d3,
+               0xd4d5d6d7, 0xd8d9dadb, 0xdcdddedf},
+      .version = 0,
+  };
+  uint32_t err_code = 0x1;
+  std::array<uint32_t, kScKeymgrOutputNumWords> output{};
+
+  ExpectIdleCheck(KEYMGR_OP_STATUS_STATUS_VALUE_IDLE);
+  EXPECT_ABS_WRITE32_SHADOWED(
+      base_ + KEYMGR_CONTROL_SHADOWED_REG_OFFSET,
+      {
+          {KEYMGR_CONTROL_SHADOWED_DEST_SEL_OFFSET,
+           KEYMGR_CONTROL_SHADOWED_DEST_SEL_VALUE_NONE},
+          {KEYMGR_CONTROL_SHADOWED_CDI_SEL_BIT, false},
+          {KEYMGR_CONTROL_SHADOWED_OPERATION_OFFSET,
+           KEYMGR_CONTROL_SHADOWED_OPERATION_VALUE_GENERATE_SW_OUTPUT},
+      });
+  ExpectDiversificationWrite(test_diversification);
+  EXPECT_ABS_WRITE32(base_ + KEYMGR_START_REG_OFFSET,
+                     {
+                         {KEYMGR_START_EN_BIT, true},
+                     });
+  ExpectWaitUntilDone(/*busy_cycles=*/0,
+                      KEYMGR_OP_STATUS_STATUS_VALUE_DONE_ERROR);
+  EXPECT_ABS_READ32(base_ + KEYMGR_ERR_CODE_REG_OFFSET, err_code);
+  EXPECT_ABS_WRITE32(base_ + KEYMGR_ERR_CODE_REG_OFFSET, err_code);
+
+  // The output registers are not read after an error.
+  EXPECT_EQ(sc_keymgr_generate_key_sw(kScKeymgrKeyTypeSealing,
+                                      test_diversification, output.data()),
+            kErrorKeymgrInternal);
+}
+
 TEST_F(KeymgrTest, SideloadClearOtbn) {
   ExpectIdleCheck(KEYMGR_OP_STATUS_STATUS_VALUE_IDLE);
   EXPECT_ABS_WRITE32(base_ + KEYMGR_SIDELOAD_CLEAR_REG_OFFSET,
@@ -34,6 +34,15 @@ rom_error_t flash_ctrl_data_write(uint32_t addr, uint32_t word_count,
   return MockFlashCtrl::Instance().DataWrite(addr, word_count, data);
 }
 
+uint32_t flash_ctrl_data_write_start(uint32_t addr, uint32_t word_count,
+                                     const void *data) {
+  return MockFlashCtrl::Instance().DataWriteStart(addr, word_count, data);
+}
+
+rom_error_t flash_ctrl_data_write_poll(bool *done) {
+  return MockFlashCtrl::Instance().DataWritePoll(done);
+}
+
 rom_error_t flash_ctrl_info_write(const flash_ctrl_info_page_t *info_page,
                                   uint32_t offset, uint32_t word_count,
                                   const void *data) {
@@ -46,6 +55,15 @@ rom_error_t flash_ctrl_data_erase(uint32_t addr,
   return MockFlashCtrl::Instance().DataErase(addr, erase_type);
 }
 
+void flash_ctrl_data_erase_start(uint32_t addr,
+                                 flash_ctrl_erase_type_t erase_type) {
+  MockFlashCtrl::Instance().DataEraseStart(addr, erase_type);
+}
+
+rom_error_t flash_ctrl_data_erase_poll(bool *done) {
+  return MockFlashCtrl::Instance().DataErasePoll(done);
+}
+
 rom_error_t flash_ctrl_data_erase_verify(uint32_t addr,
                                          flash_ctrl_erase_type_t erase_type) {
   return MockFlashCtrl::Instance().DataEraseVerify(addr, erase_type);
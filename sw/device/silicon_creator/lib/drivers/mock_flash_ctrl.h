@@ -24,10 +24,14 @@ class MockFlashCtrl : public global_mock::GlobalMock<MockFlashCtrl> {
   MOCK_METHOD(rom_error_t, InfoRead,
               (const flash_ctrl_info_page_t *, uint32_t, uint32_t, void *));
   MOCK_METHOD(rom_error_t, DataWrite, (uint32_t, uint32_t, const void *));
+  MOCK_METHOD(uint32_t, DataWriteStart, (uint32_t, uint32_t, const void *));
+  MOCK_METHOD(rom_error_t, DataWritePoll, (bool *));
   MOCK_METHOD(rom_error_t, InfoWrite,
               (const flash_ctrl_info_page_t *, uint32_t, uint32_t,
                const void *));
   MOCK_METHOD(rom_error_t, DataErase, (uint32_t, flash_ctrl_erase_type_t));
+  MOCK_METHOD(void, DataEraseStart, (uint32_t, flash_ctrl_erase_type_t));
+  MOCK_METHOD(rom_error_t, DataErasePoll, (bool *));
   MOCK_METHOD(rom_error_t, DataEraseVerify,
               (uint32_t, flash_ctrl_erase_type_t));
   MOCK_METHOD(rom_error_t, InfoErase,
@@ -36,6 +36,11 @@ void hmac_sha256(const void *data, size_t len, hmac_digest_t *digest) {
   MockHmac::Instance().sha256(data, len, digest);
 }
 
+void sc_hmac_hmac_sha256(const void *data, size_t len, hmac_key_t key,
+                         bool big_endian_digest, hmac_digest_t *digest) {
+  MockHmac::Instance().hmac_sha256(data, len, key, big_endian_digest, digest);
+}
+
 void hmac_sha256_save(hmac_context_t *ctx) {
   MockHmac::Instance().sha256_save(ctx);
 }
@@ -26,6 +26,8 @@ class MockHmac : public global_mock::GlobalMock<MockHmac> {
   MOCK_METHOD(void, sha256_final_truncated, (uint32_t *, size_t));
   MOCK_METHOD(void, sha256_final, (hmac_digest_t *));
   MOCK_METHOD(void, sha256, (const void *, size_t, hmac_digest_t *));
+  MOCK_METHOD(void, hmac_sha256,
+              (const void *, size_t, hmac_key_t, bool, hmac_digest_t *));
   MOCK_METHOD(void, sha256_save, (hmac_context_t *));
   MOCK_METHOD(void, sha256_restore, (const hmac_context_t *));
 };
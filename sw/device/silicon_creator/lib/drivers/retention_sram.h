@@ -11,12 +11,51 @@
 #include "sw/device/lib/base/macros.h"
 #include "sw/device/silicon_creator/lib/boot_log.h"
 #include "sw/device/silicon_creator/lib/boot_svc/boot_svc_msg.h"
+#include "sw/device/silicon_creator/lib/drivers/hmac.h"
 #include "sw/device/silicon_creator/lib/error.h"
+#include "sw/device/silicon_creator/lib/sigverify/ecdsa_p256_key.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * DICE public key cached across resets.
+ */
+typedef struct dice_cache_key {
+  /**
+   * MAC over the inputs of the key and `pubkey`.
+   */
+  hmac_digest_t tag;
+  /**
+   * Public key, in big-endian as in the certificates.
+   */
+  ecdsa_p256_public_key_t pubkey;
+} dice_cache_key_t;
+OT_ASSERT_MEMBER_OFFSET(dice_cache_key_t, tag, 0);
+OT_ASSERT_MEMBER_OFFSET(dice_cache_key_t, pubkey, 32);
+OT_ASSERT_SIZE(dice_cache_key_t, 96);
+
+/**
+ * Cache of the DICE public keys derived by the ROM_EXT.
+ *
+ * Written and checked by `dice_cache_keygen()` to skip the generation of a key
+ * when its inputs have not changed since the previous boot.
+ */
+typedef struct dice_cache {
+  /**
+   * UDS public key.
+   */
+  dice_cache_key_t uds;
+  /**
+   * CDI_0 public key.
+   */
+  dice_cache_key_t cdi_0;
+} dice_cache_t;
+OT_ASSERT_MEMBER_OFFSET(dice_cache_t, uds, 0);
+OT_ASSERT_MEMBER_OFFSET(dice_cache_t, cdi_0, 96);
+OT_ASSERT_SIZE(dice_cache_t, 192);
+
 /**
  * Retention SRAM silicon creator area.
  */
@@ -51,10 +90,15 @@ typedef struct retention_sram_creator {
    */
   uint32_t reserved[(2044 - (sizeof(uint32_t)          // reset_reason
                              + sizeof(boot_svc_msg_t)  // boot services message
+                             + sizeof(dice_cache_t)    // dice_cache
                              + sizeof(boot_log_t)      // boot_log
                              + sizeof(rom_error_t)     // last_shutdown_reason
                              )) /
                     sizeof(uint32_t)];
+  /**
+   * DICE public key cache.
+   */
+  dice_cache_t dice_cache;
   /**
    * Boot log area.
    *
@@ -73,6 +117,7 @@ typedef struct retention_sram_creator {
 OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, reset_reasons, 0);
 OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, boot_svc_msg, 4);
 OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, reserved, 260);
+OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, dice_cache, 1720);
 OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, boot_log, 1912);
 OT_ASSERT_MEMBER_OFFSET(retention_sram_creator_t, last_shutdown_reason, 2040);
 OT_ASSERT_SIZE(boot_svc_msg_t, 256);
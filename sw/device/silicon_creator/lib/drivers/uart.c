@@ -145,6 +145,27 @@ size_t uart_read(uint8_t *data, size_t len, uint32_t timeout_ms) {
   return n;
 }
 
+size_t uart_read_with_idle(uint8_t *data, size_t len, uint32_t timeout_ms,
+                           uart_idle_fn_t idle, void *arg) {
+  uint64_t deadline =
+      timeout_ms == UINT32_MAX
+          ? UINT64_MAX
+          : ibex_mcycle() + ibex_time_to_cycles(timeout_ms * 1000);
+
+  size_t n = 0;
+  for (n = 0; n < len; ++n) {
+    // If the receive FIFO is empty, do some other work while waiting.
+    while (uart_rx_empty()) {
+      if (ibex_mcycle() > deadline)
+        return n;
+      idle(arg);
+    }
+    uint32_t reg = abs_mmio_read32(uart_reg_base() + UART_RDATA_REG_OFFSET);
+    *data++ = (uint8_t)reg;
+  }
+  return n;
+}
+
 hardened_bool_t uart_break_detect(uint32_t timeout_us) {
   uint64_t time = ibex_mcycle();
   uint64_t deadline = time + ibex_time_to_cycles(timeout_us);
@@ -96,6 +96,31 @@ void uart_write_imm(uint64_t val);
 OT_WARN_UNUSED_RESULT
 size_t uart_read(uint8_t *data, size_t len, uint32_t timeout_ms);
 
+/**
+ * Function called by `uart_read_with_idle()` while it waits for data.
+ *
+ * @param arg The argument given to `uart_read_with_idle()`.
+ */
+typedef void (*uart_idle_fn_t)(void *arg);
+
+/**
+ * Read from the UART into a buffer, doing other work while waiting.
+ *
+ * Like `uart_read()`, but calls `idle` each time the receive FIFO is found
+ * empty.  `idle` must return quickly enough that the receive FIFO does not
+ * overflow.
+ *
+ * @param data Pointer to buffer to write.
+ * @param len Length of the buffer to write.
+ * @param timeout_ms The timeout to receive the complete buffer.
+ * @param idle Function to call while waiting for data.
+ * @param arg Argument to pass to `idle`.
+ * @return Number of bytes written.
+ */
+OT_WARN_UNUSED_RESULT
+size_t uart_read_with_idle(uint8_t *data, size_t len, uint32_t timeout_ms,
+                           uart_idle_fn_t idle, void *arg);
+
 /**
  * Returns true if UART TX is idle, otherwise returns false.
  *
@@ -140,6 +140,25 @@ TEST_F(UartTest, RecvTimeout) {
   EXPECT_EQ(result, -1);
 }
 
+TEST_F(UartTest, RecvWithIdle) {
+  // The idle function is called each time the RX FIFO is found empty.
+  EXPECT_ABS_READ32(base_ + UART_STATUS_REG_OFFSET,
+                    {{UART_STATUS_RXEMPTY_BIT, true}});
+  EXPECT_ABS_READ32(base_ + UART_STATUS_REG_OFFSET,
+                    {{UART_STATUS_RXEMPTY_BIT, true}});
+  EXPECT_ABS_READ32(base_ + UART_STATUS_REG_OFFSET,
+                    {{UART_STATUS_RXEMPTY_BIT, false}});
+  EXPECT_ABS_READ32(base_ + UART_RDATA_REG_OFFSET, 'A');
+  size_t idle_count = 0;
+  uint8_t ch = 0;
+  size_t n = uart_read_with_idle(
+      &ch, sizeof(ch), UINT32_MAX,
+      [](void *arg) { ++*static_cast<size_t *>(arg); }, &idle_count);
+  EXPECT_EQ(n, 1);
+  EXPECT_EQ(ch, 'A');
+  EXPECT_EQ(idle_count, 2);
+}
+
 TEST_F(UartTest, BreakDetect) {
   // The break detect function will continuously poll the UART value register to
   // observe the sampled value on the RX line.  A break condition over the
@@ -22,7 +22,7 @@ static rom_error_t owner_spx_verify(
     const sigverify_spx_signature_t *signature, const void *msg_prefix_1,
     size_t msg_prefix_1_len, const void *msg_prefix_2, size_t msg_prefix_2_len,
     const void *msg, size_t msg_len, hmac_digest_t digest,
-    uint32_t *flash_exec) {
+    const hmac_digest_t *msg_hash, uint32_t *flash_exec) {
   if (signature == NULL) {
     return kErrorSigverifySpxNotFound;
   }
@@ -65,6 +65,11 @@ static rom_error_t owner_spx_verify(
 
   switch (key_alg) {
     case kOwnershipKeyAlgSpxPure:
+      if (msg_hash != NULL) {
+        HARDENED_RETURN_IF_ERROR(spx_verify_msg_hash(
+            signature->data, msg_hash->digest, key->data, actual_root.data));
+        break;
+      }
       HARDENED_RETURN_IF_ERROR(spx_verify(
           signature->data, kSpxVerifyPureDomainSep, kSpxVerifyPureDomainSepSize,
           msg_prefix_1, msg_prefix_1_len, msg_prefix_2, msg_prefix_2_len, msg,
@@ -111,7 +116,9 @@ rom_error_t owner_verify(uint32_t key_alg, const owner_keydata_t *key,
                          const void *msg_prefix_1, size_t msg_prefix_1_len,
                          const void *msg_prefix_2, size_t msg_prefix_2_len,
                          const void *msg, size_t msg_len,
-                         const hmac_digest_t *digest, uint32_t *flash_exec) {
+                         const hmac_digest_t *digest,
+                         const hmac_digest_t *spx_msg_hash,
+                         uint32_t *flash_exec) {
   uint32_t ec_flash_exec = 0;
   uint32_t spx_flash_exec = 0;
   uint32_t category = key_alg & kOwnershipKeyAlgCategoryMask;
@@ -136,7 +143,7 @@ rom_error_t owner_verify(uint32_t key_alg, const owner_keydata_t *key,
         category == kOwnershipKeyAlgCategoryHybrid ? &key->hybrid.spx
                                                    : &key->spx,
         spx_sig, msg_prefix_1, msg_prefix_1_len, msg_prefix_2, msg_prefix_2_len,
-        msg, msg_len, *digest, &spx_flash_exec);
+        msg, msg_len, *digest, spx_msg_hash, &spx_flash_exec);
   } else {
     HARDENED_CHECK_EQ(category, kOwnershipKeyAlgCategoryEcdsa);
     spx = kErrorOk;
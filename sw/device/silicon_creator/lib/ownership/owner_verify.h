@@ -24,6 +24,10 @@
  * @param msg The SPX+ message to verify (if relevant).
  * @param msg_len The length of the msg.
  * @param digest The SHA256 digest over the data to verify.
+ * @param spx_msg_hash Optional SPX+ message hash for pure mode, computed over
+ *                     the domain separator, the prefixes and msg as described
+ *                     in `spx_verify_msg_start()`. If not NULL, it is used
+ *                     instead of hashing the message again.
  * @param flash_exec[out] The flash_exec password, if the verify succeeds.
  * @return kErrorOk if the verify succeeds, else an error code.
  */
@@ -33,6 +37,8 @@ rom_error_t owner_verify(uint32_t key_alg, const owner_keydata_t *key,
                          const void *msg_prefix_1, size_t msg_prefix_1_len,
                          const void *msg_prefix_2, size_t msg_prefix_2_len,
                          const void *msg, size_t msg_len,
-                         const hmac_digest_t *digest, uint32_t *flash_exec);
+                         const hmac_digest_t *digest,
+                         const hmac_digest_t *spx_msg_hash,
+                         uint32_t *flash_exec);
 
 #endif  // OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_OWNERSHIP_OWNER_VERIFY_H_
@@ -90,25 +90,26 @@ rom_error_t ownership_key_validate(size_t page, ownership_key_t key,
 
   if ((key & kOwnershipKeyUnlock) == kOwnershipKeyUnlock) {
     if (owner_verify(key_alg, &owner_page[page].unlock_key, ecdsa, spx, NULL, 0,
-                     NULL, 0, message, len, &digest, NULL) == kErrorOk) {
+                     NULL, 0, message, len, &digest, NULL, NULL) == kErrorOk) {
       return kErrorOk;
     }
   }
   if ((key & kOwnershipKeyActivate) == kOwnershipKeyActivate) {
     if (owner_verify(key_alg, &owner_page[page].activate_key, ecdsa, spx, NULL,
-                     0, NULL, 0, message, len, &digest, NULL) == kErrorOk) {
+                     0, NULL, 0, message, len, &digest, NULL,
+                     NULL) == kErrorOk) {
       return kErrorOk;
     }
   }
   if (kNoOwnerRecoveryKey &&
       (key & kOwnershipKeyRecovery) == kOwnershipKeyRecovery) {
     if (owner_verify(key_alg, kNoOwnerRecoveryKey, ecdsa, spx, NULL, 0, NULL, 0,
-                     message, len, &digest, NULL) == kErrorOk) {
+                     message, len, &digest, NULL, NULL) == kErrorOk) {
       return kErrorOk;
     }
   }
   if (owner_verify(key_alg, &owner_page[page].owner_key, ecdsa, spx, NULL, 0,
-                   NULL, 0, message, len, &digest, NULL) == kErrorOk) {
+                   NULL, 0, message, len, &digest, NULL, NULL) == kErrorOk) {
     return kErrorOk;
   }
   return kErrorOwnershipInvalidSignature;
@@ -26,7 +26,64 @@ const uint32_t kFlashPageSize = FLASH_CTRL_PARAM_BYTES_PER_PAGE;
 const uint32_t kFlashBankSize =
     kFlashPageSize * FLASH_CTRL_PARAM_REG_PAGES_PER_BANK;
 
+void rescue_flash_poll(rescue_state_t *state) {
+  if (state->flash_busy) {
+    bool done;
+    rom_error_t error = state->flash_erasing
+                            ? flash_ctrl_data_erase_poll(&done)
+                            : flash_ctrl_data_write_poll(&done);
+    if (!done) {
+      return;
+    }
+    state->flash_busy = false;
+    if (error != kErrorOk) {
+      // Drop the rest of the block; the error is reported by
+      // `rescue_flash_wait`.
+      if (state->flash_error == kErrorOk) {
+        state->flash_error = error;
+      }
+      state->flash_prog_addr = state->flash_prog_end;
+      state->flash_erase_limit = state->flash_erase_addr;
+      return;
+    }
+  }
+
+  if (state->flash_prog_addr < state->flash_prog_end &&
+      state->flash_prog_addr < state->flash_erase_addr) {
+    // Program the next window of the block.
+    const uint8_t *src = state->flash_src + sizeof(state->data) -
+                         (state->flash_prog_end - state->flash_prog_addr);
+    uint32_t word_count = flash_ctrl_data_write_start(
+        state->flash_prog_addr,
+        (state->flash_prog_end - state->flash_prog_addr) / sizeof(uint32_t),
+        src);
+    state->flash_prog_addr += word_count * sizeof(uint32_t);
+    state->flash_erasing = false;
+    state->flash_busy = true;
+  } else if (state->flash_erase_addr < state->flash_erase_limit &&
+             state->flash_erase_addr < state->flash_prog_end + kFlashPageSize) {
+    // Erase the page under the write pointer, or the one after the block so
+    // that it is ready before the next block arrives.
+    flash_ctrl_data_erase_start(state->flash_erase_addr,
+                                kFlashCtrlEraseTypePage);
+    state->flash_erase_addr += kFlashPageSize;
+    state->flash_erasing = true;
+    state->flash_busy = true;
+  }
+}
+
+rom_error_t rescue_flash_wait(rescue_state_t *state) {
+  do {
+    rescue_flash_poll(state);
+  } while (state->flash_busy);
+  rom_error_t error = state->flash_error;
+  state->flash_error = kErrorOk;
+  return error;
+}
+
 rom_error_t flash_firmware_block(rescue_state_t *state) {
+  // The previous block must be programmed before `flash_src` is reused.
+  HARDENED_RETURN_IF_ERROR(rescue_flash_wait(state));
   uint32_t bank_offset =
       state->mode == kRescueModeFirmwareSlotB ? kFlashBankSize : 0;
   if (state->flash_offset == 0) {
@@ -37,21 +94,29 @@ rom_error_t flash_firmware_block(rescue_state_t *state) {
         .write = kMultiBitBool4True,
         .erase = kMultiBitBool4True,
     });
-    for (uint32_t addr = state->flash_start; addr < state->flash_limit;
-         addr += kFlashPageSize) {
-      HARDENED_RETURN_IF_ERROR(
-          flash_ctrl_data_erase(bank_offset + addr, kFlashCtrlEraseTypePage));
-    }
+    // Pages are erased just ahead of the write pointer rather than all at
+    // once, so that erasing overlaps with receiving the image.
+    state->flash_erase_addr = bank_offset + state->flash_start;
+    state->flash_erase_limit = bank_offset + state->flash_limit;
     state->flash_offset = state->flash_start;
   }
-  if (state->flash_offset < state->flash_limit) {
-    HARDENED_RETURN_IF_ERROR(flash_ctrl_data_write(
-        bank_offset + state->flash_offset,
-        sizeof(state->data) / sizeof(uint32_t), state->data));
-    state->flash_offset += sizeof(state->data);
-  } else {
+  if (state->flash_offset >= state->flash_limit) {
     return kErrorRescueImageTooBig;
   }
+  if (state->flash_data != NULL) {
+    // `data` receives the next block while this one is programmed.
+    memcpy(state->flash_data, state->data, sizeof(state->data));
+    state->flash_src = state->flash_data;
+  } else {
+    state->flash_src = state->data;
+  }
+  state->flash_prog_addr = bank_offset + state->flash_offset;
+  state->flash_prog_end = state->flash_prog_addr + sizeof(state->data);
+  state->flash_offset += sizeof(state->data);
+  rescue_flash_poll(state);
+  if (state->flash_data == NULL) {
+    return rescue_flash_wait(state);
+  }
   return kErrorOk;
 }
 
@@ -95,6 +160,9 @@ static void ownership_erase(void) {
 
 rom_error_t rescue_validate_mode(uint32_t mode, rescue_state_t *state,
                                  boot_data_t *bootdata) {
+  // Other modes use the flash controller too, so finish programming any
+  // pending firmware block first.
+  HARDENED_RETURN_IF_ERROR(rescue_flash_wait(state));
   dbg_printf("\r\nmode: %C\r\n", bitfield_byteswap32(mode));
   rom_error_t result = kErrorOk;
 
@@ -271,6 +339,15 @@ rom_error_t rescue_recv_handler(rescue_state_t *state, boot_data_t *bootdata) {
 void rescue_state_init(rescue_state_t *state,
                        const owner_rescue_config_t *config) {
   state->config = config;
+  state->flash_data = NULL;
+  state->flash_busy = false;
+  state->flash_erasing = false;
+  state->flash_src = state->data;
+  state->flash_prog_addr = 0;
+  state->flash_prog_end = 0;
+  state->flash_erase_addr = 0;
+  state->flash_erase_limit = 0;
+  state->flash_error = kErrorOk;
   if ((hardened_bool_t)config == kHardenedBoolFalse) {
     HARDENED_CHECK_EQ((hardened_bool_t)config, kHardenedBoolFalse);
     // If there is no rescue config, then the rescue region starts immediately
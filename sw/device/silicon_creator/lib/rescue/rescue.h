@@ -14,6 +14,10 @@
 #include "sw/device/silicon_creator/lib/error.h"
 #include "sw/device/silicon_creator/lib/ownership/datatypes.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 enum {
   // Rescue is signalled by asserting serial break to the UART for at least
   // 4 byte periods.  At 115200 bps, one byte period is about 87us; four is
@@ -84,6 +88,26 @@ typedef struct RescueState {
   const owner_rescue_config_t *config;
   // Data buffer to hold xmodem upload data.
   uint8_t data[2048];
+  // Buffer for the firmware block being programmed while the next one is
+  // received into `data`, or NULL to program each block before
+  // `flash_firmware_block` returns. When set, the transport must call
+  // `rescue_flash_poll` while it waits for data and `rescue_flash_wait`
+  // before it finishes an upload. It must be as large as `data`.
+  uint8_t *flash_data;
+  // Block being programmed: `flash_data` when programming in the background,
+  // `data` otherwise.
+  const uint8_t *flash_src;
+  // Whether a flash transaction is in progress, and whether it is an erase.
+  bool flash_busy;
+  bool flash_erasing;
+  // Next flash address to program and end of the `flash_src` block.
+  uint32_t flash_prog_addr;
+  uint32_t flash_prog_end;
+  // End of the erased flash range and limit of the range to erase.
+  uint32_t flash_erase_addr;
+  uint32_t flash_erase_limit;
+  // First error reported by the background flash transactions.
+  rom_error_t flash_error;
 } rescue_state_t;
 
 /**
@@ -106,6 +130,36 @@ rom_error_t rescue_send_handler(rescue_state_t *state, boot_data_t *bootdata);
  */
 rom_error_t rescue_recv_handler(rescue_state_t *state, boot_data_t *bootdata);
 
+/**
+ * Advance background programming of the current firmware block.
+ *
+ * Lazily erases the page ahead of the write pointer and programs the block one
+ * program window at a time.  Each call does at most one step, so this can be
+ * called while waiting for the next block of data.
+ *
+ * @param state Rescue state
+ */
+void rescue_flash_poll(rescue_state_t *state);
+
+/**
+ * Wait for background programming of the current firmware block to finish.
+ *
+ * @param state Rescue state
+ * @return kErrorOk if the block was programmed, or the first flash error.
+ */
+rom_error_t rescue_flash_wait(rescue_state_t *state);
+
+/**
+ * Program the firmware block held in `data` at the current flash offset.
+ *
+ * If `flash_data` is set, the block is copied there and programmed in the
+ * background; otherwise this returns once the block is programmed.
+ *
+ * @param state Rescue state
+ * @return kErrorOk if the block was accepted, or an error.
+ */
+rom_error_t flash_firmware_block(rescue_state_t *state);
+
 /**
  * Validate a new rescue mode.
  *
@@ -154,4 +208,8 @@ rom_error_t rescue_protocol(boot_data_t *bootdata,
  */
 hardened_bool_t rescue_detect_entry(const owner_rescue_config_t *config);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif  // OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_RESCUE_RESCUE_H_
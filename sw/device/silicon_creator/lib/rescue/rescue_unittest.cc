@@ -0,0 +1,243 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/silicon_creator/lib/rescue/rescue.h"
+
+#include <algorithm>
+#include <stdint.h>
+
+#include "gtest/gtest.h"
+#include "sw/device/silicon_creator/lib/drivers/mock_flash_ctrl.h"
+#include "sw/device/silicon_creator/lib/error.h"
+#include "sw/device/silicon_creator/testing/rom_test.h"
+
+#include "hw/top/flash_ctrl_regs.h"
+
+namespace rescue_unittest {
+namespace {
+using ::testing::_;
+using ::testing::DoAll;
+using ::testing::InSequence;
+using ::testing::Return;
+using ::testing::SetArgPointee;
+
+constexpr uint32_t kPageSize = FLASH_CTRL_PARAM_BYTES_PER_PAGE;
+constexpr uint32_t kBlockSize = sizeof(rescue_state_t::data);
+// Words accepted by each `flash_ctrl_data_write_start()` call, so that a
+// block takes two program transactions.
+constexpr uint32_t kWindowWords = kBlockSize / sizeof(uint32_t) / 2;
+constexpr uint32_t kWindowSize = kWindowWords * sizeof(uint32_t);
+// The rescue region is two pages starting at page 8 of slot A.
+constexpr uint16_t kStartPage = 8;
+constexpr uint16_t kRegionPages = 2;
+constexpr uint32_t kStart = kStartPage * kPageSize;
+
+static_assert(kBlockSize == kPageSize,
+              "The tests assume that a block fills a flash page");
+
+// Not a fixture member because of its flexible array member.
+owner_rescue_config_t rescue_config;
+
+class RescueFlashTest : public rom_test::RomTest {
+ protected:
+  void SetUp() override {
+    rescue_config.start = kStartPage;
+    rescue_config.size = kRegionPages;
+    rescue_state_init(&state_, &rescue_config);
+    state_.mode = kRescueModeFirmware;
+    state_.flash_offset = 0;
+    for (uint32_t i = 0; i < kBlockSize; ++i) {
+      state_.data[i] = static_cast<uint8_t>(i);
+    }
+  }
+
+  /**
+   * Expects an erase of the page at `addr` that completes after
+   * `pending_polls` polls reporting that it is still running.
+   */
+  void ExpectErase(uint32_t addr, size_t pending_polls = 0,
+                   rom_error_t error = kErrorOk) {
+    EXPECT_CALL(flash_ctrl_, DataEraseStart(addr, kFlashCtrlEraseTypePage));
+    for (size_t i = 0; i < pending_polls; ++i) {
+      EXPECT_CALL(flash_ctrl_, DataErasePoll(_))
+          .WillOnce(DoAll(SetArgPointee<0>(false), Return(kErrorOk)));
+    }
+    EXPECT_CALL(flash_ctrl_, DataErasePoll(_))
+        .WillOnce(DoAll(SetArgPointee<0>(true), Return(error)));
+  }
+
+  /**
+   * Expects a program transaction of the words at `src` to `addr` that
+   * completes after `pending_polls` polls reporting that it is still running.
+   */
+  void ExpectWrite(uint32_t addr, const uint8_t *src, size_t pending_polls = 0,
+                   rom_error_t error = kErrorOk) {
+    // Each transaction is asked to program the rest of the block.
+    uint32_t word_count =
+        (kBlockSize - (addr - kStart) % kBlockSize) / sizeof(uint32_t);
+    EXPECT_CALL(flash_ctrl_, DataWriteStart(addr, word_count, src))
+        .WillOnce(Return(std::min(word_count, kWindowWords)));
+    for (size_t i = 0; i < pending_polls; ++i) {
+      EXPECT_CALL(flash_ctrl_, DataWritePoll(_))
+          .WillOnce(DoAll(SetArgPointee<0>(false), Return(kErrorOk)));
+    }
+    EXPECT_CALL(flash_ctrl_, DataWritePoll(_))
+        .WillOnce(DoAll(SetArgPointee<0>(true), Return(error)));
+  }
+
+  rom_test::MockFlashCtrl flash_ctrl_;
+  rescue_state_t state_;
+  uint8_t flash_data_[kBlockSize];
+};
+
+TEST_F(RescueFlashTest, ProgramsBlockBeforeReturning) {
+  InSequence seq;
+  EXPECT_CALL(flash_ctrl_, DataDefaultPermsSet(_));
+  ExpectErase(kStart);
+  ExpectWrite(kStart, state_.data);
+  ExpectWrite(kStart + kWindowSize, state_.data + kWindowSize);
+  // The next page is erased ahead of the write pointer.
+  ExpectErase(kStart + kPageSize);
+
+  EXPECT_EQ(flash_firmware_block(&state_), kErrorOk);
+  EXPECT_FALSE(state_.flash_busy);
+}
+
+TEST_F(RescueFlashTest, ErasesAheadOfEachBlock) {
+  state_.flash_data = flash_data_;
+  InSequence seq;
+  EXPECT_CALL(flash_ctrl_, DataDefaultPermsSet(_));
+  // Programming the first page waits for it to be erased.
+  ExpectErase(kStart, /*pending_polls=*/2);
+  ExpectWrite(kStart, flash_data_);
+  ExpectWrite(kStart + kWindowSize, flash_data_ + kWindowSize);
+  ExpectErase(kStart + kPageSize);
+  // The second page was erased while the host sent the block, so it is
+  // programmed right away. There is no page left to erase ahead of it.
+  ExpectWrite(kStart + kPageSize, flash_data_);
+  ExpectWrite(kStart + kPageSize + kWindowSize, flash_data_ + kWindowSize);
+
+  EXPECT_EQ(flash_firmware_block(&state_), kErrorOk);
+  EXPECT_TRUE(state_.flash_busy);
+  EXPECT_EQ(state_.flash_erase_addr, kStart + kPageSize);
+  EXPECT_EQ(state_.flash_prog_addr, kStart);
+  // Two polls while the erase runs, one to finish it and start programming,
+  // and two to finish the program transactions.
+  for (int i = 0; i < 5; ++i) {
+    rescue_flash_poll(&state_);
+  }
+  EXPECT_TRUE(state_.flash_busy);
+  EXPECT_EQ(state_.flash_erase_addr, kStart + 2 * kPageSize);
+
+  EXPECT_EQ(flash_firmware_block(&state_), kErrorOk);
+  EXPECT_EQ(rescue_flash_wait(&state_), kErrorOk);
+  EXPECT_FALSE(state_.flash_busy);
+  EXPECT_EQ(state_.flash_erase_addr, kStart + 2 * kPageSize);
+  EXPECT_EQ(state_.flash_prog_addr, kStart + 2 * kPageSize);
+}
+
+TEST_F(RescueFlashTest, HoldsProgrammingUntilPageIsErased) {
+  state_.flash_data = flash_data_;
+  InSequence seq;
+  EXPECT_CALL(flash_ctrl_, DataDefaultPermsSet(_));
+  ExpectErase(kStart, /*pending_polls=*/3);
+
+  EXPECT_EQ(flash_firmware_block(&state_), kErrorOk);
+  // The strict mock fails if programming starts while the erase is running.
+  for (int i = 0; i < 3; ++i) {
+    rescue_flash_poll(&state_);
+    EXPECT_TRUE(state_.flash_busy);
+    EXPECT_TRUE(state_.flash_erasing);
+    EXPECT_EQ(state_.flash_prog_addr, kStart);
+  }
+
+  ExpectWrite(kStart, flash_data_);
+  rescue_flash_poll(&state_);
+  EXPECT_FALSE(state_.flash_erasing);
+  EXPECT_EQ(state_.flash_prog_addr, kStart + kWindowSize);
+
+  ExpectWrite(kStart + kWindowSize, flash_data_ + kWindowSize);
+  ExpectErase(kStart + kPageSize);
+  EXPECT_EQ(rescue_flash_wait(&state_), kErrorOk);
+}
+
+TEST_F(RescueFlashTest, CopiesBlockForBackgroundProgramming) {
+  state_.flash_data = flash_data_;
+  InSequence seq;
+  EXPECT_CALL(flash_ctrl_, DataDefaultPermsSet(_));
+  EXPECT_CALL(flash_ctrl_, DataEraseStart(kStart, kFlashCtrlEraseTypePage));
+
+  EXPECT_EQ(flash_firmware_block(&state_), kErrorOk);
+  EXPECT_EQ(state_.flash_src, flash_data_);
+  EXPECT_TRUE(std::equal(state_.data, state_.data + kBlockSize, flash_data_));
+  // `data` is free to receive the next block.
+  std::fill_n(state_.data, kBlockSize, 0xff);
+  EXPECT_EQ(flash_data_[1], 1);
+}
+
+TEST_F(RescueFlashTest, WaitFinishesLastBlockAtEof) {
+  state_.flash_data = flash_data_;
+  InSequence seq;
+  EXPECT_CALL(flash_ctrl_, DataDefaultPermsSet(_));
+  ExpectErase(kStart);
+
+  // Only the erase is started before the block is acknowledged.
+  EXPECT_EQ(flash_firmware_block(&state_), kErrorOk);
+
+  ExpectWrite(kStart, flash_data_, /*pending_polls=*/1);
+  ExpectWrite(kStart + kWindowSize, flash_data_ + kWindowSize);
+  ExpectErase(kStart + kPageSize, /*pending_polls=*/1);
+  EXPECT_EQ(rescue_flash_wait(&state_), kErrorOk);
+  EXPECT_FALSE(state_.flash_busy);
+  EXPECT_EQ(state_.flash_prog_addr, state_.flash_prog_end);
+}
+
+TEST_F(RescueFlashTest, EraseErrorSkipsBlock) {
+  state_.flash_data = flash_data_;
+  InSequence seq;
+  EXPECT_CALL(flash_ctrl_, DataDefaultPermsSet(_));
+  ExpectErase(kStart, /*pending_polls=*/1, kErrorFlashCtrlDataErase);
+
+  EXPECT_EQ(flash_firmware_block(&state_), kErrorOk);
+  rescue_flash_poll(&state_);
+  rescue_flash_poll(&state_);
+  // Neither the block nor the next page is touched after the error.
+  rescue_flash_poll(&state_);
+  EXPECT_FALSE(state_.flash_busy);
+  EXPECT_EQ(rescue_flash_wait(&state_), kErrorFlashCtrlDataErase);
+  // The error is reported once.
+  EXPECT_EQ(rescue_flash_wait(&state_), kErrorOk);
+}
+
+TEST_F(RescueFlashTest, WriteErrorFailsNextBlock) {
+  state_.flash_data = flash_data_;
+  InSequence seq;
+  EXPECT_CALL(flash_ctrl_, DataDefaultPermsSet(_));
+  ExpectErase(kStart);
+  ExpectWrite(kStart, flash_data_, /*pending_polls=*/0,
+              kErrorFlashCtrlDataWrite);
+
+  EXPECT_EQ(flash_firmware_block(&state_), kErrorOk);
+  rescue_flash_poll(&state_);
+  rescue_flash_poll(&state_);
+  // The second program window and the erase of the next page are dropped, and
+  // the error fails the next block before it is programmed.
+  EXPECT_EQ(flash_firmware_block(&state_), kErrorFlashCtrlDataWrite);
+  EXPECT_FALSE(state_.flash_busy);
+  EXPECT_EQ(state_.flash_erase_addr, kStart + kPageSize);
+}
+
+TEST_F(RescueFlashTest, SynchronousWriteErrorFailsBlock) {
+  InSequence seq;
+  EXPECT_CALL(flash_ctrl_, DataDefaultPermsSet(_));
+  ExpectErase(kStart);
+  ExpectWrite(kStart, state_.data, /*pending_polls=*/1,
+              kErrorFlashCtrlDataWrite);
+
+  EXPECT_EQ(flash_firmware_block(&state_), kErrorFlashCtrlDataWrite);
+  EXPECT_FALSE(state_.flash_busy);
+}
+
+}  // namespace
+}  // namespace rescue_unittest
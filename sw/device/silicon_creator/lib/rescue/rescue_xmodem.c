@@ -12,9 +12,19 @@
 #include "sw/device/silicon_creator/lib/rescue/xmodem.h"
 
 // All of the xmodem functions accept an opaque iohandle pointer.
-// The iohandle is used to facilitate unit tests and doesn't have
-// any function in real firmware.
-#define iohandle NULL
+// In firmware, it carries the hook that keeps programming flash in the
+// background while waiting for the host.
+static xmodem_io_t xmodem_io;
+#define iohandle (&xmodem_io)
+
+// Firmware block being programmed while the host sends the next one. Only
+// xmodem programs in the background, so the rescue state of the other
+// transports doesn't carry this buffer.
+static uint8_t flash_data[2048];
+static_assert(sizeof(flash_data) == sizeof(((rescue_state_t *)NULL)->data),
+              "The flash buffer must hold a full rescue data block");
+
+static void flash_poll(void *arg) { rescue_flash_poll((rescue_state_t *)arg); }
 
 static void change_speed(void) {
   dbg_printf("ok: waiting for baudrate\r\n");
@@ -117,6 +127,8 @@ static rom_error_t protocol(rescue_state_t *state, boot_data_t *bootdata) {
           }
           HARDENED_RETURN_IF_ERROR(handle_recv_modes(state, bootdata));
         }
+        // Make sure the whole upload is in flash before acknowledging it.
+        HARDENED_RETURN_IF_ERROR(rescue_flash_wait(state));
         xmodem_ack(iohandle, true);
         if (!state->reboot) {
           state->frame = 1;
@@ -152,7 +164,16 @@ rom_error_t rescue_protocol(boot_data_t *bootdata,
                             const owner_rescue_config_t *config) {
   rescue_state_t rescue_state;
   rescue_state_init(&rescue_state, config);
+  // Firmware blocks are acknowledged as soon as they are received and
+  // programmed while the host sends the next ones.
+  rescue_state.flash_data = flash_data;
+  xmodem_io = (xmodem_io_t){
+      .idle = flash_poll,
+      .arg = &rescue_state,
+  };
   rom_error_t result = protocol(&rescue_state, bootdata);
+  // Don't leave a flash transaction running if the upload was aborted.
+  OT_DISCARD(rescue_flash_wait(&rescue_state));
   if (result == kErrorRescueReboot) {
     rstmgr_reset();
   }
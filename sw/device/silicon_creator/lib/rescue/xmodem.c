@@ -26,12 +26,18 @@ enum {
   kXModemMaxErrors = 2,
   kXModemShortTimeout = 100,
   kXModemLongTimeout = 1000,
+  // Payload bytes received between CRC updates.  Both frame sizes are a
+  // multiple of it.
+  kXModemRecvChunk = 128,
 };
 
 #ifndef XMODEM_TESTLIB
 size_t xmodem_read(void *iohandle, uint8_t *data, size_t len,
                    uint32_t timeout_ms) {
-  (void)iohandle;
+  const xmodem_io_t *io = (const xmodem_io_t *)iohandle;
+  if (io != NULL && io->idle != NULL) {
+    return uart_read_with_idle(data, len, timeout_ms, io->idle, io->arg);
+  }
   return uart_read(data, len, timeout_ms);
 }
 
@@ -45,31 +51,72 @@ void xmodem_putchar(void *iohandle, uint8_t ch) {
   xmodem_write(iohandle, &ch, sizeof(ch));
 }
 
+/**
+ * CRC-16 of each nibble value, for the XModem polynomial.
+ *
+ * A nibble table is 32 bytes, versus 512 bytes for a byte table, and still
+ * processes a byte in two table steps instead of eight shift steps.
+ */
+static const uint16_t kCrc16NibbleTable[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
+    0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef,
+};
+
+/**
+ * x^(8 * 2^i) mod the XModem polynomial.
+ *
+ * Appending `n` zero bytes to a message multiplies its CRC by x^(8 * n), so
+ * the CRC of the padding of a block can be computed from these powers instead
+ * of byte by byte.
+ */
+static const uint16_t kCrc16ZeroPadPowers[] = {
+    0x0100, 0x1021, 0x3730, 0xb861, 0xaefc,
+    0x8e29, 0x13fc, 0x36c4, 0xfd50, 0xaa9e,
+};
+// A short block is padded to a 128-byte frame, so `crc16_block` needs a power
+// for every bit of a padding length of up to 127 bytes.
+static_assert((1u << ARRAYSIZE(kCrc16ZeroPadPowers)) - 1 >= 128 - 1,
+              "kCrc16ZeroPadPowers must cover the padding of a 128-byte frame");
+
 /**
  * Calculates a CRC-16 using the XModem polynomial.
  */
 static uint16_t crc16(uint16_t crc, const void *buf, size_t len) {
   const uint8_t *p = (const uint8_t *)buf;
   for (size_t i = 0; i < len; ++i, ++p) {
-    crc ^= *p << 8;
-    for (size_t j = 0; j < 8; ++j) {
-      bool msb = (crc & 0x8000) != 0;
-      crc <<= 1;
-      if (msb)
-        crc ^= kXModemPoly;
-    }
+    crc = (uint16_t)(crc << 4) ^
+          kCrc16NibbleTable[((crc >> 12) ^ (*p >> 4)) & 0xf];
+    crc = (uint16_t)(crc << 4) ^
+          kCrc16NibbleTable[((crc >> 12) ^ (*p & 0xf)) & 0xf];
   }
   return crc;
 }
 
+/**
+ * Multiplies two polynomials modulo the XModem polynomial.
+ */
+static uint16_t crc16_mulmod(uint16_t a, uint16_t b) {
+  uint16_t r = 0;
+  for (size_t i = 16; i > 0; --i) {
+    bool msb = (r & 0x8000) != 0;
+    r <<= 1;
+    if (msb)
+      r ^= kXModemPoly;
+    if ((b >> (i - 1)) & 1)
+      r ^= a;
+  }
+  return r;
+}
+
 /**
  * Calculate an XModem CRC16 for a to-be-transmitted block.
  */
 static uint16_t crc16_block(const void *buf, size_t len, size_t block_sz) {
   uint16_t crc = crc16(0, buf, len);
-  uint8_t pad = 0;
-  for (; len < block_sz; ++len) {
-    crc = crc16(crc, &pad, 1);
+  size_t pad = block_sz - len;
+  for (size_t i = 0; pad != 0; ++i, pad >>= 1) {
+    if (pad & 1)
+      crc = crc16_mulmod(crc, kCrc16ZeroPadPowers[i]);
   }
   return crc;
 }
@@ -107,12 +154,18 @@ rom_error_t xmodem_recv_frame(void *iohandle, uint32_t frame, uint8_t *data,
     // If the frame or its inverse are incorrect, cancel.
     bool cancel = pkt[0] != (uint8_t)frame || pkt[0] != 255 - pkt[1];
 
-    // Receive the data.  At 115200 bps, 1K should take about 89ms to
-    // receive a 1K frame.  A short timeout should be enough, but we'll
-    // be generous and give more time.
-    n = xmodem_read(iohandle, data, len, kXModemShortTimeout * 3);
-    if (n != len) {
-      return kErrorXModemTimeoutData;
+    // Receive the data straight into the caller's buffer, computing the CRC
+    // of each chunk while the UART receives the next one.  At 115200 bps, a
+    // chunk should take about 11ms to receive.  The timeout applies to each
+    // chunk rather than to the whole frame, and is generous.
+    uint16_t val = 0;
+    for (size_t offset = 0; offset < len; offset += kXModemRecvChunk) {
+      n = xmodem_read(iohandle, data + offset, kXModemRecvChunk,
+                      kXModemShortTimeout * 3);
+      if (n != kXModemRecvChunk) {
+        return kErrorXModemTimeoutData;
+      }
+      val = crc16(val, data + offset, kXModemRecvChunk);
     }
 
     // Receive the CRC-16 from the client.
@@ -127,7 +180,6 @@ rom_error_t xmodem_recv_frame(void *iohandle, uint32_t frame, uint8_t *data,
 
     // Compute our own CRC-16 and compare with the client's value.
     uint16_t crc = (uint16_t)(pkt[0] << 8 | pkt[1]);
-    uint16_t val = crc16(0, data, len);
     if (crc != val) {
       return kErrorXModemCrc;
     }
@@ -10,6 +10,22 @@
 #include "sw/device/lib/base/hardened.h"
 #include "sw/device/silicon_creator/lib/error.h"
 
+/**
+ * I/O handle used by the firmware implementation of xmodem.
+ *
+ * A NULL iohandle is equivalent to a handle without an idle function.
+ */
+typedef struct xmodem_io {
+  /**
+   * Called while waiting for data from the host (may be NULL).
+   */
+  void (*idle)(void *arg);
+  /**
+   * Argument passed to `idle`.
+   */
+  void *arg;
+} xmodem_io_t;
+
 /**
  * Send the Xmodem-CRC start sequence.
  *
@@ -71,6 +71,61 @@ static uint32_t shift_left(sigverify_rsa_buffer_t *a) {
   return msb;
 }
 
+#ifdef OT_PLATFORM_RV32
+/**
+ * Processes the digit `x_i` of `x` in Montgomery multiplication.
+ *
+ * Hand-scheduled RV32IM implementation of `mont_mul_row()` below, see
+ * `mod_exp_ibex_mont_mul.S`.
+ */
+uint32_t mod_exp_ibex_mont_mul_row(uint32_t *result, const uint32_t *y,
+                                   const uint32_t *n, uint32_t x_i,
+                                   uint32_t n0_inv, size_t num_words);
+#define mont_mul_row mod_exp_ibex_mont_mul_row
+#else
+/**
+ * Processes the digit `x_i` of `x` in Montgomery multiplication.
+ *
+ * Computes `result = (result + x_i * y + u * n) / 2^32`, i.e. step 2 of the
+ * algorithm referenced in `mont_mul()`.
+ *
+ * @param[in,out] result Intermediate result, little-endian.
+ * @param y Buffer that holds `y`, little-endian.
+ * @param n Modulus, little-endian.
+ * @param x_i Digit of `x` to process.
+ * @param n0_inv -n^-1 mod 2^32.
+ * @param num_words Number of words in each buffer.
+ * @return Carry out of the most significant word of `result`.
+ */
+static uint32_t mont_mul_row(uint32_t *result, const uint32_t *y,
+                             const uint32_t *n, uint32_t x_i, uint32_t n0_inv,
+                             size_t num_words) {
+  // The loop below reads one word ahead of writes to avoid a separate loop
+  // for the division by `b` in step 2.2 of the algorithm. Thus, `acc0` and
+  // `acc1` are initialized here before the loop. `acc0` holds the sum of
+  // first two addends in step 2.2 while `acc1` holds the entire sum. Carries
+  // of these operations are stored separately in the upper words of `acc0`
+  // and `acc1`. `acc0` and `acc1` can safely store these intermediate values,
+  // i.e. without wrapping, because UINT32_MAX^2 + 2*UINT32_MAX is
+  // 0xffff_ffff_ffff_ffff.
+
+  // Holds the sum of the first two addends in step 2.2.
+  uint64_t acc0 = (uint64_t)x_i * y[0] + result[0];
+  const uint32_t u_i = (uint32_t)acc0 * n0_inv;
+  // Holds the sum of the all three addends in step 2.2.
+  uint64_t acc1 = (uint64_t)u_i * n[0] + (uint32_t)acc0;
+
+  for (size_t j = 1; j < num_words; ++j) {
+    acc0 = (uint64_t)x_i * y[j] + result[j] + (acc0 >> 32);
+    acc1 = (uint64_t)u_i * n[j] + (uint32_t)acc0 + (acc1 >> 32);
+    result[j - 1] = (uint32_t)acc1;
+  }
+  acc0 = (acc0 >> 32) + (acc1 >> 32);
+  result[num_words - 1] = (uint32_t)acc0;
+  return (uint32_t)(acc0 >> 32);
+}
+#endif
+
 /**
  * Computes the Montgomery reduction of the product of two integers.
  *
@@ -94,40 +149,21 @@ static void mont_mul(const sigverify_rsa_key_t *key,
   memset(result->data, 0, sizeof(result->data));
 
   for (size_t i = 0; i < ARRAYSIZE(x->data); ++i) {
-    // The loop below reads one word ahead of writes to avoid a separate loop
-    // for the division by `b` in step 2.2 of the algorithm. Thus, `acc0` and
-    // `acc1` are initialized here before the loop. `acc0` holds the sum of
-    // first two addends in step 2.2 while `acc1` holds the entire sum. Carries
-    // of these operations are stored separately in the upper words of `acc0`
-    // and `acc1`. `acc0` and `acc1` can safely store these intermediate values,
-    // i.e. without wrapping, because UINT32_MAX^2 + 2*UINT32_MAX is
-    // 0xffff_ffff_ffff_ffff.
-
-    // Holds the sum of the first two addends in step 2.2.
-    uint64_t acc0 = (uint64_t)x->data[i] * y->data[0] + result->data[0];
-    const uint32_t u_i = (uint32_t)acc0 * key->n0_inv[0];
-    // Holds the sum of the all three addends in step 2.2.
-    uint64_t acc1 = (uint64_t)u_i * key->n.data[0] + (uint32_t)acc0;
-
     // Process the i^th digit of `x`, i.e. `x[i]`.
-    for (size_t j = 1; j < ARRAYSIZE(result->data); ++j) {
-      acc0 = (uint64_t)x->data[i] * y->data[j] + result->data[j] + (acc0 >> 32);
-      acc1 = (uint64_t)u_i * key->n.data[j] + (uint32_t)acc0 + (acc1 >> 32);
-      result->data[j - 1] = (uint32_t)acc1;
-    }
-    acc0 = (acc0 >> 32) + (acc1 >> 32);
-    result->data[ARRAYSIZE(result->data) - 1] = (uint32_t)acc0;
+    uint32_t carry =
+        mont_mul_row(result->data, y->data, key->n.data, x->data[i],
+                     key->n0_inv[0], ARRAYSIZE(result->data));
 
     // The intermediate result of this algorithm before the check below is
     // bounded by R + n (Eq. (4) in Montgomery Arithmetic from a Software
     // Perspective, Bos. J. W, Montgomery, P. L.) where n is the modulus of
     // `key` and n < R. Therefore, if there is a carry, then `result` is not the
-    // least non-negative residue of x*y*R^-1 mod n. Since `acc0 >> 32` here is
-    // at most 1, we can subtract the modulus from `result` without taking it
-    // into account and fit `result` into `kSigVerifyRsaNumWords`. Since this is
+    // least non-negative residue of x*y*R^-1 mod n. Since `carry` is at most 1,
+    // we can subtract the modulus from `result` without taking it into
+    // account and fit `result` into `kSigVerifyRsaNumWords`. Since this is
     // not a direct comparison with the modulus, the final result is not
     // guaranteed to be the least non-negative residue of x*y*R^-1 mod n.
-    if (acc0 >> 32) {
+    if (carry) {
       OT_DISCARD(subtract_modulus(key, result));
     }
   }
@@ -167,6 +203,24 @@ static void calc_r_square(const sigverify_rsa_key_t *key,
   }
 }
 
+/**
+ * Checks whether `key` carries a precomputed R^2 mod n.
+ *
+ * R^2 mod n is never zero since n is odd, so a zero value marks keys that
+ * were provisioned without it.
+ *
+ * @param key An RSA public key.
+ * @return Whether `key->rr` is set.
+ */
+OT_WARN_UNUSED_RESULT
+static bool rr_is_precomputed(const sigverify_rsa_key_t *key) {
+  uint32_t acc = 0;
+  for (size_t i = 0; i < ARRAYSIZE(key->rr.data); ++i) {
+    acc |= key->rr.data[i];
+  }
+  return acc != 0;
+}
+
 rom_error_t sigverify_mod_exp_ibex(const sigverify_rsa_key_t *key,
                                    const sigverify_rsa_buffer_t *sig,
                                    sigverify_rsa_buffer_t *result) {
@@ -178,10 +232,14 @@ rom_error_t sigverify_mod_exp_ibex(const sigverify_rsa_key_t *key,
 
   sigverify_rsa_buffer_t buf;
 
-  // result = R^2 mod n
-  calc_r_square(key, result);
   // buf = sig * R mod n
-  mont_mul(key, sig, result, &buf);
+  if (rr_is_precomputed(key)) {
+    mont_mul(key, sig, &key->rr, &buf);
+  } else {
+    // result = R^2 mod n
+    calc_r_square(key, result);
+    mont_mul(key, sig, result, &buf);
+  }
   for (size_t i = 0; i < 8; ++i) {
     // result = sig^{2*4^i} * R mod n (sig's exponent: 2, 8, 32, ..., 32768)
     mont_mul(key, &buf, &buf, result);
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/runtime/ibex.h"
 #include "sw/device/lib/testing/test_framework/ottf_main.h"
 #include "sw/device/silicon_creator/lib/base/sec_mmio.h"
 #include "sw/device/silicon_creator/lib/sigverify/mod_exp_ibex.h"
@@ -50,6 +51,31 @@ rom_error_t sigverify_mod_exp_ibex_test(void) {
   return kErrorOk;
 }
 
+/**
+ * Returns the number of cycles `sigverify_mod_exp_ibex()` takes for `key`.
+ */
+static uint32_t mod_exp_ibex_cycles(const sigverify_rsa_key_t *key,
+                                    const sigverify_rsa_buffer_t *sig) {
+  sigverify_rsa_buffer_t recovered_message;
+  uint64_t start = ibex_mcycle_read();
+  OT_DISCARD(sigverify_mod_exp_ibex(key, sig, &recovered_message));
+  uint64_t end = ibex_mcycle_read();
+  CHECK(end - start <= UINT32_MAX, "Cycle count must fit in uint32_t");
+  return (uint32_t)(end - start);
+}
+
+rom_error_t sigverify_mod_exp_ibex_benchmark(void) {
+  const sigverify_test_vector_t *testvec = &sigverify_tests[0];
+  sigverify_rsa_key_t key = testvec->key;
+
+  LOG_INFO("sigverify_mod_exp_ibex() took %u cycles with precomputed R^2",
+           mod_exp_ibex_cycles(&key, &testvec->sig));
+  memset(key.rr.data, 0, sizeof(key.rr.data));
+  LOG_INFO("sigverify_mod_exp_ibex() took %u cycles without precomputed R^2",
+           mod_exp_ibex_cycles(&key, &testvec->sig));
+  return kErrorOk;
+}
+
 OTTF_DEFINE_TEST_CONFIG();
 
 bool test_main(void) {
@@ -57,6 +83,7 @@ bool test_main(void) {
 
   // The definition of `RULE_NAME` comes from the autogen Bazel rule.
   LOG_INFO("Starting mod_exp_ibex_functest:%s", RULE_NAME);
+  EXECUTE_TEST(result, sigverify_mod_exp_ibex_benchmark);
   for (uint32_t i = 0; i < SIGVERIFY_NUM_TESTS; i++) {
     LOG_INFO("Starting test vector %d of %d...", i + 1, SIGVERIFY_NUM_TESTS);
     test_index = i;
@@ -54,6 +54,14 @@ typedef struct sigverify_rsa_key {
    * first word, which is equal to -n^-1 mod 2^32.
    */
   uint32_t n0_inv[8];
+  /**
+   * R^2 mod n, where R = 2^`kSigVerifyRsaNumBits`, little-endian.
+   *
+   * Precomputed Montgomery constant used by `sigverify_mod_exp_ibex()`. Keys
+   * that leave this all zero fall back to computing it at runtime, which is
+   * considerably slower.
+   */
+  sigverify_rsa_buffer_t rr;
 } sigverify_rsa_key_t;
 
 /**
@@ -31,6 +31,40 @@ extern "C" {
 OT_WARN_UNUSED_RESULT
 rom_error_t spx_hash_initialize(spx_ctx_t *ctx);
 
+/**
+ * Starts the inner hash of H_msg.
+ *
+ * Starts a new SHA-256 operation on the HMAC block and sends it R and the
+ * public key. The caller sends the message, and then passes the digest to
+ * `spx_hash_message_finish()`. This allows the message to be hashed in a
+ * single pass together with other data, using `hmac_sha256_save()` and
+ * `hmac_sha256_restore()` to switch between the operations.
+ *
+ * The HMAC block must be configured for big-endian digests, see
+ * `spx_hash_initialize()`.
+ *
+ * @param R Per-signature random number.
+ * @param pk Public key.
+ */
+void spx_hash_message_start(const uint32_t *R, const uint32_t *pk);
+
+/**
+ * Derives the message digest and leaf index from the inner hash of H_msg.
+ *
+ * @param R Per-signature random number.
+ * @param pk Public key.
+ * @param msg_hash Big-endian SHA-256 digest of R, the public key, and the
+ *                 message, see `spx_hash_message_start()`.
+ * @param[out] digest Output buffer for message digest.
+ * @param[out] tree Tree index.
+ * @param[out] leaf_idx Leaf index.
+ * @return Error code indicating if the operation succeeded.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t spx_hash_message_finish(const uint32_t *R, const uint32_t *pk,
+                                    const uint32_t *msg_hash, uint8_t *digest,
+                                    uint64_t *tree, uint32_t *leaf_idx);
+
 /**
  * Hash the input message and derive the leaf index.
  *
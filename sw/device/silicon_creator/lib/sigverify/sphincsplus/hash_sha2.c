@@ -62,25 +62,22 @@ inline rom_error_t spx_hash_initialize(spx_ctx_t *ctx) {
   return kErrorOk;
 }
 
-rom_error_t spx_hash_message(
-    const uint32_t *R, const uint32_t *pk, const uint8_t *msg_prefix_1,
-    size_t msg_prefix_1_len, const uint8_t *msg_prefix_2,
-    size_t msg_prefix_2_len, const uint8_t *msg_prefix_3,
-    size_t msg_prefix_3_len, const uint8_t *msg, size_t msg_len,
-    uint8_t *digest, uint64_t *tree, uint32_t *leaf_idx) {
+void spx_hash_message_start(const uint32_t *R, const uint32_t *pk) {
+  hmac_sha256_start();
+  hmac_sha256_update_words(R, kSpxNWords);
+  hmac_sha256_update_words(pk, kSpxPkWords);
+}
+
+rom_error_t spx_hash_message_finish(const uint32_t *R, const uint32_t *pk,
+                                    const uint32_t *msg_hash, uint8_t *digest,
+                                    uint64_t *tree, uint32_t *leaf_idx) {
+  static_assert(kSpxDigestWords * sizeof(uint32_t) <= sizeof(hmac_digest_t),
+                "The message digest must fit in a SHA-256 digest.");
   uint32_t seed[kSpxDigestWords + (2 * kSpxNWords)] = {0};
   // H_msg: MGF1-SHA256(R || PK.seed || SHA256(R || PK.seed || PK.root || M))
   memcpy(seed, R, kSpxN);
   memcpy(&seed[kSpxNWords], pk, kSpxN);
-  hmac_sha256_start();
-  hmac_sha256_update_words(R, kSpxNWords);
-  hmac_sha256_update_words(pk, kSpxPkWords);
-  hmac_sha256_update(msg_prefix_1, msg_prefix_1_len);
-  hmac_sha256_update(msg_prefix_2, msg_prefix_2_len);
-  hmac_sha256_update(msg_prefix_3, msg_prefix_3_len);
-  hmac_sha256_update(msg, msg_len);
-  hmac_sha256_process();
-  hmac_sha256_final_truncated(&seed[2 * kSpxNWords], kSpxDigestWords);
+  memcpy(&seed[2 * kSpxNWords], msg_hash, kSpxDigestWords * sizeof(uint32_t));
 
   uint32_t buf[kSpxDigestWords] = {0};
   mgf1_sha256(seed, ARRAYSIZE(seed), ARRAYSIZE(buf), buf);
@@ -102,3 +99,20 @@ rom_error_t spx_hash_message(
 
   return kErrorOk;
 }
+
+rom_error_t spx_hash_message(
+    const uint32_t *R, const uint32_t *pk, const uint8_t *msg_prefix_1,
+    size_t msg_prefix_1_len, const uint8_t *msg_prefix_2,
+    size_t msg_prefix_2_len, const uint8_t *msg_prefix_3,
+    size_t msg_prefix_3_len, const uint8_t *msg, size_t msg_len,
+    uint8_t *digest, uint64_t *tree, uint32_t *leaf_idx) {
+  spx_hash_message_start(R, pk);
+  hmac_sha256_update(msg_prefix_1, msg_prefix_1_len);
+  hmac_sha256_update(msg_prefix_2, msg_prefix_2_len);
+  hmac_sha256_update(msg_prefix_3, msg_prefix_3_len);
+  hmac_sha256_update(msg, msg_len);
+  hmac_sha256_process();
+  uint32_t msg_hash[kSpxDigestWords];
+  hmac_sha256_final_truncated(msg_hash, kSpxDigestWords);
+  return spx_hash_message_finish(R, pk, msg_hash, digest, tree, leaf_idx);
+}
@@ -0,0 +1,140 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Software model of the silicon_creator HMAC driver for host builds.
+//
+// Implements the SHA-256 subset of `drivers/hmac.h` that the SPHINCS+
+// verification code uses, including `hmac_sha256_save()` and
+// `hmac_sha256_restore()`, so that the unmodified device sources can run on
+// the host. The SHA-256 compression function comes from `host_sha256.h`.
+// HMAC (keyed) mode is not modelled.
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sw/device/silicon_creator/lib/drivers/hmac.h"
+#include "sw/device/silicon_creator/lib/sigverify/sphincsplus/host_sha256.h"
+
+/**
+ * State of the modelled HMAC block.
+ */
+static struct {
+  bool big_endian_digest;
+  uint32_t state[kSpxHostSha256StateWords];
+  uint64_t msg_len_bytes;
+  uint8_t block[kSpxHostSha256BlockBytes];
+  size_t block_len;
+} hmac;
+
+void sc_hmac_hmac_sha256_configure(bool big_endian_digest, hmac_key_t key) {
+  // HMAC mode is not modelled.
+  (void)big_endian_digest;
+  (void)key;
+  abort();
+}
+
+void sc_hmac_hmac_sha256(const void *data, size_t len, hmac_key_t key,
+                         bool big_endian_digest, hmac_digest_t *digest) {
+  (void)data;
+  (void)len;
+  (void)digest;
+  sc_hmac_hmac_sha256_configure(big_endian_digest, key);
+}
+
+void hmac_sha256_configure(bool big_endian_digest) {
+  hmac.big_endian_digest = big_endian_digest;
+}
+
+void hmac_sha256_start(void) {
+  memcpy(hmac.state, kSpxHostSha256Iv, sizeof(hmac.state));
+  hmac.msg_len_bytes = 0;
+  hmac.block_len = 0;
+}
+
+void hmac_sha256_update(const void *data, size_t len) {
+  const uint8_t *bytes = (const uint8_t *)data;
+  hmac.msg_len_bytes += len;
+
+  if (hmac.block_len > 0) {
+    size_t fill = kSpxHostSha256BlockBytes - hmac.block_len;
+    fill = len < fill ? len : fill;
+    memcpy(&hmac.block[hmac.block_len], bytes, fill);
+    hmac.block_len += fill;
+    bytes += fill;
+    len -= fill;
+    if (hmac.block_len < kSpxHostSha256BlockBytes) {
+      return;
+    }
+    spx_host_sha256_compress(hmac.state, hmac.block, 1);
+    hmac.block_len = 0;
+  }
+
+  size_t nblocks = len / kSpxHostSha256BlockBytes;
+  spx_host_sha256_compress(hmac.state, bytes, nblocks);
+  bytes += nblocks * kSpxHostSha256BlockBytes;
+  len -= nblocks * kSpxHostSha256BlockBytes;
+
+  memcpy(hmac.block, bytes, len);
+  hmac.block_len = len;
+}
+
+void hmac_sha256_update_words(const uint32_t *data, size_t len) {
+  // The message FIFO consumes words in little-endian byte order, which is
+  // the host byte order on all supported platforms.
+  hmac_sha256_update(data, len * sizeof(uint32_t));
+}
+
+void hmac_sha256_process(void) {
+  uint64_t msg_len_bits = hmac.msg_len_bytes * 8;
+
+  uint8_t pad[2 * kSpxHostSha256BlockBytes] = {0x80};
+  size_t pad_len = kSpxHostSha256BlockBytes - hmac.block_len;
+  if (pad_len < 1 + sizeof(msg_len_bits)) {
+    pad_len += kSpxHostSha256BlockBytes;
+  }
+  for (size_t i = 0; i < sizeof(msg_len_bits); ++i) {
+    pad[pad_len - 1 - i] = (uint8_t)(msg_len_bits >> (8 * i));
+  }
+  hmac_sha256_update(pad, pad_len);
+  assert(hmac.block_len == 0);
+}
+
+void hmac_sha256_final_truncated(uint32_t *digest, size_t len) {
+  len = len <= kHmacDigestNumWords ? len : kHmacDigestNumWords;
+  for (size_t i = 0; i < len; ++i) {
+    // Match the word and byte order of the hardware, see `hmac.c`.
+    digest[i] = hmac.big_endian_digest
+                    ? __builtin_bswap32(hmac.state[i])
+                    : hmac.state[kHmacDigestNumWords - 1 - i];
+  }
+}
+
+void hmac_sha256(const void *data, size_t len, hmac_digest_t *digest) {
+  hmac_sha256_init();
+  hmac_sha256_update(data, len);
+  hmac_sha256_process();
+  hmac_sha256_final(digest);
+}
+
+void hmac_sha256_save(hmac_context_t *ctx) {
+  // As on the hardware, only whole blocks can be saved.
+  assert(hmac.block_len == 0);
+  memcpy(ctx->digest, hmac.state, sizeof(ctx->digest));
+  uint64_t msg_len_bits = hmac.msg_len_bytes * 8;
+  ctx->msg_len_lower = (uint32_t)msg_len_bits;
+  ctx->msg_len_upper = (uint32_t)(msg_len_bits >> 32);
+}
+
+void hmac_sha256_restore(const hmac_context_t *ctx) {
+  memcpy(hmac.state, ctx->digest, sizeof(hmac.state));
+  uint64_t msg_len_bits =
+      (uint64_t)ctx->msg_len_upper << 32 | ctx->msg_len_lower;
+  hmac.msg_len_bytes = msg_len_bits / 8;
+  hmac.block_len = 0;
+}
+
+extern void sc_hmac_hmac_sha256_init(hmac_key_t key, bool big_endian_digest);
+extern void hmac_sha256_init(void);
+extern void hmac_sha256_final(hmac_digest_t *digest);
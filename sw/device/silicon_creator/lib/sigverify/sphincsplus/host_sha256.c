@@ -0,0 +1,200 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/silicon_creator/lib/sigverify/sphincsplus/host_sha256.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SPX_HOST_SHA256_X86 1
+#endif
+
+const uint32_t kSpxHostSha256Iv[kSpxHostSha256StateWords] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+static const uint32_t kRoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static inline uint32_t rotr32(uint32_t x, uint32_t n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+static inline uint32_t load_be32(const uint8_t *p) {
+  return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 |
+         (uint32_t)p[3];
+}
+
+static void compress_portable(uint32_t *state, const uint8_t *blocks,
+                              size_t nblocks) {
+  for (; nblocks > 0; --nblocks, blocks += kSpxHostSha256BlockBytes) {
+    // The message schedule is kept in a 16-word ring buffer.
+    uint32_t w[16];
+    for (size_t i = 0; i < 16; ++i) {
+      w[i] = load_be32(&blocks[4 * i]);
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (size_t i = 0; i < 64; ++i) {
+      if (i >= 16) {
+        uint32_t w15 = w[(i - 15) & 15];
+        uint32_t w2 = w[(i - 2) & 15];
+        uint32_t s0 = rotr32(w15, 7) ^ rotr32(w15, 18) ^ (w15 >> 3);
+        uint32_t s1 = rotr32(w2, 17) ^ rotr32(w2, 19) ^ (w2 >> 10);
+        w[i & 15] += s0 + w[(i - 7) & 15] + s1;
+      }
+      uint32_t s1 = rotr32(e, 6) ^ rotr32(e, 11) ^ rotr32(e, 25);
+      uint32_t ch = (e & f) ^ (~e & g);
+      uint32_t t1 = h + s1 + ch + kRoundConstants[i] + w[i & 15];
+      uint32_t s0 = rotr32(a, 2) ^ rotr32(a, 13) ^ rotr32(a, 22);
+      uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+      uint32_t t2 = s0 + maj;
+      h = g;
+      g = f;
+      f = e;
+      e = d + t1;
+      d = c;
+      c = b;
+      b = a;
+      a = t1 + t2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+  }
+}
+
+#ifdef SPX_HOST_SHA256_X86
+/**
+ * Four rounds using the SHA-NI instructions.
+ *
+ * `msg` holds message words `i..i+3` and `k` the matching round constants.
+ */
+#define SHA_NI_ROUNDS(abef, cdgh, msg, k)                           \
+  do {                                                              \
+    __m128i wk = _mm_add_epi32((msg), (k));                         \
+    (cdgh) = _mm_sha256rnds2_epu32((cdgh), (abef), wk);             \
+    (abef) = _mm_sha256rnds2_epu32((abef), (cdgh),                  \
+                                   _mm_shuffle_epi32(wk, 0x0e));    \
+  } while (false)
+
+__attribute__((target("sha,sse4.1"))) static void compress_sha_ni(
+    uint32_t *state, const uint8_t *blocks, size_t nblocks) {
+  const __m128i kByteSwap =
+      _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+  // The instructions expect the state as {a, b, e, f} and {c, d, g, h}.
+  __m128i tmp = _mm_loadu_si128((const __m128i *)&state[0]);
+  __m128i cdgh = _mm_loadu_si128((const __m128i *)&state[4]);
+  tmp = _mm_shuffle_epi32(tmp, 0xb1);    // c d a b
+  cdgh = _mm_shuffle_epi32(cdgh, 0x1b);  // h g f e
+  __m128i abef = _mm_alignr_epi8(tmp, cdgh, 8);
+  cdgh = _mm_blend_epi16(cdgh, tmp, 0xf0);
+
+  for (; nblocks > 0; --nblocks, blocks += kSpxHostSha256BlockBytes) {
+    __m128i abef_save = abef;
+    __m128i cdgh_save = cdgh;
+
+    __m128i msg[4];
+    for (size_t i = 0; i < 4; ++i) {
+      msg[i] = _mm_shuffle_epi8(
+          _mm_loadu_si128((const __m128i *)&blocks[16 * i]), kByteSwap);
+    }
+
+    for (size_t i = 0; i < 16; ++i) {
+      __m128i k = _mm_loadu_si128((const __m128i *)&kRoundConstants[4 * i]);
+      SHA_NI_ROUNDS(abef, cdgh, msg[i & 3], k);
+      if (i >= 3 && i < 15) {
+        // msg[(i + 1) & 3] holds W[4i-12..4i-9]; complete the words
+        // W[4i+4..4i+7] from it.
+        __m128i next = msg[(i + 1) & 3];
+        next = _mm_add_epi32(next, _mm_alignr_epi8(msg[i & 3],
+                                                   msg[(i + 3) & 3], 4));
+        next = _mm_sha256msg2_epu32(next, msg[i & 3]);
+        msg[(i + 1) & 3] = next;
+      }
+      if (i >= 1 && i < 13) {
+        msg[(i + 3) & 3] = _mm_sha256msg1_epu32(msg[(i + 3) & 3], msg[i & 3]);
+      }
+    }
+
+    abef = _mm_add_epi32(abef, abef_save);
+    cdgh = _mm_add_epi32(cdgh, cdgh_save);
+  }
+
+  tmp = _mm_shuffle_epi32(abef, 0x1b);   // f e b a
+  cdgh = _mm_shuffle_epi32(cdgh, 0xb1);  // d c h g
+  _mm_storeu_si128((__m128i *)&state[0], _mm_blend_epi16(tmp, cdgh, 0xf0));
+  _mm_storeu_si128((__m128i *)&state[4], _mm_alignr_epi8(cdgh, tmp, 8));
+}
+#endif
+
+static spx_host_sha256_backend_t backend;
+static bool backend_selected = false;
+
+bool spx_host_sha256_backend_supported(spx_host_sha256_backend_t backend) {
+  switch (backend) {
+    case kSpxHostSha256BackendPortable:
+      return true;
+    case kSpxHostSha256BackendShaNi:
+#ifdef SPX_HOST_SHA256_X86
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("sha") &&
+             __builtin_cpu_supports("sse4.1");
+#else
+      return false;
+#endif
+    default:
+      return false;
+  }
+}
+
+bool spx_host_sha256_backend_set(spx_host_sha256_backend_t new_backend) {
+  if (!spx_host_sha256_backend_supported(new_backend)) {
+    return false;
+  }
+  backend = new_backend;
+  backend_selected = true;
+  return true;
+}
+
+spx_host_sha256_backend_t spx_host_sha256_backend_get(void) {
+  if (!backend_selected) {
+    if (!spx_host_sha256_backend_set(kSpxHostSha256BackendShaNi)) {
+      spx_host_sha256_backend_set(kSpxHostSha256BackendPortable);
+    }
+  }
+  return backend;
+}
+
+void spx_host_sha256_compress(uint32_t *state, const uint8_t *blocks,
+                              size_t nblocks) {
+  switch (spx_host_sha256_backend_get()) {
+#ifdef SPX_HOST_SHA256_X86
+    case kSpxHostSha256BackendShaNi:
+      compress_sha_ni(state, blocks, nblocks);
+      return;
+#endif
+    default:
+      compress_portable(state, blocks, nblocks);
+      return;
+  }
+}
@@ -0,0 +1,87 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_SIGVERIFY_SPHINCSPLUS_HOST_SHA256_H_
+#define OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_SIGVERIFY_SPHINCSPLUS_HOST_SHA256_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * SHA-256 compression backends available to host builds.
+ *
+ * The host build of SPHINCS+ verification (see `host_hmac.c`) runs the
+ * device code against a software model of the HMAC block, which uses one of
+ * these backends for the SHA-256 compression function.
+ */
+typedef enum spx_host_sha256_backend {
+  /**
+   * Portable C implementation, always available.
+   */
+  kSpxHostSha256BackendPortable,
+  /**
+   * x86 SHA extensions (SHA-NI), if supported by the CPU.
+   */
+  kSpxHostSha256BackendShaNi,
+} spx_host_sha256_backend_t;
+
+enum {
+  /**
+   * Size of a SHA-256 message block in bytes.
+   */
+  kSpxHostSha256BlockBytes = 64,
+  /**
+   * Size of the SHA-256 state in 32-bit words.
+   */
+  kSpxHostSha256StateWords = 8,
+};
+
+/**
+ * SHA-256 initial hash value.
+ */
+extern const uint32_t kSpxHostSha256Iv[kSpxHostSha256StateWords];
+
+/**
+ * Checks whether a backend can be used on this machine.
+ *
+ * @param backend Backend to check.
+ * @return Whether `backend` is supported.
+ */
+bool spx_host_sha256_backend_supported(spx_host_sha256_backend_t backend);
+
+/**
+ * Selects the backend used by `spx_host_sha256_compress()`.
+ *
+ * Defaults to the fastest supported backend.
+ *
+ * @param backend Backend to use.
+ * @return Whether `backend` is supported; if not, the selection is unchanged.
+ */
+bool spx_host_sha256_backend_set(spx_host_sha256_backend_t backend);
+
+/**
+ * Returns the backend used by `spx_host_sha256_compress()`.
+ */
+spx_host_sha256_backend_t spx_host_sha256_backend_get(void);
+
+/**
+ * Runs the SHA-256 compression function over whole message blocks.
+ *
+ * @param[in,out] state Hash state (`kSpxHostSha256StateWords` words).
+ * @param blocks Message blocks (`nblocks * kSpxHostSha256BlockBytes` bytes).
+ * @param nblocks Number of blocks.
+ */
+void spx_host_sha256_compress(uint32_t *state, const uint8_t *blocks,
+                              size_t nblocks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_SIGVERIFY_SPHINCSPLUS_HOST_SHA256_H_
@@ -0,0 +1,87 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Throughput benchmark for the host build of SPHINCS+ verification.
+//
+// Usage: host_verify_bench [SECONDS]
+//
+// Verifies the test vectors in a loop for each supported SHA-256 backend and
+// prints the number of signatures verified per second.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "sw/device/silicon_creator/lib/sigverify/sphincsplus/host_sha256.h"
+#include "sw/device/silicon_creator/lib/sigverify/sphincsplus/verify.h"
+
+#include "sphincsplus_testvectors.h"
+
+namespace {
+
+struct Backend {
+  spx_host_sha256_backend_t id;
+  const char *name;
+};
+
+constexpr Backend kBackends[] = {
+    {kSpxHostSha256BackendPortable, "portable"},
+    {kSpxHostSha256BackendShaNi, "sha-ni"},
+};
+
+/**
+ * Verifies test vector `index`, returning false on any failure.
+ */
+bool VerifyOne(size_t index) {
+  const spx_verify_test_vector_t &test = spx_verify_tests[index];
+  uint32_t root[kSpxVerifyRootNumWords];
+  uint32_t pub_root[kSpxVerifyRootNumWords];
+  spx_public_key_root(test.pk, pub_root);
+  if (spx_verify(test.sig, NULL, 0, NULL, 0, NULL, 0, test.msg, test.msg_len,
+                 test.pk, root) != kErrorOk) {
+    return false;
+  }
+  return memcmp(root, pub_root, sizeof(root)) == 0;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  double seconds = argc > 1 ? strtod(argv[1], nullptr) : 2.0;
+  if (seconds <= 0) {
+    fprintf(stderr, "Usage: %s [SECONDS]\n", argv[0]);
+    return 2;
+  }
+
+  int ret = 0;
+  for (const Backend &backend : kBackends) {
+    if (!spx_host_sha256_backend_set(backend.id)) {
+      printf("%-10s unsupported\n", backend.name);
+      continue;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::duration<double>(seconds);
+    size_t verified = 0;
+    size_t failed = 0;
+    std::chrono::steady_clock::time_point now;
+    do {
+      for (size_t i = 0; i < kSpxVerifyNumTests; ++i) {
+        failed += !VerifyOne(i);
+      }
+      verified += kSpxVerifyNumTests;
+      now = std::chrono::steady_clock::now();
+    } while (now < deadline);
+
+    double elapsed = std::chrono::duration<double>(now - start).count();
+    printf("%-10s %8.1f signatures/s (%zu in %.2fs)\n", backend.name,
+           verified / elapsed, verified, elapsed);
+    if (failed) {
+      printf("%-10s %zu verifications FAILED\n", backend.name, failed);
+      ret = 1;
+    }
+  }
+  return ret;
+}
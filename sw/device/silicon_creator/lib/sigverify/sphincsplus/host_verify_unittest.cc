@@ -0,0 +1,144 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <array>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sw/device/silicon_creator/lib/drivers/hmac.h"
+#include "sw/device/silicon_creator/lib/sigverify/sphincsplus/host_sha256.h"
+#include "sw/device/silicon_creator/lib/sigverify/sphincsplus/verify.h"
+
+// The autogen rule that creates this header creates it in a directory named
+// after the rule, so the same source is built against each test vector set
+// that the device `verify_test_*` targets run.
+#include "sphincsplus_testvectors.h"
+
+namespace host_verify_unittest {
+namespace {
+
+class HostVerifyTest
+    : public testing::TestWithParam<spx_host_sha256_backend_t> {
+ protected:
+  void SetUp() override {
+    if (!spx_host_sha256_backend_supported(GetParam())) {
+      GTEST_SKIP() << "SHA-256 backend not supported on this machine";
+    }
+    ASSERT_TRUE(spx_host_sha256_backend_set(GetParam()));
+  }
+
+  /**
+   * Computes the little-endian SHA-256 digest of `msg` with the HMAC model.
+   */
+  std::array<uint32_t, kHmacDigestNumWords> Sha256(const std::string &msg) {
+    hmac_digest_t digest;
+    hmac_sha256(msg.data(), msg.size(), &digest);
+    std::array<uint32_t, kHmacDigestNumWords> out;
+    std::copy(std::begin(digest.digest), std::end(digest.digest), out.begin());
+    return out;
+  }
+
+  /**
+   * Runs verification and returns whether the signature was accepted.
+   */
+  bool Verify(const spx_verify_test_vector_t &test) {
+    uint32_t root[kSpxVerifyRootNumWords];
+    uint32_t pub_root[kSpxVerifyRootNumWords];
+    spx_public_key_root(test.pk, pub_root);
+    EXPECT_EQ(spx_verify(test.sig, NULL, 0, NULL, 0, NULL, 0, test.msg,
+                         test.msg_len, test.pk, root),
+              kErrorOk);
+    return memcmp(root, pub_root, sizeof(root)) == 0;
+  }
+};
+
+TEST_P(HostVerifyTest, Sha256KnownAnswer) {
+  // FIPS 180-2 examples; words are in the little-endian order produced by
+  // `hmac_sha256()`.
+  EXPECT_EQ(Sha256("abc"), (std::array<uint32_t, kHmacDigestNumWords>{
+                               0xf20015ad, 0xb410ff61, 0x96177a9c, 0xb00361a3,
+                               0x5dae2223, 0x414140de, 0x8f01cfea, 0xba7816bf,
+                           }));
+  EXPECT_EQ(
+      Sha256("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+      (std::array<uint32_t, kHmacDigestNumWords>{
+          0x19db06c1, 0xf6ecedd4, 0x64ff2167, 0xa33ce459,
+          0x0c3e6039, 0xe5c02693, 0xd20638b8, 0x248d6a61,
+      }));
+}
+
+TEST_P(HostVerifyTest, BackendsAgree) {
+  std::string msg;
+  for (size_t len = 0; len < 3 * kSpxHostSha256BlockBytes; ++len) {
+    ASSERT_TRUE(spx_host_sha256_backend_set(kSpxHostSha256BackendPortable));
+    auto expected = Sha256(msg);
+    ASSERT_TRUE(spx_host_sha256_backend_set(GetParam()));
+    EXPECT_EQ(Sha256(msg), expected) << "length " << len;
+    msg.push_back(static_cast<char>(len * 7 + 1));
+  }
+}
+
+TEST_P(HostVerifyTest, ValidSignatures) {
+  for (size_t i = 0; i < kSpxVerifyNumTests; ++i) {
+    EXPECT_TRUE(Verify(spx_verify_tests[i])) << "test vector " << i;
+  }
+}
+
+TEST_P(HostVerifyTest, InvalidSignatures) {
+  for (size_t i = 0; i < kSpxVerifyNumTests; ++i) {
+    spx_verify_test_vector_t test = spx_verify_tests[i];
+    std::vector<uint8_t> msg(test.msg, test.msg + test.msg_len);
+    if (msg.empty()) {
+      test.sig[0] = ~test.sig[0];
+    } else {
+      msg[0] = ~msg[0];
+      test.msg = msg.data();
+    }
+    EXPECT_FALSE(Verify(test)) << "test vector " << i;
+  }
+}
+
+TEST_P(HostVerifyTest, MsgHashMatchesMessage) {
+  for (size_t i = 0; i < kSpxVerifyNumTests; ++i) {
+    const spx_verify_test_vector_t &test = spx_verify_tests[i];
+    uint32_t root[kSpxVerifyRootNumWords];
+    ASSERT_EQ(spx_verify(test.sig, NULL, 0, NULL, 0, NULL, 0, test.msg,
+                         test.msg_len, test.pk, root),
+              kErrorOk);
+
+    // Suspend the message hash after the first block to hash other data, as a
+    // caller hashing the message together with other digests would.
+    size_t split = kSpxHostSha256BlockBytes - kSpxVerifyMsgStartBytes;
+    split = test.msg_len < split ? 0 : split;
+    spx_verify_msg_start(test.sig, test.pk);
+    hmac_sha256_update(test.msg, split);
+    if (split > 0) {
+      hmac_context_t ctx;
+      hmac_sha256_save(&ctx);
+      Sha256("abc");
+      hmac_sha256_configure(/*big_endian_digest=*/true);
+      hmac_sha256_restore(&ctx);
+    }
+    hmac_sha256_update(test.msg + split, test.msg_len - split);
+    hmac_sha256_process();
+    hmac_digest_t msg_hash;
+    hmac_sha256_final(&msg_hash);
+
+    uint32_t root_from_hash[kSpxVerifyRootNumWords];
+    EXPECT_EQ(spx_verify_msg_hash(test.sig, msg_hash.digest, test.pk,
+                                  root_from_hash),
+              kErrorOk);
+    EXPECT_EQ(memcmp(root, root_from_hash, sizeof(root)), 0)
+        << "test vector " << i;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllBackends, HostVerifyTest,
+                         testing::Values(kSpxHostSha256BackendPortable,
+                                         kSpxHostSha256BackendShaNi));
+
+}  // namespace
+}  // namespace host_verify_unittest
@@ -36,6 +36,33 @@ extern "C" {
 void thash(const uint32_t *in, size_t inblocks, const spx_ctx_t *ctx,
            const spx_addr_t *addr, uint32_t *out);
 
+/**
+ * Starts a tweakable hash computation without waiting for the result.
+ *
+ * Loads the seeded hash state, writes the message (address followed by
+ * `inblocks` blocks of `in`) and starts the hardware digest. The caller may do
+ * unrelated work, such as preparing the address or input of the next hash,
+ * before collecting the result with `thash_finish()`. `in` and `addr` may be
+ * modified as soon as this function returns.
+ *
+ * Exactly one `thash_finish()` call must follow before the next hash is
+ * started.
+ *
+ * @param in Input buffer.
+ * @param inblocks Number of `kSpxN`-byte blocks in input buffer.
+ * @param ctx Context object.
+ * @param addr Hypertree address.
+ */
+void thash_start(const uint32_t *in, size_t inblocks, const spx_ctx_t *ctx,
+                 const spx_addr_t *addr);
+
+/**
+ * Waits for a hash started with `thash_start()` and reads the result.
+ *
+ * @param[out] out Output buffer (at least `kSpxN` bytes).
+ */
+void thash_finish(uint32_t *out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,11 +11,31 @@
 #include "sw/device/silicon_creator/lib/sigverify/sphincsplus/sha2.h"
 #include "sw/device/silicon_creator/lib/sigverify/sphincsplus/thash.h"
 
-void thash(const uint32_t *in, size_t inblocks, const spx_ctx_t *ctx,
-           const spx_addr_t *addr, uint32_t *out) {
+// The address is word-aligned and only its last word is partially used, so
+// all but the trailing bytes can go to the FIFO as full words.
+static_assert(kSpxSha256AddrBytes % sizeof(uint32_t) != 0,
+              "Address is expected to end in a partial word.");
+enum {
+  kSpxSha256AddrFullWords = kSpxSha256AddrBytes / sizeof(uint32_t),
+  kSpxSha256AddrTailBytes = kSpxSha256AddrBytes % sizeof(uint32_t),
+};
+
+void thash_start(const uint32_t *in, size_t inblocks, const spx_ctx_t *ctx,
+                 const spx_addr_t *addr) {
   hmac_sha256_restore(&ctx->state_seeded);
-  hmac_sha256_update((unsigned char *)addr->addr, kSpxSha256AddrBytes);
+  hmac_sha256_update_words(addr->addr, kSpxSha256AddrFullWords);
+  hmac_sha256_update(&addr->addr[kSpxSha256AddrFullWords],
+                     kSpxSha256AddrTailBytes);
   hmac_sha256_update_words(in, inblocks * kSpxNWords);
   hmac_sha256_process();
+}
+
+void thash_finish(uint32_t *out) {
   hmac_sha256_final_truncated(out, kSpxNWords);
 }
+
+void thash(const uint32_t *in, size_t inblocks, const spx_ctx_t *ctx,
+           const spx_addr_t *addr, uint32_t *out) {
+  thash_start(in, inblocks, ctx, addr);
+  thash_finish(out);
+}
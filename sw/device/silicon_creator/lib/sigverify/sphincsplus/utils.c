@@ -64,9 +64,12 @@ void spx_utils_compute_root(const uint32_t *leaf, uint32_t leaf_idx,
     uint32_t *hash_dst = (leaf_idx & 1) ? buffer_second : buffer;
     uint32_t *auth_dst = (leaf_idx & 1) ? buffer : buffer_second;
 
-    thash(buffer, /*inblocks=*/2, ctx, addr, hash_dst);
+    thash_start(buffer, /*inblocks=*/2, ctx, addr);
+    // The input has been written to HMAC, so fetch the next authentication
+    // path node while it is processing.
     memcpy(auth_dst, auth_path, kSpxN);
     auth_path += kSpxNWords;
+    thash_finish(hash_dst);
   }
 
   // The last iteration is exceptional; we do not copy an auth_path node.
@@ -11,6 +11,7 @@
 #include <stdint.h>
 
 #include "sw/device/lib/base/memory.h"
+#include "sw/device/silicon_creator/lib/drivers/hmac.h"
 #include "sw/device/silicon_creator/lib/sigverify/sphincsplus/address.h"
 #include "sw/device/silicon_creator/lib/sigverify/sphincsplus/context.h"
 #include "sw/device/silicon_creator/lib/sigverify/sphincsplus/fors.h"
@@ -25,18 +26,19 @@ static_assert(kSpxVerifySigWords * sizeof(uint32_t) == kSpxVerifySigBytes,
 static_assert(kSpxVerifyPkWords * sizeof(uint32_t) == kSpxVerifyPkBytes,
               "kSpxVerifyPkWords and kSpxVerifyPkBytes do not match.");
 static_assert(kSpxD <= UINT8_MAX, "kSpxD must fit into a uint8_t.");
-rom_error_t spx_verify(const uint32_t *sig, const uint8_t *msg_prefix_1,
-                       size_t msg_prefix_1_len, const uint8_t *msg_prefix_2,
-                       size_t msg_prefix_2_len, const uint8_t *msg_prefix_3,
-                       size_t msg_prefix_3_len, const uint8_t *msg,
-                       size_t msg_len, const uint32_t *pk, uint32_t *root) {
-  spx_ctx_t ctx;
-  memcpy(ctx.pub_seed, pk, kSpxN);
-
-  // This hook allows the hash function instantiation to do whatever
-  // preparation or computation it needs, based on the public seed.
-  HARDENED_RETURN_IF_ERROR(spx_hash_initialize(&ctx));
-
+/**
+ * Computes the root for a signature given the digest of its message.
+ *
+ * @param sig Input signature, excluding the randomness R.
+ * @param ctx Context object, see `spx_hash_initialize()`.
+ * @param mhash Message digest.
+ * @param tree Tree index.
+ * @param idx_leaf Leaf index.
+ * @param[out] root Buffer for computed tree root.
+ */
+static void root_compute(const uint32_t *sig, const spx_ctx_t *ctx,
+                         const uint8_t *mhash, uint64_t tree,
+                         uint32_t idx_leaf, uint32_t *root) {
   spx_addr_t wots_addr = {.addr = {0}};
   spx_addr_t tree_addr = {.addr = {0}};
   spx_addr_t wots_pk_addr = {.addr = {0}};
@@ -44,21 +46,11 @@ rom_error_t spx_verify(const uint32_t *sig, const uint8_t *msg_prefix_1,
   spx_addr_type_set(&tree_addr, kSpxAddrTypeHashTree);
   spx_addr_type_set(&wots_pk_addr, kSpxAddrTypeWotsPk);
 
-  // Derive the message digest and leaf index from R || PK || M.
-  // The additional kSpxN is a result of the hash domain separator.
-  uint8_t mhash[kSpxForsMsgBytes];
-  uint64_t tree;
-  uint32_t idx_leaf;
-  HARDENED_RETURN_IF_ERROR(spx_hash_message(
-      sig, pk, msg_prefix_1, msg_prefix_1_len, msg_prefix_2, msg_prefix_2_len,
-      msg_prefix_3, msg_prefix_3_len, msg, msg_len, mhash, &tree, &idx_leaf));
-  sig += kSpxNWords;
-
   // Layer correctly defaults to 0, so no need to set_layer_addr.
   spx_addr_tree_set(&wots_addr, tree);
   spx_addr_keypair_set(&wots_addr, idx_leaf);
 
-  fors_pk_from_sig(sig, mhash, &ctx, &wots_addr, root);
+  fors_pk_from_sig(sig, mhash, ctx, &wots_addr, root);
   sig += kSpxForsWords;
 
   // For each subtree..
@@ -75,15 +67,15 @@ rom_error_t spx_verify(const uint32_t *sig, const uint8_t *msg_prefix_1,
     // Initially, root is the FORS pk, but on subsequent iterations it is
     // the root of the subtree below the currently processed subtree.
     uint32_t wots_pk[kSpxWotsWords];
-    wots_pk_from_sig(sig, root, &ctx, &wots_addr, wots_pk);
+    wots_pk_from_sig(sig, root, ctx, &wots_addr, wots_pk);
     sig += kSpxWotsWords;
 
     // Compute the leaf node using the WOTS public key.
     uint32_t leaf[kSpxNWords];
-    thash(wots_pk, kSpxWotsLen, &ctx, &wots_pk_addr, leaf);
+    thash(wots_pk, kSpxWotsLen, ctx, &wots_pk_addr, leaf);
 
     // Compute the root node of this subtree.
-    spx_utils_compute_root(leaf, idx_leaf, 0, sig, kSpxTreeHeight, &ctx,
+    spx_utils_compute_root(leaf, idx_leaf, 0, sig, kSpxTreeHeight, ctx,
                            &tree_addr, root);
     sig += kSpxTreeHeight * kSpxNWords;
 
@@ -91,7 +83,51 @@ rom_error_t spx_verify(const uint32_t *sig, const uint8_t *msg_prefix_1,
     idx_leaf = (tree & ((1 << kSpxTreeHeight) - 1));
     tree = tree >> kSpxTreeHeight;
   }
+}
+
+rom_error_t spx_verify(const uint32_t *sig, const uint8_t *msg_prefix_1,
+                       size_t msg_prefix_1_len, const uint8_t *msg_prefix_2,
+                       size_t msg_prefix_2_len, const uint8_t *msg_prefix_3,
+                       size_t msg_prefix_3_len, const uint8_t *msg,
+                       size_t msg_len, const uint32_t *pk, uint32_t *root) {
+  spx_ctx_t ctx;
+  memcpy(ctx.pub_seed, pk, kSpxN);
+
+  // This hook allows the hash function instantiation to do whatever
+  // preparation or computation it needs, based on the public seed.
+  HARDENED_RETURN_IF_ERROR(spx_hash_initialize(&ctx));
+
+  // Derive the message digest and leaf index from R || PK || M.
+  // The additional kSpxN is a result of the hash domain separator.
+  uint8_t mhash[kSpxForsMsgBytes];
+  uint64_t tree;
+  uint32_t idx_leaf;
+  HARDENED_RETURN_IF_ERROR(spx_hash_message(
+      sig, pk, msg_prefix_1, msg_prefix_1_len, msg_prefix_2, msg_prefix_2_len,
+      msg_prefix_3, msg_prefix_3_len, msg, msg_len, mhash, &tree, &idx_leaf));
+
+  root_compute(sig + kSpxNWords, &ctx, mhash, tree, idx_leaf, root);
+  return kErrorOk;
+}
+
+void spx_verify_msg_start(const uint32_t *sig, const uint32_t *pk) {
+  hmac_sha256_configure(/*big_endian_digest=*/true);
+  spx_hash_message_start(sig, pk);
+}
+
+rom_error_t spx_verify_msg_hash(const uint32_t *sig, const uint32_t *msg_hash,
+                                const uint32_t *pk, uint32_t *root) {
+  spx_ctx_t ctx;
+  memcpy(ctx.pub_seed, pk, kSpxN);
+  HARDENED_RETURN_IF_ERROR(spx_hash_initialize(&ctx));
+
+  uint8_t mhash[kSpxForsMsgBytes];
+  uint64_t tree;
+  uint32_t idx_leaf;
+  HARDENED_RETURN_IF_ERROR(spx_hash_message_finish(sig, pk, msg_hash, mhash,
+                                                   &tree, &idx_leaf));
 
+  root_compute(sig + kSpxNWords, &ctx, mhash, tree, idx_leaf, root);
   return kErrorOk;
 }
 
@@ -40,6 +40,10 @@ enum {
    * Size of SPHINCS+ public key in words.
    */
   kSpxVerifyPkWords = kSpxPkWords,
+  /**
+   * Number of bytes that `spx_verify_msg_start()` sends to the HMAC block.
+   */
+  kSpxVerifyMsgStartBytes = kSpxN + kSpxPkBytes,
 };
 
 /**
@@ -69,6 +73,38 @@ rom_error_t spx_verify(const uint32_t *sig, const uint8_t *msg_prefix_1,
                        size_t msg_prefix_3_len, const uint8_t *msg,
                        size_t msg_len, const uint32_t *pk, uint32_t *root);
 
+/**
+ * Starts hashing the message of a signature on the HMAC block.
+ *
+ * Configures the HMAC block for big-endian digests and starts a SHA-256
+ * operation over the randomness of the signature and the public key
+ * (`kSpxVerifyMsgStartBytes` bytes). The caller then sends the message,
+ * including any prefixes, and reads the big-endian digest, which is passed to
+ * `spx_verify_msg_hash()`. In between, the operation may be suspended with
+ * `hmac_sha256_save()` to hash other data in the same pass over the message.
+ *
+ * @param sig Input signature (`kSpxVerifySigBytes` bytes long).
+ * @param pk Public key (`kSpxVerifyPkBytes` bytes long).
+ */
+void spx_verify_msg_start(const uint32_t *sig, const uint32_t *pk);
+
+/**
+ * Computes the root for a signature given the hash of its message.
+ *
+ * Same as `spx_verify()`, but the message has already been hashed, see
+ * `spx_verify_msg_start()`.
+ *
+ * @param sig Input signature (`kSpxVerifySigBytes` bytes long).
+ * @param msg_hash Big-endian message hash (`kHmacDigestNumWords` words long).
+ * @param pk Public key (`kSpxVerifyPkBytes` bytes long).
+ * @param[out] root Buffer for computed tree root (`kSpxVerifyRootNumWords`
+ *                  words long).
+ * @return Error code indicating if the operation succeeded.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t spx_verify_msg_hash(const uint32_t *sig, const uint32_t *msg_hash,
+                                const uint32_t *pk, uint32_t *root);
+
 /**
  * Extract the public key root.
  *
@@ -8,11 +8,9 @@
 #include "sw/device/silicon_creator/lib/sigverify/sphincsplus/wots.h"
 
 #include "sw/device/lib/base/memory.h"
-#include "sw/device/silicon_creator/lib/drivers/hmac.h"
 #include "sw/device/silicon_creator/lib/error.h"
 #include "sw/device/silicon_creator/lib/sigverify/sphincsplus/address.h"
 #include "sw/device/silicon_creator/lib/sigverify/sphincsplus/params.h"
-#include "sw/device/silicon_creator/lib/sigverify/sphincsplus/sha2.h"
 #include "sw/device/silicon_creator/lib/sigverify/sphincsplus/thash.h"
 #include "sw/device/silicon_creator/lib/sigverify/sphincsplus/utils.h"
 
@@ -44,14 +42,10 @@ static void gen_chain(const uint32_t *in, uint8_t start, const spx_ctx_t *ctx,
   // performance-critical.
   spx_addr_hash_set(addr, start);
   for (uint8_t i = start; i + 1 < kSpxWotsW; i++) {
-    // This loop body is essentially just `thash`, inlined for performance.
-    hmac_sha256_restore(&ctx->state_seeded);
-    hmac_sha256_update((unsigned char *)addr->addr, kSpxSha256AddrBytes);
-    hmac_sha256_update_words(out, kSpxNWords);
-    hmac_sha256_process();
+    thash_start(out, /*inblocks=*/1, ctx, addr);
     // Update the address while HMAC is processing for performance reasons.
     spx_addr_hash_set(addr, i + 1);
-    hmac_sha256_final_truncated(out, kSpxNWords);
+    thash_finish(out);
   }
 }
 
@@ -2,6 +2,7 @@
 // Licensed under the Apache License, Version 2.0, see LICENSE for details.
 // SPDX-License-Identifier: Apache-2.0
 
+#include "sw/device/lib/runtime/ibex.h"
 #include "sw/device/lib/testing/test_framework/check.h"
 #include "sw/device/lib/testing/test_framework/ottf_main.h"
 #include "sw/device/silicon_creator/lib/sigverify/sphincsplus/verify.h"
@@ -428,10 +429,14 @@ static rom_error_t spx_verify_impl_test(void) {
   sigverify_spx_root_t expected_root;
   sigverify_spx_root_t actual_root;
   spx_public_key_root(kPubKey.data, expected_root.data);
+  uint64_t start = ibex_mcycle_read();
   rom_error_t error = spx_verify(kSignature.data, kSpxVerifyDomainSep,
                                  sizeof(kSpxVerifyDomainSep), NULL, 0, NULL, 0,
                                  (const uint8_t *)kMessage, kMessageLen,
                                  kPubKey.data, actual_root.data);
+  uint64_t end = ibex_mcycle_read();
+  CHECK(end - start <= UINT32_MAX, "Cycle count must fit in uint32_t");
+  LOG_INFO("spx_verify() took %u cycles", (uint32_t)(end - start));
   if (memcmp(&expected_root, &actual_root, sizeof(sigverify_spx_root_t)) != 0) {
     return kErrorUnknown;
   }
@@ -198,6 +198,132 @@ void rom_ext_sram_exec(owner_sram_exec_mode_t mode) {
   }
 }
 
+enum {
+  /**
+   * Bytes of the image read per chunk by `rom_ext_image_hash()`, a multiple of
+   * the SHA256 block size.
+   */
+  kImageHashChunkBytes = 1024,
+  kImageHashBlockBytes = 64,
+};
+
+/**
+ * One of the hash operations of `rom_ext_image_hash()`.
+ */
+typedef struct image_hash_op {
+  /**
+   * Saved state of the operation while the other one runs.
+   */
+  hmac_context_t ctx;
+  /**
+   * Number of bytes hashed before the digest region.
+   */
+  size_t prefix_len;
+  /**
+   * Offset of the first byte of the digest region not hashed yet.
+   */
+  size_t offset;
+} image_hash_op_t;
+
+// Chunk of the image being hashed, preceded by the last block of the previous
+// chunk which may not have been hashed by both operations yet.
+static uint32_t image_hash_buf[(kImageHashBlockBytes + kImageHashChunkBytes) /
+                               sizeof(uint32_t)];
+
+/**
+ * Computes the image digest and the SPX+ pure-mode message hash in a single
+ * pass over the digest region.
+ *
+ * Each chunk of the image is read from flash once and then fed to both
+ * operations, which are switched with `hmac_sha256_save()` and
+ * `hmac_sha256_restore()`. A save must follow a whole number of blocks, so
+ * each operation stops at the last block boundary of its own message in the
+ * chunk and picks up the remainder from the next one.
+ *
+ * @param usage_constraints Usage constraints, hashed before the image.
+ * @param digest_region Region of the image to hash.
+ * @param spx_signature SPX+ signature of the image.
+ * @param spx_key SPX+ key of the image.
+ * @param[out] image_digest Digest of the image, as computed by
+ *                          `hmac_sha256_init()`.
+ * @param[out] spx_msg_hash Message hash for `spx_verify_msg_hash()`.
+ */
+static void rom_ext_image_hash(
+    const manifest_usage_constraints_t *usage_constraints,
+    manifest_digest_region_t digest_region,
+    const sigverify_spx_signature_t *spx_signature,
+    const sigverify_spx_key_t *spx_key, hmac_digest_t *image_digest,
+    hmac_digest_t *spx_msg_hash) {
+  image_hash_op_t ops[] = {
+      {
+          .prefix_len = sizeof(*usage_constraints),
+          .offset = 0,
+      },
+      {
+          .prefix_len = kSpxVerifyMsgStartBytes + kSpxVerifyPureDomainSepSize +
+                        sizeof(*usage_constraints),
+          .offset = 0,
+      },
+  };
+  hmac_digest_t *digests[] = {image_digest, spx_msg_hash};
+  static_assert(ARRAYSIZE(ops) == ARRAYSIZE(digests),
+                "Unexpected number of hash operations.");
+
+  uint8_t *chunk = (uint8_t *)image_hash_buf + kImageHashBlockBytes;
+  size_t pos = 0;
+  do {
+    size_t len = digest_region.length - pos;
+    if (len > kImageHashChunkBytes) {
+      len = kImageHashChunkBytes;
+    }
+    if (pos > 0) {
+      // Only full chunks precede this one.
+      memcpy(image_hash_buf,
+             chunk + kImageHashChunkBytes - kImageHashBlockBytes,
+             kImageHashBlockBytes);
+    }
+    memcpy(chunk, (const uint8_t *)digest_region.start + pos, len);
+    size_t end = pos + len;
+    bool last = end == digest_region.length;
+
+    for (size_t i = 0; i < ARRAYSIZE(ops); ++i) {
+      image_hash_op_t *op = &ops[i];
+      if (pos == 0) {
+        if (i == 0) {
+          // Same configuration as the SPX+ operation, so that they can share
+          // the engine.
+          hmac_sha256_configure(/*big_endian_digest=*/true);
+          hmac_sha256_start();
+        } else {
+          spx_verify_msg_start(spx_signature->data, spx_key->data);
+          hmac_sha256_update(kSpxVerifyPureDomainSep,
+                             kSpxVerifyPureDomainSepSize);
+        }
+        hmac_sha256_update(usage_constraints, sizeof(*usage_constraints));
+      } else {
+        hmac_sha256_restore(&op->ctx);
+      }
+      size_t op_end = end;
+      if (!last) {
+        op_end -= (op->prefix_len + end) % kImageHashBlockBytes;
+      }
+      hmac_sha256_update(chunk - (pos - op->offset), op_end - op->offset);
+      op->offset = op_end;
+      if (last) {
+        hmac_sha256_process();
+        hmac_sha256_final(digests[i]);
+      } else {
+        hmac_sha256_save(&op->ctx);
+      }
+    }
+    pos = end;
+  } while (pos < digest_region.length);
+  HARDENED_CHECK_EQ(ops[0].offset, digest_region.length);
+  HARDENED_CHECK_EQ(ops[1].offset, digest_region.length);
+
+  util_reverse_bytes(image_digest->digest, sizeof(image_digest->digest));
+}
+
 OT_WARN_UNUSED_RESULT
 static rom_error_t rom_ext_verify(const manifest_t *manifest,
                                   const boot_data_t *boot_data,
@@ -211,10 +337,12 @@ static rom_error_t rom_ext_verify(const manifest_t *manifest,
   const manifest_ext_spx_signature_t *ext_spx_signature;
   rom_error_t spx_err = manifest_ext_get_spx_key(manifest, &ext_spx_key);
   spx_err += manifest_ext_get_spx_signature(manifest, &ext_spx_signature);
+  bool has_spx = false;
   switch ((uint32_t)spx_err) {
     case kErrorOk * 2:
       // Both extensions present: valid SPX+ signature.
       key_id ^= sigverify_spx_key_id_get(&ext_spx_key->key);
+      has_spx = true;
       break;
     case kErrorManifestBadExtension * 2:
       // Both extensions absent: ECDSA only.
@@ -233,32 +361,56 @@ static rom_error_t rom_ext_verify(const manifest_t *manifest,
   memset(boot_measurements.bl0.data, (int)rnd_uint32(),
          sizeof(boot_measurements.bl0.data));
 
-  hmac_sha256_init();
-  // Hash usage constraints.
   manifest_usage_constraints_t usage_constraints_from_hw;
   sigverify_usage_constraints_get(manifest->usage_constraints.selector_bits |
                                       keyring.key[verify_key]->usage_constraint,
                                   &usage_constraints_from_hw);
-  hmac_sha256_update(&usage_constraints_from_hw,
-                     sizeof(usage_constraints_from_hw));
-  // Hash the remaining part of the image.
   manifest_digest_region_t digest_region = manifest_digest_region_get(manifest);
-  hmac_sha256_update(digest_region.start, digest_region.length);
   // TODO(#19596): add owner configuration block to measurement.
-  // Verify signature
-  hmac_sha256_process();
   hmac_digest_t act_digest;
-  hmac_sha256_final(&act_digest);
+  hmac_digest_t spx_msg_hash;
+  const hmac_digest_t *spx_msg_hash_ptr = NULL;
+  uint32_t category = key_alg & kOwnershipKeyAlgCategoryMask;
+  uint32_t spx_alg = (key_alg & ~(uint32_t)kOwnershipKeyAlgCategoryMask) |
+                     kOwnershipKeyAlgCategorySpx;
+  uint32_t start = ibex_mcycle32();
+  if (has_spx && spx_alg == kOwnershipKeyAlgSpxPure &&
+      (category == kOwnershipKeyAlgCategorySpx ||
+       category == kOwnershipKeyAlgCategoryHybrid)) {
+    // Pure-mode SPX+ hashes the image too: hash it for both in a single pass.
+    const owner_keydata_t *key = &keyring.key[verify_key]->data;
+    rom_ext_image_hash(&usage_constraints_from_hw, digest_region,
+                       &ext_spx_signature->signature,
+                       category == kOwnershipKeyAlgCategoryHybrid
+                           ? &key->hybrid.spx
+                           : &key->spx,
+                       &act_digest, &spx_msg_hash);
+    spx_msg_hash_ptr = &spx_msg_hash;
+  } else {
+    hmac_sha256_init();
+    // Hash usage constraints.
+    hmac_sha256_update(&usage_constraints_from_hw,
+                       sizeof(usage_constraints_from_hw));
+    // Hash the remaining part of the image.
+    hmac_sha256_update(digest_region.start, digest_region.length);
+    hmac_sha256_process();
+    hmac_sha256_final(&act_digest);
+  }
+  dbg_printf("verify: hash=%u cycles\r\n", ibex_mcycle32() - start);
 
   static_assert(sizeof(boot_measurements.bl0) == sizeof(act_digest),
                 "Unexpected BL0 digest size.");
   memcpy(&boot_measurements.bl0, &act_digest, sizeof(boot_measurements.bl0));
 
-  return owner_verify(
+  // Verify signature
+  start = ibex_mcycle32();
+  rom_error_t error = owner_verify(
       key_alg, &keyring.key[verify_key]->data, &manifest->ecdsa_signature,
       &ext_spx_signature->signature, &usage_constraints_from_hw,
       sizeof(usage_constraints_from_hw), NULL, 0, digest_region.start,
-      digest_region.length, &act_digest, flash_exec);
+      digest_region.length, &act_digest, spx_msg_hash_ptr, flash_exec);
+  dbg_printf("verify: sig=%u cycles\r\n", ibex_mcycle32() - start);
+  return error;
 }
 
 /**
@@ -34,6 +34,29 @@
         0xfe86b80b, 0x43f83fe6, 0x96163096, 0x261c4bba,                 \
         0x4e69ab6e, 0x6e214b18, 0x9cf1da8f, 0x8183bfa0,                 \
     },                                                                  \
+    .rr =                                                               \
+        {{                                                              \
+            0x79769f62, 0xe6f29ddc, 0x6f1f74df, 0xea3e779f, 0x05aa3432, \
+            0x6942aee7, 0x243f93b6, 0x09e14c44, 0x81f5dfc4, 0x17cc9c57, \
+            0x27ca60fd, 0x98ae0eec, 0x22be6dfc, 0x4a7b8caf, 0xe8636fcd, \
+            0x3db3f9e9, 0x2f1cb24d, 0xe7ee79d7, 0x0d45c43b, 0xbc2ca650, \
+            0xb98e1473, 0xc53face8, 0x0f5c17ce, 0xa6937a44, 0xe505ae68, \
+            0xe12ad876, 0xf539c9e4, 0xe53378fc, 0x56868f67, 0xc6be7365, \
+            0xda3e68c9, 0x432f3240, 0x2e0843ac, 0x4b611cbc, 0xd42dac87, \
+            0xb45e5138, 0x0449b678, 0x2e860bdc, 0x9f19ada5, 0x7e4520dd, \
+            0xa3a76cf4, 0x6a735c41, 0x4655940f, 0x0c0a5fd0, 0x721b150c, \
+            0x6b6156b6, 0x28cfd26c, 0xe00dce44, 0xe0e0c875, 0xbabbe4c7, \
+            0xdede8e03, 0x29ba2f44, 0xfa8c43fd, 0x8592ce88, 0x2855ca31, \
+            0x7ae65b59, 0x5f5d396d, 0x152127b6, 0xb932c926, 0x499e7c8b, \
+            0x98edc5eb, 0xf6ab5dd6, 0xbc67ab8b, 0xfe334438, 0xda0c82a7, \
+            0x5ff99334, 0x263a4482, 0xc3bfa2ab, 0xf2eba073, 0xb6e5ed74, \
+            0x1e1b6746, 0x4dc59952, 0x0eec41d8, 0xcbd513fe, 0xa0a3bd49, \
+            0xf41aac20, 0x1b6fe504, 0xb64b2d88, 0x71ccc550, 0x296ca228, \
+            0x374aa214, 0x2cdcc365, 0xe8d69bd9, 0x95108428, 0x607dad92, \
+            0xdd08f9df, 0x6435e3a7, 0xdc61a192, 0x98be897b, 0xb4cf66f6, \
+            0x75b7c640, 0x23bbf1b6, 0x1041bc91, 0xef12ccf2, 0x3847102f, \
+            0x1264c753,                                                 \
+        }},                                                             \
   }
 
 #endif  // OPENTITAN_SW_DEVICE_SILICON_CREATOR_ROM_EXT_SIVAL_KEYS_EARLGREY_Z0_SIVAL_1_H_
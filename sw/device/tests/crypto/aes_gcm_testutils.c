@@ -188,7 +188,9 @@ status_t aes_gcm_testutils_encrypt(const aes_gcm_test_t *test, bool streaming,
 
   if (streaming) {
     uint64_t t_start = profile_start();
-    otcrypto_aes_gcm_context_t ctx;
+    // Static, since the context is too large for the stack in some GHASH
+    // configurations.
+    static otcrypto_aes_gcm_context_t ctx;
     TRY(otcrypto_aes_gcm_encrypt_init(&key, iv, &ctx));
     size_t ciphertext_bytes_written;
     TRY(stream_gcm(&ctx, aad, plaintext, actual_ciphertext,
@@ -288,7 +290,9 @@ status_t aes_gcm_testutils_decrypt(const aes_gcm_test_t *test,
   otcrypto_aes_gcm_tag_len_t tag_len = get_tag_length(test->tag_len);
 
   if (streaming) {
-    otcrypto_aes_gcm_context_t ctx;
+    // Static, since the context is too large for the stack in some GHASH
+    // configurations.
+    static otcrypto_aes_gcm_context_t ctx;
     uint64_t t_start = profile_start();
     TRY(otcrypto_aes_gcm_decrypt_init(&key, iv, &ctx));
     size_t plaintext_bytes_written;
@@ -0,0 +1,149 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/crypto/drivers/entropy.h"
+#include "sw/device/lib/crypto/impl/integrity.h"
+#include "sw/device/lib/crypto/impl/keyblob.h"
+#include "sw/device/lib/crypto/include/aes.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/profile.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+// Module ID for status codes.
+#define MODULE_ID MAKE_MODULE_ID('t', 's', 't')
+
+enum {
+  kAesBlockBytes = 128 / 8,
+  kAesBlockWords = kAesBlockBytes / sizeof(uint32_t),
+  /**
+   * Size of the benchmarked buffers, a typical storage blob.
+   */
+  kBenchmarkBytes = 4096,
+  kBenchmarkWords = kBenchmarkBytes / sizeof(uint32_t),
+};
+
+// AES-256 key and random mask for testing.
+static const uint32_t kKey[8] = {
+    0x603deb10, 0x15ca71be, 0x2b73aef0, 0x857d7781,
+    0x1f352c07, 0x3b6108d7, 0x2d9810a3, 0x0914dff4,
+};
+static const uint32_t kKeyMask[8] = {
+    0x1b81540c, 0x220733c9, 0x8bf85383, 0x05ab50b4,
+    0x8acdcb7e, 0x15e76440, 0x8459b2ce, 0xdc2110cc,
+};
+static const uint32_t kIv[kAesBlockWords] = {
+    0xf3f2f1f0,
+    0xf7f6f5f4,
+    0xfbfaf9f8,
+    0xfffefdfc,
+};
+
+// One extra word so that the buffers can also be used misaligned.
+static uint32_t plaintext[kBenchmarkWords + 1];
+static uint32_t ciphertext[kBenchmarkWords + 1];
+static uint32_t recovered[kBenchmarkWords + 1];
+
+/**
+ * Encrypt and decrypt `kBenchmarkBytes` bytes and report cycles per byte.
+ *
+ * @param mode Block cipher mode.
+ * @param key_mode Matching key mode.
+ * @param name Name of the mode, for printing.
+ * @param offset Byte offset of the data in the buffers, to compare the
+ *               word-aligned and misaligned paths.
+ */
+static status_t run_benchmark(otcrypto_aes_mode_t mode,
+                              otcrypto_key_mode_t key_mode, const char *name,
+                              size_t offset) {
+  otcrypto_key_config_t config = {
+      .version = kOtcryptoLibVersion1,
+      .key_mode = key_mode,
+      .key_length = sizeof(kKey),
+      .hw_backed = kHardenedBoolFalse,
+      .security_level = kOtcryptoKeySecurityLevelLow,
+  };
+  uint32_t keyblob[keyblob_num_words(config)];
+  TRY(keyblob_from_key_and_mask(kKey, kKeyMask, config, keyblob));
+  otcrypto_blinded_key_t key = {
+      .config = config,
+      .keyblob_length = sizeof(keyblob),
+      .keyblob = keyblob,
+  };
+  key.checksum = integrity_blinded_checksum(&key);
+
+  uint32_t iv_data[kAesBlockWords];
+  otcrypto_word32_buf_t iv = {
+      .data = iv_data,
+      .len = kAesBlockWords,
+  };
+
+  otcrypto_const_byte_buf_t plaintext_buf = {
+      .data = (const unsigned char *)plaintext + offset,
+      .len = kBenchmarkBytes,
+  };
+  otcrypto_byte_buf_t ciphertext_buf = {
+      .data = (unsigned char *)ciphertext + offset,
+      .len = kBenchmarkBytes,
+  };
+  memcpy(iv_data, kIv, sizeof(kIv));
+  uint64_t t_start = profile_start();
+  TRY(otcrypto_aes(&key, iv, mode, kOtcryptoAesOperationEncrypt,
+                   plaintext_buf, kOtcryptoAesPaddingNull, ciphertext_buf));
+  uint32_t enc_cycles = profile_end(t_start);
+
+  otcrypto_const_byte_buf_t ciphertext_in_buf = {
+      .data = ciphertext_buf.data,
+      .len = kBenchmarkBytes,
+  };
+  otcrypto_byte_buf_t recovered_buf = {
+      .data = (unsigned char *)recovered + offset,
+      .len = kBenchmarkBytes,
+  };
+  memcpy(iv_data, kIv, sizeof(kIv));
+  t_start = profile_start();
+  TRY(otcrypto_aes(&key, iv, mode, kOtcryptoAesOperationDecrypt,
+                   ciphertext_in_buf, kOtcryptoAesPaddingNull,
+                   recovered_buf));
+  uint32_t dec_cycles = profile_end(t_start);
+
+  TRY_CHECK_ARRAYS_EQ(recovered_buf.data, plaintext_buf.data,
+                      kBenchmarkBytes);
+
+  // Print cycles per byte with two decimals.
+  uint32_t enc_cpb = enc_cycles * 100 / kBenchmarkBytes;
+  uint32_t dec_cpb = dec_cycles * 100 / kBenchmarkBytes;
+  LOG_INFO("AES-256-%s (%s): encrypt %u.%02u cycles/byte, decrypt %u.%02u "
+           "cycles/byte",
+           name, offset == 0 ? "aligned" : "misaligned", enc_cpb / 100,
+           enc_cpb % 100, dec_cpb / 100, dec_cpb % 100);
+  return OK_STATUS();
+}
+
+static status_t run_benchmarks(size_t offset) {
+  TRY(run_benchmark(kOtcryptoAesModeEcb, kOtcryptoKeyModeAesEcb, "ECB",
+                    offset));
+  TRY(run_benchmark(kOtcryptoAesModeCbc, kOtcryptoKeyModeAesCbc, "CBC",
+                    offset));
+  TRY(run_benchmark(kOtcryptoAesModeCtr, kOtcryptoKeyModeAesCtr, "CTR",
+                    offset));
+  return OK_STATUS();
+}
+
+OTTF_DEFINE_TEST_CONFIG();
+
+bool test_main(void) {
+  CHECK_STATUS_OK(entropy_complex_init());
+
+  for (size_t i = 0; i < ARRAYSIZE(plaintext); ++i) {
+    plaintext[i] = 0x9e3779b9 * (i + 1);
+  }
+
+  status_t result = OK_STATUS();
+  EXECUTE_TEST(result, run_benchmarks, 0);
+  EXECUTE_TEST(result, run_benchmarks, 1);
+  return status_ok(result);
+}
@@ -28,6 +28,9 @@ status_t process_cmd(ujson_t *uj) {
       case kPenetrationtestCommandCryptoLibFiAsym:
         RESP_ERR(uj, handle_cryptolib_fi_asym(uj));
         break;
+      case kPenetrationtestCommandSetEncoding:
+        RESP_ERR(uj, ujson_ottf_set_encoding(uj));
+        break;
       default:
         LOG_ERROR("Unrecognized command: %d", cmd);
         RESP_ERR(uj, INVALID_ARGUMENT());
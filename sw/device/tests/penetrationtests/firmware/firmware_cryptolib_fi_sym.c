@@ -28,6 +28,9 @@ status_t process_cmd(ujson_t *uj) {
       case kPenetrationtestCommandCryptoLibFiSym:
         RESP_ERR(uj, handle_cryptolib_fi_sym(uj));
         break;
+      case kPenetrationtestCommandSetEncoding:
+        RESP_ERR(uj, ujson_ottf_set_encoding(uj));
+        break;
       default:
         LOG_ERROR("Unrecognized command: %d", cmd);
         RESP_ERR(uj, INVALID_ARGUMENT());
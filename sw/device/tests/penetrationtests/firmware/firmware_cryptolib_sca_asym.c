@@ -34,6 +34,9 @@ status_t process_cmd(ujson_t *uj) {
       case kPenetrationtestCommandPrngSca:
         RESP_ERR(uj, handle_prng_sca(uj));
         break;
+      case kPenetrationtestCommandSetEncoding:
+        RESP_ERR(uj, ujson_ottf_set_encoding(uj));
+        break;
       default:
         LOG_ERROR("Unrecognized command: %d", cmd);
         RESP_ERR(uj, INVALID_ARGUMENT());
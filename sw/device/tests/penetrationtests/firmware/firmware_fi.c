@@ -61,6 +61,9 @@ status_t process_cmd(ujson_t *uj) {
       case kPenetrationtestCommandAlertFi:
         RESP_ERR(uj, handle_alert_fi(uj));
         break;
+      case kPenetrationtestCommandSetEncoding:
+        RESP_ERR(uj, ujson_ottf_set_encoding(uj));
+        break;
       default:
         LOG_ERROR("Unrecognized command: %d", cmd);
         RESP_ERR(uj, INVALID_ARGUMENT());
@@ -32,6 +32,9 @@ status_t process_cmd(ujson_t *uj) {
       case kPenetrationtestCommandAlertInfo:
         RESP_ERR(uj, pentest_read_rstmgr_alert_info(uj));
         break;
+      case kPenetrationtestCommandSetEncoding:
+        RESP_ERR(uj, ujson_ottf_set_encoding(uj));
+        break;
       default:
         LOG_ERROR("Unrecognized command: %d", cmd);
         RESP_ERR(uj, INVALID_ARGUMENT());
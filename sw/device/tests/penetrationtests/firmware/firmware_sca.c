@@ -76,6 +76,9 @@ status_t process_cmd(ujson_t *uj) {
       case kPenetrationtestCommandTriggerSca:
         RESP_ERR(uj, handle_trigger_sca(uj));
         break;
+      case kPenetrationtestCommandSetEncoding:
+        RESP_ERR(uj, ujson_ottf_set_encoding(uj));
+        break;
       default:
         LOG_ERROR("Unrecognized command: %d", cmd);
         RESP_ERR(uj, INVALID_ARGUMENT());
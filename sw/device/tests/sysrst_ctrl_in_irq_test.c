@@ -219,7 +219,7 @@ void ottf_external_isr(uint32_t *exc_info) {
 
   switch (peripheral) {
     case kTopEarlgreyPlicPeripheralUart0:
-      if (!ottf_console_flow_control_isr(exc_info)) {
+      if (!ottf_console_flow_control_isr(exc_info, plic_irq_id)) {
         goto unexpected_irq;
       };
       break;
@@ -5,12 +5,14 @@ use anyhow::Result;
 use crc::{CRC_32_ISO_HDLC, Crc};
 use serde::Serialize;
 use serde::de::DeserializeOwned;
-use std::time::Duration;
+use std::io::Read;
+use std::time::{Duration, Instant};
 
 use crate::io::console::ext::{PassFail, PassFailResult};
 use crate::io::console::{ConsoleDevice, ConsoleError, ConsoleExt};
 use crate::regex;
 use crate::test_utils::status::Status;
+use crate::test_utils::ujson_bin;
 
 // Bring in the auto-generated sources.
 include!(env!("ottf"));
@@ -21,6 +23,11 @@ where
 {
     fn send(&self, device: &T) -> Result<String>;
     fn send_with_crc(&self, device: &T) -> Result<String>;
+
+    /// Sends in the binary encoding, which the device must have been switched
+    /// to with `OttfEncoding::Binary` (see `ujson_ottf_set_encoding`).
+    fn send_binary(&self, device: &T) -> Result<Vec<u8>>;
+    fn send_binary_with_crc(&self, device: &T) -> Result<Vec<u8>>;
 }
 
 impl<T, U> ConsoleSend<T> for U
@@ -45,6 +52,22 @@ where
         let crc_s = actual_crc.send(device)?;
         Ok(s + &crc_s)
     }
+
+    fn send_binary(&self, device: &T) -> Result<Vec<u8>> {
+        let bytes = ujson_bin::to_vec(self)?;
+        log::info!("Sending: {:02x?}", bytes);
+        device.write(&bytes)?;
+        Ok(bytes)
+    }
+
+    fn send_binary_with_crc(&self, device: &T) -> Result<Vec<u8>> {
+        let mut bytes = self.send_binary(device)?;
+        let actual_crc = OttfCrc {
+            crc: Crc::<u32>::new(&CRC_32_ISO_HDLC).checksum(&bytes),
+        };
+        bytes.extend(actual_crc.send_binary(device)?);
+        Ok(bytes)
+    }
 }
 
 pub trait ConsoleRecv<T>
@@ -54,6 +77,12 @@ where
     fn recv(device: &T, timeout: Duration, quiet: bool) -> Result<Self>
     where
         Self: Sized;
+
+    /// Receives a response in the binary encoding.  Console output before the
+    /// `RESP_OK:` or `RESP_ERR:` marker is logged unless `quiet` is set.
+    fn recv_binary(device: &T, timeout: Duration, quiet: bool) -> Result<Self>
+    where
+        Self: Sized;
 }
 
 impl<T, U> ConsoleRecv<T> for U
@@ -89,6 +118,95 @@ where
             }
         }
     }
+
+    fn recv_binary(device: &T, timeout: Duration, quiet: bool) -> Result<Self>
+    where
+        Self: Sized,
+    {
+        let deadline = Instant::now() + timeout;
+        // Only the text before the marker is logged, the message is binary.
+        let ok = {
+            let logged = device.logged();
+            let console: &dyn ConsoleDevice = if quiet { &device } else { &logged };
+            BinaryReader {
+                device: console,
+                deadline,
+                received: Vec::new(),
+            }
+            .find_marker()?
+        };
+        let mut reader = BinaryReader {
+            device,
+            deadline,
+            received: Vec::new(),
+        };
+        if ok {
+            let value = ujson_bin::from_reader::<Self, _>(&mut reader)?;
+            reader.check_crc()?;
+            Ok(value)
+        } else {
+            let status = ujson_bin::from_reader::<Status, _>(&mut reader)?;
+            reader.check_crc()?;
+            Err(status)?
+        }
+    }
+}
+
+/// Reads the console until a deadline, keeping everything it has read.
+struct BinaryReader<'a, T: ConsoleDevice + ?Sized> {
+    device: &'a T,
+    deadline: Instant,
+    received: Vec<u8>,
+}
+
+impl<T: ConsoleDevice + ?Sized> BinaryReader<'_, T> {
+    /// Skips to the end of the next `RESP_OK:` (true) or `RESP_ERR:` (false).
+    fn find_marker(&mut self) -> Result<bool> {
+        let mut ch = 0u8;
+        loop {
+            self.read_exact(std::slice::from_mut(&mut ch))?;
+            if self.received.ends_with(b"RESP_OK:") {
+                return Ok(true);
+            }
+            if self.received.ends_with(b"RESP_ERR:") {
+                return Ok(false);
+            }
+            if ch == b'\n' {
+                self.received.clear();
+            }
+        }
+    }
+
+    /// Checks the CRC that follows the message against the message bytes.
+    fn check_crc(&mut self) -> Result<()> {
+        let actual_crc = Crc::<u32>::new(&CRC_32_ISO_HDLC).checksum(&self.received);
+        let crc = ujson_bin::from_reader::<OttfCrc, _>(&mut *self)?.crc;
+        if crc != actual_crc {
+            return Err(ConsoleError::GenericError(
+                "CRC didn't match received binary body.".into(),
+            )
+            .into());
+        }
+        Ok(())
+    }
+}
+
+impl<T: ConsoleDevice + ?Sized> Read for BinaryReader<'_, T> {
+    fn read(&mut self, buf: &mut [u8]) -> std::io::Result<usize> {
+        let timeout = self.deadline.saturating_duration_since(Instant::now());
+        let len = self
+            .device
+            .read_timeout(buf, timeout)
+            .map_err(std::io::Error::other)?;
+        if len == 0 {
+            return Err(std::io::Error::new(
+                std::io::ErrorKind::TimedOut,
+                ConsoleError::TimedOut,
+            ));
+        }
+        self.received.extend_from_slice(&buf[..len]);
+        Ok(len)
+    }
 }
 
 fn check_crc(json_str: &str, crc_str: &str) -> Result<()> {
@@ -0,0 +1,706 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+//! The binary ujson wire encoding (`kUjsonEncodingBinary` in
+//! `sw/device/lib/ujson/ujson.h`) for the types generated by `ujson_rust`.
+//!
+//! - Integers are fixed-width little-endian; `usize` is always 8 bytes.
+//! - `bool` is a single byte, 0 or 1.
+//! - `String` is a 16-bit length followed by the bytes.
+//! - Structs are their fields in declaration order.
+//! - Sequences (`ArrayVec`) are a 16-bit element count followed by the
+//!   elements.
+//! - Enums are the 32-bit variant index followed by the variant's fields, which
+//!   is also how the C side encodes an `IntValue(u32)`.
+//! - [`Status`] is the raw 32-bit `status_t`.
+//!
+//! Types that rely on a self-describing format, such as `with_unknown!` enums,
+//! options and maps, are not supported.
+//!
+//! [`Status`]: crate::test_utils::status::Status
+
+use serde::de::{self, DeserializeOwned};
+use serde::ser::Serializer as _;
+use serde::{Serialize, ser};
+use std::fmt::Display;
+use std::io::Read;
+use thiserror::Error;
+
+#[derive(Debug, Error)]
+pub enum Error {
+    #[error("{0}")]
+    Message(String),
+    #[error(transparent)]
+    Io(#[from] std::io::Error),
+    #[error("{0} is not supported by the binary encoding")]
+    Unsupported(&'static str),
+    #[error("Invalid bool byte {0:#x}")]
+    InvalidBool(u8),
+    #[error("Length {0} does not fit the 16-bit length prefix")]
+    Length(usize),
+    #[error("Invalid status_t {0:#010x}")]
+    InvalidStatus(u32),
+    #[error("{0} trailing bytes after the message")]
+    TrailingBytes(usize),
+}
+
+impl ser::Error for Error {
+    fn custom<T: Display>(msg: T) -> Self {
+        Error::Message(msg.to_string())
+    }
+}
+
+impl de::Error for Error {
+    fn custom<T: Display>(msg: T) -> Self {
+        Error::Message(msg.to_string())
+    }
+}
+
+type Result<T> = std::result::Result<T, Error>;
+
+// The serde name of `test_utils::status::Status`, which is sent as a raw
+// `status_t` rather than as an enum.
+const STATUS: &str = "Status";
+const STATUS_ERROR_BIT: u32 = 1 << 31;
+
+/// Serializes `value` in the binary encoding.
+pub fn to_vec<T: Serialize + ?Sized>(value: &T) -> Result<Vec<u8>> {
+    let mut serializer = Serializer::default();
+    value.serialize(&mut serializer)?;
+    Ok(serializer.output)
+}
+
+/// Deserializes a value in the binary encoding from `reader`, reading exactly
+/// the bytes that make up the value.
+pub fn from_reader<T: DeserializeOwned, R: Read>(reader: R) -> Result<T> {
+    T::deserialize(&mut Deserializer::new(reader))
+}
+
+/// Deserializes a value in the binary encoding that makes up all of `bytes`.
+pub fn from_slice<T: DeserializeOwned>(mut bytes: &[u8]) -> Result<T> {
+    let value = from_reader(&mut bytes)?;
+    match bytes.len() {
+        0 => Ok(value),
+        n => Err(Error::TrailingBytes(n)),
+    }
+}
+
+#[derive(Default)]
+pub struct Serializer {
+    output: Vec<u8>,
+}
+
+impl Serializer {
+    fn put_length(&mut self, len: usize) -> Result<()> {
+        let len = u16::try_from(len).map_err(|_| Error::Length(len))?;
+        self.output.extend_from_slice(&len.to_le_bytes());
+        Ok(())
+    }
+}
+
+impl<'a> ser::Serializer for &'a mut Serializer {
+    type Ok = ();
+    type Error = Error;
+    type SerializeSeq = Self;
+    type SerializeTuple = Self;
+    type SerializeTupleStruct = Self;
+    type SerializeTupleVariant = TupleVariant<'a>;
+    type SerializeMap = ser::Impossible<(), Error>;
+    type SerializeStruct = Self;
+    type SerializeStructVariant = Self;
+
+    fn serialize_bool(self, v: bool) -> Result<()> {
+        self.output.push(v.into());
+        Ok(())
+    }
+    fn serialize_i8(self, v: i8) -> Result<()> {
+        self.output.extend_from_slice(&v.to_le_bytes());
+        Ok(())
+    }
+    fn serialize_i16(self, v: i16) -> Result<()> {
+        self.output.extend_from_slice(&v.to_le_bytes());
+        Ok(())
+    }
+    fn serialize_i32(self, v: i32) -> Result<()> {
+        self.output.extend_from_slice(&v.to_le_bytes());
+        Ok(())
+    }
+    fn serialize_i64(self, v: i64) -> Result<()> {
+        self.output.extend_from_slice(&v.to_le_bytes());
+        Ok(())
+    }
+    fn serialize_u8(self, v: u8) -> Result<()> {
+        self.output.push(v);
+        Ok(())
+    }
+    fn serialize_u16(self, v: u16) -> Result<()> {
+        self.output.extend_from_slice(&v.to_le_bytes());
+        Ok(())
+    }
+    fn serialize_u32(self, v: u32) -> Result<()> {
+        self.output.extend_from_slice(&v.to_le_bytes());
+        Ok(())
+    }
+    fn serialize_u64(self, v: u64) -> Result<()> {
+        self.output.extend_from_slice(&v.to_le_bytes());
+        Ok(())
+    }
+    fn serialize_f32(self, _v: f32) -> Result<()> {
+        Err(Error::Unsupported("f32"))
+    }
+    fn serialize_f64(self, _v: f64) -> Result<()> {
+        Err(Error::Unsupported("f64"))
+    }
+    fn serialize_char(self, _v: char) -> Result<()> {
+        Err(Error::Unsupported("char"))
+    }
+    fn serialize_str(self, v: &str) -> Result<()> {
+        self.serialize_bytes(v.as_bytes())
+    }
+    fn serialize_bytes(self, v: &[u8]) -> Result<()> {
+        self.put_length(v.len())?;
+        self.output.extend_from_slice(v);
+        Ok(())
+    }
+    fn serialize_none(self) -> Result<()> {
+        Err(Error::Unsupported("Option"))
+    }
+    fn serialize_some<T: Serialize + ?Sized>(self, _value: &T) -> Result<()> {
+        Err(Error::Unsupported("Option"))
+    }
+    fn serialize_unit(self) -> Result<()> {
+        Ok(())
+    }
+    fn serialize_unit_struct(self, _name: &'static str) -> Result<()> {
+        Ok(())
+    }
+    fn serialize_unit_variant(
+        self,
+        _name: &'static str,
+        variant_index: u32,
+        _variant: &'static str,
+    ) -> Result<()> {
+        self.serialize_u32(variant_index)
+    }
+    fn serialize_newtype_struct<T: Serialize + ?Sized>(
+        self,
+        _name: &'static str,
+        value: &T,
+    ) -> Result<()> {
+        value.serialize(self)
+    }
+    fn serialize_newtype_variant<T: Serialize + ?Sized>(
+        self,
+        name: &'static str,
+        variant_index: u32,
+        _variant: &'static str,
+        value: &T,
+    ) -> Result<()> {
+        if name == STATUS {
+            // `Status::Ok(value)`.
+            let value = u32::from_le_bytes(
+                to_vec(value)?
+                    .try_into()
+                    .map_err(|_| Error::Unsupported("this Status"))?,
+            );
+            if variant_index != 0 || value & STATUS_ERROR_BIT != 0 {
+                return Err(Error::InvalidStatus(value));
+            }
+            return self.serialize_u32(value);
+        }
+        self.serialize_u32(variant_index)?;
+        value.serialize(self)
+    }
+    fn serialize_seq(self, len: Option<usize>) -> Result<Self> {
+        self.put_length(len.ok_or(Error::Unsupported("sequence of unknown length"))?)?;
+        Ok(self)
+    }
+    fn serialize_tuple(self, _len: usize) -> Result<Self> {
+        Ok(self)
+    }
+    fn serialize_tuple_struct(self, _name: &'static str, _len: usize) -> Result<Self> {
+        Ok(self)
+    }
+    fn serialize_tuple_variant(
+        self,
+        name: &'static str,
+        variant_index: u32,
+        _variant: &'static str,
+        _len: usize,
+    ) -> Result<TupleVariant<'a>> {
+        if name == STATUS {
+            // `Status::<Error>(module, line)`.
+            return Ok(TupleVariant::Status {
+                output: self,
+                code: variant_index,
+                fields: Serializer::default(),
+            });
+        }
+        self.serialize_u32(variant_index)?;
+        Ok(TupleVariant::Enum(self))
+    }
+    fn serialize_map(self, _len: Option<usize>) -> Result<Self::SerializeMap> {
+        Err(Error::Unsupported("map"))
+    }
+    fn serialize_struct(self, _name: &'static str, _len: usize) -> Result<Self> {
+        Ok(self)
+    }
+    fn serialize_struct_variant(
+        self,
+        _name: &'static str,
+        variant_index: u32,
+        _variant: &'static str,
+        _len: usize,
+    ) -> Result<Self> {
+        self.serialize_u32(variant_index)?;
+        Ok(self)
+    }
+    fn is_human_readable(&self) -> bool {
+        false
+    }
+}
+
+impl ser::SerializeSeq for &mut Serializer {
+    type Ok = ();
+    type Error = Error;
+    fn serialize_element<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<()> {
+        value.serialize(&mut **self)
+    }
+    fn end(self) -> Result<()> {
+        Ok(())
+    }
+}
+
+impl ser::SerializeTuple for &mut Serializer {
+    type Ok = ();
+    type Error = Error;
+    fn serialize_element<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<()> {
+        value.serialize(&mut **self)
+    }
+    fn end(self) -> Result<()> {
+        Ok(())
+    }
+}
+
+impl ser::SerializeTupleStruct for &mut Serializer {
+    type Ok = ();
+    type Error = Error;
+    fn serialize_field<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<()> {
+        value.serialize(&mut **self)
+    }
+    fn end(self) -> Result<()> {
+        Ok(())
+    }
+}
+
+impl ser::SerializeStruct for &mut Serializer {
+    type Ok = ();
+    type Error = Error;
+    fn serialize_field<T: Serialize + ?Sized>(
+        &mut self,
+        _key: &'static str,
+        value: &T,
+    ) -> Result<()> {
+        value.serialize(&mut **self)
+    }
+    fn end(self) -> Result<()> {
+        Ok(())
+    }
+}
+
+impl ser::SerializeStructVariant for &mut Serializer {
+    type Ok = ();
+    type Error = Error;
+    fn serialize_field<T: Serialize + ?Sized>(
+        &mut self,
+        _key: &'static str,
+        value: &T,
+    ) -> Result<()> {
+        value.serialize(&mut **self)
+    }
+    fn end(self) -> Result<()> {
+        Ok(())
+    }
+}
+
+pub enum TupleVariant<'a> {
+    Enum(&'a mut Serializer),
+    /// Collects the module and line of an error `Status` to pack them into a
+    /// `status_t`.
+    Status {
+        output: &'a mut Serializer,
+        code: u32,
+        fields: Serializer,
+    },
+}
+
+impl ser::SerializeTupleVariant for TupleVariant<'_> {
+    type Ok = ();
+    type Error = Error;
+    fn serialize_field<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<()> {
+        match self {
+            TupleVariant::Enum(output) => value.serialize(&mut **output),
+            TupleVariant::Status { fields, .. } => value.serialize(fields),
+        }
+    }
+    fn end(self) -> Result<()> {
+        let TupleVariant::Status {
+            output,
+            code,
+            fields,
+        } = self
+        else {
+            return Ok(());
+        };
+        let (module, line): (String, u32) = from_slice(&fields.output)?;
+        // See `MAKE_MODULE_ID` in `sw/device/lib/base/internal/status.h`.
+        let module = (0..3).fold(0, |id, i| {
+            let ch = module.as_bytes().get(i).copied().unwrap_or(0);
+            let ch = match ch {
+                b'@'..=b'_' => ch - b'@',
+                b'`'..=b'z' => ch - b'`',
+                _ => b'_' - b'@',
+            };
+            id | u32::from(ch) << (5 * i)
+        });
+        let line = line & 0x7ff;
+        output.serialize_u32(STATUS_ERROR_BIT | module << 16 | line << 5 | code)
+    }
+}
+
+pub struct Deserializer<R> {
+    reader: R,
+}
+
+impl<R: Read> Deserializer<R> {
+    pub fn new(reader: R) -> Self {
+        Deserializer { reader }
+    }
+
+    fn get<const N: usize>(&mut self) -> Result<[u8; N]> {
+        let mut buf = [0u8; N];
+        self.reader.read_exact(&mut buf)?;
+        Ok(buf)
+    }
+
+    fn get_length(&mut self) -> Result<usize> {
+        Ok(u16::from_le_bytes(self.get()?).into())
+    }
+
+    fn get_bytes(&mut self) -> Result<Vec<u8>> {
+        let mut buf = vec![0u8; self.get_length()?];
+        self.reader.read_exact(&mut buf)?;
+        Ok(buf)
+    }
+}
+
+// Rewrites a raw `status_t` into the binary encoding of the `Status` enum.
+fn status_to_enum(status: u32) -> Result<Vec<u8>> {
+    let mut serializer = Serializer::default();
+    if status & STATUS_ERROR_BIT == 0 {
+        ser::Serializer::serialize_newtype_variant(&mut serializer, "", 0, "Ok", &status)?;
+        return Ok(serializer.output);
+    }
+    let code = status & 0x1f;
+    if code == 0 {
+        return Err(Error::InvalidStatus(status));
+    }
+    let module = (0..3)
+        .map(|i| char::from(b'@' + (status >> (16 + 5 * i) & 0x1f) as u8))
+        .collect::<String>();
+    let line = status >> 5 & 0x7ff;
+    serializer.serialize_u32(code)?;
+    (module, line).serialize(&mut serializer)?;
+    Ok(serializer.output)
+}
+
+impl<'de, R: Read> de::Deserializer<'de> for &mut Deserializer<R> {
+    type Error = Error;
+
+    fn deserialize_any<V: de::Visitor<'de>>(self, _visitor: V) -> Result<V::Value> {
+        Err(Error::Unsupported("self-describing type"))
+    }
+    fn deserialize_bool<V: de::Visitor<'de>>(self, visitor: V) -> Result<V::Value> {
+        match self.get::<1>()?[0] {
+            0 => visitor.visit_bool(false),
+            1 => visitor.visit_bool(true),
+            b => Err(Error::InvalidBool(b)),
+        }
+    }
+    fn deserialize_i8<V: de::Visitor<'de>>(self, visitor: V) -> Result<V::Value> {
+        visitor.visit_i8(i8::from_le_bytes(self.get()?))
+    }
+    fn deserialize_i16<V: de::Visitor<'de>>(self, visitor: V) -> Result<V::Value> {
+        visitor.visit_i16(i16::from_le_bytes(self.get()?))
+    }
+    fn deserialize_i32<V: de::Visitor<'de>>(self, visitor: V) -> Result<V::Value> {
+        visitor.visit_i32(i32::from_le_bytes(self.get()?))
+    }
+    fn deserialize_i64<V: de::Visitor<'de>>(self, visitor: V) -> Result<V::Value> {
+        visitor.visit_i64(i64::from_le_bytes(self.get()?))
+    }
+    fn deserialize_u8<V: de::Visitor<'de>>(self, visitor: V) -> Result<V::Value> {
+        visitor.visit_u8(u8::from_le_bytes(self.get()?))
+    }
+    fn deserialize_u16<V: de::Visitor<'de>>(self, visitor: V) -> Result<V::Value> {
+        visitor.visit_u16(u16::from_le_bytes(self.get()?))
+    }
+    fn deserialize_u32<V: de::Visitor<'de>>(self, visitor: V) -> Result<V::Value> {
+        visitor.visit_u32(u32::from_le_bytes(self.get()?))
+    }
+    fn deserialize_u64<V: de::Visitor<'de>>(self, visitor: V) -> Result<V::Value> {
+        visitor.visit_u64(u64::from_le_bytes(self.get()?))
+    }
+    fn deserialize_f32<V: de::Visitor<'de>>(self, _visitor: V) -> Result<V::Value> {
+        Err(Error::Unsupported("f32"))
+    }
+    fn deserialize_f64<V: de::Visitor<'de>>(self, _visitor: V) -> Result<V::Value> {
+        Err(Error::Unsupported("f64"))
+    }
+    fn deserialize_char<V: de::Visitor<'de>>(self, _visitor: V) -> Result<V::Value> {
+        Err(Error::Unsupported("char"))
+    }
+    fn deserialize_str<V: de::Visitor<'de>>(self, visitor: V) -> Result<V::Value> {
+        self.deserialize_string(visitor)
+    }
+    fn deserialize_string<V: de::Visitor<'de>>(self, visitor: V) -> Result<V::Value> {
+        let bytes = self.get_bytes()?;
+        visitor.visit_string(String::from_utf8(bytes).map_err(|e| Error::Message(e.to_string()))?)
+    }
+    fn deserialize_bytes<V: de::Visitor<'de>>(self, visitor: V) -> Result<V::Value> {
+        self.deserialize_byte_buf(visitor)
+    }
+    fn deserialize_byte_buf<V: de::Visitor<'de>>(self, visitor: V) -> Result<V::Value> {
+        visitor.visit_byte_buf(self.get_bytes()?)
+    }
+    fn deserialize_option<V: de::Visitor<'de>>(self, _visitor: V) -> Result<V::Value> {
+        Err(Error::Unsupported("Option"))
+    }
+    fn deserialize_unit<V: de::Visitor<'de>>(self, visitor: V) -> Result<V::Value> {
+        visitor.visit_unit()
+    }
+    fn deserialize_unit_struct<V: de::Visitor<'de>>(
+        self,
+        _name: &'static str,
+        visitor: V,
+    ) -> Result<V::Value> {
+        visitor.visit_unit()
+    }
+    fn deserialize_newtype_struct<V: de::Visitor<'de>>(
+        self,
+        _name: &'static str,
+        visitor: V,
+    ) -> Result<V::Value> {
+        visitor.visit_newtype_struct(self)
+    }
+    fn deserialize_seq<V: de::Visitor<'de>>(self, visitor: V) -> Result<V::Value> {
+        let len = self.get_length()?;
+        self.deserialize_tuple(len, visitor)
+    }
+    fn deserialize_tuple<V: de::Visitor<'de>>(self, len: usize, visitor: V) -> Result<V::Value> {
+        visitor.visit_seq(Elements {
+            de: self,
+            remaining: len,
+        })
+    }
+    fn deserialize_tuple_struct<V: de::Visitor<'de>>(
+        self,
+        _name: &'static str,
+        len: usize,
+        visitor: V,
+    ) -> Result<V::Value> {
+        self.deserialize_tuple(len, visitor)
+    }
+    fn deserialize_map<V: de::Visitor<'de>>(self, _visitor: V) -> Result<V::Value> {
+        Err(Error::Unsupported("map"))
+    }
+    fn deserialize_struct<V: de::Visitor<'de>>(
+        self,
+        _name: &'static str,
+        fields: &'static [&'static str],
+        visitor: V,
+    ) -> Result<V::Value> {
+        self.deserialize_tuple(fields.len(), visitor)
+    }
+    fn deserialize_enum<V: de::Visitor<'de>>(
+        self,
+        name: &'static str,
+        _variants: &'static [&'static str],
+        visitor: V,
+    ) -> Result<V::Value> {
+        if name == STATUS {
+            let status = u32::from_le_bytes(self.get()?);
+            let bytes = status_to_enum(status)?;
+            return visitor.visit_enum(&mut Deserializer::new(bytes.as_slice()));
+        }
+        visitor.visit_enum(self)
+    }
+    fn deserialize_identifier<V: de::Visitor<'de>>(self, _visitor: V) -> Result<V::Value> {
+        Err(Error::Unsupported("identifier"))
+    }
+    fn deserialize_ignored_any<V: de::Visitor<'de>>(self, _visitor: V) -> Result<V::Value> {
+        Err(Error::Unsupported("ignored value"))
+    }
+    fn is_human_readable(&self) -> bool {
+        false
+    }
+}
+
+struct Elements<'a, R> {
+    de: &'a mut Deserializer<R>,
+    remaining: usize,
+}
+
+impl<'de, R: Read> de::SeqAccess<'de> for Elements<'_, R> {
+    type Error = Error;
+    fn next_element_seed<T: de::DeserializeSeed<'de>>(
+        &mut self,
+        seed: T,
+    ) -> Result<Option<T::Value>> {
+        if self.remaining == 0 {
+            return Ok(None);
+        }
+        self.remaining -= 1;
+        seed.deserialize(&mut *self.de).map(Some)
+    }
+    fn size_hint(&self) -> Option<usize> {
+        Some(self.remaining)
+    }
+}
+
+impl<'de, R: Read> de::EnumAccess<'de> for &mut Deserializer<R> {
+    type Error = Error;
+    type Variant = Self;
+    fn variant_seed<V: de::DeserializeSeed<'de>>(self, seed: V) -> Result<(V::Value, Self)> {
+        let index = u32::from_le_bytes(self.get()?);
+        let variant = seed.deserialize(de::value::U32Deserializer::<Error>::new(index))?;
+        Ok((variant, self))
+    }
+}
+
+impl<'de, R: Read> de::VariantAccess<'de> for &mut Deserializer<R> {
+    type Error = Error;
+    fn unit_variant(self) -> Result<()> {
+        Ok(())
+    }
+    fn newtype_variant_seed<T: de::DeserializeSeed<'de>>(self, seed: T) -> Result<T::Value> {
+        seed.deserialize(self)
+    }
+    fn tuple_variant<V: de::Visitor<'de>>(self, len: usize, visitor: V) -> Result<V::Value> {
+        de::Deserializer::deserialize_tuple(self, len, visitor)
+    }
+    fn struct_variant<V: de::Visitor<'de>>(
+        self,
+        fields: &'static [&'static str],
+        visitor: V,
+    ) -> Result<V::Value> {
+        de::Deserializer::deserialize_tuple(self, fields.len(), visitor)
+    }
+}
+
+#[cfg(test)]
+mod test {
+    use super::*;
+    use crate::test_utils::status::Status;
+    use serde::Deserialize;
+
+    #[derive(Debug, PartialEq, Serialize, Deserialize)]
+    struct Foo {
+        foo: i32,
+        bar: u32,
+        message: String,
+    }
+
+    #[derive(Debug, PartialEq, Serialize, Deserialize)]
+    #[repr(u32)]
+    enum Direction {
+        North,
+        East,
+        South,
+        West,
+        IntValue(u32),
+    }
+
+    #[derive(Debug, PartialEq, Serialize, Deserialize)]
+    struct Blob {
+        id: u16,
+        data: Vec<Vec<u8>>,
+        flags: Vec<bool>,
+        names: Vec<String>,
+    }
+
+    // The byte layouts below match `sw/device/lib/ujson/example_test.cc`.
+    #[test]
+    fn test_foo() -> anyhow::Result<()> {
+        let foo = Foo {
+            foo: -5,
+            bar: 150000,
+            message: "Kilroy".into(),
+        };
+        let bytes = to_vec(&foo)?;
+        assert_eq!(bytes, b"\xfb\xff\xff\xff\xf0\x49\x02\x00\x06\x00Kilroy");
+        assert_eq!(from_slice::<Foo>(&bytes)?, foo);
+        assert!(from_slice::<Foo>(&bytes[..6]).is_err());
+        Ok(())
+    }
+
+    #[test]
+    fn test_enum() -> anyhow::Result<()> {
+        for (value, bytes) in [
+            (Direction::North, &b"\x00\x00\x00\x00"[..]),
+            (Direction::West, b"\x03\x00\x00\x00"),
+            (
+                Direction::IntValue(120),
+                b"\x04\x00\x00\x00\x78\x00\x00\x00",
+            ),
+        ] {
+            assert_eq!(to_vec(&value)?, bytes);
+            assert_eq!(from_slice::<Direction>(bytes)?, value);
+        }
+        assert!(from_slice::<Direction>(b"\x05\x00\x00\x00").is_err());
+        Ok(())
+    }
+
+    #[test]
+    fn test_blob() -> anyhow::Result<()> {
+        let blob = Blob {
+            id: 0x1234,
+            data: vec![vec![1, 2, 3], vec![4, 5, 6]],
+            flags: vec![true, false],
+            names: vec!["ab".into(), "cde".into()],
+        };
+        let bytes = to_vec(&blob)?;
+        assert_eq!(
+            bytes,
+            b"\x34\x12\x02\x00\x03\x00\x01\x02\x03\x03\x00\x04\x05\x06\
+              \x02\x00\x01\x00\x02\x00\x02\x00ab\x03\x00cde"
+        );
+        assert_eq!(from_slice::<Blob>(&bytes)?, blob);
+        Ok(())
+    }
+
+    #[test]
+    fn test_bad_bool() {
+        let result = from_slice::<Blob>(b"\x34\x12\x00\x00\x02\x00\x01\x02");
+        assert!(matches!(result, Err(Error::InvalidBool(2))));
+    }
+
+    #[test]
+    fn test_status() -> anyhow::Result<()> {
+        for (status, raw) in [
+            (Status::Ok(5), 0x0000_0005u32),
+            // INVALID_ARGUMENT() at line 5 of a module "FOO".
+            (
+                Status::InvalidArgument("FOO".into(), 5),
+                0x8000_0000 | (6 | 15 << 5 | 15 << 10) << 16 | 5 << 5 | 3,
+            ),
+        ] {
+            assert_eq!(to_vec(&status)?, raw.to_le_bytes());
+            assert_eq!(from_slice::<Status>(&raw.to_le_bytes())?, status);
+        }
+        // The error bit without an error code.
+        assert!(from_slice::<Status>(&0x8000_0000u32.to_le_bytes()).is_err());
+        Ok(())
+    }
+}
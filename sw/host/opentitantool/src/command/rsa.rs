@@ -226,6 +226,10 @@ impl CommandDispatch for RsaKeyExportCommand {
         writeln!(&mut file, "    .n0_inv = {{ \\")?;
         write_bigint_as_u32(&mut file, key.n0_inv()?.to_le_bytes(), 4, "        ", "\\")?;
         writeln!(&mut file, "        }}, \\")?;
+        writeln!(&mut file, "    .rr = \\")?;
+        writeln!(&mut file, "        {{{{ \\")?;
+        write_bigint_as_u32(&mut file, key.rr().to_le_bytes(), 5, "            ", "\\")?;
+        writeln!(&mut file, "        }}}}, \\")?;
         writeln!(&mut file, " }}")?;
         writeln!(&mut file)?;
         writeln!(&mut file, "#endif // {}", header_guard)?;
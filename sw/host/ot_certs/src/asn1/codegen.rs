@@ -54,8 +54,8 @@ struct CodeChunkWithComment {
 
 #[derive(Clone, Debug, PartialEq, Eq)]
 enum CodeChunk {
-    // A code snippet.
-    Code(String),
+    // A code snippet, with the number of bytes it outputs if that is fixed.
+    Code(String, Option<usize>),
     // If all the arguments are constants, derive its resulting bytes directly.
     ConstBytes(Vec<u8>),
     // Patch the last two bytes with length delta.
@@ -69,7 +69,7 @@ enum CodeChunk {
 impl CodeChunk {
     fn is_constant(&self) -> bool {
         match self {
-            CodeChunk::Code(_) => false,
+            CodeChunk::Code(..) => false,
             CodeChunk::ConstBytes(_) => true,
             CodeChunk::SizePatchMemo(_) => true,
             CodeChunk::OpenBlock => true,
@@ -78,7 +78,7 @@ impl CodeChunk {
     }
     fn len(&self) -> usize {
         match self {
-            CodeChunk::Code(_) => panic!("Variable has no size"),
+            CodeChunk::Code(..) => panic!("Variable has no size"),
             CodeChunk::ConstBytes(x) => x.len(),
             _ => 0,
         }
@@ -105,12 +105,18 @@ pub struct CodegenOutput {
     pub min_size: usize,
     /// Maximum size of the produced cert/TBS.
     pub max_size: usize,
+    /// Streaming version of `code` when the output has a fixed size and `code`
+    /// patches a pre-generated skeleton instead; both produce the same bytes.
+    pub reference_code: Option<String>,
 }
 
 impl Codegen<'_> {
     /// Generate code that corresponds to an ASN1 document described by a closure acting on a Builder.
     /// Returns the generated code and the min/max possible size of the output.
     ///
+    /// When the output has a fixed size, every field lands at a fixed offset and the generated
+    /// code copies a constant skeleton of the whole output before patching the variable fields.
+    ///
     /// # Arguments
     ///
     /// * `buf_name` - Name of the variable holding the pointer to the output buffer.
@@ -132,12 +138,31 @@ impl Codegen<'_> {
         };
         build(&mut builder)?;
 
+        let stream_code = builder.generate_stream(buf_name, buf_size_name);
+        let (code, reference_code) = if builder.min_out_size == builder.max_out_size {
+            let patch_code = builder.generate_patch(buf_name, buf_size_name)?;
+            (patch_code, Some(stream_code))
+        } else {
+            (stream_code, None)
+        };
+
+        Ok(CodegenOutput {
+            code,
+            min_size: builder.min_out_size,
+            max_size: builder.max_out_size,
+            reference_code,
+        })
+    }
+
+    /// Generate code that outputs the chunks in order, copying the constant
+    /// segments from a shared pool and patching the var-sized lengths.
+    fn generate_stream(&self, buf_name: &str, buf_size_name: &str) -> String {
         let mut output = String::new();
         let mut const_bytes = Vec::<u8>::new();
         let mut size_patches = Vec::<(usize, i16)>::new();
 
         // For neighboring const chunks, we collect them into a single array and write them at once.
-        for (is_code, chunk) in &builder
+        for (is_code, chunk) in &self
             .output
             .iter()
             .chunk_by(|inst| !inst.code.is_constant())
@@ -192,7 +217,7 @@ impl Codegen<'_> {
                         output.push_str(&format!("/* {comment} */\n"));
                     }
                     match &code {
-                        CodeChunk::Code(inner) => output.push_str(inner),
+                        CodeChunk::Code(inner, _) => output.push_str(inner),
                         _ => unreachable!(),
                     }
                 }
@@ -211,7 +236,7 @@ impl Codegen<'_> {
             .iter()
             .map(|ch| format!("0x{:02x}", ch))
             .join(", ");
-        let max_size = builder.max_out_size;
+        let max_size = self.max_out_size;
         output = format!(
             "
                 if (*{buf_size_name} < {max_size}) {{
@@ -229,11 +254,67 @@ impl Codegen<'_> {
             "
         );
 
-        Ok(CodegenOutput {
-            code: output,
-            min_size: builder.min_out_size,
-            max_size: builder.max_out_size,
-        })
+        output
+    }
+
+    /// Generate code for a fixed-size output: every field has a fixed offset,
+    /// so the whole output is copied from a pre-generated skeleton in one go
+    /// and only the variable fields are written on top of it.
+    fn generate_patch(&self, buf_name: &str, buf_size_name: &str) -> Result<String> {
+        let mut patches = String::new();
+        let mut skeleton = Vec::<u8>::new();
+        // Offset at which the template engine writes next. The skeleton copy
+        // leaves it at the end of the output.
+        let mut cursor = self.max_out_size;
+
+        for CodeChunkWithComment { code, comment } in &self.output {
+            match &code {
+                CodeChunk::ConstBytes(data) => skeleton.extend(data),
+                CodeChunk::Code(inner, Some(size)) => {
+                    let offset = skeleton.len();
+                    if let Some(comment) = comment {
+                        patches.push_str(&format!("/* {comment} */\n"));
+                    }
+                    if offset != cursor {
+                        patches.push_str(&format!("template_seek(&state, {offset});\n"));
+                    }
+                    patches.push_str(inner);
+                    // The skeleton holds zeroes where the variable fields go.
+                    skeleton.extend(std::iter::repeat_n(0, *size));
+                    cursor = offset + size;
+                }
+                CodeChunk::OpenBlock | CodeChunk::CloseBlock => (),
+                CodeChunk::Code(_, None) | CodeChunk::SizePatchMemo(_) => {
+                    bail!("internal error: var-sized chunk in a fixed-size output")
+                }
+            }
+        }
+        ensure!(
+            skeleton.len() == self.max_out_size,
+            "internal error: skeleton size {} does not match output size {}",
+            skeleton.len(),
+            self.max_out_size
+        );
+
+        let size = skeleton.len();
+        let skeleton = skeleton.iter().map(|ch| format!("0x{:02x}", ch)).join(", ");
+        Ok(format!(
+            "
+                if (*{buf_size_name} < {size}) {{
+                    return kErrorCertInvalidSize;
+                }}
+
+                const static uint8_t kTemplateConstBytes[] = {{{skeleton}}};
+                template_state_t state;
+
+                template_init(&state, {buf_name}, kTemplateConstBytes);
+                template_push_const(&state, /*nbytes=*/{size});
+
+                {patches}
+
+                *{buf_size_name} = {size};
+            "
+        ))
     }
 
     /// Push a chunk to the output stream.
@@ -275,7 +356,8 @@ impl Codegen<'_> {
     fn push_function_call(&mut self, min_size: usize, max_size: usize, s: &str) {
         self.min_out_size += min_size;
         self.max_out_size += max_size;
-        self.push_chunk(CodeChunk::Code(s.to_owned()), None);
+        let size = (min_size == max_size).then_some(max_size);
+        self.push_chunk(CodeChunk::Code(s.to_owned(), size), None);
     }
 
     /// Get the placeholder for length octet encoded with DER.
@@ -732,9 +814,12 @@ impl Builder for Codegen<'_> {
                             );
                         };
                         self.push_chunk(
-                            CodeChunk::Code(format!(
-                                "template_set_bit(&state, {byte_offset}, {bit_offset}, {value_expr});\n"
-                            )),
+                            CodeChunk::Code(
+                                format!(
+                                    "template_set_bit(&state, {byte_offset}, {bit_offset}, {value_expr});\n"
+                                ),
+                                Some(0),
+                            ),
                             Some(name.clone()),
                         );
                     }
@@ -836,7 +921,7 @@ impl Builder for Codegen<'_> {
                 comment: Some(format!("Start of {tag_name}")),
             };
             self.push_chunk(
-                CodeChunk::Code("template_patch_size_be(&state, memo);\n".to_string()),
+                CodeChunk::Code("template_patch_size_be(&state, memo);\n".to_string(), None),
                 Some(format!("End of {tag_name}")),
             );
         }
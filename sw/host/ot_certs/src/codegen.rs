@@ -212,16 +212,28 @@ pub fn generate_cert(from_file: &str, tmpl: &Template) -> Result<Codegen> {
     source_unittest.push_str("extern \"C\" {\n");
     writeln!(source_unittest, "#include \"{}.h\"", tmpl.name)?;
     source_unittest.push_str("}\n");
-    source_unittest.push_str("#include \"gtest/gtest.h\"\n\n");
+    source_unittest.push_str("#include \"gtest/gtest.h\"\n");
+    source_unittest.push_str("#include \"sw/device/silicon_creator/lib/cert/asn1.h\"\n");
+    source_unittest.push_str("#include \"sw/device/silicon_creator/lib/cert/template.h\"\n\n");
+
+    // Streaming implementations of the fixed-size builders.
+    for reference_code in [
+        &generate_tbs_fn_impl.reference_code,
+        &generate_cert_fn_impl.reference_code,
+    ]
+    .into_iter()
+    .flatten()
+    {
+        source_unittest.push_str(reference_code);
+    }
 
     for idx in 0..TEST_CASE_COUNT {
         let test_case = generate_test_case(
             &format!("Verify{idx}"),
             &tbs_vars,
             &sig_vars,
-            generate_tbs_fn_impl.min_size,
-            generate_tbs_fn_impl.max_size,
-            generate_cert_fn_impl.max_size,
+            &generate_tbs_fn_impl,
+            &generate_cert_fn_impl,
             tmpl,
         )?;
         source_unittest.push_str(&test_case);
@@ -239,11 +251,13 @@ fn generate_test_case(
     test_name: &str,
     tbs_vars: &IndexMap<String, VariableType>,
     sig_vars: &IndexMap<String, VariableType>,
-    min_tbs_size: usize,
-    max_tbs_size: usize,
-    max_cert_size: usize,
+    tbs_impl: &CodegenOutput,
+    cert_impl: &CodegenOutput,
     tmpl: &Template,
 ) -> Result<String> {
+    let min_tbs_size = tbs_impl.min_size;
+    let max_tbs_size = tbs_impl.max_size;
+    let max_cert_size = cert_impl.max_size;
     let mut source_unittest = String::new();
     let unittest_data = tmpl.random_test()?;
     let expected_cert = x509::generate_certificate(&tmpl.subst(&unittest_data)?)?;
@@ -344,6 +358,29 @@ fn generate_test_case(
         "#,
     });
 
+    // Fixed-size builders patch a skeleton: check them byte-for-byte against
+    // the streaming implementation.
+    if tbs_impl.reference_code.is_some() {
+        source_unittest.push_str(&format! { r#"
+            uint8_t tbs_stream[{max_tbs_size}];
+            size_t tbs_stream_size = sizeof(tbs_stream);
+            EXPECT_EQ(kErrorOk, {generate_tbs_fn_name}_stream(&g_tbs_values, tbs_stream, &tbs_stream_size));
+            EXPECT_EQ(tbs_size, tbs_stream_size);
+            EXPECT_EQ(0, memcmp(g_tbs, tbs_stream, tbs_size));
+        "#,
+        });
+    }
+    if cert_impl.reference_code.is_some() {
+        source_unittest.push_str(&format! { r#"
+            uint8_t cert_stream[{max_cert_size}];
+            size_t cert_stream_size = sizeof(cert_stream);
+            EXPECT_EQ(kErrorOk, {generate_cert_fn_name}_stream(&g_sig_values, cert_stream, &cert_stream_size));
+            EXPECT_EQ(cert_size, cert_stream_size);
+            EXPECT_EQ(0, memcmp(g_cert_data, cert_stream, cert_size));
+        "#,
+        });
+    }
+
     source_unittest.push_str(
         "
         }
@@ -493,6 +530,20 @@ fn generate_builder(
     generate_fn_impl.push_str("}\n\n");
     generated_code.code = generate_fn_impl;
 
+    // The streaming implementation of a fixed-size output is only used by the
+    // unittest, to check the patched one against it.
+    if let Some(reference_code) = generated_code.reference_code.take() {
+        let mut reference_fn_impl = String::new();
+        writeln!(
+            reference_fn_impl,
+            "static rom_error_t {fn_name}_stream({fn_params_str}) {{"
+        )?;
+        reference_fn_impl.push_str(&reference_code);
+        reference_fn_impl.push_str("  return kErrorOk;\n");
+        reference_fn_impl.push_str("}\n\n");
+        generated_code.reference_code = Some(reference_fn_impl);
+    }
+
     Ok((generate_fn_def, generated_code))
 }
 
@@ -668,11 +668,22 @@ enum GeneratedCode {
     FunctionCall(String),
     // If all the arguments are constants, derive its resulting bytes directly.
     CborBytes(Vec<u8>),
+    // The raw content of a variable, with its exact size if known before runtime.
+    VarBytes {
+        value: String,
+        size: String,
+        exact_size: Option<u64>,
+    },
 }
 
 struct GeneratedCborInstructions {
     constant_definitions: String,
     cbor_instructions: String,
+    // Streaming version of `cbor_instructions` when the structure has a fixed
+    // size and `cbor_instructions` patch a pre-generated skeleton instead; both
+    // produce the same bytes. Its constants are defined in place, so that it
+    // can be used as the body of a function on its own.
+    reference_instructions: Option<String>,
 }
 
 fn generate_cbor_instructions(
@@ -691,6 +702,15 @@ fn generate_cbor_instructions(
 
     let gen_inst = |inst: String| GeneratedCode::FunctionCall(call_wrapper(inst));
 
+    let var_bytes = |var: &CodegenVar, value: String| GeneratedCode::VarBytes {
+        value,
+        size: var.size_expression(),
+        exact_size: match var.size {
+            VariableSize::ExactSize(size) => Some(size),
+            VariableSize::MaxSize(_) => None,
+        },
+    };
+
     // For each CodegenStructure, generate its CodeBlock first.
     let mut code_blocks = Vec::<CodeBlock>::new();
     for (idx, (node, size_exp)) in nodes.iter().zip(size_exps.iter()).enumerate() {
@@ -706,9 +726,7 @@ fn generate_cbor_instructions(
                     let content = if let Some(constant) = val {
                         GeneratedCode::CborBytes(constant.clone())
                     } else {
-                        let val = var.value_expression();
-                        let size = var.size_expression();
-                        gen_inst(format!("cbor_write_raw_bytes(&cbor, {val}, {size})"))
+                        var_bytes(var, var.value_expression())
                     };
 
                     vec![header, content]
@@ -723,11 +741,7 @@ fn generate_cbor_instructions(
                     let content = if let Some(constant) = val {
                         GeneratedCode::CborBytes(constant.as_bytes().to_vec())
                     } else {
-                        let val = var.value_expression();
-                        let size = var.size_expression();
-                        gen_inst(format!(
-                            "cbor_write_raw_bytes(&cbor, (uint8_t *){val}, {size})"
-                        ))
+                        var_bytes(var, format!("(uint8_t *){}", var.value_expression()))
                     };
 
                     vec![header, content]
@@ -774,14 +788,80 @@ fn generate_cbor_instructions(
 
     // Collect the code blocks, and then linearize them into a sequence of single operations.
     let order = collect_preorder_indicies(nodes);
-    let insts = order.iter().flat_map(|&idx| code_blocks[idx].clone());
+    let insts = order
+        .iter()
+        .flat_map(|&idx| code_blocks[idx].clone())
+        .collect::<Vec<_>>();
+
+    let stream = generate_streaming_instructions(&insts, prefix);
+
+    // When the size of the whole structure is known before runtime, every
+    // variable has a fixed offset: write the encoding at once with zeroes in
+    // place of the variables, and then patch them in.
+    if size_exps.last().is_some_and(|exp| exp.is_constant()) {
+        let mut constant_definitions = String::new();
+        let mut cbor_instructions = String::new();
+        let mut skeleton = Vec::<u8>::new();
+        for inst in insts {
+            match inst {
+                GeneratedCode::CborBytes(inner) => skeleton.extend(inner),
+                GeneratedCode::VarBytes {
+                    value,
+                    exact_size: Some(size),
+                    ..
+                } => {
+                    let offset = skeleton.len();
+                    cbor_instructions += &call_wrapper(format!(
+                        "cbor_patch_raw_bytes(&cbor, {offset}, {value}, {size})"
+                    ));
+                    skeleton.extend(iter::repeat_n(0, size as usize));
+                }
+                _ => bail!("internal error: var-sized item in a fixed-size structure"),
+            }
+        }
+
+        let bytes = skeleton.iter().map(|ch| format!("{}", ch));
+        let initializer: String =
+            itertools::Itertools::intersperse(bytes, ", ".to_owned()).collect();
+
+        constant_definitions += &indoc::formatdoc! { r#"
+            {prefix}const static uint8_t skeleton[] = {{{initializer}}};
+            "#};
+        cbor_instructions =
+            call_wrapper("cbor_write_raw_bytes(&cbor, skeleton, sizeof(skeleton))".to_owned())
+                + &cbor_instructions;
+
+        return Ok(GeneratedCborInstructions {
+            constant_definitions,
+            cbor_instructions,
+            reference_instructions: Some(stream.constant_definitions + &stream.cbor_instructions),
+        });
+    }
+
+    Ok(stream)
+}
+
+// Generate the instructions that write the linearized operations one after the other.
+fn generate_streaming_instructions(
+    insts: &[GeneratedCode],
+    prefix: &str,
+) -> GeneratedCborInstructions {
+    let call_wrapper = |func_call: String| {
+        indoc::formatdoc! { r#"
+            {prefix}{func_call};
+            "#
+        }
+    };
 
     let mut constant_definitions = String::new();
     let mut cbor_instructions = String::new();
 
     // For neighboring CBOR, we collect them into a single array and write them at once.
     let mut idx = 0usize;
-    for (is_constant, chunk) in &insts.chunk_by(|inst| matches!(inst, GeneratedCode::CborBytes(_)))
+    for (is_constant, chunk) in &insts
+        .iter()
+        .cloned()
+        .chunk_by(|inst| matches!(inst, GeneratedCode::CborBytes(_)))
     {
         if is_constant {
             let buf = chunk.flat_map(|inst| match inst {
@@ -805,16 +885,21 @@ fn generate_cbor_instructions(
             for block in chunk {
                 match block {
                     GeneratedCode::FunctionCall(inner) => cbor_instructions += &inner,
-                    _ => panic!("Shouldn't have any non GeneratedCode::FunctionCall variant."),
+                    GeneratedCode::VarBytes { value, size, .. } => {
+                        cbor_instructions +=
+                            &call_wrapper(format!("cbor_write_raw_bytes(&cbor, {value}, {size})"))
+                    }
+                    _ => panic!("Shouldn't have any GeneratedCode::CborBytes variant."),
                 }
             }
         }
     }
 
-    Ok(GeneratedCborInstructions {
+    GeneratedCborInstructions {
         constant_definitions,
         cbor_instructions,
-    })
+        reference_instructions: None,
+    }
 }
 
 fn generate_header(from_file: &str, template_name: &str, max_size: u64, decls: String) -> String {
@@ -846,14 +931,35 @@ fn generate_header(from_file: &str, template_name: &str, max_size: u64, decls: S
     "#}
 }
 
-fn generate_source(
-    from_file: &str,
+// Generate the definition of a builder function.
+fn generate_build_fn(
+    fn_decl: &str,
     template_name: &str,
-    constant_definitions: &str,
     size_computations: &str,
     input_size_checks: &str,
     output_size_checks: &str,
     cbor_instructions: &str,
+) -> String {
+    indoc::formatdoc! { r#"
+        {fn_decl}({template_name}_values_t *values, uint8_t *buffer, size_t *inout_size) {{
+        {size_computations}
+        {input_size_checks}
+          cbor_out_t cbor;
+          cbor_out_init(&cbor, buffer);
+
+        {cbor_instructions}
+          *inout_size = cbor_out_size(&cbor);
+        {output_size_checks}
+          return kErrorOk;
+        }}
+    "#}
+}
+
+fn generate_source(
+    from_file: &str,
+    template_name: &str,
+    constant_definitions: &str,
+    build_fn: &str,
 ) -> String {
     let source_template = indoc::formatdoc! { r#"
         // Copyright lowRISC contributors (OpenTitan project).
@@ -867,20 +973,97 @@ fn generate_source(
         #include "sw/device/silicon_creator/lib/cert/cbor.h"
 
         {constant_definitions}
-        rom_error_t {template_name}_build({template_name}_values_t *values, uint8_t *buffer, size_t *inout_size) {{
-        {size_computations}
-        {input_size_checks}
-          cbor_out_t cbor;
-          cbor_out_init(&cbor, buffer);
+        {build_fn}"#};
 
-        {cbor_instructions}
-          *inout_size = cbor_out_size(&cbor);
-        {output_size_checks}
-          return kErrorOk;
+    source_template
+}
+
+// Generate a unittest building the template with deterministic values. When the
+// builder patches a skeleton, its output is checked byte-for-byte against the
+// streaming reference.
+fn generate_unittest(
+    from_file: &str,
+    template_name: &str,
+    vars: &CodegenVarTable,
+    reference_fn: Option<&str>,
+) -> String {
+    let enum_name = template_name.to_upper_camel_case();
+
+    let mut value_definitions = String::new();
+    let mut value_assignments = String::new();
+    for (idx, var) in vars.values().filter(|var| !var.is_constant()).enumerate() {
+        let name = &var.name;
+        let size = match var.size {
+            VariableSize::ExactSize(size) | VariableSize::MaxSize(size) => size as usize,
+        };
+        match var.value {
+            CodegenVarValue::ByteArray(_) => {
+                let bytes = (0..size)
+                    .map(|i| format!("{:#04x}", (i * 7 + idx) & 0xff))
+                    .join(", ");
+                value_definitions += &format!("  static uint8_t g_{name}[] = {{{bytes}}};\n");
+            }
+            CodegenVarValue::String(_) => {
+                let chars = (0..size)
+                    .map(|i| format!("'{}'", (b'a' + ((i + idx) % 26) as u8) as char))
+                    .join(", ");
+                value_definitions += &format!("  static char g_{name}[] = {{{chars}}};\n");
+            }
+            CodegenVarValue::Integer(_) => {
+                value_assignments += &format!("      .{name} = {},\n", 1000 + idx);
+                continue;
+            }
+        }
+        value_assignments += &format!("      .{name} = g_{name},\n");
+        value_assignments += &format!("      .{name}_size = sizeof(g_{name}),\n");
+    }
+
+    let reference_check = if reference_fn.is_some() {
+        [
+            String::new(),
+            format!("  uint8_t stream[k{enum_name}MaxVariableSizeBytes];"),
+            "  size_t stream_size = sizeof(stream);".to_string(),
+            format!(
+                "  EXPECT_EQ(kErrorOk, {template_name}_build_stream(&values, stream, &stream_size));"
+            ),
+            "  EXPECT_EQ(size, stream_size);".to_string(),
+            "  EXPECT_EQ(0, memcmp(buffer, stream, size));".to_string(),
+        ]
+        .iter()
+        .map(|line| format!("{line}\n"))
+        .collect()
+    } else {
+        String::new()
+    };
+
+    indoc::formatdoc! { r#"
+        // Copyright lowRISC contributors (OpenTitan project).
+        // Licensed under the Apache License, Version 2.0, see LICENSE for details.
+        // SPDX-License-Identifier: Apache-2.0
+
+        // This file was automatically generated using opentitantool from:
+        // {from_file}
+
+        extern "C" {{
+        #include "{template_name}.h"
         }}
-    "#};
+        #include "gtest/gtest.h"
+        #include "sw/device/silicon_creator/lib/cert/cbor.h"
 
-    source_template
+        {reference_fn}
+        TEST({enum_name}, Build) {{
+        {value_definitions}
+          {template_name}_values_t values = {{
+        {value_assignments}  }};
+
+          uint8_t buffer[k{enum_name}MaxVariableSizeBytes];
+          size_t size = sizeof(buffer);
+          EXPECT_EQ(kErrorOk, {template_name}_build(&values, buffer, &size));
+          EXPECT_LE(size, sizeof(buffer));
+        {reference_check}}}
+        "#,
+        reference_fn = reference_fn.unwrap_or_default(),
+    }
 }
 
 impl CwtTemplate {
@@ -944,21 +1127,34 @@ pub fn generate_cert(from_file: &str, template: &CwtTemplate) -> Result<Codegen>
     let GeneratedCborInstructions {
         constant_definitions,
         cbor_instructions,
+        reference_instructions,
     } = generate_cbor_instructions(&structures, &exact_sizes, "  ")
         .context("generate_cbor_instructions failed")?;
 
-    let source_c = generate_source(
-        from_file,
+    let build_fn = generate_build_fn(
+        &format!("rom_error_t {}_build", template.name),
         &template.name,
-        &constant_definitions,
         &size_computations,
         &input_size_checks,
         &output_size_checks,
         &cbor_instructions,
     );
-
-    // TODO: finish the unittest
-    let source_unittest = String::new();
+    let source_c = generate_source(from_file, &template.name, &constant_definitions, &build_fn);
+
+    // The streaming implementation of a fixed-size output is only used by the
+    // unittest, to check the patched one against it.
+    let reference_fn = reference_instructions.map(|instructions| {
+        generate_build_fn(
+            &format!("static rom_error_t {}_build_stream", template.name),
+            &template.name,
+            &size_computations,
+            &input_size_checks,
+            &output_size_checks,
+            &instructions,
+        )
+    });
+    let source_unittest =
+        generate_unittest(from_file, &template.name, &vars, reference_fn.as_deref());
 
     Ok(Codegen {
         source_h,
@@ -19,6 +19,7 @@ mod test {
     //use std::io::{Read, Write};
     use opentitanlib::util::testing::{ChildConsole, TransferState};
     use opentitanlib::util::tmpfilename;
+    use std::time::Instant;
     use xmodem::XmodemFirmware;
 
     #[rustfmt::skip]
@@ -166,4 +167,30 @@ November 19, 1863
         assert_eq!(err.unwrap_err().to_string(), "Cancel");
         Ok(())
     }
+
+    #[test]
+    fn test_xmodem1k_recv_throughput() -> Result<()> {
+        // A firmware-sized image, so that the per-frame cost of the C
+        // implementation (CRC, framing) dominates process startup.
+        const IMAGE_LEN: usize = 256 * 1024;
+        let filename = tmpfilename("test_xmodem1k_recv_throughput");
+        let image = (0..IMAGE_LEN as u32)
+            .map(|i| (i.wrapping_mul(0x9e3779b9) >> 24) as u8)
+            .collect::<Vec<u8>>();
+        std::fs::write(&filename, &image)?;
+        let child = ChildConsole::spawn(&["sx", "--1k", &filename])?;
+        let xmodem = XmodemFirmware::new();
+        let mut result = Vec::new();
+        let start = Instant::now();
+        xmodem.receive(&child, &mut result)?;
+        let elapsed = start.elapsed();
+        assert!(child.wait()?.success());
+        assert!(result.len() >= IMAGE_LEN);
+        assert_eq!(&result[..IMAGE_LEN], &image[..]);
+        println!(
+            "xmodem-1k receive: {IMAGE_LEN} bytes in {elapsed:?} ({:.0} KiB/s)",
+            IMAGE_LEN as f64 / 1024.0 / elapsed.as_secs_f64()
+        );
+        Ok(())
+    }
 }
@@ -19,12 +19,16 @@
 //! - `TEST_UNDECLARED_OUTPUTS_DIR`: The directory where extra coverage report is stored.
 //!
 //! The script looks in $COVERAGE_DIR for the OpenTitan compressed counters
-//! (`.xprofraw`) and uses lcov to get the coverage data. The coverage data
-//! is placed in $COVERAGE_DIR with `.dat` extension.
+//! (`.xprofraw`) and uses lcov to get the coverage data. Counters with the
+//! same build ID, e.g. the delta reports streamed by a long-running test, are
+//! merged first. The coverage data is placed in $COVERAGE_DIR with `.dat`
+//! extension.
 
 use anyhow::Result;
+use std::collections::btree_map::{BTreeMap, Entry};
 use std::env;
 use std::fs;
+use std::path::PathBuf;
 
 use coverage_lib::{
     debug_environ, debug_log, llvm_cov_export, llvm_profdata_merge, path_from_env,
@@ -42,15 +46,28 @@ fn main() -> Result<()> {
 
     let output_dir = path_from_env("TEST_UNDECLARED_OUTPUTS_DIR");
 
-    // Correlate profile data with counters from the device.
+    // Merge the counters of each build, e.g. the delta reports streamed by a
+    // long-running test, so that each build is reported once.
+    let mut counters: BTreeMap<String, (PathBuf, ProfileCounter)> = BTreeMap::new();
     for path in &xprofraw_files {
+        debug_log!("Loading {path:?}");
+        let counter = ProfileCounter::load(path).unwrap();
+        match counters.entry(counter.build_id.clone()) {
+            Entry::Occupied(mut entry) => entry.get_mut().1.merge(&counter)?,
+            Entry::Vacant(entry) => {
+                entry.insert((path.clone(), counter));
+            }
+        }
+    }
+
+    // Correlate profile data with counters from the device.
+    for (path, counter) in counters.values() {
         debug_log!("Processing {path:?}");
         // We use .xprofdata instead of .profdata to avoid lcov_merger from parsing it.
         let profdata_file = path.with_extension("xprofdata");
         let profraw_file = path.with_extension("profraw");
         let lcov_file = path.with_extension("dat");
 
-        let counter = ProfileCounter::load(path).unwrap();
         let profile = profile_registry.get(&counter.build_id).unwrap();
 
         eprintln!("Profile:");
@@ -59,7 +76,7 @@ fn main() -> Result<()> {
         eprintln!("  Firmware: {:?}", &profile.file_name);
         debug_log!("{:?}", &profile.elf);
 
-        profile.generate_profraw(&counter, &profraw_file).unwrap();
+        profile.generate_profraw(counter, &profraw_file).unwrap();
         llvm_profdata_merge(&profraw_file, &profdata_file);
         llvm_cov_export("lcov", &profdata_file, &profile.elf, &lcov_file);
 
@@ -217,6 +217,26 @@ impl ProfileCounter {
             cnts: decompress_counters(&mut f)?,
         })
     }
+
+    /// Merges the counters of `other` into `self`.
+    ///
+    /// A counter is covered in the result if it is covered in either profile.
+    /// This combines the delta reports streamed by `coverage_flush()` on the
+    /// device, which each carry only the counters covered since the previous
+    /// report, into the coverage of the whole run.
+    pub fn merge(&mut self, other: &ProfileCounter) -> Result<()> {
+        if self.build_id != other.build_id {
+            bail!("build_id mismatched");
+        }
+        if self.cnts.len() != other.cnts.len() {
+            bail!("cnts size mismatched");
+        }
+        // Covered counters are 0x00 and uncovered ones 0xff.
+        for (cnt, other_cnt) in self.cnts.iter_mut().zip(&other.cnts) {
+            *cnt &= other_cnt;
+        }
+        Ok(())
+    }
 }
 
 impl ProfileData {